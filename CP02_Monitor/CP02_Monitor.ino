@@ -38,12 +38,19 @@ const char* DATA_URL = "http://192.168.1.19/metrics";  // 修改成你的小电
 const int REFRESH_INTERVAL = 500;   // 刷新间隔 (ms)
 
 // 任务计时器
-unsigned long lastRGBUpdate = 0;
-unsigned long lastPowerUpdate = 0;
 unsigned long lastWiFiCheck = 0;
-const unsigned long RGB_UPDATE_INTERVAL = 20;     // RGB更新间隔 (ms)
-const unsigned long POWER_UPDATE_INTERVAL = 500;  // 功率监控更新间隔 (ms)
-const unsigned long WIFI_CHECK_INTERVAL = 1000;   // WiFi状态检查间隔 (ms)
+const unsigned long WIFI_CHECK_INTERVAL = 1000;   // WiFi状态检查间隔 (ms)，也是主循环最长的休眠时间
+const unsigned long LOAD_REPORT_INTERVAL = 10000; // 主循环负载统计的打印间隔 (ms)
+const unsigned long STACK_REPORT_INTERVAL = 60000; // 任务栈水位的打印间隔 (ms)
+const uint32_t STACK_MARGIN_PERCENT = 25;          // 建议栈大小在峰值上加的余量
+const uint32_t STACK_MIN_MARGIN = 512;             // 最小余量 (字节)
+
+// 主循环负载统计：醒着的时间和唤醒次数
+uint32_t loopWaitMs = 0;
+uint32_t loadWindowStart = 0;
+uint32_t loadBusyUs = 0;
+uint32_t loadWakeups = 0;
+uint32_t lastStackReport = 0;
 
 // 系统状态
 bool systemInitialized = false;
@@ -88,8 +95,14 @@ bool initializeSystem() {
         RGB_Lamp_Off();
         printf("[RGB] RGB lamp disabled\n");
     } else {
+        RGB_Lamp_Start();
         printf("[RGB] RGB lamp enabled\n");
     }
+    
+    // WiFi状态变化时唤醒主循环
+    WiFi.onEvent([](arduino_event_id_t event) {
+        Lvgl_Notify(LVGL_EVENT_WIFI);
+    });
     delay(100);
 
     printf("[System] System initialization complete\n");
@@ -111,6 +124,53 @@ void setup()
     }
 }
 
+// 打印主循环醒着的时间占比和每秒唤醒次数
+void reportLoopLoad(uint32_t busyUs) {
+    loadBusyUs += busyUs;
+    loadWakeups++;
+    
+    uint32_t elapsed = millis() - loadWindowStart;
+    if (elapsed >= LOAD_REPORT_INTERVAL) {
+        printf("[System] Loop busy %.1f%%, %.1f wakeups/s, portal %.1f wakeups/s, free heap %u\n",
+               loadBusyUs / (elapsed * 10.0f), loadWakeups * 1000.0f / elapsed,
+               ConfigManager::takePortalWakeups() * 1000.0f / elapsed, (unsigned)ESP.getFreeHeap());
+        loadWindowStart = millis();
+        loadBusyUs = 0;
+        loadWakeups = 0;
+    }
+}
+
+// 打印任务栈的峰值用量和建议大小
+// FreeRTOS创建任务时把栈填满0xA5，水位是栈底还没被改写的字节数，即运行以来剩余最少的字节数
+void printStackUsage(const char* name, TaskHandle_t task, uint32_t stackSize) {
+    uint32_t minFree = uxTaskGetStackHighWaterMark(task);
+    uint32_t used = stackSize > minFree ? stackSize - minFree : 0;
+    uint32_t margin = used * STACK_MARGIN_PERCENT / 100;
+    if (margin < STACK_MIN_MARGIN) {
+        margin = STACK_MIN_MARGIN;
+    }
+    uint32_t suggested = (used + margin + 255) / 256 * 256;
+    printf("[Stack] %-12s size %u, peak %u, min free %u, suggest %u (%+d)\n",
+           name, (unsigned)stackSize, (unsigned)used, (unsigned)minFree,
+           (unsigned)suggested, (int)stackSize - (int)suggested);
+}
+
+// 定期打印各任务的栈水位，用于调整栈大小
+void reportStacks() {
+    if (millis() - lastStackReport < STACK_REPORT_INTERVAL) {
+        return;
+    }
+    lastStackReport = millis();
+    
+    printStackUsage("loopTask", NULL, getArduinoLoopTaskStackSize());
+    if (monitorTaskHandle != NULL) {
+        printStackUsage("MonitorTask", monitorTaskHandle, MONITOR_TASK_STACK);
+    }
+    if (ConfigManager::getPortalTask() != NULL) {
+        printStackUsage("PortalTask", ConfigManager::getPortalTask(), ConfigManager::PORTAL_TASK_STACK);
+    }
+}
+
 void loop()
 {
     // 如果系统未初始化，不执行任何操作
@@ -119,18 +179,21 @@ void loop()
         return;
     }
 
+    // 休眠到下一个LVGL定时器、下一次WiFi检查，或者被其他任务的事件唤醒
+    uint32_t events = Lvgl_Wait(loopWaitMs);
+    uint32_t wakeUs = micros();
     unsigned long currentMillis = millis();
     
-    // 处理LVGL任务
-    if (displayInitialized) {
-        lv_timer_handler();
+    // 采集任务发布了新数据，让刷新定时器在这一轮就取数据
+    if (events & LVGL_EVENT_DATA) {
+        PowerMonitor_DataReady();
     }
     
-    // 处理配置门户
-    ConfigManager::handle();
+    // 配置门户在自己的任务中处理请求，这里只刷新配置相关的屏幕
+    ConfigManager::updateScreens();
     
-    // 定期检查WiFi状态
-    if (currentMillis - lastWiFiCheck >= WIFI_CHECK_INTERVAL) {
+    // 定期检查WiFi状态，WiFi状态变化时立即检查
+    if (currentMillis - lastWiFiCheck >= WIFI_CHECK_INTERVAL || (events & LVGL_EVENT_WIFI)) {
         bool wifiReady = ConfigManager::isConfigured() && ConfigManager::isConnected();
         
         if (wifiReady && !powerMonitorInitialized) {
@@ -151,25 +214,29 @@ void loop()
         lastWiFiCheck = currentMillis;
     }
     
-    // 检查并更新RGB灯状态
-    bool currentRGBState = ConfigManager::isRGBEnabled();
-    if (currentRGBState != lastRGBState) {
-        if (!currentRGBState) {
-            RGB_Lamp_Off();
-            printf("[RGB] RGB lamp disabled\n");
-        } else {
-            printf("[RGB] RGB lamp enabled\n");
+    // 配置门户修改了RGB灯开关
+    if (events & LVGL_EVENT_CONFIG) {
+        bool currentRGBState = ConfigManager::isRGBEnabled();
+        if (currentRGBState != lastRGBState) {
+            if (!currentRGBState) {
+                RGB_Lamp_Off();
+                printf("[RGB] RGB lamp disabled\n");
+            } else {
+                RGB_Lamp_Start();
+                printf("[RGB] RGB lamp enabled\n");
+            }
+            lastRGBState = currentRGBState;
         }
-        lastRGBState = currentRGBState;
     }
     
-    // 更新RGB灯效果
-    if (currentMillis - lastRGBUpdate >= RGB_UPDATE_INTERVAL && currentRGBState) {
-        RGB_Lamp_Loop(1);
-        lastRGBUpdate = currentMillis;
+    // 处理LVGL任务，屏幕静止时返回LV_NO_TIMER_READY
+    uint32_t lvglIdle = displayInitialized ? Timer_Loop() : WIFI_CHECK_INTERVAL;
+    uint32_t wifiIdle = WIFI_CHECK_INTERVAL - (millis() - lastWiFiCheck);
+    if (wifiIdle > WIFI_CHECK_INTERVAL) {
+        wifiIdle = 0;
     }
+    loopWaitMs = lvglIdle < wifiIdle ? lvglIdle : wifiIdle;
     
-    // 给其他任务一些执行时间
-    yield();
-    delay(5);  // 短暂延时，防止看门狗复位
+    reportLoopLoad(micros() - wakeUs);
+    reportStacks();
 }
@@ -0,0 +1,185 @@
+#include "Charge_Card.h"
+#include "Power_Monitor.h"
+
+#define CARD_PAD        8
+#define PHASE_BAR_WIDTH 300
+#define PHASE_BAR_H     12
+
+lv_obj_t* ChargeCard::panel = nullptr;
+lv_obj_t* ChargeCard::titleLabel = nullptr;
+lv_obj_t* ChargeCard::timeLabel = nullptr;
+lv_obj_t* ChargeCard::bodyLabel = nullptr;
+lv_obj_t* ChargeCard::phaseBar = nullptr;
+lv_obj_t* ChargeCard::segments[CHARGE_PHASE_MAX] = {};
+lv_timer_t* ChargeCard::pageTimer = nullptr;
+ChargeSummary ChargeCard::sessions[ChargeHistory::CAPACITY];
+uint8_t ChargeCard::sessionCount = 0;
+uint8_t ChargeCard::page = 0;
+
+// 各阶段的颜色，与图例一致
+static const uint32_t PHASE_COLORS[] = {
+    0x888888,   // RAMP
+    0x88FF00,   // BULK
+    0xFF8800,   // TAPER
+    0x00AAFF,   // TRICKLE
+};
+
+static const char* PORT_NAMES[MAX_PORTS] = { "A", "C1", "C2", "C3", "C4" };
+
+static const char* protocolName(uint8_t protocol) {
+    static const char* const NAMES[] = {
+        "None", "QC2", "QC3", "QC3+", "SFCP", "AFC", "FCP", "SCP", "VOOC1.0", "VOOC4.0", "SVOOC2.0",
+        "TFCP", "UFCS", "PE1", "PE2", "PD_Fix5V", "PD_FixHV", "PD_SPR_AVS", "PD_PPS", "PD_EPR_HV", "PD_AVS",
+    };
+    return protocol < sizeof(NAMES) / sizeof(NAMES[0]) ? NAMES[protocol] : "?";
+}
+
+// 时长格式化为1h23m或23m45s
+static void formatDuration(char* buf, size_t len, uint32_t seconds) {
+    if (seconds >= 3600) {
+        snprintf(buf, len, "%uh%02um", (unsigned)(seconds / 3600), (unsigned)(seconds % 3600 / 60));
+    } else {
+        snprintf(buf, len, "%um%02us", (unsigned)(seconds / 60), (unsigned)(seconds % 60));
+    }
+}
+
+void ChargeCard::create() {
+    // 盖在当前屏幕上，不影响监控屏幕的对象
+    panel = lv_obj_create(lv_layer_top());
+    lv_obj_set_size(panel, LV_PCT(100), LV_PCT(100));
+    lv_obj_set_style_bg_color(panel, lv_color_black(), 0);
+    lv_obj_set_style_bg_opa(panel, LV_OPA_COVER, 0);
+    lv_obj_set_style_border_width(panel, 0, 0);
+    lv_obj_set_style_radius(panel, 0, 0);
+    lv_obj_set_style_pad_all(panel, CARD_PAD, 0);
+    lv_obj_clear_flag(panel, LV_OBJ_FLAG_SCROLLABLE);
+
+    titleLabel = lv_label_create(panel);
+    lv_obj_set_style_text_color(titleLabel, lv_color_white(), 0);
+    lv_obj_set_style_text_font(titleLabel, &lv_font_montserrat_16, 0);
+    lv_obj_align(titleLabel, LV_ALIGN_TOP_LEFT, 0, 0);
+
+    timeLabel = lv_label_create(panel);
+    lv_obj_set_style_text_color(timeLabel, lv_color_white(), 0);
+    lv_obj_set_style_text_font(timeLabel, &lv_font_montserrat_16, 0);
+    lv_obj_align(timeLabel, LV_ALIGN_TOP_RIGHT, 0, 0);
+
+    bodyLabel = lv_label_create(panel);
+    lv_obj_set_width(bodyLabel, LV_PCT(100));
+    lv_label_set_long_mode(bodyLabel, LV_LABEL_LONG_DOT);
+    lv_obj_set_style_text_color(bodyLabel, lv_color_white(), 0);
+    lv_obj_set_style_text_font(bodyLabel, &lv_font_montserrat_14, 0);
+    lv_obj_set_style_text_line_space(bodyLabel, 4, 0);
+    lv_obj_align(bodyLabel, LV_ALIGN_TOP_LEFT, 0, 26);
+
+    // 阶段条，每段是一个不透明的矩形，按时间比例排列
+    phaseBar = lv_obj_create(panel);
+    lv_obj_remove_style_all(phaseBar);
+    lv_obj_set_size(phaseBar, PHASE_BAR_WIDTH, PHASE_BAR_H);
+    lv_obj_align(phaseBar, LV_ALIGN_BOTTOM_MID, 0, -20);
+    lv_obj_set_style_bg_color(phaseBar, lv_color_hex(0x444444), 0);
+    lv_obj_set_style_bg_opa(phaseBar, LV_OPA_COVER, 0);
+    for (int i = 0; i < CHARGE_PHASE_MAX; i++) {
+        segments[i] = lv_obj_create(phaseBar);
+        lv_obj_remove_style_all(segments[i]);
+        lv_obj_set_style_bg_opa(segments[i], LV_OPA_COVER, 0);
+        lv_obj_set_height(segments[i], PHASE_BAR_H);
+    }
+
+    lv_obj_t* legend = lv_label_create(panel);
+    lv_label_set_recolor(legend, true);
+    lv_label_set_text(legend, "#888888 RAMP#  #88FF00 BULK#  #FF8800 TAPER#  #00AAFF TRICKLE#");
+    lv_obj_set_style_text_font(legend, &lv_font_montserrat_14, 0);
+    lv_obj_align(legend, LV_ALIGN_BOTTOM_MID, 0, 0);
+}
+
+void ChargeCard::render() {
+    const ChargeSummary& s = sessions[page];
+    char buf[160];
+
+    snprintf(buf, sizeof(buf), "%s  %u/%u", s.port < MAX_PORTS ? PORT_NAMES[s.port] : "?",
+             (unsigned)(page + 1), (unsigned)sessionCount);
+    lv_label_set_text(titleLabel, buf);
+    formatDuration(buf, sizeof(buf), s.durationS);
+    lv_label_set_text(timeLabel, buf);
+
+    // 电量和功率
+    int len = snprintf(buf, sizeof(buf), "%u.%02uWh  Peak %u.%uW  Avg %u.%uW\n",
+                       (unsigned)(s.energyMwh / 1000), (unsigned)(s.energyMwh % 1000 / 10),
+                       s.peakDw / 10, s.peakDw % 10, s.avgDw / 10, s.avgDw % 10);
+
+    // 进入降流的时间和结束方式
+    if (s.taperS == CHARGE_NO_TAPER) {
+        len += snprintf(buf + len, sizeof(buf) - len, "No taper");
+    } else {
+        char taper[16];
+        formatDuration(taper, sizeof(taper), s.taperS);
+        len += snprintf(buf + len, sizeof(buf) - len, "Taper at %s", taper);
+    }
+    len += snprintf(buf + len, sizeof(buf) - len, ", %s\n", s.end == END_UNPLUG ? "unplugged" : "done");
+
+    // 协议顺序
+    if (s.protoCount == 0) {
+        snprintf(buf + len, sizeof(buf) - len, "No fast charge");
+    }
+    for (uint8_t i = 0; i < s.protoCount && len < (int)sizeof(buf); i++) {
+        len += snprintf(buf + len, sizeof(buf) - len, "%s%s", i > 0 ? " > " : "", protocolName(s.protocols[i]));
+    }
+    lv_label_set_text(bodyLabel, buf);
+
+    // 阶段条
+    uint32_t duration = s.durationS > 0 ? s.durationS : 1;
+    for (uint8_t i = 0; i < CHARGE_PHASE_MAX; i++) {
+        if (i >= s.phaseCount) {
+            lv_obj_add_flag(segments[i], LV_OBJ_FLAG_HIDDEN);
+            continue;
+        }
+        uint32_t from = s.phases[i].offsetS;
+        uint32_t to = i + 1 < s.phaseCount ? s.phases[i + 1].offsetS : duration;
+        lv_coord_t x1 = (lv_coord_t)(LV_MIN(from, duration) * PHASE_BAR_WIDTH / duration);
+        lv_coord_t x2 = (lv_coord_t)(LV_MIN(to, duration) * PHASE_BAR_WIDTH / duration);
+        lv_obj_clear_flag(segments[i], LV_OBJ_FLAG_HIDDEN);
+        lv_obj_set_style_bg_color(segments[i], lv_color_hex(PHASE_COLORS[s.phases[i].phase & 3]), 0);
+        lv_obj_set_x(segments[i], x1);
+        lv_obj_set_width(segments[i], LV_MAX(x2 - x1, 1));
+    }
+}
+
+void ChargeCard::pageTimerCb(lv_timer_t* timer) {
+    if (++page >= sessionCount) {
+        hide();
+        return;
+    }
+    render();
+}
+
+void ChargeCard::show() {
+    sessionCount = PowerMonitor_CopySessions(sessions, ChargeHistory::CAPACITY);
+    if (sessionCount == 0) {
+        hide();
+        return;
+    }
+
+    if (panel == nullptr) {
+        create();
+    }
+    page = 0;
+    render();
+
+    if (pageTimer == nullptr) {
+        pageTimer = lv_timer_create(pageTimerCb, PAGE_MS, NULL);
+    } else {
+        lv_timer_reset(pageTimer);
+    }
+}
+
+void ChargeCard::hide() {
+    if (pageTimer != nullptr) {
+        lv_timer_del(pageTimer);
+        pageTimer = nullptr;
+    }
+    if (panel != nullptr) {
+        lv_obj_del(panel);
+        panel = nullptr;
+    }
+}
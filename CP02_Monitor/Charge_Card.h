@@ -0,0 +1,34 @@
+#pragma once
+#include <Arduino.h>
+#include "lvgl.h"
+#include "Charge_Session.h"
+
+// 充电会话摘要卡片
+// 有会话结束时盖在监控屏幕上，从最新的会话开始每张显示几秒，显示完最早
+// 的一张后自动关闭。卡片上是端口、时长、电量、峰值和平均功率、进入降流
+// 的时间、协议顺序，底部按时间比例画出各充电阶段。
+class ChargeCard {
+public:
+    static const uint32_t PAGE_MS = 4000;   // 每张卡片显示的时间
+
+    // 重新读取会话摘要，从最新的一张开始显示
+    static void show();
+    static void hide();
+    static bool isVisible() { return panel != nullptr; }
+
+private:
+    static void create();
+    static void render();
+    static void pageTimerCb(lv_timer_t* timer);
+
+    static lv_obj_t* panel;
+    static lv_obj_t* titleLabel;
+    static lv_obj_t* timeLabel;
+    static lv_obj_t* bodyLabel;
+    static lv_obj_t* phaseBar;
+    static lv_obj_t* segments[CHARGE_PHASE_MAX];
+    static lv_timer_t* pageTimer;
+    static ChargeSummary sessions[ChargeHistory::CAPACITY];
+    static uint8_t sessionCount;
+    static uint8_t page;
+};
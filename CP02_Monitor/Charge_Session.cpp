@@ -0,0 +1,216 @@
+#include "Charge_Session.h"
+#include <string.h>
+
+#define RISE_PERCENT    102     // 平滑功率比上次记下的最高值高出2%才算在上升
+
+const ChargeSession::Config ChargeSession::DEFAULT_CONFIG = {
+    .startMa = 100,
+    .stopMa = 50,
+    .offMv = 1000,
+    .startHoldMs = 2000,
+    .unplugHoldMs = 3000,
+    .idleEndMs = 120000,
+    .holdMs = 10000,
+    .maxGapMs = 10000,
+    .alphaPercent = 10,
+    .taperPercent = 80,
+    .tricklePercent = 15,
+    .resumePercent = 95,
+};
+
+void ChargeSession::begin(uint8_t port) {
+    memset(this, 0, sizeof(*this));
+    this->port = port;
+}
+
+void ChargeSession::start(uint32_t nowMs) {
+    isActive = true;
+    unplugging = false;
+    idling = false;
+    stateSeen = false;
+    phase = PHASE_RAMP;
+    candidate = PHASE_RAMP;
+    riseMs = nowMs;
+    plateauMs = nowMs;
+    energyMwMs = 0;
+    memset(&current, 0, sizeof(current));
+    current.startMs = nowMs;
+    current.port = port;
+    current.taperS = CHARGE_NO_TAPER;
+    addPhase(PHASE_RAMP, nowMs);
+}
+
+// 协议0和0xFF表示没有快充协议，不记录
+void ChargeSession::addProtocol(uint8_t protocol) {
+    if (protocol == 0 || protocol == 0xFF) {
+        return;
+    }
+    if (current.protoCount > 0 && current.protocols[current.protoCount - 1] == protocol) {
+        return;
+    }
+    if (current.protoCount < CHARGE_PROTO_MAX) {
+        current.protoCount++;
+    }
+    current.protocols[current.protoCount - 1] = protocol;
+}
+
+void ChargeSession::addPhase(ChargePhase phase, uint32_t atMs) {
+    uint32_t offsetS = (atMs - current.startMs) / 1000;
+    if (phase == PHASE_TAPER && current.taperS == CHARGE_NO_TAPER) {
+        current.taperS = offsetS;
+    }
+    if (current.phaseCount < CHARGE_PHASE_MAX) {
+        current.phaseCount++;
+    }
+    ChargePhaseMark& mark = current.phases[current.phaseCount - 1];
+    mark.offsetS = offsetS;
+    mark.phase = phase;
+}
+
+// 按平滑功率相对会话内最高值的比例判断阶段，TAPER和TRICKLE要回到resumePercent以上才回到BULK
+void ChargeSession::updatePhase(const Config& cfg, float powerMw, uint32_t nowMs) {
+    emaMw += (powerMw - emaMw) * cfg.alphaPercent / 100.0f;
+    if (emaMw * 100 > plateauMw * RISE_PERCENT) {
+        riseMs = nowMs;
+    }
+    if (emaMw > plateauMw) {
+        plateauMw = emaMw;
+    }
+    if (plateauMw <= 0) {
+        return;
+    }
+
+    float percent = emaMw * 100 / plateauMw;
+    if (percent >= cfg.resumePercent) {
+        plateauMs = nowMs;
+    }
+    ChargePhase target;
+    if (percent < cfg.tricklePercent) {
+        target = PHASE_TRICKLE;
+    } else if (percent < cfg.taperPercent) {
+        target = PHASE_TAPER;
+    } else if (phase >= PHASE_TAPER && percent < cfg.resumePercent) {
+        target = PHASE_TAPER;
+    } else if (phase == PHASE_RAMP && nowMs - riseMs < cfg.holdMs) {
+        target = PHASE_RAMP;
+    } else {
+        target = PHASE_BULK;
+    }
+
+    if (target == phase) {
+        candidate = phase;
+        return;
+    }
+    if (target != candidate) {
+        candidate = target;
+        candidateMs = nowMs;
+    }
+    if (nowMs - candidateMs >= cfg.holdMs) {
+        // 上升结束的时间是BULK的起点，开始下降的时间是TAPER的起点
+        uint32_t atMs = candidateMs;
+        if (target == PHASE_BULK && phase == PHASE_RAMP) {
+            atMs = riseMs;
+        } else if (target == PHASE_TAPER && phase < PHASE_TAPER) {
+            atMs = plateauMs;
+        }
+        phase = target;
+        addPhase(target, atMs);
+    }
+}
+
+void ChargeSession::finish(ChargeEnd end, uint32_t endMs, ChargeSummary* summary) {
+    uint32_t durationMs = endMs - current.startMs;
+    current.durationS = durationMs / 1000;
+    current.energyMwh = (uint32_t)(energyMwMs / 3600000);
+    current.peakDw = (uint16_t)(peakMw / 100);
+    current.avgDw = durationMs > 0 ? (uint16_t)(energyMwMs / durationMs / 100) : 0;
+    current.end = end;
+    *summary = current;
+    isActive = false;
+    pending = false;
+}
+
+bool ChargeSession::update(const Config& cfg, uint8_t state, uint8_t protocol, uint16_t voltageMv, uint16_t currentMa,
+                           uint32_t nowMs, ChargeSummary* summary) {
+    float powerMw = voltageMv * (float)currentMa / 1000.0f;
+
+    if (!isActive) {
+        if (currentMa < cfg.startMa || voltageMv < cfg.offMv) {
+            pending = false;
+            return false;
+        }
+        if (!pending) {
+            pending = true;
+            pendingMs = nowMs;
+            pendingProtocol = protocol;
+        }
+        if (nowMs - pendingMs < cfg.startHoldMs) {
+            return false;
+        }
+        // 确认开始时补上等待期间的电量
+        start(pendingMs);
+        energyMwMs = (uint64_t)(powerMw * (nowMs - pendingMs));
+        lastMs = nowMs;
+        lastMw = powerMw;
+        peakMw = powerMw;
+        emaMw = powerMw;
+        plateauMw = powerMw;
+        addProtocol(pendingProtocol);
+        addProtocol(protocol);
+        return false;
+    }
+
+    // 相邻两次采样的平均功率乘以间隔，断网时不按整个间隔累计
+    uint32_t dtMs = nowMs - lastMs;
+    if (dtMs > cfg.maxGapMs) {
+        dtMs = cfg.maxGapMs;
+    }
+    energyMwMs += (uint64_t)((lastMw + powerMw) / 2 * dtMs);
+    lastMs = nowMs;
+    lastMw = powerMw;
+    if (powerMw > peakMw) {
+        peakMw = powerMw;
+    }
+    addProtocol(protocol);
+
+    if (state != 0) {
+        stateSeen = true;
+    }
+    bool unplugged = voltageMv < cfg.offMv || (stateSeen && state == 0 && currentMa < cfg.stopMa);
+    if (!unplugged) {
+        unplugging = false;
+    } else if (!unplugging) {
+        unplugging = true;
+        unplugMs = nowMs;
+    }
+    if (unplugging && nowMs - unplugMs >= cfg.unplugHoldMs) {
+        finish(END_UNPLUG, unplugMs, summary);
+        return true;
+    }
+
+    if (currentMa >= cfg.stopMa) {
+        idling = false;
+    } else if (!idling) {
+        idling = true;
+        idleMs = nowMs;
+    }
+    if (idling && nowMs - idleMs >= cfg.idleEndMs) {
+        finish(END_IDLE, idleMs, summary);
+        return true;
+    }
+
+    updatePhase(cfg, powerMw, nowMs);
+    return false;
+}
+
+void ChargeHistory::add(const ChargeSummary& summary) {
+    ring[head] = summary;
+    head = (head + 1) % CAPACITY;
+    if (used < CAPACITY) {
+        used++;
+    }
+}
+
+const ChargeSummary& ChargeHistory::get(uint8_t index) const {
+    return ring[(head + CAPACITY - 1 - index % CAPACITY) % CAPACITY];
+}
@@ -0,0 +1,130 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// 充电会话统计
+// 设备插入后电流持续超过startMa时开始一个会话，拔出（电压消失，或者端口
+// 状态回到0且没有电流）或者电流长时间低于stopMa（充满）时结束。会话期间按
+// 相邻两次采样的平均功率累计电量，记下峰值功率和出现过的快充协议。
+//
+// 充电曲线按平滑后的功率在线分段，每个采样只做常数次比较：
+//   RAMP    刚开始，功率还在上升
+//   BULK    功率接近会话内的最高值（恒流或恒功率）
+//   TAPER   功率持续低于最高值的taperPercent，进入恒压降流
+//   TRICKLE 功率持续低于最高值的tricklePercent，基本充满
+// 新阶段需要保持holdMs才确认，起点记在第一次满足条件的采样上；TAPER的
+// 起点记在功率最后一次接近最高值的时候，也就是开始下降的时间。
+// 只依赖标准C头文件，可以在主机上回放记录的数据验证。
+
+#define CHARGE_PROTO_MAX    4       // 每个会话记录的协议数
+#define CHARGE_PHASE_MAX    6       // 每个会话记录的阶段数，满了之后最后一个记录最新的阶段
+#define CHARGE_NO_TAPER     UINT32_MAX
+
+enum ChargePhase : uint8_t {
+    PHASE_RAMP,
+    PHASE_BULK,
+    PHASE_TAPER,
+    PHASE_TRICKLE,
+};
+
+enum ChargeEnd : uint8_t {
+    END_UNPLUG,     // 设备拔出
+    END_IDLE,       // 电流长时间很小，认为已经充满
+};
+
+// 阶段起点，相对会话开始的秒数
+struct ChargePhaseMark {
+    uint32_t offsetS : 24;
+    uint32_t phase : 8;
+};
+
+// 一个已结束会话的摘要，52字节
+struct ChargeSummary {
+    uint32_t startMs;           // 开始时间（millis）
+    uint32_t durationS;
+    uint32_t energyMwh;
+    uint16_t peakDw;            // 峰值功率（0.1W）
+    uint16_t avgDw;             // 平均功率（0.1W）
+    uint32_t taperS;            // 第一次进入TAPER的时间，CHARGE_NO_TAPER表示没有
+    uint8_t port;
+    uint8_t end;                // ChargeEnd
+    uint8_t protoCount;
+    uint8_t phaseCount;
+    uint8_t protocols[CHARGE_PROTO_MAX];    // 按出现顺序，相邻重复的只记一次
+    ChargePhaseMark phases[CHARGE_PHASE_MAX];
+};
+
+// 单个端口的会话跟踪
+class ChargeSession {
+public:
+    struct Config {
+        uint16_t startMa;           // 电流超过这个值开始会话
+        uint16_t stopMa;            // 电流低于这个值认为没有在充电
+        uint16_t offMv;             // 电压低于这个值认为设备已拔出
+        uint16_t startHoldMs;       // 开始条件需要保持的时间
+        uint16_t unplugHoldMs;      // 拔出条件需要保持的时间，PD复位时电压会短暂消失
+        uint32_t idleEndMs;         // 电流低于stopMa这么久后结束会话
+        uint16_t holdMs;            // 新阶段需要保持的时间
+        uint16_t maxGapMs;          // 两次采样间隔超过这个值时按这个值累计电量
+        uint8_t alphaPercent;       // 功率平滑时新采样所占的比例
+        uint8_t taperPercent;
+        uint8_t tricklePercent;
+        uint8_t resumePercent;      // 功率回到最高值的这个比例以上时回到BULK
+    };
+    static const Config DEFAULT_CONFIG;
+
+    void begin(uint8_t port);
+
+    // 输入一次采样，有会话结束时返回true并写入summary
+    bool update(const Config& cfg, uint8_t state, uint8_t protocol, uint16_t voltageMv, uint16_t currentMa,
+                uint32_t nowMs, ChargeSummary* summary);
+
+    bool active() const { return isActive; }
+
+private:
+    void start(uint32_t nowMs);
+    void finish(ChargeEnd end, uint32_t endMs, ChargeSummary* summary);
+    void addProtocol(uint8_t protocol);
+    void addPhase(ChargePhase phase, uint32_t atMs);
+    void updatePhase(const Config& cfg, float powerMw, uint32_t nowMs);
+
+    uint8_t port;
+    bool isActive;
+    bool pending;               // 开始条件已满足，等待保持startHoldMs
+    bool unplugging;            // 拔出条件已满足，等待保持unplugHoldMs
+    bool idling;                // 电流已低于stopMa
+    bool stateSeen;             // 会话中端口状态出现过非0值，没有时不按状态判断拔出
+    uint32_t pendingMs;         // 以上三个条件第一次满足的时间
+    uint8_t pendingProtocol;    // 开始条件第一次满足时的协议，握手时协议可能在确认之前就变了
+    uint32_t unplugMs;
+    uint32_t idleMs;
+    uint32_t lastMs;
+    float lastMw;
+    float peakMw;
+    float emaMw;
+    float plateauMw;            // 会话内平滑功率的最高值
+    uint32_t riseMs;            // 平滑功率最近一次明显上升的时间
+    uint32_t plateauMs;         // 平滑功率最近一次在最高值的resumePercent以上的时间
+    uint64_t energyMwMs;
+    ChargePhase phase;
+    ChargePhase candidate;      // 等待确认的新阶段，等于phase表示没有
+    uint32_t candidateMs;
+    ChargeSummary current;      // 正在进行的会话
+};
+
+// 最近N个会话摘要的环形缓冲区，不做加锁，由使用者保护
+class ChargeHistory {
+public:
+    static const uint8_t CAPACITY = 8;
+
+    ChargeHistory() : head(0), used(0) {}
+    void add(const ChargeSummary& summary);
+    uint8_t count() const { return used; }
+    // index为0时是最新的会话
+    const ChargeSummary& get(uint8_t index) const;
+
+private:
+    ChargeSummary ring[CAPACITY];
+    uint8_t head;               // 下一个写入的位置
+    uint8_t used;
+};
@@ -1,12 +1,37 @@
 #include "Config_Manager.h"
 #include "RGB_lamp.h"  // 添加RGB_lamp头文件
 #include "Power_Monitor.h"
+#include "LVGL_Driver.h"
+#include "Portal_Pages.h"
+
+// 门户任务两次处理请求之间的间隔 (ms)，有人在用门户时短，空闲时长
+#define PORTAL_POLL_MS      10
+#define PORTAL_IDLE_POLL_MS 200
+// 最后一个请求之后保持短间隔的时间 (ms)
+#define PORTAL_ACTIVE_MS    5000
+// 页面发送缓冲区大小，每满一次作为一个chunk发出
+#define PAGE_CHUNK_SIZE 256
+// 占位符名称的最大长度
+#define PAGE_VAR_MAX    16
+// 切换WiFi时等待新网络连接的时间 (ms)，超时后连回原来的网络
+#define WIFI_SWITCH_TIMEOUT_MS  15000
 
 WebServer ConfigManager::server(80);
 DNSServer ConfigManager::dnsServer;
 Preferences ConfigManager::preferences;
 bool ConfigManager::configured = false;
 bool ConfigManager::apStarted = false;
+volatile bool ConfigManager::displayDirty = false;
+TaskHandle_t ConfigManager::portalTaskHandle = NULL;
+volatile uint32_t ConfigManager::lastRequestMs = 0;
+volatile uint32_t ConfigManager::portalWakeups = 0;
+ConfigManager::WiFiSwitchState ConfigManager::switchState = ConfigManager::SWITCH_IDLE;
+char ConfigManager::switchSSID[33] = "";
+char ConfigManager::switchPassword[65] = "";
+uint32_t ConfigManager::switchStartMs = 0;
+portMUX_TYPE ConfigManager::configLock = portMUX_INITIALIZER_UNLOCKED;
+char ConfigManager::monitorUrl[128] = "";
+volatile uint32_t ConfigManager::configVersion = 0;
 const char* ConfigManager::AP_SSID = "ESP32_Config";
 const char* ConfigManager::NVS_NAMESPACE = "wifi_config";
 const char* ConfigManager::NVS_SSID_KEY = "ssid";
@@ -35,7 +60,9 @@ void ConfigManager::begin() {
     if (monitorUrl.length() == 0) {
         printf("[Config] Setting default monitor URL\n");
         preferences.putString(NVS_MONITOR_URL_KEY, DEFAULT_MONITOR_URL);
+        monitorUrl = DEFAULT_MONITOR_URL;
     }
+    strlcpy(ConfigManager::monitorUrl, monitorUrl.c_str(), sizeof(ConfigManager::monitorUrl));
     
     if (ssid.length() > 0) {
         configured = true;
@@ -96,6 +123,11 @@ void ConfigManager::begin() {
     // 启动AP和配置门户
     startConfigPortal();
     
+    // 门户请求在单独的任务中处理，LVGL循环没有事件时可以一直休眠
+    if (portalTaskHandle == NULL) {
+        xTaskCreate(portalTask, "PortalTask", PORTAL_TASK_STACK, NULL, 1, &portalTaskHandle);
+    }
+    
     printf("[Config] Initialization complete\n");
     delay(100);
 }
@@ -108,9 +140,110 @@ void ConfigManager::startConfigPortal() {
     }
 }
 
+// WebServer和DNSServer不提供可以select()的套接字，只能轮询。AP上有设备连着、
+// 最近处理过请求或者正在切换WiFi时每10ms处理一次，否则每200ms一次：空闲时
+// 从每秒100次唤醒降到5次，第一个请求最多多等200ms，之后恢复短间隔。
+uint32_t ConfigManager::pollDelayMs() {
+    if (switchState != SWITCH_IDLE || WiFi.softAPgetStationNum() > 0 ||
+        millis() - lastRequestMs < PORTAL_ACTIVE_MS) {
+        return PORTAL_POLL_MS;
+    }
+    return PORTAL_IDLE_POLL_MS;
+}
+
+void ConfigManager::portalTask(void* parameter) {
+    while (true) {
+        handle();
+        portalWakeups++;
+        vTaskDelay(pdMS_TO_TICKS(pollDelayMs()));
+    }
+}
+
+uint32_t ConfigManager::takePortalWakeups() {
+    uint32_t n = portalWakeups;
+    portalWakeups = 0;
+    return n;
+}
+
 void ConfigManager::handle() {
     dnsServer.processNextRequest();
     server.handleClient();
+    serviceWiFiSwitch();
+}
+
+void ConfigManager::requestWiFiSwitch(const char* ssid, const char* password) {
+    strlcpy(switchSSID, ssid, sizeof(switchSSID));
+    strlcpy(switchPassword, password, sizeof(switchPassword));
+    switchState = SWITCH_PENDING;
+    printf("[WiFi] Switch to %s requested\n", switchSSID);
+}
+
+// 切换WiFi：原来连着网络时先扫描，确认新网络存在再断开原连接；新网络连上后
+// 才保存设置，超时则连回原来的网络。每次调用只推进一步，不阻塞门户任务。
+void ConfigManager::serviceWiFiSwitch() {
+    switch (switchState) {
+        case SWITCH_IDLE:
+            return;
+            
+        case SWITCH_PENDING:
+            if (WiFi.status() == WL_CONNECTED) {
+                WiFi.scanNetworks(true, false, false, 300, 0, switchSSID);
+                switchState = SWITCH_SCANNING;
+                return;
+            }
+            break;
+            
+        case SWITCH_SCANNING: {
+            int16_t found = WiFi.scanComplete();
+            if (found == WIFI_SCAN_RUNNING) {
+                return;
+            }
+            WiFi.scanDelete();
+            if (found <= 0) {
+                printf("[WiFi] %s not found, keeping current network\n", switchSSID);
+                switchState = SWITCH_IDLE;
+                return;
+            }
+            break;
+        }
+            
+        case SWITCH_WAITING:
+            // WiFi.begin()之后断开原网络是异步的，状态可能还是原来那个网络的
+            // WL_CONNECTED，要连上的确实是新网络才算切换成功
+            if (WiFi.status() == WL_CONNECTED && WiFi.SSID() == switchSSID) {
+                printf("[WiFi] Switched to %s\n", switchSSID);
+                saveConfig(switchSSID, switchPassword);
+                switchState = SWITCH_IDLE;
+                Lvgl_Notify(LVGL_EVENT_WIFI);
+            } else if (millis() - switchStartMs >= WIFI_SWITCH_TIMEOUT_MS) {
+                String ssid = getSSID();
+                switchState = SWITCH_IDLE;
+                if (ssid.length() > 0) {
+                    printf("[WiFi] %s failed, back to %s\n", switchSSID, ssid.c_str());
+                    WiFi.begin(ssid.c_str(), getPassword().c_str());
+                } else {
+                    printf("[WiFi] %s failed\n", switchSSID);
+                }
+                Lvgl_Notify(LVGL_EVENT_WIFI);
+            }
+            return;
+    }
+    
+    // 新网络存在，或者原来就没有连接，开始连接新网络
+    if (WiFi.getMode() == WIFI_AP) {
+        WiFi.mode(WIFI_AP_STA);
+    }
+    printf("[WiFi] Connecting to %s...\n", switchSSID);
+    WiFi.begin(switchSSID, switchPassword);
+    switchStartMs = millis();
+    switchState = SWITCH_WAITING;
+}
+
+void ConfigManager::updateScreens() {
+    if (displayDirty) {
+        displayDirty = false;
+        applyDisplay();
+    }
     
     // 定期更新显示
     static unsigned long lastDisplayUpdate = 0;
@@ -173,207 +306,157 @@ void ConfigManager::setupAP() {
     delay(100);
 }
 
+// 固定大小的发送缓冲区，满了就作为一个chunk发给客户端
+class ChunkWriter {
+public:
+    explicit ChunkWriter(WebServer& server) : server(server), len(0), total(0), firstByteUs(0) {}
+    
+    void write(char c) {
+        buf[len++] = c;
+        if (len == sizeof(buf)) {
+            flush();
+        }
+    }
+    
+    // 按HTML转义写入，值可能出现在属性里
+    void writeEscaped(const char* s) {
+        for (; *s; s++) {
+            switch (*s) {
+                case '&':  writeRaw("&amp;"); break;
+                case '<':  writeRaw("&lt;"); break;
+                case '>':  writeRaw("&gt;"); break;
+                case '"':  writeRaw("&quot;"); break;
+                case '\'': writeRaw("&#39;"); break;
+                default:   write(*s); break;
+            }
+        }
+    }
+    
+    void flush() {
+        if (len == 0) {
+            return;
+        }
+        server.sendContent(buf, len);
+        if (total == 0) {
+            firstByteUs = micros();
+        }
+        total += len;
+        len = 0;
+    }
+    
+    size_t totalBytes() const { return total; }
+    uint32_t firstByteAt() const { return firstByteUs; }
+    
+private:
+    void writeRaw(const char* s) {
+        while (*s) {
+            write(*s++);
+        }
+    }
+    
+    WebServer& server;
+    char buf[PAGE_CHUNK_SIZE];
+    size_t len;
+    size_t total;
+    uint32_t firstByteUs;
+};
+
+// 用chunked编码发送flash中的页面模板，{{NAME}}替换成vars中对应的值
+// 整个过程只用一个固定大小的缓冲区，不管页面有多大
+void ConfigManager::sendPage(const char* page, const PageVar* vars, size_t varCount) {
+    uint32_t startUs = micros();
+    ChunkWriter out(server);
+    
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(200, "text/html", "");
+    
+    const char* p = page;
+    char c;
+    while ((c = pgm_read_byte(p)) != '\0') {
+        if (c == '{' && pgm_read_byte(p + 1) == '{') {
+            // 读出占位符名称，找不到结尾或名称太长时按原样输出
+            char name[PAGE_VAR_MAX + 1];
+            size_t n = 0;
+            const char* q = p + 2;
+            char d;
+            while (n < PAGE_VAR_MAX && (d = pgm_read_byte(q)) != '\0' && d != '}') {
+                name[n++] = d;
+                q++;
+            }
+            name[n] = '\0';
+            if (pgm_read_byte(q) == '}' && pgm_read_byte(q + 1) == '}') {
+                for (size_t i = 0; i < varCount; i++) {
+                    if (strcmp(vars[i].name, name) == 0) {
+                        out.writeEscaped(vars[i].value);
+                        break;
+                    }
+                }
+                p = q + 2;
+                continue;
+            }
+        }
+        out.write(c);
+        p++;
+    }
+    out.flush();
+    server.sendContent("");     // chunked结束标记
+    
+    uint32_t endUs = micros();
+    printf("[Web] %s: %u bytes, first byte %u us, total %u us, free heap %u, min free heap %u\n",
+           server.uri().c_str(), (unsigned)out.totalBytes(), (unsigned)(out.firstByteAt() - startUs),
+           (unsigned)(endUs - startUs), (unsigned)ESP.getFreeHeap(), (unsigned)ESP.getMinFreeHeap());
+}
+
 void ConfigManager::handleRoot() {
+    lastRequestMs = millis();
     // 获取当前URL并提取IP地址
     String currentUrl = getMonitorUrl();
     String currentIP = extractIPFromUrl(currentUrl);
     
     printf("[Config] Current URL: %s, Extracted IP: %s\n", currentUrl.c_str(), currentIP.c_str());
     
-    String html = R"rawliteral(
-    <!DOCTYPE html>
-    <html>
-    <head>
-        <meta charset='utf-8'>
-        <title>ESP32 配置</title>
-        <meta name='viewport' content='width=device-width, initial-scale=1'>
-        <style>
-            body { font-family: Arial; margin: 20px; background: #f0f0f0; }
-            .container { max-width: 400px; margin: 0 auto; background: white; padding: 20px; border-radius: 10px; box-shadow: 0 2px 5px rgba(0,0,0,0.1); }
-            .status { margin-bottom: 20px; padding: 10px; border-radius: 5px; }
-            .connected { background: #e8f5e9; color: #2e7d32; }
-            .disconnected { background: #ffebee; color: #c62828; }
-            input { width: 100%; padding: 8px; margin: 10px 0; border: 1px solid #ddd; border-radius: 4px; box-sizing: border-box; }
-            button { width: 100%; padding: 10px; background: #4CAF50; color: white; border: none; border-radius: 4px; cursor: pointer; margin-bottom: 10px; }
-            button:hover { background: #45a049; }
-            .danger-button { background: #f44336; }
-            .danger-button:hover { background: #d32f2f; }
-            .status-box { margin-top: 20px; }
-            .switch { position: relative; display: inline-block; width: 60px; height: 34px; }
-            .switch input { opacity: 0; width: 0; height: 0; }
-            .slider { position: absolute; cursor: pointer; top: 0; left: 0; right: 0; bottom: 0; background-color: #ccc; transition: .4s; border-radius: 34px; }
-            .slider:before { position: absolute; content: ""; height: 26px; width: 26px; left: 4px; bottom: 4px; background-color: white; transition: .4s; border-radius: 50%; }
-            input:checked + .slider { background-color: #4CAF50; }
-            input:checked + .slider:before { transform: translateX(26px); }
-            .control-group { margin: 20px 0; padding: 15px; border: 1px solid #ddd; border-radius: 5px; }
-            .modal { display: none; position: fixed; z-index: 1; left: 0; top: 0; width: 100%; height: 100%; background-color: rgba(0,0,0,0.5); }
-            .modal-content { background-color: #fefefe; margin: 15% auto; padding: 20px; border-radius: 5px; max-width: 300px; text-align: center; }
-            .modal-buttons { display: flex; justify-content: space-between; margin-top: 20px; }
-            .modal-buttons button { width: 45%; margin: 0; }
-            .cancel-button { background: #9e9e9e; }
-            .cancel-button:hover { background: #757575; }
-        </style>
-    </head>
-    <body>
-        <div class='container'>
-            <h2>ESP32 配置</h2>
-            <div id='status' class='status'></div>
-            
-            <div class='control-group'>
-                <h3>WiFi设置</h3>
-                <form method='post' action='/save'>
-                    WiFi名称:<br>
-                    <input type='text' name='ssid'><br>
-                    WiFi密码:<br>
-                    <input type='password' name='password'><br>
-                    小电拼服务器IP地址:<br>
-                    <input type='text' name='monitor_url' value=')rawliteral";
-    
-    html += currentIP;
-    
-    html += R"rawliteral(' placeholder='例如: 192.168.32.2'><br>
-                    <button type='submit'>保存配置</button>
-                </form>
-            </div>
-            
-            <div class='control-group'>
-                <h3>RGB灯控制</h3>
-                <label class='switch'>
-                    <input type='checkbox' id='rgb-switch' onchange='toggleRGB()'>
-                    <span class='slider'></span>
-                </label>
-                <span style='margin-left: 10px;'>RGB灯状态</span>
-            </div>
-
-            <div class='control-group'>
-                <h3>系统设置</h3>
-                <button class='danger-button' onclick='showResetConfirm()'>重置所有配置</button>
-            </div>
-        </div>
-
-        <div id='resetModal' class='modal'>
-            <div class='modal-content'>
-                <h3>确认重置</h3>
-                <p>这将清除所有配置并重启设备。确定要继续吗？</p>
-                <div class='modal-buttons'>
-                    <button class='cancel-button' onclick='hideResetConfirm()'>取消</button>
-                    <button class='danger-button' onclick='doReset()'>确认重置</button>
-                </div>
-            </div>
-        </div>
-        <script>
-            let lastUpdate = 0;
-            let updateInterval = 2000;
-            let statusUpdateTimeout = null;
-
-            function updateStatus() {
-                const now = Date.now();
-                if (now - lastUpdate < updateInterval) {
-                    return;
-                }
-                lastUpdate = now;
-
-                fetch('/status')
-                    .then(response => response.json())
-                    .then(data => {
-                        const statusBox = document.getElementById('status');
-                        if (data.connected) {
-                            statusBox.innerHTML = `已连接到WiFi: ${data.ssid}<br>IP地址: ${data.ip}`;
-                            statusBox.className = 'status connected';
-                        } else {
-                            statusBox.innerHTML = '未连接到WiFi';
-                            statusBox.className = 'status disconnected';
-                        }
-                        const rgbSwitch = document.getElementById('rgb-switch');
-                        if (rgbSwitch.checked !== data.rgb_enabled) {
-                            rgbSwitch.checked = data.rgb_enabled;
-                        }
-                    })
-                    .catch(() => {
-                        if (statusUpdateTimeout) {
-                            clearTimeout(statusUpdateTimeout);
-                        }
-                        statusUpdateTimeout = setTimeout(updateStatus, updateInterval);
-                    });
-            }
-            
-            function toggleRGB() {
-                const enabled = document.getElementById('rgb-switch').checked;
-                fetch('/rgb', {
-                    method: 'POST',
-                    headers: {'Content-Type': 'application/x-www-form-urlencoded'},
-                    body: 'enabled=' + enabled
-                }).then(() => {
-                    lastUpdate = 0;
-                    updateStatus();
-                });
-            }
-
-            function showResetConfirm() {
-                document.getElementById('resetModal').style.display = 'block';
-            }
-
-            function hideResetConfirm() {
-                document.getElementById('resetModal').style.display = 'none';
-            }
+    const PageVar vars[] = {
+        { "MONITOR_IP", currentIP.c_str() },
+    };
+    sendPage(PAGE_ROOT, vars, sizeof(vars) / sizeof(vars[0]));
+}
 
-            function doReset() {
-                hideResetConfirm();
-                fetch('/reset', {
-                    method: 'POST'
-                }).then(() => {
-                    alert('配置已重置，设备将重启...');
-                    setTimeout(() => {
-                        window.location.reload();
-                    }, 5000);
-                });
-            }
-            
-            // 点击模态框外部时关闭
-            window.onclick = function(event) {
-                const modal = document.getElementById('resetModal');
-                if (event.target == modal) {
-                    hideResetConfirm();
-                }
-            }
-            
-            window.onload = updateStatus;
-            setInterval(updateStatus, updateInterval);
-        </script>
-    </body>
-    </html>)rawliteral";
-    
-    server.send(200, "text/html", html);
+// JSON中的字符串值，转义引号和反斜杠，控制字符直接丢弃
+static size_t appendJsonString(char* buf, size_t pos, size_t size, const char* s) {
+    for (; *s && pos + 2 < size; s++) {
+        if (*s == '"' || *s == '\\') {
+            buf[pos++] = '\\';
+            buf[pos++] = *s;
+        } else if ((uint8_t)*s >= 0x20) {
+            buf[pos++] = *s;
+        }
+    }
+    buf[pos] = '\0';
+    return pos;
 }
 
 void ConfigManager::handleStatus() {
-    String json = "{\"connected\":";
-    json += WiFi.status() == WL_CONNECTED ? "true" : "false";
-    json += ",\"ssid\":\"";
-    json += WiFi.SSID();
-    json += "\",\"ip\":\"";
-    json += WiFi.localIP().toString();
-    json += "\",\"rgb_enabled\":";
-    json += isRGBEnabled() ? "true" : "false";
-    json += "}";
-    server.send(200, "application/json", json);
+    lastRequestMs = millis();
+    // SSID最长32字节，转义后最多64字节，其余字段长度固定
+    char json[160];
+    String ssid = WiFi.SSID();
+    IPAddress ip = WiFi.localIP();
+    
+    size_t len = snprintf(json, sizeof(json), "{\"connected\":%s,\"ssid\":\"",
+                          WiFi.status() == WL_CONNECTED ? "true" : "false");
+    len = appendJsonString(json, len, sizeof(json), ssid.c_str());
+    len += snprintf(json + len, sizeof(json) - len, "\",\"ip\":\"%u.%u.%u.%u\",\"rgb_enabled\":%s}",
+                    ip[0], ip[1], ip[2], ip[3], isRGBEnabled() ? "true" : "false");
+    server.send_P(200, "application/json", json, len);
 }
 
 void ConfigManager::handleRGBControl() {
+    lastRequestMs = millis();
     if (server.hasArg("enabled")) {
         bool enabled = server.arg("enabled") == "true";
+        // 保存后通知主循环，由主循环立即开关RGB灯
         setRGBEnabled(enabled);
-        
-        // 立即应用RGB灯状态
-        if (enabled) {
-            printf("RGB Light enabled\n");
-            // 立即启动一次RGB效果
-            RGB_Lamp_Loop(1);
-        } else {
-            printf("RGB Light disabled\n");
-            // 立即关闭RGB灯
-            RGB_Lamp_Off();
-        }
+        printf("RGB Light %s\n", enabled ? "enabled" : "disabled");
         
         // 立即响应请求
         server.send(200, "text/plain", "OK");
@@ -384,76 +467,35 @@ void ConfigManager::handleRGBControl() {
 }
 
 void ConfigManager::handleSave() {
+    lastRequestMs = millis();
     String ssid = server.arg("ssid");
     String password = server.arg("password");
-    String monitorUrl = server.arg("monitor_url");
+    String monitorIp = server.arg("monitor_url");
     
-    bool needRestart = false;
+    bool wifiChanged = false;
     bool configChanged = false;
     
-    if (ssid.length() > 0) {
-        saveConfig(ssid.c_str(), password.c_str());
-        WiFi.mode(WIFI_AP_STA);
-        WiFi.begin(ssid.c_str(), password.c_str());
-        needRestart = true;
+    // 服务器地址立即生效，采集任务在下一次采集时换用新地址
+    if (monitorIp.length() > 0 && monitorIp != extractIPFromUrl(getMonitorUrl())) {
+        saveMonitorUrl(monitorIp.c_str());
         configChanged = true;
     }
     
-    if (monitorUrl.length() > 0) {
-        String currentUrl = getMonitorUrl();
-        String newIp = monitorUrl;
-        String currentIp = extractIPFromUrl(currentUrl);
-        
-        if (currentIp != newIp) {
-            saveMonitorUrl(newIp.c_str());
-            needRestart = true;
-            configChanged = true;
-        }
+    // WiFi在门户任务中后台切换，不需要重启
+    if (ssid.length() > 0) {
+        requestWiFiSwitch(ssid.c_str(), password.c_str());
+        wifiChanged = true;
+        configChanged = true;
     }
     
     if (configChanged) {
-        String html = R"rawliteral(
-        <!DOCTYPE html>
-        <html>
-        <head>
-            <meta charset='utf-8'>
-            <title>配置已保存</title>
-            <meta name='viewport' content='width=device-width, initial-scale=1'>
-            <style>
-                body { font-family: Arial; margin: 20px; text-align: center; }
-                .message { margin: 20px; padding: 20px; background: #e8f5e9; border-radius: 5px; }
-                .countdown { font-size: 24px; margin: 20px; }
-            </style>
-            <script>
-                let count = 5;
-                function updateCountdown() {
-                    document.getElementById('countdown').textContent = count;
-                    if (count > 0) {
-                        count--;
-                        setTimeout(updateCountdown, 1000);
-                    }
-                }
-                window.onload = function() {
-                    updateCountdown();
-                    setTimeout(function() {
-                        window.location.href = '/';
-                    }, 5000);
-                }
-            </script>
-        </head>
-        <body>
-            <div class='message'>
-                <h2>配置已保存</h2>
-                <p>设备将在 <span id='countdown'>5</span> 秒后重启...</p>
-            </div>
-        </body>
-        </html>)rawliteral";
-        
-        server.send(200, "text/html", html);
-        delay(1000);
-        if (needRestart) {
-            ESP.restart();
-        }
+        const PageVar vars[] = {
+            { "TITLE", "配置已保存" },
+            { "BACKGROUND", "#e8f5e9" },
+            { "HEADING", "配置已保存" },
+            { "MESSAGE", wifiChanged ? "正在连接新的WiFi，连接失败时会保持原来的网络。" : "设置已生效。" },
+        };
+        sendPage(PAGE_NOTICE, vars, sizeof(vars) / sizeof(vars[0]));
     } else {
         server.sendHeader("Location", "/", true);
         server.send(302, "text/plain", "");
@@ -461,50 +503,20 @@ void ConfigManager::handleSave() {
 }
 
 void ConfigManager::handleReset() {
+    lastRequestMs = millis();
     printf("[Config] Processing reset request...\n");
     
     // 先重置配置
     resetConfig();
     
     // 然后发送响应
-    String html = R"rawliteral(
-    <!DOCTYPE html>
-    <html>
-    <head>
-        <meta charset='utf-8'>
-        <title>重置配置</title>
-        <meta name='viewport' content='width=device-width, initial-scale=1'>
-        <style>
-            body { font-family: Arial; margin: 20px; text-align: center; }
-            .message { margin: 20px; padding: 20px; background: #ffebee; border-radius: 5px; }
-            .countdown { font-size: 24px; margin: 20px; }
-        </style>
-        <script>
-            let count = 5;
-            function updateCountdown() {
-                document.getElementById('countdown').textContent = count;
-                if (count > 0) {
-                    count--;
-                    setTimeout(updateCountdown, 1000);
-                }
-            }
-            window.onload = function() {
-                updateCountdown();
-                setTimeout(function() {
-                    window.location.href = '/';
-                }, 5000);
-            }
-        </script>
-    </head>
-    <body>
-        <div class='message'>
-            <h2>配置已重置</h2>
-            <p>设备将在 <span id='countdown'>5</span> 秒后重启...</p>
-        </div>
-    </body>
-    </html>)rawliteral";
-    
-    server.send(200, "text/html", html);
+    const PageVar vars[] = {
+        { "TITLE", "重置配置" },
+        { "BACKGROUND", "#ffebee" },
+        { "HEADING", "配置已重置" },
+        { "MESSAGE", "设备正在重启。" },
+    };
+    sendPage(PAGE_NOTICE, vars, sizeof(vars) / sizeof(vars[0]));
     
     // 等待响应发送完成
     delay(1000);
@@ -514,6 +526,7 @@ void ConfigManager::handleReset() {
 }
 
 void ConfigManager::handleNotFound() {
+    lastRequestMs = millis();
     server.sendHeader("Location", "/", true);
     server.send(302, "text/plain", "");
 }
@@ -532,6 +545,7 @@ bool ConfigManager::isRGBEnabled() {
 
 void ConfigManager::setRGBEnabled(bool enabled) {
     preferences.putBool(NVS_RGB_KEY, enabled);
+    Lvgl_Notify(LVGL_EVENT_CONFIG);
 }
 
 void ConfigManager::resetConfig() {
@@ -573,7 +587,13 @@ void ConfigManager::saveConfig(const char* ssid, const char* password) {
     updateDisplay();
 }
 
+// 可能在门户任务中调用，只做标记，由LVGL循环在updateScreens()中刷新
 void ConfigManager::updateDisplay() {
+    displayDirty = true;
+    Lvgl_Notify(LVGL_EVENT_CONFIG);
+}
+
+void ConfigManager::applyDisplay() {
     if (!configured) {
         // 只有在未配置时才显示AP配置屏幕
         if (!DisplayManager::isAPScreenActive()) {
@@ -605,9 +625,17 @@ String ConfigManager::extractIPFromUrl(const String& url) {
 
 // 获取监控服务器地址
 String ConfigManager::getMonitorUrl() {
-    String url = preferences.getString(NVS_MONITOR_URL_KEY, DEFAULT_MONITOR_URL);
-    printf("[Config] Current monitor URL: %s\n", url.c_str());
-    return url;
+    char url[sizeof(monitorUrl)];
+    copyMonitorUrl(url, sizeof(url));
+    return String(url);
+}
+
+uint32_t ConfigManager::copyMonitorUrl(char* out, size_t len) {
+    portENTER_CRITICAL(&configLock);
+    strlcpy(out, monitorUrl, len);
+    uint32_t version = configVersion;
+    portEXIT_CRITICAL(&configLock);
+    return version;
 }
 
 // 保存监控服务器地址
@@ -615,6 +643,10 @@ void ConfigManager::saveMonitorUrl(const char* ip) {
     if (strlen(ip) > 0) {
         String fullUrl = String(URL_PREFIX) + ip + URL_SUFFIX;
         preferences.putString(NVS_MONITOR_URL_KEY, fullUrl.c_str());
+        portENTER_CRITICAL(&configLock);
+        strlcpy(monitorUrl, fullUrl.c_str(), sizeof(monitorUrl));
+        configVersion++;
+        portEXIT_CRITICAL(&configLock);
         printf("[Config] New monitor URL saved: %s\n", fullUrl.c_str());
     }
 } 
\ No newline at end of file
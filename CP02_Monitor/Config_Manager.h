@@ -6,11 +6,14 @@
 #include <WiFi.h>
 #include "Display_Manager.h"
 
+struct PageVar;
+
 // 配置管理类
 class ConfigManager {
 public:
     static void begin();
-    static void handle();
+    static void handle();           // 处理DNS和HTTP请求，在门户任务中调用
+    static void updateScreens();    // 刷新配置相关的屏幕，在LVGL循环中调用
     static bool isConfigured();
     static void resetConfig();
     static String getSSID();
@@ -22,12 +25,37 @@ public:
     static void setRGBEnabled(bool enabled);
     static void updateDisplay();
     static const char* getAPSSID() { return AP_SSID; }
+    static TaskHandle_t getPortalTask() { return portalTaskHandle; }
+    // 门户任务上次调用之后的唤醒次数，调用后清零
+    static uint32_t takePortalWakeups();
+    
+    static const uint32_t PORTAL_TASK_STACK = 6144;    // 门户任务的栈大小（字节）
     
     // 添加监控服务器地址相关函数
     static String getMonitorUrl();
     static void saveMonitorUrl(const char* url);
+    // 配置版本号，服务器地址每次修改加一，采集任务据此判断是否需要换地址
+    static uint32_t getConfigVersion() { return configVersion; }
+    // 复制当前的服务器地址，返回对应的配置版本号，可以在任何任务中调用
+    static uint32_t copyMonitorUrl(char* out, size_t len);
+    
+    // 后台切换到新的WiFi，新网络连上之后才保存，失败时连回原来的网络
+    static void requestWiFiSwitch(const char* ssid, const char* password);
     
 private:
+    // WiFi切换的状态，只在门户任务中推进
+    enum WiFiSwitchState : uint8_t {
+        SWITCH_IDLE,
+        SWITCH_PENDING,     // 收到新的WiFi设置
+        SWITCH_SCANNING,    // 保持原连接，先扫描确认新网络存在
+        SWITCH_WAITING,     // 已切换到新网络，等待连接结果
+    };
+    
+    static void portalTask(void* parameter);
+    static uint32_t pollDelayMs();
+    static void serviceWiFiSwitch();
+    static void applyDisplay();
+    static void sendPage(const char* page, const PageVar* vars, size_t varCount);
     static void setupAP();
     static void handleRoot();
     static void handleSave();
@@ -42,6 +70,17 @@ private:
     static Preferences preferences;
     static bool configured;
     static bool apStarted;
+    static volatile bool displayDirty;     // 门户任务请求刷新屏幕
+    static TaskHandle_t portalTaskHandle;
+    static volatile uint32_t lastRequestMs;    // 最后一个HTTP请求的时间，决定门户任务的轮询间隔
+    static volatile uint32_t portalWakeups;
+    static WiFiSwitchState switchState;
+    static char switchSSID[33];
+    static char switchPassword[65];
+    static uint32_t switchStartMs;
+    static portMUX_TYPE configLock;         // 保护monitorUrl
+    static char monitorUrl[128];            // 服务器地址，NVS中的值的副本
+    static volatile uint32_t configVersion;
     static const char* AP_SSID;
     static const char* NVS_NAMESPACE;
     static const char* NVS_SSID_KEY;
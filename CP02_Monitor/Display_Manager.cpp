@@ -1,4 +1,6 @@
 #include "Display_Manager.h"
+#include "Config_Manager.h"
+#include "QR_Panel.h"
 
 lv_obj_t* DisplayManager::apScreen = nullptr;
 lv_obj_t* DisplayManager::monitorScreen = nullptr;
@@ -36,14 +38,14 @@ void DisplayManager::createAPScreenContent(const char* ssid, const char* ip) {
     // 创建标题
     lv_obj_t* title = lv_label_create(apScreen);
     lv_label_set_text(title, "WiFi Setup");
-    lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 20);  // 顶部居中
+    lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 15);  // 顶部居中
     lv_obj_set_style_text_color(title, lv_color_white(), 0);
     lv_obj_set_style_text_font(title, &lv_font_montserrat_16, 0);
     
-    // 创建容器来组织内容
+    // 创建容器来组织内容 - 左侧文字，右侧二维码
     lv_obj_t* cont = lv_obj_create(apScreen);
-    lv_obj_set_size(cont, 280, 80);  // 保持宽度足够显示内容
-    lv_obj_align(cont, LV_ALIGN_TOP_MID, 0, 60);  // 居中对齐
+    lv_obj_set_size(cont, 180, 100);
+    lv_obj_align(cont, LV_ALIGN_TOP_LEFT, 10, 50);
     lv_obj_set_style_bg_color(cont, lv_color_black(), 0);
     lv_obj_set_style_border_width(cont, 0, 0);
     lv_obj_set_style_pad_all(cont, 0, 0);
@@ -52,17 +54,24 @@ void DisplayManager::createAPScreenContent(const char* ssid, const char* ip) {
     lv_obj_t* ssidLabel = lv_label_create(cont);
     lv_obj_set_style_text_font(ssidLabel, &lv_font_montserrat_16, 0);
     lv_obj_set_style_text_color(ssidLabel, lv_color_white(), 0);
-    String ssidText = String("Network: ") + ssid;
+    String ssidText = String("Network:\n") + ssid;
     lv_label_set_text(ssidLabel, ssidText.c_str());
-    lv_obj_align(ssidLabel, LV_ALIGN_TOP_MID, 0, 0);  // 容器内顶部居中
+    lv_obj_align(ssidLabel, LV_ALIGN_TOP_LEFT, 0, 0);
     
     // 创建IP信息
     lv_obj_t* ipLabel = lv_label_create(cont);
     lv_obj_set_style_text_font(ipLabel, &lv_font_montserrat_16, 0);
     lv_obj_set_style_text_color(ipLabel, lv_color_white(), 0);
-    String ipText = String("Setup URL: ") + ip;
+    String ipText = String("Setup URL:\n") + ip;
     lv_label_set_text(ipLabel, ipText.c_str());
-    lv_obj_align(ipLabel, LV_ALIGN_TOP_MID, 0, 40);  // 容器内居中，距顶部40px
+    lv_obj_align(ipLabel, LV_ALIGN_TOP_LEFT, 0, 50);
+    
+    // 扫码加入配置热点，连接后会自动弹出配置页面
+    lv_obj_t* qr = QRPanel::create(apScreen, 120, lv_color_black(), lv_color_white());
+    if (qr != nullptr) {
+        lv_obj_align(qr, LV_ALIGN_BOTTOM_RIGHT, -10, -10);
+        QRPanel::setText(qr, QRPanel::wifiString(ssid, nullptr).c_str());
+    }
 }
 
 void DisplayManager::deleteAPScreen() {
@@ -170,8 +179,11 @@ bool DisplayManager::isAPScreenActive() {
 }
 
 void DisplayManager::createWiFiErrorScreen() {
+    // 断线重连时可能反复调用，屏幕已存在时直接显示，二维码内容不变不会重新生成
     if (wifiErrorScreen != nullptr) {
-        deleteWiFiErrorScreen();
+        currentScreen = wifiErrorScreen;
+        lv_scr_load(wifiErrorScreen);
+        return;
     }
     
     // 创建WiFi错误屏幕
@@ -183,15 +195,21 @@ void DisplayManager::createWiFiErrorScreen() {
     lv_label_set_text(title, "WiFi Connection Failed");
     lv_obj_set_style_text_color(title, lv_color_make(0xFF, 0x00, 0x00), 0);  // 红色
     lv_obj_set_style_text_font(title, &lv_font_montserrat_16, 0);
-    lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 30);
+    lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 15);
     
-    // 创建提示信息
+    // 创建提示信息 - 左侧文字，右侧二维码
     lv_obj_t* message = lv_label_create(wifiErrorScreen);
-    lv_label_set_text(message, "Please check your WiFi settings\nRetrying connection...");
+    lv_label_set_text(message, "Check WiFi settings\nRetrying...\n\nScan to join\nsetup hotspot");
     lv_obj_set_style_text_color(message, lv_color_white(), 0);
     lv_obj_set_style_text_font(message, &lv_font_montserrat_16, 0);
-    lv_obj_set_style_text_align(message, LV_TEXT_ALIGN_CENTER, 0);
-    lv_obj_align(message, LV_ALIGN_CENTER, 0, 0);
+    lv_obj_align(message, LV_ALIGN_LEFT_MID, 10, 15);
+    
+    // 扫码加入配置热点修改WiFi设置
+    lv_obj_t* qr = QRPanel::create(wifiErrorScreen, 120, lv_color_black(), lv_color_white());
+    if (qr != nullptr) {
+        lv_obj_align(qr, LV_ALIGN_BOTTOM_RIGHT, -10, -10);
+        QRPanel::setText(qr, QRPanel::wifiString(ConfigManager::getAPSSID(), nullptr).c_str());
+    }
     
     // 切换到错误屏幕
     currentScreen = wifiErrorScreen;
@@ -7,6 +7,8 @@
 #include "LVGL_Driver.h"
 
 static lv_disp_draw_buf_t draw_buf;
+static uint32_t last_tick_ms = 0;
+static TaskHandle_t lvgl_task = NULL;      // 运行LVGL循环的任务，即Arduino的loopTask
 static lv_color_t buf1[ LVGL_BUF_LEN ];
 static lv_color_t buf2[ LVGL_BUF_LEN ];
 // static lv_color_t* buf1 = (lv_color_t*) heap_caps_malloc(LVGL_BUF_LEN, MALLOC_CAP_SPIRAM);
@@ -30,16 +32,6 @@ void Lvgl_Display_LCD( lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_
   LCD_addWindow(area->x1, area->y1, area->x2, area->y2, ( uint16_t *)&color_p->full);
   lv_disp_flush_ready( disp_drv );
 }
-/*Read the touchpad*/
-void Lvgl_Touchpad_Read( lv_indev_drv_t * indev_drv, lv_indev_data_t * data )
-{
-  // NULL
-}
-void example_increase_lvgl_tick(void *arg)
-{
-    /* Tell LVGL how many milliseconds has elapsed */
-    lv_tick_inc(EXAMPLE_LVGL_TICK_PERIOD_MS);
-}
 void Lvgl_Init(void)
 {
   lv_init();
@@ -61,24 +53,38 @@ void Lvgl_Init(void)
   
   lv_disp_drv_register( &disp_drv );
 
-  /*Initialize the (dummy) input device driver*/
-  static lv_indev_drv_t indev_drv;
-  lv_indev_drv_init( &indev_drv );
-  indev_drv.type = LV_INDEV_TYPE_POINTER;
-  indev_drv.read_cb = Lvgl_Touchpad_Read;
-  lv_indev_drv_register( &indev_drv );
+  // 屏幕没有触摸，不注册输入设备，否则它的读取定时器每30ms唤醒一次Lvgl_Wait
 
   /* Create simple label */
   lv_obj_t *label = lv_label_create( lv_scr_act() );
   lv_label_set_text( label, "Hello Ardino and LVGL!");
   lv_obj_align( label, LV_ALIGN_CENTER, 0, 0 );
 
-  const esp_timer_create_args_t lvgl_tick_timer_args = {
-    .callback = &example_increase_lvgl_tick,
-    .name = "lvgl_tick"
-  };
-  esp_timer_handle_t lvgl_tick_timer = NULL;
-  esp_timer_create(&lvgl_tick_timer_args, &lvgl_tick_timer);
-  esp_timer_start_periodic(lvgl_tick_timer, EXAMPLE_LVGL_TICK_PERIOD_MS * 1000);
+  last_tick_ms = millis();
+  lvgl_task = xTaskGetCurrentTaskHandle();
+}
+
+/*  LVGL时间在处理前按millis()的差值补上，不再需要周期性的tick定时器中断 */
+uint32_t Timer_Loop(void)
+{
+  uint32_t now = millis();
+  lv_tick_inc(now - last_tick_ms);
+  last_tick_ms = now;
+  // 屏幕没有变化时刷新和动画定时器会自己暂停，这里返回LV_NO_TIMER_READY
+  return lv_timer_handler();
+}
+
+void Lvgl_Notify(uint32_t events)
+{
+  if (lvgl_task != NULL) {
+    xTaskNotify(lvgl_task, events, eSetBits);
+  }
+}
 
+/*  休眠期间CPU进入空闲任务，WiFi和其他任务照常运行 */
+uint32_t Lvgl_Wait(uint32_t timeout_ms)
+{
+  uint32_t events = 0;
+  xTaskNotifyWait(0, ULONG_MAX, &events, pdMS_TO_TICKS(timeout_ms));
+  return events;
 }
@@ -10,13 +10,16 @@
 #define LVGL_HEIGHT   LCD_HEIGHT
 #define LVGL_BUF_LEN  (LVGL_WIDTH * LVGL_HEIGHT / 20)
 
-#define EXAMPLE_LVGL_TICK_PERIOD_MS  10
-
 
 void Lvgl_print(const char * buf);
 void Lvgl_Display_LCD( lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p ); // Displays LVGL content on the LCD.    This function implements associating LVGL data to the LCD screen
-void Lvgl_Touchpad_Read( lv_indev_drv_t * indev_drv, lv_indev_data_t * data );                // Read the touchpad
-void example_increase_lvgl_tick(void *arg);
+
+// 唤醒LVGL循环的事件，可以从任意任务发送
+#define LVGL_EVENT_DATA     (1UL << 0)    // 采集任务发布了新数据
+#define LVGL_EVENT_CONFIG   (1UL << 1)    // 配置门户修改了设置
+#define LVGL_EVENT_WIFI     (1UL << 2)    // WiFi状态变化
 
 void Lvgl_Init(void);
-void Timer_Loop(void);
+uint32_t Timer_Loop(void);                  // 处理LVGL定时器，返回距离下一个定时器的ms数
+void Lvgl_Notify(uint32_t events);          // 唤醒LVGL循环
+uint32_t Lvgl_Wait(uint32_t timeout_ms);    // LVGL循环休眠，直到超时或收到事件，返回收到的事件
@@ -0,0 +1,134 @@
+#include "Metrics_Parser.h"
+#include <stdlib.h>
+#include <string.h>
+
+enum MetricField : uint8_t {
+    FIELD_CURRENT,
+    FIELD_VOLTAGE,
+    FIELD_STATE,
+    FIELD_PROTOCOL,
+};
+
+struct MetricName {
+    const char* prefix;
+    uint8_t len;
+    MetricField field;
+};
+
+#define METRIC(name, field) { name "{", sizeof(name "{") - 1, field }
+
+static const MetricName METRICS[] = {
+    METRIC("ionbridge_port_current", FIELD_CURRENT),
+    METRIC("ionbridge_port_voltage", FIELD_VOLTAGE),
+    METRIC("ionbridge_port_state", FIELD_STATE),
+    METRIC("ionbridge_port_fc_protocol", FIELD_PROTOCOL),
+};
+
+void MetricsParser::begin(PortInfo* ports, uint8_t count) {
+    this->ports = ports;
+    this->count = count;
+    state = STATE_LINE;
+    lineLen = 0;
+    fields = 0;
+}
+
+void MetricsParser::feed(const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        char c = (char)data[i];
+        if (c == '\n') {
+            if (state == STATE_LINE) {
+                parseLine();
+            }
+            state = STATE_LINE;
+            lineLen = 0;
+        } else if (state == STATE_LINE) {
+            if (lineLen < LINE_MAX - 1) {
+                line[lineLen++] = c;
+            } else {
+                state = STATE_SKIP;
+            }
+        }
+    }
+}
+
+uint16_t MetricsParser::finish() {
+    if (state == STATE_LINE && lineLen > 0) {
+        parseLine();
+    }
+    state = STATE_LINE;
+    lineLen = 0;
+    return fields;
+}
+
+// 在标签集合中找id标签，p指向'{'后面，成功时返回'}'的位置
+// 标签可以有任意多个、任意顺序，值里的转义字符跳过
+static const char* findIdLabel(const char* p, long* id) {
+    bool found = false;
+    while (*p != '}') {
+        const char* key = p;
+        while (*p != '\0' && *p != '=') {
+            p++;
+        }
+        if (p[0] != '=' || p[1] != '"') {
+            return NULL;
+        }
+        size_t keyLen = p - key;
+        p += 2;
+        const char* value = p;
+        while (*p != '\0' && *p != '"') {
+            p += (p[0] == '\\' && p[1] != '\0') ? 2 : 1;
+        }
+        if (*p != '"') {
+            return NULL;
+        }
+        if (keyLen == 2 && memcmp(key, "id", 2) == 0) {
+            char* end;
+            *id = strtol(value, &end, 10);
+            if (end == value || end != p) {
+                return NULL;
+            }
+            found = true;
+        }
+        p++;
+        if (*p == ',') {
+            p++;
+        }
+    }
+    return found ? p : NULL;
+}
+
+// 解析一行：name{...,id="N",...} value，其他行（注释、别的指标）忽略
+void MetricsParser::parseLine() {
+    if (lineLen > 0 && line[lineLen - 1] == '\r') {
+        lineLen--;
+    }
+    line[lineLen] = '\0';
+
+    for (const MetricName& metric : METRICS) {
+        if (lineLen <= metric.len || memcmp(line, metric.prefix, metric.len) != 0) {
+            continue;
+        }
+
+        long id;
+        const char* labelEnd = findIdLabel(line + metric.len, &id);
+        if (labelEnd == NULL) {
+            return;
+        }
+        const char* valueStart = labelEnd + 1;
+        char* end;
+        long value = strtol(valueStart, &end, 10);
+        if (end == valueStart || id < 0 || id >= count) {
+            return;
+        }
+
+        PortInfo& port = ports[id];
+        switch (metric.field) {
+            case FIELD_CURRENT:  port.current = (uint16_t)value; break;
+            case FIELD_VOLTAGE:  port.voltage = (uint16_t)value; break;
+            case FIELD_STATE:    port.state = (uint8_t)value; break;
+            case FIELD_PROTOCOL: port.fc_protocol = (uint8_t)value; break;
+        }
+        fields++;
+        return;
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "Power_Monitor.h"
+
+// Prometheus指标流式解析
+// 数据按任意大小的块送入，逐字节拼成行，行缓冲区大小固定，整个解析过程
+// 不分配内存。超过缓冲区的行整行丢弃，缓冲区要能放下带几个额外标签的行。
+class MetricsParser {
+public:
+    static const size_t LINE_MAX = 128;
+
+    // 开始新的一次解析，结果写入ports
+    void begin(PortInfo* ports, uint8_t count);
+    // 送入一块数据，块的边界可以落在任意位置
+    void feed(const uint8_t* data, size_t len);
+    // 数据结束，处理没有换行结尾的最后一行，返回解析到的字段数
+    uint16_t finish();
+
+private:
+    enum State : uint8_t {
+        STATE_LINE,     // 正在拼接一行
+        STATE_SKIP,     // 行太长，丢弃到行尾
+    };
+
+    void parseLine();
+
+    PortInfo* ports;
+    uint8_t count;
+    State state;
+    uint8_t lineLen;
+    uint16_t fields;
+    char line[LINE_MAX];
+};
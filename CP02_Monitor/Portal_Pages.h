@@ -0,0 +1,211 @@
+#pragma once
+#include <Arduino.h>
+
+// 配置门户的页面模板
+// 页面放在flash中，发送时按块读出，{{NAME}}占位符在发送时替换成当前的值，
+// 请求处理过程中不在RAM里拼出整个页面。只由Config_Manager.cpp包含。
+
+// 占位符和它的值，值按HTML转义后输出
+struct PageVar {
+    const char* name;
+    const char* value;
+};
+
+// 配置主页，占位符：MONITOR_IP
+static const char PAGE_ROOT[] PROGMEM = R"rawliteral(
+    <!DOCTYPE html>
+    <html>
+    <head>
+        <meta charset='utf-8'>
+        <title>ESP32 配置</title>
+        <meta name='viewport' content='width=device-width, initial-scale=1'>
+        <style>
+            body { font-family: Arial; margin: 20px; background: #f0f0f0; }
+            .container { max-width: 400px; margin: 0 auto; background: white; padding: 20px; border-radius: 10px; box-shadow: 0 2px 5px rgba(0,0,0,0.1); }
+            .status { margin-bottom: 20px; padding: 10px; border-radius: 5px; }
+            .connected { background: #e8f5e9; color: #2e7d32; }
+            .disconnected { background: #ffebee; color: #c62828; }
+            input { width: 100%; padding: 8px; margin: 10px 0; border: 1px solid #ddd; border-radius: 4px; box-sizing: border-box; }
+            button { width: 100%; padding: 10px; background: #4CAF50; color: white; border: none; border-radius: 4px; cursor: pointer; margin-bottom: 10px; }
+            button:hover { background: #45a049; }
+            .danger-button { background: #f44336; }
+            .danger-button:hover { background: #d32f2f; }
+            .status-box { margin-top: 20px; }
+            .switch { position: relative; display: inline-block; width: 60px; height: 34px; }
+            .switch input { opacity: 0; width: 0; height: 0; }
+            .slider { position: absolute; cursor: pointer; top: 0; left: 0; right: 0; bottom: 0; background-color: #ccc; transition: .4s; border-radius: 34px; }
+            .slider:before { position: absolute; content: ""; height: 26px; width: 26px; left: 4px; bottom: 4px; background-color: white; transition: .4s; border-radius: 50%; }
+            input:checked + .slider { background-color: #4CAF50; }
+            input:checked + .slider:before { transform: translateX(26px); }
+            .control-group { margin: 20px 0; padding: 15px; border: 1px solid #ddd; border-radius: 5px; }
+            .modal { display: none; position: fixed; z-index: 1; left: 0; top: 0; width: 100%; height: 100%; background-color: rgba(0,0,0,0.5); }
+            .modal-content { background-color: #fefefe; margin: 15% auto; padding: 20px; border-radius: 5px; max-width: 300px; text-align: center; }
+            .modal-buttons { display: flex; justify-content: space-between; margin-top: 20px; }
+            .modal-buttons button { width: 45%; margin: 0; }
+            .cancel-button { background: #9e9e9e; }
+            .cancel-button:hover { background: #757575; }
+        </style>
+    </head>
+    <body>
+        <div class='container'>
+            <h2>ESP32 配置</h2>
+            <div id='status' class='status'></div>
+            
+            <div class='control-group'>
+                <h3>WiFi设置</h3>
+                <form method='post' action='/save'>
+                    WiFi名称:<br>
+                    <input type='text' name='ssid'><br>
+                    WiFi密码:<br>
+                    <input type='password' name='password'><br>
+                    小电拼服务器IP地址:<br>
+                    <input type='text' name='monitor_url' value='{{MONITOR_IP}}' placeholder='例如: 192.168.32.2'><br>
+                    <button type='submit'>保存配置</button>
+                </form>
+            </div>
+            
+            <div class='control-group'>
+                <h3>RGB灯控制</h3>
+                <label class='switch'>
+                    <input type='checkbox' id='rgb-switch' onchange='toggleRGB()'>
+                    <span class='slider'></span>
+                </label>
+                <span style='margin-left: 10px;'>RGB灯状态</span>
+            </div>
+
+            <div class='control-group'>
+                <h3>系统设置</h3>
+                <button class='danger-button' onclick='showResetConfirm()'>重置所有配置</button>
+            </div>
+        </div>
+
+        <div id='resetModal' class='modal'>
+            <div class='modal-content'>
+                <h3>确认重置</h3>
+                <p>这将清除所有配置并重启设备。确定要继续吗？</p>
+                <div class='modal-buttons'>
+                    <button class='cancel-button' onclick='hideResetConfirm()'>取消</button>
+                    <button class='danger-button' onclick='doReset()'>确认重置</button>
+                </div>
+            </div>
+        </div>
+        <script>
+            let lastUpdate = 0;
+            let updateInterval = 2000;
+            let statusUpdateTimeout = null;
+
+            function updateStatus() {
+                const now = Date.now();
+                if (now - lastUpdate < updateInterval) {
+                    return;
+                }
+                lastUpdate = now;
+
+                fetch('/status')
+                    .then(response => response.json())
+                    .then(data => {
+                        const statusBox = document.getElementById('status');
+                        if (data.connected) {
+                            statusBox.innerHTML = `已连接到WiFi: ${data.ssid}<br>IP地址: ${data.ip}`;
+                            statusBox.className = 'status connected';
+                        } else {
+                            statusBox.innerHTML = '未连接到WiFi';
+                            statusBox.className = 'status disconnected';
+                        }
+                        const rgbSwitch = document.getElementById('rgb-switch');
+                        if (rgbSwitch.checked !== data.rgb_enabled) {
+                            rgbSwitch.checked = data.rgb_enabled;
+                        }
+                    })
+                    .catch(() => {
+                        if (statusUpdateTimeout) {
+                            clearTimeout(statusUpdateTimeout);
+                        }
+                        statusUpdateTimeout = setTimeout(updateStatus, updateInterval);
+                    });
+            }
+            
+            function toggleRGB() {
+                const enabled = document.getElementById('rgb-switch').checked;
+                fetch('/rgb', {
+                    method: 'POST',
+                    headers: {'Content-Type': 'application/x-www-form-urlencoded'},
+                    body: 'enabled=' + enabled
+                }).then(() => {
+                    lastUpdate = 0;
+                    updateStatus();
+                });
+            }
+
+            function showResetConfirm() {
+                document.getElementById('resetModal').style.display = 'block';
+            }
+
+            function hideResetConfirm() {
+                document.getElementById('resetModal').style.display = 'none';
+            }
+
+            function doReset() {
+                hideResetConfirm();
+                fetch('/reset', {
+                    method: 'POST'
+                }).then(() => {
+                    alert('配置已重置，设备将重启...');
+                    setTimeout(() => {
+                        window.location.reload();
+                    }, 5000);
+                });
+            }
+            
+            // 点击模态框外部时关闭
+            window.onclick = function(event) {
+                const modal = document.getElementById('resetModal');
+                if (event.target == modal) {
+                    hideResetConfirm();
+                }
+            }
+            
+            window.onload = updateStatus;
+            setInterval(updateStatus, updateInterval);
+        </script>
+    </body>
+    </html>)rawliteral";
+
+// 保存或重置后的提示页面，5秒后回到主页，占位符：TITLE、BACKGROUND、HEADING、MESSAGE
+static const char PAGE_NOTICE[] PROGMEM = R"rawliteral(
+    <!DOCTYPE html>
+    <html>
+    <head>
+        <meta charset='utf-8'>
+        <title>{{TITLE}}</title>
+        <meta name='viewport' content='width=device-width, initial-scale=1'>
+        <style>
+            body { font-family: Arial; margin: 20px; text-align: center; }
+            .message { margin: 20px; padding: 20px; background: {{BACKGROUND}}; border-radius: 5px; }
+            .countdown { font-size: 24px; margin: 20px; }
+        </style>
+        <script>
+            let count = 5;
+            function updateCountdown() {
+                document.getElementById('countdown').textContent = count;
+                if (count > 0) {
+                    count--;
+                    setTimeout(updateCountdown, 1000);
+                }
+            }
+            window.onload = function() {
+                updateCountdown();
+                setTimeout(function() {
+                    window.location.href = '/';
+                }, 5000);
+            }
+        </script>
+    </head>
+    <body>
+        <div class='message'>
+            <h2>{{HEADING}}</h2>
+            <p>{{MESSAGE}}</p>
+            <p><span id='countdown'>5</span> 秒后返回配置页...</p>
+        </div>
+    </body>
+    </html>)rawliteral";
@@ -13,6 +13,9 @@
 #include <freertos/task.h>
 #include <freertos/queue.h>
 #include "Config_Manager.h"
+#include "Metrics_Parser.h"
+#include "LVGL_Driver.h"
+#include "Charge_Card.h"
 
 // 声明外部常量引用
 extern const int MAX_POWER_WATTS;
@@ -42,9 +45,108 @@ static lv_timer_t *wifi_timer = NULL;
 // 数据获取任务句柄
 TaskHandle_t monitorTaskHandle = NULL;
 
-// 数据队列
+// 数据队列 - 长度为1，采集任务用xQueueOverwrite覆盖成最新的一帧
 QueueHandle_t dataQueue = NULL;
 
+// 每个端口的充电会话，只在采集任务中更新；结束的会话摘要由historyLock保护
+// CP02_Monitor_4.3的采集同样有端口状态和快充协议，但目前只有这个草图接入了会话跟踪
+static ChargeSession chargeSessions[MAX_PORTS];
+static ChargeHistory chargeHistory;
+static portMUX_TYPE historyLock = portMUX_INITIALIZER_UNLOCKED;
+static volatile uint32_t sessionVersion = 0;
+
+// 界面检查新数据的间隔 (ms)，平时由采集任务的通知立即触发，这里只是兜底
+#define UI_POLL_INTERVAL    1000
+
+// 读取响应的块大小和无数据超时
+#define FETCH_CHUNK_SIZE    128
+#define FETCH_TIMEOUT_MS    2000
+
+// 从响应流中边读边解析，不把整个页面读进String，返回解析到的字段数
+static uint16_t PowerMonitor_ReadMetrics(HTTPClient& http, MetricsParser& parser, PortInfo* ports) {
+    uint8_t chunk[FETCH_CHUNK_SIZE];
+    WiFiClient* stream = http.getStreamPtr();
+    int remaining = http.getSize();     // 没有Content-Length时为-1，读到连接关闭
+    uint32_t lastData = millis();
+    
+    parser.begin(ports, MAX_PORTS);
+    while (remaining != 0 && (http.connected() || stream->available() > 0)) {
+        int avail = stream->available();
+        if (avail <= 0) {
+            if (millis() - lastData > FETCH_TIMEOUT_MS) {
+                printf("[Monitor] Read timeout\n");
+                break;
+            }
+            vTaskDelay(pdMS_TO_TICKS(1));
+            continue;
+        }
+        
+        size_t want = avail < FETCH_CHUNK_SIZE ? avail : FETCH_CHUNK_SIZE;
+        if (remaining > 0 && want > (size_t)remaining) {
+            want = remaining;
+        }
+        int n = stream->readBytes(chunk, want);
+        if (n <= 0) {
+            continue;
+        }
+        parser.feed(chunk, n);
+        if (remaining > 0) {
+            remaining -= n;
+        }
+        lastData = millis();
+    }
+    return parser.finish();
+}
+
+// 刷新定时器回调 - 在LVGL循环中取最新一帧，序号没变时什么都不做
+static void PowerMonitor_RefreshTimerCb(lv_timer_t* timer) {
+    static uint32_t lastSeq = 0;
+    PowerData frame;
+    
+    if (xQueuePeek(dataQueue, &frame, 0) != pdTRUE || frame.seq == lastSeq) {
+        return;
+    }
+    lastSeq = frame.seq;
+    
+    // 整帧复制，界面不会读到采集一半的数据
+    memcpy(portInfos, frame.ports, sizeof(portInfos));
+    totalPower = frame.totalPower;
+    PowerMonitor_UpdateUI();
+    
+    // 有充电会话结束，弹出会话摘要
+    static uint32_t lastSessionVersion = 0;
+    if (sessionVersion != lastSessionVersion) {
+        lastSessionVersion = sessionVersion;
+        ChargeCard::show();
+    }
+}
+
+// 在采集任务中把这一帧送给每个端口的会话跟踪，结束的会话放进历史记录
+static void PowerMonitor_TrackSessions(const PowerData& frame) {
+    uint32_t now = millis();
+    ChargeSummary summary;
+    
+    for (int i = 0; i < MAX_PORTS; i++) {
+        const PortInfo& port = frame.ports[i];
+        if (!chargeSessions[i].update(ChargeSession::DEFAULT_CONFIG, port.state, port.fc_protocol,
+                                      port.voltage, port.current, now, &summary)) {
+            continue;
+        }
+        
+        portENTER_CRITICAL(&historyLock);
+        chargeHistory.add(summary);
+        sessionVersion++;
+        portEXIT_CRITICAL(&historyLock);
+        
+        printf("[Session] %s: %us, %u.%03uWh, peak %u.%uW, avg %u.%uW, taper %d s, %s\n",
+               port.name, (unsigned)summary.durationS,
+               (unsigned)(summary.energyMwh / 1000), (unsigned)(summary.energyMwh % 1000),
+               summary.peakDw / 10, summary.peakDw % 10, summary.avgDw / 10, summary.avgDw % 10,
+               summary.taperS == CHARGE_NO_TAPER ? -1 : (int)summary.taperS,
+               summary.end == END_UNPLUG ? "unplugged" : "idle");
+    }
+}
+
 // 初始化电源监控
 void PowerMonitor_Init() {
     // 初始化端口信息
@@ -64,12 +166,19 @@ void PowerMonitor_Init() {
     portInfos[3].name = "C3";
     portInfos[4].name = "C4";
     
-    // 创建数据队列
-    dataQueue = xQueueCreate(1, sizeof(PowerData));
+    // 创建数据队列，WiFi重连后再次初始化时复用
+    if (dataQueue == NULL) {
+        dataQueue = xQueueCreate(1, sizeof(PowerData));
+    }
     
     // 创建UI
     PowerMonitor_CreateUI();
     
+    // 界面从队列中取数据的定时器
+    if (refresh_timer == NULL) {
+        refresh_timer = lv_timer_create(PowerMonitor_RefreshTimerCb, UI_POLL_INTERVAL, NULL);
+    }
+    
     // 启动监控任务
     PowerMonitor_Start();
 }
@@ -169,10 +278,21 @@ void PowerMonitor_CreateUI() {
 // 监控任务
 void PowerMonitor_Task(void* parameter) {
     HTTPClient http;
-    String payload;
+    MetricsParser parser;
+    PowerData frame;
     bool lastWiFiState = false;
     uint32_t wifiRetryTime = 0;
     const uint32_t WIFI_RETRY_INTERVAL = 5000; // 5秒重试一次WiFi连接
+    char url[128];
+    uint32_t urlVersion = ConfigManager::copyMonitorUrl(url, sizeof(url));
+    
+    // 采集任务只写自己的这一帧，端口名称等固定信息从初始值复制
+    frame.seq = 0;
+    memcpy(frame.ports, portInfos, sizeof(frame.ports));
+    frame.totalPower = 0.0f;
+    for (int i = 0; i < MAX_PORTS; i++) {
+        chargeSessions[i].begin(i);
+    }
     
     while (true) {
         bool currentWiFiState = WiFi.status() == WL_CONNECTED;
@@ -207,106 +327,44 @@ void PowerMonitor_Task(void* parameter) {
             continue;
         }
         
+        // 门户修改了服务器地址，从这一次采集开始换用新地址
+        if (ConfigManager::getConfigVersion() != urlVersion) {
+            urlVersion = ConfigManager::copyMonitorUrl(url, sizeof(url));
+            printf("[Monitor] Monitor URL changed to: %s\n", url);
+        }
+        
         // WiFi已连接，获取数据
-        String url = ConfigManager::getMonitorUrl();
-        printf("[Monitor] Fetching data from: %s\n", url.c_str());
+        printf("[Monitor] Fetching data from: %s\n", url);
         
+        // 使用HTTP/1.0，服务器不会用分块编码，响应流就是页面本身
+        http.useHTTP10(true);
         http.begin(url);
         int httpCode = http.GET();
         
         // 检查HTTP响应代码
         if (httpCode > 0 && httpCode == HTTP_CODE_OK) {
-            payload = http.getString();
+            // 逐块读取并解析数据
+            uint16_t fields = PowerMonitor_ReadMetrics(http, parser, frame.ports);
             
             // 重置总功率
-            totalPower = 0.0f;
-            
-            // 逐行解析数据
-            int position = 0;
-            while (position < payload.length()) {
-                int lineEnd = payload.indexOf('\n', position);
-                if (lineEnd == -1) lineEnd = payload.length();
-                
-                String line = payload.substring(position, lineEnd);
-                position = lineEnd + 1;
-                
-                // 解析电流数据
-                if (line.startsWith("ionbridge_port_current{id=")) {
-                    // 提取端口ID
-                    int idStart = line.indexOf("\"") + 1;
-                    int idEnd = line.indexOf("\"", idStart);
-                    int portId = line.substring(idStart, idEnd).toInt();
-                    
-                    // 提取电流值
-                    int valueStart = line.indexOf("}") + 1;
-                    int current = line.substring(valueStart).toInt();
-                    
-                    // 更新端口电流
-                    if (portId >= 0 && portId < MAX_PORTS) {
-                        portInfos[portId].current = current;
-                    }
-                }
-                // 解析电压数据
-                else if (line.startsWith("ionbridge_port_voltage{id=")) {
-                    // 提取端口ID
-                    int idStart = line.indexOf("\"") + 1;
-                    int idEnd = line.indexOf("\"", idStart);
-                    int portId = line.substring(idStart, idEnd).toInt();
-                    
-                    // 提取电压值
-                    int valueStart = line.indexOf("}") + 1;
-                    int voltage = line.substring(valueStart).toInt();
-                    
-                    // 更新端口电压
-                    if (portId >= 0 && portId < MAX_PORTS) {
-                        portInfos[portId].voltage = voltage;
-                    }
-                }
-                // 解析状态数据
-                else if (line.startsWith("ionbridge_port_state{id=")) {
-                    // 提取端口ID
-                    int idStart = line.indexOf("\"") + 1;
-                    int idEnd = line.indexOf("\"", idStart);
-                    int portId = line.substring(idStart, idEnd).toInt();
-                    
-                    // 提取状态值
-                    int valueStart = line.indexOf("}") + 1;
-                    int state = line.substring(valueStart).toInt();
-                    
-                    // 更新端口状态
-                    if (portId >= 0 && portId < MAX_PORTS) {
-                        portInfos[portId].state = state;
-                    }
-                }
-                // 解析协议数据
-                else if (line.startsWith("ionbridge_port_fc_protocol{id=")) {
-                    // 提取端口ID
-                    int idStart = line.indexOf("\"") + 1;
-                    int idEnd = line.indexOf("\"", idStart);
-                    int portId = line.substring(idStart, idEnd).toInt();
-                    
-                    // 提取协议值
-                    int valueStart = line.indexOf("}") + 1;
-                    int protocol = line.substring(valueStart).toInt();
-                    
-                    // 更新端口协议
-                    if (portId >= 0 && portId < MAX_PORTS) {
-                        portInfos[portId].fc_protocol = protocol;
-                    }
-                }
-            }
+            frame.totalPower = 0.0f;
             
             // 计算每个端口的功率
             for (int i = 0; i < MAX_PORTS; i++) {
                 // 功率 = 电流(mA) * 电压(mV) / 1000000 (转换为W)
-                portInfos[i].power = (portInfos[i].current * portInfos[i].voltage) / 1000000.0f;
-                totalPower += portInfos[i].power;
+                frame.ports[i].power = (frame.ports[i].current * frame.ports[i].voltage) / 1000000.0f;
+                frame.totalPower += frame.ports[i].power;
             }
             
-            // 更新UI
-            PowerMonitor_UpdateUI();
-            dataError = false;
-            printf("[Monitor] Data updated successfully\n");
+            // 先记下结束的会话，界面取到这一帧时就能看到
+            PowerMonitor_TrackSessions(frame);
+            
+            // 发布完整的一帧，由LVGL循环中的刷新定时器更新UI
+            frame.seq++;
+            xQueueOverwrite(dataQueue, &frame);
+            Lvgl_Notify(LVGL_EVENT_DATA);
+            dataError = fields == 0;
+            printf("[Monitor] Data updated successfully (%u fields)\n", fields);
         } else {
             dataError = true;
             printf("[Monitor] Failed to fetch data, HTTP code: %d\n", httpCode);
@@ -328,7 +386,7 @@ void PowerMonitor_Start() {
         xTaskCreate(
             PowerMonitor_Task,    // 任务函数
             "MonitorTask",        // 任务名称
-            8192,                 // 堆栈大小
+            MONITOR_TASK_STACK,   // 堆栈大小
             NULL,                 // 任务参数
             1,                    // 任务优先级
             &monitorTaskHandle    // 任务句柄
@@ -336,6 +394,13 @@ void PowerMonitor_Start() {
     }
 }
 
+// 有新数据，让刷新定时器在下一次lv_timer_handler()中执行
+void PowerMonitor_DataReady() {
+    if (refresh_timer != NULL) {
+        lv_timer_ready(refresh_timer);
+    }
+}
+
 // 停止监控任务
 void PowerMonitor_Stop() {
     if (monitorTaskHandle != NULL) {
@@ -435,4 +500,18 @@ void PowerMonitor_UpdateWiFiStatus() {
         lv_label_set_text(ui_wifi_status, "WiFi");
         lv_obj_set_style_text_color(ui_wifi_status, lv_color_hex(0xFF0000), LV_PART_MAIN | LV_STATE_DEFAULT);
     }
-} 
\ No newline at end of file
+} 
+
+uint8_t PowerMonitor_CopySessions(ChargeSummary* out, uint8_t max) {
+    portENTER_CRITICAL(&historyLock);
+    uint8_t count = chargeHistory.count() < max ? chargeHistory.count() : max;
+    for (uint8_t i = 0; i < count; i++) {
+        out[i] = chargeHistory.get(i);
+    }
+    portEXIT_CRITICAL(&historyLock);
+    return count;
+}
+
+uint32_t PowerMonitor_GetSessionVersion() {
+    return sessionVersion;
+}
@@ -12,10 +12,14 @@
 #include <Arduino.h>
 #include <HTTPClient.h>
 #include <lvgl.h>
+#include "Charge_Session.h"
 
 // 定义端口最大数量
 #define MAX_PORTS 5
 
+// 采集任务的栈大小（字节），HTTP客户端和解析都在这个栈上
+#define MONITOR_TASK_STACK 8192
+
 // 从主程序引用常量定义
 extern const int MAX_POWER_WATTS;    // 最大总功率 160W
 extern const int MAX_PORT_WATTS;     // 每个端口最大功率 140W
@@ -33,13 +37,14 @@ typedef struct {
     const char* name;          // 端口名称
 } PortInfo;
 
-// 数据结构体
+// 采集任务发给界面的一帧完整数据
 struct PowerData {
-    String payload;
-    bool isValid;
+    uint32_t seq;              // 帧序号，每次采集成功加一
+    PortInfo ports[MAX_PORTS];
+    float totalPower;
 };
 
-// 所有端口信息
+// 所有端口信息，只在LVGL循环中由刷新定时器更新
 extern PortInfo portInfos[MAX_PORTS];
 extern float totalPower;
 
@@ -61,10 +66,19 @@ void PowerMonitor_Start();
 // 停止监控任务
 void PowerMonitor_Stop();
 
+// 采集任务发布了新数据，在LVGL循环中调用
+void PowerMonitor_DataReady();
+
 // 更新UI
 void PowerMonitor_UpdateUI();
 
 // 更新WiFi状态
 void PowerMonitor_UpdateWiFiStatus();
 
+// 复制最近结束的充电会话摘要，最新的在前，返回复制的个数，可以在任何任务中调用
+uint8_t PowerMonitor_CopySessions(ChargeSummary* out, uint8_t max);
+
+// 会话摘要的版本号，每结束一个会话加一
+uint32_t PowerMonitor_GetSessionVersion();
+
 #endif /* POWER_MONITOR_H */ 
\ No newline at end of file
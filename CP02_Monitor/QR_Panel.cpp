@@ -0,0 +1,167 @@
+#include "QR_Panel.h"
+#include "extra/libs/qrcode/qrcodegen.h"
+
+#define QR_MAX_VERSION  10      // 57x57模块，足够放下配网地址和WiFi字符串
+#define QR_QUIET_ZONE   2       // 静区宽度（模块数）
+
+bool QRPanel::module(const Data* qr, int32_t x, int32_t y) {
+    uint32_t stride = (qr->modules + 7) / 8;
+    return (qr->bits[y * stride + (x >> 3)] >> (7 - (x & 7))) & 1;
+}
+
+// 绘制时放大：每行深色模块合并成一段，只绘制与刷新区域相交的行
+void QRPanel::drawCallback(lv_event_t* e) {
+    lv_obj_t* obj = lv_event_get_target(e);
+    Data* qr = (Data*)lv_obj_get_user_data(obj);
+    if (qr == nullptr || qr->bits == nullptr) {
+        return;
+    }
+
+    lv_draw_ctx_t* drawCtx = lv_event_get_draw_ctx(e);
+    const lv_area_t* clip = drawCtx->clip_area;
+
+    lv_area_t content;
+    lv_obj_get_content_coords(obj, &content);
+    int32_t n = qr->modules;
+    int32_t scale = LV_MIN(lv_area_get_width(&content), lv_area_get_height(&content)) / n;
+    if (scale < 1) {
+        return;
+    }
+    lv_coord_t x0 = content.x1 + (lv_area_get_width(&content) - n * scale) / 2;
+    lv_coord_t y0 = content.y1 + (lv_area_get_height(&content) - n * scale) / 2;
+
+    if (clip->y2 < y0 || clip->y1 >= y0 + n * scale) {
+        return;
+    }
+    int32_t rowFirst = clip->y1 > y0 ? (clip->y1 - y0) / scale : 0;
+    int32_t rowLast = LV_MIN(n - 1, (clip->y2 - y0) / scale);
+
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = qr->dark;
+    dsc.bg_opa = LV_OPA_COVER;
+
+    for (int32_t y = rowFirst; y <= rowLast; y++) {
+        int32_t x = 0;
+        while (x < n) {
+            if (!module(qr, x, y)) {
+                x++;
+                continue;
+            }
+            int32_t run = x;
+            while (x < n && module(qr, x, y)) {
+                x++;
+            }
+            lv_area_t area;
+            area.x1 = x0 + run * scale;
+            area.y1 = y0 + y * scale;
+            area.x2 = x0 + x * scale - 1;
+            area.y2 = y0 + (y + 1) * scale - 1;
+            lv_draw_rect(drawCtx, &dsc, &area);
+        }
+    }
+}
+
+void QRPanel::deleteCallback(lv_event_t* e) {
+    Data* qr = (Data*)lv_obj_get_user_data(lv_event_get_target(e));
+    if (qr != nullptr) {
+        free(qr->bits);
+        free(qr->text);
+        free(qr);
+    }
+}
+
+lv_obj_t* QRPanel::create(lv_obj_t* parent, lv_coord_t size, lv_color_t dark, lv_color_t light) {
+    Data* qr = (Data*)calloc(1, sizeof(Data));
+    if (qr == nullptr) {
+        printf("[QR] Out of memory\n");
+        return nullptr;
+    }
+    qr->dark = dark;
+
+    lv_obj_t* obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_clear_flag(obj, (lv_obj_flag_t)(LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_CLICKABLE));
+    lv_obj_set_size(obj, size, size);
+    lv_obj_set_style_bg_color(obj, light, 0);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_user_data(obj, qr);
+    lv_obj_add_event_cb(obj, drawCallback, LV_EVENT_DRAW_MAIN, nullptr);
+    lv_obj_add_event_cb(obj, deleteCallback, LV_EVENT_DELETE, nullptr);
+    return obj;
+}
+
+bool QRPanel::setText(lv_obj_t* panel, const char* text) {
+    Data* qr = (Data*)lv_obj_get_user_data(panel);
+    if (qr == nullptr || text == nullptr) {
+        return false;
+    }
+    if (qr->text != nullptr && strcmp(qr->text, text) == 0) {
+        return true;
+    }
+
+    // 编码缓冲区只在生成时临时使用
+    size_t bufLen = qrcodegen_BUFFER_LEN_FOR_VERSION(QR_MAX_VERSION);
+    uint8_t* qrBuf = (uint8_t*)malloc(bufLen);
+    uint8_t* tmpBuf = (uint8_t*)malloc(bufLen);
+    bool ok = qrBuf != nullptr && tmpBuf != nullptr &&
+              qrcodegen_encodeText(text, tmpBuf, qrBuf, qrcodegen_Ecc_LOW, qrcodegen_VERSION_MIN,
+                                   QR_MAX_VERSION, qrcodegen_Mask_AUTO, true);
+    if (!ok) {
+        printf("[QR] Failed to encode \"%s\"\n", text);
+        free(qrBuf);
+        free(tmpBuf);
+        return false;
+    }
+
+    int32_t size = qrcodegen_getSize(qrBuf);
+    int32_t n = size + 2 * QR_QUIET_ZONE;
+    uint32_t stride = (n + 7) / 8;
+    uint8_t* bits = (uint8_t*)calloc(stride * n, 1);
+    char* textCopy = strdup(text);
+    if (bits != nullptr && textCopy != nullptr) {
+        for (int32_t y = 0; y < size; y++) {
+            uint8_t* row = bits + (y + QR_QUIET_ZONE) * stride;
+            for (int32_t x = 0; x < size; x++) {
+                if (qrcodegen_getModule(qrBuf, x, y)) {
+                    int32_t px = x + QR_QUIET_ZONE;
+                    row[px >> 3] |= 0x80 >> (px & 7);
+                }
+            }
+        }
+        free(qr->bits);
+        free(qr->text);
+        qr->bits = bits;
+        qr->modules = n;
+        qr->text = textCopy;
+        lv_obj_invalidate(panel);
+        printf("[QR] %dx%d modules, %u bytes\n", (int)size, (int)size, (unsigned)(stride * n));
+    } else {
+        free(bits);
+        free(textCopy);
+        ok = false;
+    }
+
+    free(qrBuf);
+    free(tmpBuf);
+    return ok;
+}
+
+// WiFi字符串中的 \ ; , : " 需要转义
+String QRPanel::escape(const char* s) {
+    String out;
+    for (; *s != '\0'; s++) {
+        if (strchr("\\;,:\"", *s) != nullptr) {
+            out += '\\';
+        }
+        out += *s;
+    }
+    return out;
+}
+
+String QRPanel::wifiString(const char* ssid, const char* password) {
+    if (password == nullptr || password[0] == '\0') {
+        return String("WIFI:T:nopass;S:") + escape(ssid) + ";;";
+    }
+    return String("WIFI:T:WPA;S:") + escape(ssid) + ";P:" + escape(password) + ";;";
+}
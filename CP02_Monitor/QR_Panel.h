@@ -0,0 +1,26 @@
+#pragma once
+#include <Arduino.h>
+#include "lvgl.h"
+
+// 二维码面板
+// 二维码以每个模块一位的位图保存，绘制时放大到面板大小，只填充与刷新区域
+// 相交的深色模块，不需要整块的画布缓冲区。内容不变时不会重新编码。
+class QRPanel {
+public:
+    static lv_obj_t* create(lv_obj_t* parent, lv_coord_t size, lv_color_t dark, lv_color_t light);
+    static bool setText(lv_obj_t* panel, const char* text);
+    // 手机扫码加入WiFi的字符串，password为空时为开放网络
+    static String wifiString(const char* ssid, const char* password);
+
+private:
+    struct Data {
+        uint8_t* bits;      // 带静区的位图，1为深色
+        uint16_t modules;   // 每边模块数（含静区）
+        char* text;
+        lv_color_t dark;
+    };
+    static bool module(const Data* qr, int32_t x, int32_t y);
+    static void drawCallback(lv_event_t* e);
+    static void deleteCallback(lv_event_t* e);
+    static String escape(const char* s);
+};
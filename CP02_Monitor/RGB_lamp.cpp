@@ -1,8 +1,9 @@
 #include "RGB_lamp.h"
+#include <esp_timer.h>
 
-uint16_t Time = 0;
 uint16_t Number = 0;
-bool isRGBRunning = false;  // 添加运行状态标志
+volatile bool isRGBRunning = false;  // 添加运行状态标志
+static esp_timer_handle_t rgbTimer = NULL;
 uint8_t RGB_Data[192][3] = {
   {64, 1, 0},  {63, 2, 0},  {62, 3, 0},  {61, 4, 0},  {60, 5, 0},  {59, 6, 0},  {58, 7, 0},  {57, 8, 0},
   {56, 9, 0},  {55, 10, 0}, {54, 11, 0}, {53, 12, 0}, {52, 13, 0}, {51, 14, 0}, {50, 15, 0}, {49, 16, 0},
@@ -35,27 +36,42 @@ uint8_t RGB_Data[192][3] = {
 void Set_Color(uint8_t Red, uint8_t Green, uint8_t Blue) {
     neopixelWrite(PIN_NEOPIXEL, Red, Green, Blue);
 }
-void RGB_Lamp_Loop(uint16_t Waiting)
-{ 
+// 定时器回调，在esp_timer任务中执行。RMT驱动不能在中断中调用，所以不用硬件定时器中断
+static void RGB_Lamp_Step(void* arg)
+{
     if (!isRGBRunning) {
-        isRGBRunning = true;
-        // 首次启动时立即显示颜色
-        Set_Color(RGB_Data[Number][0]*3, RGB_Data[Number][1]*3, RGB_Data[Number][2]*3);
+        return;
     }
-    
-    Time++;
-    if (Time >= Waiting) {
-        Time = 0;
-        Number++;
-        if (Number >= 192) {
-            Number = 0;
+    Number++;
+    if (Number >= 192) {
+        Number = 0;
+    }
+    Set_Color(RGB_Data[Number][0]*3, RGB_Data[Number][1]*3, RGB_Data[Number][2]*3);
+}
+void RGB_Lamp_Start()
+{
+    if (rgbTimer == NULL) {
+        esp_timer_create_args_t args = {};
+        args.callback = RGB_Lamp_Step;
+        args.name = "rgb_lamp";
+        if (esp_timer_create(&args, &rgbTimer) != ESP_OK) {
+            printf("[RGB] Failed to create timer\n");
+            return;
         }
-        Set_Color(RGB_Data[Number][0]*3, RGB_Data[Number][1]*3, RGB_Data[Number][2]*3);
     }
+    if (isRGBRunning) {
+        return;
+    }
+    isRGBRunning = true;
+    // 首次启动时立即显示颜色
+    Set_Color(RGB_Data[Number][0]*3, RGB_Data[Number][1]*3, RGB_Data[Number][2]*3);
+    esp_timer_start_periodic(rgbTimer, RGB_STEP_MS * 1000);
 }
 void RGB_Lamp_Off() {
     isRGBRunning = false;
-    Time = 0;
+    if (rgbTimer != NULL) {
+        esp_timer_stop(rgbTimer);
+    }
     Number = 0;
     Set_Color(0, 0, 0);  // 设置RGB颜色为黑色（关闭）
 }
\ No newline at end of file
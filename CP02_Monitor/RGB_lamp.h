@@ -4,5 +4,7 @@
 #define PIN_NEOPIXEL 38
 
 void Set_Color(uint8_t Red,uint8_t Green,uint8_t Blue);                 // Set RGB bead color
-void RGB_Lamp_Loop(uint16_t Waiting);                                   // The lamp beads change color in cycles
+#define RGB_STEP_MS   20                                                // 颜色切换间隔 (ms)
+
+void RGB_Lamp_Start();                                                  // 由定时器循环切换颜色，不占用主循环
 void RGB_Lamp_Off();                                                    // Turn off RGB lamp
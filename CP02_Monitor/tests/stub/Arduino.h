@@ -0,0 +1,6 @@
+// 主机测试用的Arduino声明，只包含头文件里引用到的类型
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+typedef void* TaskHandle_t;
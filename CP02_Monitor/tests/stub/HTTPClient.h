@@ -0,0 +1,2 @@
+// 主机测试用的空头文件
+#pragma once
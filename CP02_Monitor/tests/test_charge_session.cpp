@@ -0,0 +1,195 @@
+/**
+ * @file     test_charge_session.cpp
+ * @brief    充电会话跟踪：回放traces目录中的合成记录
+ *
+ * 每个记录由traces/gen_charge_traces.py生成，充电曲线的降流时间、协议和结束
+ * 方式是生成时确定的，这里检查ChargeSession从采样中还原出来的结果。电量和
+ * 一个独立的累计比较：相邻采样的平均功率乘以间隔（间隔同样最多按maxGapMs算），
+ * 只统计VBUS存在的采样。
+ *
+ *   test_charge_session [trace...]    只打印给定记录的会话摘要
+ */
+
+#include <math.h>
+#include <string.h>
+#include "host_test.h"
+#include "Charge_Session.h"
+
+#define TRACE_DIR       "traces/"
+#define MAX_SESSIONS    ChargeHistory::CAPACITY
+
+struct Replay {
+    uint8_t count;
+    ChargeSummary sessions[MAX_SESSIONS];
+    double refMwh;              // 独立累计的电量
+    uint32_t samples;
+};
+
+static const char* const PHASE_NAMES[] = {"ramp", "bulk", "taper", "trickle"};
+
+// 按时间顺序回放一个记录，结束的会话依次放进replay->sessions
+static bool replayTrace(const char* path, Replay* replay) {
+    FILE* f = fopen(path, "r");
+    if (f == NULL) {
+        fprintf(stderr, "%s: cannot open\n", path);
+        return false;
+    }
+
+    const ChargeSession::Config& cfg = ChargeSession::DEFAULT_CONFIG;
+    ChargeSession session;
+    session.begin(0);
+    memset(replay, 0, sizeof(*replay));
+
+    char line[128];
+    bool first = true;
+    uint32_t lastMs = 0;
+    double lastMw = 0;
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (line[0] == '#') {
+            continue;
+        }
+        unsigned ms, state, proto, mv, ma;
+        if (sscanf(line, "%u %u %u %u %u", &ms, &state, &proto, &mv, &ma) != 5) {
+            fprintf(stderr, "%s: bad line: %s", path, line);
+            fclose(f);
+            return false;
+        }
+        replay->samples++;
+
+        double mw = mv >= cfg.offMv ? mv * (double)ma / 1000.0 : 0.0;
+        if (!first) {
+            uint32_t dtMs = ms - lastMs;
+            if (dtMs > cfg.maxGapMs) {
+                dtMs = cfg.maxGapMs;
+            }
+            replay->refMwh += (lastMw + mw) / 2 * dtMs / 3600000.0;
+        }
+        first = false;
+        lastMs = ms;
+        lastMw = mw;
+
+        ChargeSummary summary;
+        if (session.update(cfg, state, proto, mv, ma, ms, &summary) && replay->count < MAX_SESSIONS) {
+            replay->sessions[replay->count++] = summary;
+        }
+    }
+    fclose(f);
+    return true;
+}
+
+static void printSummary(const ChargeSummary& s) {
+    printf("  start %us, %us, %u mWh, peak %u.%uW, avg %u.%uW, taper %d s, %s, protocols",
+           (unsigned)(s.startMs / 1000), (unsigned)s.durationS, (unsigned)s.energyMwh,
+           s.peakDw / 10, s.peakDw % 10, s.avgDw / 10, s.avgDw % 10,
+           s.taperS == CHARGE_NO_TAPER ? -1 : (int)s.taperS,
+           s.end == END_UNPLUG ? "unplugged" : "idle");
+    for (int i = 0; i < s.protoCount; i++) {
+        printf(" %u", s.protocols[i]);
+    }
+    printf(", phases");
+    for (int i = 0; i < s.phaseCount; i++) {
+        printf(" %s@%u", PHASE_NAMES[s.phases[i].phase], (unsigned)s.phases[i].offsetS);
+    }
+    printf("\n");
+}
+
+static void printReplay(const char* path, const Replay& replay) {
+    printf("%s: %u samples, %u sessions, reference %.0f mWh\n", path, (unsigned)replay.samples,
+           replay.count, replay.refMwh);
+    for (int i = 0; i < replay.count; i++) {
+        printSummary(replay.sessions[i]);
+    }
+}
+
+// 生成时确定的结果
+struct Expect {
+    uint32_t taperS;            // 会话开始到降流的秒数，CHARGE_NO_TAPER表示不检查
+    uint8_t end;
+    uint8_t protoCount;
+    uint8_t protocols[CHARGE_PROTO_MAX];
+};
+
+#define TAPER_TOLERANCE_S   90      // 平滑和holdMs带来的偏差
+
+// 阶段按RAMP、BULK、TAPER的顺序出现，降流时间和TAPER阶段的起点一致
+static void checkSession(const ChargeSummary& s, const Expect& e) {
+    CHECK_EQ_INT(s.end, e.end);
+    CHECK_EQ_INT(s.protoCount, e.protoCount);
+    for (int i = 0; i < e.protoCount && i < s.protoCount; i++) {
+        CHECK_EQ_INT(s.protocols[i], e.protocols[i]);
+    }
+    CHECK(s.phaseCount >= 3);
+    CHECK_EQ_INT(s.phases[0].phase, PHASE_RAMP);
+    CHECK_EQ_INT(s.phases[1].phase, PHASE_BULK);
+    CHECK_EQ_INT(s.phases[2].phase, PHASE_TAPER);
+    CHECK_EQ_INT(s.phases[2].offsetS, s.taperS);
+    CHECK(s.taperS != CHARGE_NO_TAPER);
+    if (s.taperS != CHARGE_NO_TAPER) {
+        CHECK(fabs((double)s.taperS - e.taperS) <= TAPER_TOLERANCE_S);
+    }
+}
+
+// 单个会话的记录：会话电量和独立累计相差不到2%
+static void checkSingle(const char* name, const Expect& e) {
+    char path[64];
+    snprintf(path, sizeof(path), TRACE_DIR "%s", name);
+    Replay replay;
+    CHECK(replayTrace(path, &replay));
+    printReplay(path, replay);
+    CHECK_EQ_INT(replay.count, 1);
+    if (replay.count != 1) {
+        return;
+    }
+    checkSession(replay.sessions[0], e);
+    CHECK(fabs(replay.sessions[0].energyMwh - replay.refMwh) < replay.refMwh * 0.02);
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        for (int i = 1; i < argc; i++) {
+            Replay replay;
+            if (replayTrace(argv[i], &replay)) {
+                printReplay(argv[i], replay);
+            }
+        }
+        return 0;
+    }
+
+    const Expect phone = {1500, END_UNPLUG, 2, {15, 16}};
+    const Expect laptop = {2400, END_IDLE, 1, {16}};
+    const Expect buds = {600, END_IDLE, 0, {}};
+    const Expect noState = {1200, END_UNPLUG, 1, {16}};
+    checkSingle("phone.txt", phone);
+    checkSingle("laptop.txt", laptop);
+    checkSingle("buds.txt", buds);
+    checkSingle("no_state.txt", noState);
+
+    // 1s的VBUS跌落不拆开会话，断网的30s按maxGapMs累计
+    checkSingle("glitch.txt", phone);
+    Replay plain, glitch;
+    CHECK(replayTrace(TRACE_DIR "phone.txt", &plain));
+    CHECK(replayTrace(TRACE_DIR "glitch.txt", &glitch));
+    if (plain.count == 1 && glitch.count == 1) {
+        CHECK(fabs((double)glitch.sessions[0].energyMwh - plain.sessions[0].energyMwh) <
+              plain.sessions[0].energyMwh * 0.02);
+    }
+
+    // 两个会话依次结束，放进历史记录后最新的在前
+    Replay both;
+    CHECK(replayTrace(TRACE_DIR "back_to_back.txt", &both));
+    printReplay(TRACE_DIR "back_to_back.txt", both);
+    CHECK_EQ_INT(both.count, 2);
+    if (both.count == 2) {
+        checkSession(both.sessions[0], buds);
+        checkSession(both.sessions[1], phone);
+        CHECK(both.sessions[1].startMs >= both.sessions[0].startMs + both.sessions[0].durationS * 1000);
+
+        ChargeHistory history;
+        history.add(both.sessions[0]);
+        history.add(both.sessions[1]);
+        CHECK_EQ_INT(history.count(), 2);
+        CHECK_EQ_INT(history.get(0).startMs, both.sessions[1].startMs);
+        CHECK_EQ_INT(history.get(1).startMs, both.sessions[0].startMs);
+    }
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,104 @@
+/**
+ * @file     test_metrics_parser.cpp
+ * @brief    Prometheus指标流式解析：标签集合、分块边界、超长行
+ */
+
+#include <string.h>
+#include "host_test.h"
+#include "Metrics_Parser.h"
+
+// 原始格式，每个指标只有id标签
+static const char PAGE_PLAIN[] =
+    "# HELP ionbridge_port_current Port current in mA\n"
+    "# TYPE ionbridge_port_current gauge\n"
+    "ionbridge_port_current{id=\"0\"} 1500\n"
+    "ionbridge_port_current{id=\"1\"} 0\n"
+    "ionbridge_port_voltage{id=\"0\"} 9000\n"
+    "ionbridge_port_voltage{id=\"1\"} 5000\n"
+    "ionbridge_port_state{id=\"0\"} 3\n"
+    "ionbridge_port_fc_protocol{id=\"0\"} 12\n"
+    "ionbridge_uptime_seconds 12345\n";
+
+// 固件加了额外的标签，id不一定在第一个，行尾是CRLF，最后一行没有换行
+static const char PAGE_LABELS[] =
+    "ionbridge_port_current{device=\"cp02\",id=\"2\",name=\"C1\"} 2100\r\n"
+    "ionbridge_port_voltage{id=\"2\",name=\"C1\"} 20000\r\n"
+    "ionbridge_port_state{name=\"a\\\"b,id=\\\"3\\\"\",id=\"2\"} 4\r\n"
+    "ionbridge_port_fc_protocol{ida=\"1\",id=\"2\"} 7\r\n"
+    "ionbridge_port_current{name=\"no id\"} 999\r\n"
+    "ionbridge_port_current{id=\"9\"} 999\r\n"
+    "ionbridge_port_current{id=\"x\"} 999\r\n"
+    "ionbridge_port_current_limit{id=\"2\"} 999\r\n"
+    "ionbridge_port_voltage{id=\"4\"} 12000";
+
+static uint16_t parse(const char* page, size_t chunk, PortInfo* ports) {
+    MetricsParser parser;
+    memset(ports, 0, sizeof(PortInfo) * MAX_PORTS);
+    parser.begin(ports, MAX_PORTS);
+    size_t len = strlen(page);
+    for (size_t pos = 0; pos < len; pos += chunk) {
+        size_t n = len - pos < chunk ? len - pos : chunk;
+        parser.feed((const uint8_t*)page + pos, n);
+    }
+    return parser.finish();
+}
+
+static void test_plain() {
+    PortInfo ports[MAX_PORTS];
+    CHECK_EQ_INT(parse(PAGE_PLAIN, sizeof(PAGE_PLAIN), ports), 6);
+    CHECK_EQ_INT(ports[0].current, 1500);
+    CHECK_EQ_INT(ports[0].voltage, 9000);
+    CHECK_EQ_INT(ports[0].state, 3);
+    CHECK_EQ_INT(ports[0].fc_protocol, 12);
+    CHECK_EQ_INT(ports[1].current, 0);
+    CHECK_EQ_INT(ports[1].voltage, 5000);
+}
+
+static void test_labels() {
+    PortInfo ports[MAX_PORTS];
+    CHECK_EQ_INT(parse(PAGE_LABELS, sizeof(PAGE_LABELS), ports), 5);
+    CHECK_EQ_INT(ports[2].current, 2100);
+    CHECK_EQ_INT(ports[2].voltage, 20000);
+    CHECK_EQ_INT(ports[2].state, 4);
+    CHECK_EQ_INT(ports[2].fc_protocol, 7);
+    CHECK_EQ_INT(ports[3].state, 0);
+    CHECK_EQ_INT(ports[1].fc_protocol, 0);
+    CHECK_EQ_INT(ports[4].voltage, 12000);
+    CHECK_EQ_INT(ports[4].current, 0);
+}
+
+// 任意大小的块得到的结果都和整页一次送入相同
+static void test_chunks() {
+    PortInfo whole[MAX_PORTS];
+    PortInfo split[MAX_PORTS];
+    const char* pages[] = { PAGE_PLAIN, PAGE_LABELS };
+    for (const char* page : pages) {
+        uint16_t fields = parse(page, strlen(page), whole);
+        for (size_t chunk = 1; chunk <= 40; chunk++) {
+            CHECK_EQ_INT(parse(page, chunk, split), fields);
+            CHECK(memcmp(whole, split, sizeof(whole)) == 0);
+        }
+    }
+}
+
+// 超过缓冲区的行整行丢弃，不影响下一行
+static void test_long_line() {
+    char page[512];
+    char label[200];
+    memset(label, 'x', sizeof(label) - 1);
+    label[sizeof(label) - 1] = '\0';
+    snprintf(page, sizeof(page),
+             "ionbridge_port_current{id=\"1\",note=\"%s\"} 777\n"
+             "ionbridge_port_current{id=\"1\"} 888\n", label);
+    PortInfo ports[MAX_PORTS];
+    CHECK_EQ_INT(parse(page, 7, ports), 1);
+    CHECK_EQ_INT(ports[1].current, 888);
+}
+
+int main() {
+    test_plain();
+    test_labels();
+    test_chunks();
+    test_long_line();
+    return HOST_TEST_RESULT();
+}
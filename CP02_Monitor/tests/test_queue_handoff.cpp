@@ -0,0 +1,130 @@
+/**
+ * @file     test_queue_handoff.cpp
+ * @brief    采集任务和LVGL循环之间的单槽队列交接
+ *
+ * 采集任务用xQueueOverwrite()把完整的一帧PowerData写进长度为1的队列，
+ * 刷新定时器用xQueuePeek()取最新一帧，序号变化时才复制到界面。这里用两个
+ * 线程按同样的方式交接，队列按FreeRTOS的语义在锁内整帧复制。检查界面从不
+ * 读到半帧、序号不倒退、没有新数据时不重绘、最后一帧一定被取走。
+ */
+
+#include <atomic>
+#include <mutex>
+#include <string.h>
+#include <thread>
+#include "host_test.h"
+#include "Power_Monitor.h"
+
+#define FRAMES      200000
+
+// 长度为1的队列，写入覆盖旧数据，读取不取走
+class SingleSlotQueue {
+public:
+    void overwrite(const PowerData* item) {
+        std::lock_guard<std::mutex> lock(mutex);
+        memcpy(&slot, item, sizeof(slot));
+        full = true;
+    }
+    bool peek(PowerData* item) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!full) {
+            return false;
+        }
+        memcpy(item, &slot, sizeof(slot));
+        return true;
+    }
+
+private:
+    std::mutex mutex;
+    PowerData slot;
+    bool full = false;
+};
+
+static SingleSlotQueue dataQueue;
+static std::atomic<bool> producerDone(false);
+
+// 和PowerMonitor_Task一样，每一帧的所有字段由序号决定，界面可以检查是否完整
+static void fillFrame(PowerData* frame, uint32_t seq) {
+    memset(frame, 0, sizeof(*frame));
+    frame->seq = seq;
+    frame->totalPower = 0.0f;
+    for (int i = 0; i < MAX_PORTS; i++) {
+        frame->ports[i].id = i;
+        frame->ports[i].state = (uint8_t)(seq + i);
+        frame->ports[i].fc_protocol = (uint8_t)(seq >> 8);
+        frame->ports[i].current = (uint16_t)(seq * 3 + i);
+        frame->ports[i].voltage = (uint16_t)(seq * 7 + i);
+        frame->ports[i].power = (float)(seq % 1000);
+        frame->totalPower += frame->ports[i].power;
+    }
+}
+
+static bool frameConsistent(const PowerData* frame) {
+    PowerData expected;
+    fillFrame(&expected, frame->seq);
+    return memcmp(&expected, frame, sizeof(expected)) == 0;
+}
+
+static void producer() {
+    PowerData frame;
+    for (uint32_t seq = 1; seq <= FRAMES; seq++) {
+        fillFrame(&frame, seq);
+        dataQueue.overwrite(&frame);
+        // 偶尔让出，界面有机会在两帧之间读到数据
+        if (seq % 64 == 0) {
+            std::this_thread::yield();
+        }
+    }
+    producerDone = true;
+}
+
+// 和PowerMonitor_RefreshTimerCb一样：序号没变时什么都不做
+struct Consumer {
+    uint32_t lastSeq = 0;
+    uint32_t redraws = 0;
+    uint32_t torn = 0;
+    uint32_t backwards = 0;
+    PowerData ui;
+
+    bool poll() {
+        PowerData frame;
+        if (!dataQueue.peek(&frame) || frame.seq == lastSeq) {
+            return false;
+        }
+        if (frame.seq < lastSeq) {
+            backwards++;
+        }
+        if (!frameConsistent(&frame)) {
+            torn++;
+        }
+        lastSeq = frame.seq;
+        memcpy(&ui, &frame, sizeof(ui));
+        redraws++;
+        return true;
+    }
+};
+
+int main() {
+    Consumer consumer;
+    CHECK(!consumer.poll());
+
+    std::thread thread(producer);
+    while (!producerDone) {
+        consumer.poll();
+    }
+    thread.join();
+
+    // 采集结束后的下一次检查取到最后一帧，之后不再重绘
+    consumer.poll();
+    uint32_t redraws = consumer.redraws;
+    CHECK(!consumer.poll());
+    CHECK_EQ_INT(consumer.redraws, redraws);
+
+    CHECK_EQ_INT(consumer.torn, 0);
+    CHECK_EQ_INT(consumer.backwards, 0);
+    CHECK_EQ_INT(consumer.lastSeq, FRAMES);
+    CHECK(frameConsistent(&consumer.ui));
+    CHECK(consumer.redraws >= 1 && consumer.redraws <= FRAMES);
+    printf("%u frames, %u redraws\n", (unsigned)FRAMES, (unsigned)consumer.redraws);
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+"""
+生成充电会话回放用的合成数据，每个文件是一个端口的一段记录
+
+  phone.txt         9V PD手机：5V握手后切到9V，2.4A恒流到1500s，之后指数降流，涓流一段时间后拔出，
+                    拔出后端口状态回到0，VBUS保持5V
+  laptop.txt        20V PD笔记本：3A带系统负载波动，2400s开始降流，降到几十mA后一直插着
+  buds.txt          5V耳机盒：没有快充协议，600s开始降流，电流降到几mA后还插着
+  no_state.txt      不上报端口状态的固件：状态一直是0，1200s开始降流，最后VBUS消失
+  glitch.txt        和phone相同的充电曲线，恒流阶段有一次1s的VBUS跌落和一次30s的断网
+  back_to_back.txt  同一个端口先充耳机盒，充满后拔出，10s后再充手机
+
+每行是一次采样：时间(ms) 端口状态 快充协议 电压(mV) 电流(mA)，用空格分隔。
+采样间隔在800~1200ms之间抖动，和采集任务的HTTP轮询差不多。随机数种子固定，
+重新生成的文件完全相同。
+
+用法: python tests/traces/gen_charge_traces.py [-o tests/traces]
+"""
+
+import argparse
+import math
+import os
+import random
+
+PROTO_NONE = 0
+PROTO_PD_FIX5V = 15
+PROTO_PD_FIXHV = 16
+
+
+class Trace:
+    def __init__(self, rng):
+        self.rng = rng
+        self.ms = 0
+        self.rows = []
+
+    def sample(self, state, proto, mv, ma):
+        self.rows.append((self.ms, state, proto, max(int(mv), 0), max(int(ma), 0)))
+        self.ms += self.rng.randint(800, 1200)
+
+    def stall(self, ms):
+        self.ms += ms
+
+    # 持续seconds秒，fn(t)返回(状态, 协议, 电压, 电流)，t是这一段内的秒数
+    def segment(self, seconds, fn):
+        end = self.ms + seconds * 1000
+        start = self.ms
+        while self.ms < end:
+            self.sample(*fn((self.ms - start) / 1000.0))
+
+    def unplugged(self, seconds):
+        self.segment(seconds, lambda t: (0, PROTO_NONE, self.rng.randint(0, 40), 0))
+
+    def write(self, path, comment):
+        with open(path, 'w') as f:
+            f.write('# %s\n' % comment)
+            f.write('# 时间ms 状态 协议 电压mV 电流mA\n')
+            for row in self.rows:
+                f.write('%d %d %d %d %d\n' % row)
+
+
+def charge_curve(rng, t, ramp_s, peak_ma, taper_s, tau_s, floor_ma, noise_ma):
+    """恒流充电曲线：线性上升，恒流，从taper_s开始按tau_s指数下降到floor_ma"""
+    if t < ramp_s:
+        ma = peak_ma * t / ramp_s
+    elif t < taper_s:
+        ma = peak_ma
+    else:
+        ma = floor_ma + (peak_ma - floor_ma) * math.exp(-(t - taper_s) / tau_s)
+    return ma + rng.randint(-noise_ma, noise_ma)
+
+
+def phone(tr, rng, glitch=False):
+    tr.segment(3, lambda t: (1, PROTO_PD_FIX5V, 5000 + rng.randint(-30, 30), 500 + rng.randint(-20, 20)))
+    plug_s = 3
+
+    def fn(t):
+        ma = charge_curve(rng, t + plug_s, 60, 2400, 1500, 500, 60, 15)
+        return 2, PROTO_PD_FIXHV, 9000 + rng.randint(-40, 40), ma
+
+    if not glitch:
+        tr.segment(3300, fn)
+    else:
+        tr.segment(800, fn)
+        # PD复位：VBUS掉到0约1s后重新握手
+        tr.sample(0, PROTO_NONE, 0, 0)
+        tr.segment(200, lambda t: fn(t + 800))
+        tr.stall(30000)
+        tr.segment(2270, lambda t: fn(t + 1030))
+    # 拔出后端口状态回到0，口子上仍然保持5V
+    tr.segment(20, lambda t: (0, PROTO_NONE, 5000 + rng.randint(-30, 30), 0))
+
+
+def laptop(tr, rng):
+    def fn(t):
+        # 系统负载的波动和电流成比例，充满后只剩几十mA
+        ma = charge_curve(rng, t, 120, 2800, 2400, 400, 30, 0)
+        ma += rng.gauss(0, ma * 0.03)
+        return 2, PROTO_PD_FIXHV, 20000 + rng.randint(-60, 60), ma
+
+    tr.segment(4800, fn)
+
+
+def buds(tr, rng):
+    def fn(t):
+        ma = charge_curve(rng, t, 20, 350, 600, 200, 0, 8)
+        return 1, PROTO_NONE, 5000 + rng.randint(-30, 30), ma
+
+    tr.segment(1500, fn)
+
+
+def no_state(tr, rng):
+    def fn(t):
+        ma = charge_curve(rng, t, 40, 2000, 1200, 400, 40, 15)
+        return 0, PROTO_PD_FIXHV, 9000 + rng.randint(-40, 40), ma
+
+    tr.segment(2800, fn)
+    tr.unplugged(20)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='生成充电会话回放用的合成数据')
+    parser.add_argument('-o', '--output', default=os.path.dirname(os.path.abspath(__file__)))
+    args = parser.parse_args()
+
+    traces = [
+        ('phone.txt', '9V PD手机，1500s开始降流，之后拔出', lambda tr, rng: phone(tr, rng)),
+        ('laptop.txt', '20V PD笔记本，2400s开始降流，充满后一直插着', laptop),
+        ('buds.txt', '5V耳机盒，600s开始降流，充满后还插着', buds),
+        ('no_state.txt', '不上报端口状态的固件，1200s开始降流，之后VBUS消失', no_state),
+        ('glitch.txt', '9V PD手机，800s时VBUS跌落1s，1000s时断网30s', lambda tr, rng: phone(tr, rng, True)),
+        ('back_to_back.txt', '耳机盒充满拔出，10s后插上手机',
+         lambda tr, rng: (tr.unplugged(5), buds(tr, rng), tr.unplugged(10), phone(tr, rng))),
+    ]
+    for name, comment, build in traces:
+        rng = random.Random(20261018)
+        tr = Trace(rng)
+        build(tr, rng)
+        path = os.path.join(args.output, name)
+        tr.write(path, comment)
+        print('%s: %d samples, %d s' % (path, len(tr.rows), tr.ms // 1000))
+
+
+if __name__ == '__main__':
+    main()
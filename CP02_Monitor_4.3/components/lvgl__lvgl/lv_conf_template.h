@@ -92,6 +92,8 @@
     /*If using lvgl as ESP32 component*/
     // #define LV_TICK_CUSTOM_INCLUDE "esp_timer.h"
     // #define LV_TICK_CUSTOM_SYS_TIME_EXPR ((esp_timer_get_time() / 1000LL))
+    /*Optional separate time source for the animations, e.g. a clock latched at each displayed frame*/
+    // #define LV_ANIM_TIME_CUSTOM_EXPR (ui_clock_ms())
 #endif   /*LV_TICK_CUSTOM*/
 
 /*Default Dot Per Inch. Used to initialize default sizes such as widgets sized, style paddings.
@@ -294,6 +296,24 @@
 /*1: Draw random colored rectangles over the redrawn areas*/
 #define LV_USE_REFR_DEBUG 0
 
+/*1: Don't draw the parts of an object which are covered by opaque children*/
+#define LV_USE_OCCLUSION_CULLING 0
+#if LV_USE_OCCLUSION_CULLING
+    /*Max. number of visible areas an object's clip area can be split into. Above it the whole area is drawn*/
+    #define LV_OCCLUSION_CULLING_MAX_RECTS 8
+#endif
+
+/*1: Limit the time of a refresh. Areas invalidated with lower priority are deferred to the next refresh if needed*/
+#define LV_USE_REFR_BUDGET 0
+#if LV_USE_REFR_BUDGET
+    /*Time budget of a refresh [ms]. Areas with `LV_REFR_PRIO_HIGH` are always drawn*/
+    #define LV_REFR_BUDGET_MS LV_DISP_DEF_REFR_PERIOD
+
+    /*Microsecond clock to time the rendering. If not set `lv_tick` is used which can be too coarse*/
+    // #define LV_REFR_BUDGET_TIME_INCLUDE "esp_timer.h"
+    // #define LV_REFR_BUDGET_TIME_US_EXPR (esp_timer_get_time())
+#endif
+
 /*Change the built in (v)snprintf functions*/
 #define LV_SPRINTF_CUSTOM 0
 #if LV_SPRINTF_CUSTOM
@@ -222,6 +222,14 @@ uint32_t lv_event_register_id(void);
  */
 void _lv_event_mark_deleted(struct _lv_obj_t * obj);
 
+/**
+ * Check if an object has an event handler which receives the main draw events
+ * (`LV_EVENT_DRAW_MAIN/_BEGIN/_END` or `LV_EVENT_DRAW_PART_BEGIN/END` sent while drawing the main part).
+ * @param obj   pointer to an object
+ * @return      true if there is such a handler
+ */
+bool _lv_obj_has_draw_main_event_cb(struct _lv_obj_t * obj);
+
 /**
  * Add an event handler function for an object.
  * Used by the user to react on event which happens with the object.
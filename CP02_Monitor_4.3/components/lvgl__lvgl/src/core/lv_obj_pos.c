@@ -842,7 +842,13 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
     lv_area_copy(&area_tmp, area);
     if(!lv_obj_area_is_visible(obj, &area_tmp)) return;
 
+#if LV_USE_REFR_BUDGET
+    lv_refr_prio_t prio = LV_REFR_PRIO_MID;
+    if(disp->driver->refr_prio_cb) prio = disp->driver->refr_prio_cb(disp->driver, obj);
+    _lv_inv_area_prio(disp, &area_tmp, prio);
+#else
     _lv_inv_area(lv_obj_get_disp(obj),  &area_tmp);
+#endif
 }
 
 void lv_obj_invalidate(const lv_obj_t * obj)
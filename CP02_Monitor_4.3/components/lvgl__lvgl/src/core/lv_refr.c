@@ -10,6 +10,9 @@
 #include "lv_refr.h"
 #include "lv_disp.h"
 #include "../hal/lv_hal_tick.h"
+#if LV_USE_REFR_BUDGET && defined(LV_REFR_BUDGET_TIME_US_EXPR)
+    #include LV_REFR_BUDGET_TIME_INCLUDE
+#endif
 #include "../hal/lv_hal_disp.h"
 #include "../misc/lv_timer.h"
 #include "../misc/lv_mem.h"
@@ -48,6 +51,31 @@ typedef struct {
 #endif
 } mem_monitor_t;
 
+#if LV_USE_OCCLUSION_CULLING
+typedef struct {
+    uint32_t    drawn_px;
+    uint32_t    culled_px;
+} occlusion_stats_t;
+#endif
+
+#if LV_USE_REFR_BUDGET
+typedef struct {
+    /*Areas removed from the current refresh, invalidated again when it's finished*/
+    lv_area_t defer_areas[LV_INV_BUF_SIZE];
+    lv_refr_prio_t defer_prio[LV_INV_BUF_SIZE];
+    uint16_t defer_cnt;
+
+    /*Time spent waiting for the display in the current refresh [us]*/
+    uint32_t wait_time;
+
+    /*Rendering time [us] and pixels of the recent refreshes to estimate the cost of an area*/
+    uint32_t cost_time;
+    uint32_t cost_px;
+
+    lv_refr_budget_stats_t stats;
+} refr_budget_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -62,7 +90,16 @@ static void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj);
 static uint32_t get_max_row(lv_disp_t * disp, lv_coord_t area_w, lv_coord_t area_h);
 static void draw_buf_flush(lv_disp_t * disp);
 static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
+static void obj_draw_main(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj);
 
+#if LV_USE_OCCLUSION_CULLING
+    static void obj_draw_main_culled(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj);
+#endif
+#if LV_USE_REFR_BUDGET
+    static void refr_budget_plan(uint64_t start);
+    static void refr_budget_update(uint32_t frame_time, uint32_t render_time);
+    static void refr_budget_restore(void);
+#endif
 #if LV_USE_PERF_MONITOR
     static void perf_monitor_init(perf_monitor_t * perf_monitor);
 #endif
@@ -84,9 +121,26 @@ static lv_disp_t * disp_refr; /*Display being refreshed*/
     static mem_monitor_t    mem_monitor;
 #endif
 
+#if LV_USE_OCCLUSION_CULLING
+    static occlusion_stats_t occlusion_stats;
+#endif
+
+#if LV_USE_REFR_BUDGET
+    static refr_budget_t refr_budget;
+#endif
+
 /**********************
  *      MACROS
  **********************/
+#if LV_USE_REFR_BUDGET
+    /*The tick can be too coarse to time a refresh, so a microsecond clock can be set*/
+    #ifdef LV_REFR_BUDGET_TIME_US_EXPR
+        #define REFR_BUDGET_TIME_US() ((uint64_t)(LV_REFR_BUDGET_TIME_US_EXPR))
+    #else
+        #define REFR_BUDGET_TIME_US() ((uint64_t)lv_tick_get() * 1000)
+    #endif
+#endif
+
 #if LV_LOG_TRACE_DISP_REFR
     #define REFR_TRACE(...) LV_LOG_TRACE(__VA_ARGS__)
 #else
@@ -144,9 +198,13 @@ void lv_obj_redraw(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
     if(should_draw) {
         draw_ctx->clip_area = &clip_coords_for_obj;
 
-        lv_event_send(obj, LV_EVENT_DRAW_MAIN_BEGIN, draw_ctx);
-        lv_event_send(obj, LV_EVENT_DRAW_MAIN, draw_ctx);
-        lv_event_send(obj, LV_EVENT_DRAW_MAIN_END, draw_ctx);
+#if LV_USE_OCCLUSION_CULLING
+        /*Skip the parts of the object covered by opaque children*/
+        if(com_clip_res) obj_draw_main_culled(draw_ctx, obj);
+        else obj_draw_main(draw_ctx, obj);
+#else
+        obj_draw_main(draw_ctx, obj);
+#endif
 #if LV_USE_REFR_DEBUG
         lv_color_t debug_color = lv_color_make(lv_rand(0, 0xFF), lv_rand(0, 0xFF), lv_rand(0, 0xFF));
         lv_draw_rect_dsc_t draw_dsc;
@@ -204,6 +262,21 @@ void lv_obj_redraw(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
  */
 void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
 {
+    _lv_inv_area_prio(disp, area_p, LV_REFR_PRIO_MID);
+}
+
+/**
+ * Invalidate an area on display to redraw it with a given priority.
+ * With `LV_USE_REFR_BUDGET` lower priority areas are drawn in a later refresh if the time budget is exceeded.
+ * @param disp pointer to display where the area should be invalidated (NULL can be used if there is
+ * only one display)
+ * @param area_p pointer to area which should be invalidated (NULL: delete the invalidated areas)
+ * @param prio `LV_REFR_PRIO_LOW/MID/HIGH`
+ */
+void _lv_inv_area_prio(lv_disp_t * disp, const lv_area_t * area_p, lv_refr_prio_t prio)
+{
+    LV_UNUSED(prio);
+
     if(!disp) disp = lv_disp_get_default();
     if(!disp) return;
     if(!lv_disp_is_invalidation_enabled(disp)) return;
@@ -234,6 +307,9 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
     /*If there were at least 1 invalid area in full refresh mode, redraw the whole screen*/
     if(disp->driver->full_refresh) {
         disp->inv_areas[0] = scr_area;
+#if LV_USE_REFR_BUDGET
+        disp->inv_area_prio[0] = LV_REFR_PRIO_HIGH;
+#endif
         disp->inv_p = 1;
         if(disp->refr_timer) lv_timer_resume(disp->refr_timer);
         return;
@@ -244,16 +320,27 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
     /*Save only if this area is not in one of the saved areas*/
     uint16_t i;
     for(i = 0; i < disp->inv_p; i++) {
-        if(_lv_area_is_in(&com_area, &disp->inv_areas[i], 0) != false) return;
+        if(_lv_area_is_in(&com_area, &disp->inv_areas[i], 0) != false) {
+#if LV_USE_REFR_BUDGET
+            if(disp->inv_area_prio[i] < prio) disp->inv_area_prio[i] = prio;
+#endif
+            return;
+        }
     }
 
     /*Save the area*/
     if(disp->inv_p < LV_INV_BUF_SIZE) {
         lv_area_copy(&disp->inv_areas[disp->inv_p], &com_area);
+#if LV_USE_REFR_BUDGET
+        disp->inv_area_prio[disp->inv_p] = prio;
+#endif
     }
     else {   /*If no place for the area add the screen*/
         disp->inv_p = 0;
         lv_area_copy(&disp->inv_areas[disp->inv_p], &scr_area);
+#if LV_USE_REFR_BUDGET
+        disp->inv_area_prio[disp->inv_p] = LV_REFR_PRIO_HIGH;
+#endif
     }
     disp->inv_p++;
     if(disp->refr_timer) lv_timer_resume(disp->refr_timer);
@@ -289,6 +376,9 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
 
     uint32_t start = lv_tick_get();
     volatile uint32_t elaps = 0;
+#if LV_USE_REFR_BUDGET
+    uint64_t start_us = REFR_BUDGET_TIME_US();
+#endif
 
     if(tmr) {
         disp_refr = tmr->user_data;
@@ -320,9 +410,25 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
     }
 
     lv_refr_join_area();
+#if LV_USE_REFR_BUDGET
+    /*Before syncing, so the deferred areas are copied from the other buffer in direct mode*/
+    refr_budget_plan(start_us);
+#endif
     refr_sync_areas();
+
+#if LV_USE_REFR_BUDGET
+    refr_budget.wait_time = 0;
+    uint64_t render_start = REFR_BUDGET_TIME_US();
+#endif
     refr_invalid_areas();
 
+#if LV_USE_REFR_BUDGET
+    /*Only the drawing is learned: waiting for the display (e.g. for VSYNC in the flush) doesn't scale with the pixels*/
+    uint64_t render_end = REFR_BUDGET_TIME_US();
+    uint32_t render_time = (uint32_t)(render_end - render_start);
+    render_time = render_time > refr_budget.wait_time ? render_time - refr_budget.wait_time : 0;
+#endif
+
     /*If refresh happened ...*/
     if(disp_refr->inv_p != 0) {
 
@@ -346,12 +452,20 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
 
         elaps = lv_tick_elaps(start);
 
+#if LV_USE_REFR_BUDGET
+        refr_budget_update((uint32_t)((render_end - start_us) / 1000), render_time);
+#endif
+
         /*Call monitor cb if present*/
         if(disp_refr->driver->monitor_cb) {
             disp_refr->driver->monitor_cb(disp_refr->driver, elaps, px_num);
         }
     }
 
+#if LV_USE_REFR_BUDGET
+    refr_budget_restore();
+#endif
+
     lv_mem_buf_free_all();
     _lv_font_clean_up_fmt_txt();
 
@@ -466,6 +580,34 @@ uint32_t lv_refr_get_fps_avg(void)
 }
 #endif
 
+#if LV_USE_OCCLUSION_CULLING
+void lv_refr_get_occlusion_stats(uint32_t * drawn_px, uint32_t * culled_px)
+{
+    if(drawn_px) *drawn_px = occlusion_stats.drawn_px;
+    if(culled_px) *culled_px = occlusion_stats.culled_px;
+}
+
+void lv_refr_reset_occlusion_stats(void)
+{
+    occlusion_stats.drawn_px = 0;
+    occlusion_stats.culled_px = 0;
+}
+#endif
+
+#if LV_USE_REFR_BUDGET
+void lv_refr_get_budget_stats(lv_refr_budget_stats_t * stats)
+{
+    *stats = refr_budget.stats;
+    stats->px_cost_ns = refr_budget.cost_px ? (uint32_t)((uint64_t)refr_budget.cost_time * 1000 /
+                                                          refr_budget.cost_px) : 0;
+}
+
+void lv_refr_reset_budget_stats(void)
+{
+    lv_memset_00(&refr_budget.stats, sizeof(refr_budget.stats));
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -502,11 +644,130 @@ static void lv_refr_join_area(void)
 
                 /*Mark 'join_form' is joined into 'join_in'*/
                 disp_refr->inv_area_joined[join_from] = 1;
+#if LV_USE_REFR_BUDGET
+                if(disp_refr->inv_area_prio[join_in] < disp_refr->inv_area_prio[join_from]) {
+                    disp_refr->inv_area_prio[join_in] = disp_refr->inv_area_prio[join_from];
+                }
+#endif
             }
         }
     }
 }
 
+#if LV_USE_REFR_BUDGET
+/**
+ * Estimate the time needed to render an area based on the recent refreshes
+ * @param area_p    pointer to an area
+ * @return          the estimated time [us]
+ */
+static uint32_t refr_budget_cost(const lv_area_t * area_p)
+{
+    return (uint32_t)((uint64_t)lv_area_get_size(area_p) * refr_budget.cost_time / refr_budget.cost_px);
+}
+
+/**
+ * Order the invalidated areas by priority and remove the ones which don't fit into
+ * `LV_REFR_BUDGET_MS`. The removed areas are invalidated again by `refr_budget_restore()`.
+ * @param start     the time when the refresh started [us]
+ */
+static void refr_budget_plan(uint64_t start)
+{
+    refr_budget.defer_cnt = 0;
+
+    /*In full refresh mode the whole screen is drawn anyway*/
+    if(disp_refr->driver->full_refresh) return;
+
+    lv_area_t * areas = disp_refr->inv_areas;
+    lv_refr_prio_t * prios = disp_refr->inv_area_prio;
+
+    /*Drop the joined areas and sort the rest by priority. Insertion sort to keep the original order*/
+    uint16_t cnt = 0;
+    uint16_t i;
+    for(i = 0; i < disp_refr->inv_p; i++) {
+        if(disp_refr->inv_area_joined[i]) continue;
+
+        lv_area_t a = areas[i];
+        lv_refr_prio_t p = prios[i];
+        uint16_t j = cnt;
+        while(j > 0 && prios[j - 1] < p) {
+            areas[j] = areas[j - 1];
+            prios[j] = prios[j - 1];
+            j--;
+        }
+        areas[j] = a;
+        prios[j] = p;
+        cnt++;
+    }
+    lv_memset_00(disp_refr->inv_area_joined, sizeof(disp_refr->inv_area_joined));
+    disp_refr->inv_p = cnt;
+
+    /*No estimation yet*/
+    if(refr_budget.cost_px == 0) return;
+
+    uint64_t elaps = REFR_BUDGET_TIME_US() - start;
+    uint32_t budget = elaps < LV_REFR_BUDGET_MS * 1000 ? (uint32_t)(LV_REFR_BUDGET_MS * 1000 - elaps) : 0;
+    uint32_t cost_sum = 0;
+    uint16_t keep_cnt = 0;
+    bool defer = false;
+    for(i = 0; i < cnt; i++) {
+        uint32_t cost = refr_budget_cost(&areas[i]);
+
+        /*Always draw something and once an area is deferred defer the lower priority ones too*/
+        if(!defer && (prios[i] == LV_REFR_PRIO_HIGH || keep_cnt == 0 || cost_sum + cost <= budget)) {
+            cost_sum += cost;
+            areas[keep_cnt] = areas[i];
+            prios[keep_cnt] = prios[i];
+            keep_cnt++;
+        }
+        else {
+            defer = true;
+            /*Raise the priority so an area is not deferred forever*/
+            refr_budget.defer_areas[refr_budget.defer_cnt] = areas[i];
+            refr_budget.defer_prio[refr_budget.defer_cnt] = prios[i] + 1;
+            refr_budget.defer_cnt++;
+            refr_budget.stats.deferred_areas++;
+            refr_budget.stats.deferred_px += lv_area_get_size(&areas[i]);
+        }
+    }
+    disp_refr->inv_p = keep_cnt;
+}
+
+/**
+ * Update the statistics and the cost estimation after a refresh
+ * @param frame_time    time of the whole refresh [ms]
+ * @param render_time   time of rendering the areas without waiting for the display [us]
+ */
+static void refr_budget_update(uint32_t frame_time, uint32_t render_time)
+{
+    lv_refr_budget_stats_t * stats = &refr_budget.stats;
+    stats->frames++;
+    stats->last_time = frame_time;
+    stats->sum_time += frame_time;
+    if(frame_time > stats->max_time) stats->max_time = frame_time;
+    if(frame_time > LV_REFR_BUDGET_MS) stats->over_budget++;
+
+    /*Accumulate the refreshes and forget the old ones slowly to smooth out the noise*/
+    refr_budget.cost_time += render_time;
+    refr_budget.cost_px += px_num;
+    if(refr_budget.cost_px > 4 * 1024 * 1024) {
+        refr_budget.cost_time /= 2;
+        refr_budget.cost_px /= 2;
+    }
+}
+
+/**
+ * Invalidate the areas deferred by `refr_budget_plan()` again
+ */
+static void refr_budget_restore(void)
+{
+    uint16_t i;
+    for(i = 0; i < refr_budget.defer_cnt; i++) {
+        _lv_inv_area_prio(disp_refr, &refr_budget.defer_areas[i], refr_budget.defer_prio[i]);
+    }
+    refr_budget.defer_cnt = 0;
+}
+#endif /*LV_USE_REFR_BUDGET*/
+
 /**
  * Refresh the sync areas
  */
@@ -706,9 +967,15 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx)
     bool full_sized = draw_buf->size == (uint32_t)disp_refr->driver->hor_res * disp_refr->driver->ver_res;
     if((draw_buf->buf1 && !draw_buf->buf2) ||
        (draw_buf->buf1 && draw_buf->buf2 && full_sized)) {
+#if LV_USE_REFR_BUDGET
+        uint64_t wait_start = REFR_BUDGET_TIME_US();
+#endif
         while(draw_buf->flushing) {
             if(disp_refr->driver->wait_cb) disp_refr->driver->wait_cb(disp_refr->driver);
         }
+#if LV_USE_REFR_BUDGET
+        refr_budget.wait_time += (uint32_t)(REFR_BUDGET_TIME_US() - wait_start);
+#endif
 
         /*If the screen is transparent initialize it when the flushing is ready*/
 #if LV_COLOR_SCREEN_TRANSP
@@ -1046,6 +1313,150 @@ void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
     }
 }
 
+static void obj_draw_main(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
+{
+    lv_event_send(obj, LV_EVENT_DRAW_MAIN_BEGIN, draw_ctx);
+    lv_event_send(obj, LV_EVENT_DRAW_MAIN, draw_ctx);
+    lv_event_send(obj, LV_EVENT_DRAW_MAIN_END, draw_ctx);
+}
+
+#if LV_USE_OCCLUSION_CULLING
+
+/**
+ * Subtract an area from a list of disjoint areas.
+ * @param rects     the list of areas, updated in place
+ * @param rect_cnt  number of areas in the list, updated in place
+ * @param cut       the area to subtract
+ * @return          false if the result doesn't fit into `LV_OCCLUSION_CULLING_MAX_RECTS` areas.
+ *                  In this case the list is not changed.
+ */
+static bool occlusion_subtract(lv_area_t * rects, uint32_t * rect_cnt, const lv_area_t * cut)
+{
+    lv_area_t res[LV_OCCLUSION_CULLING_MAX_RECTS];
+    uint32_t res_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < *rect_cnt; i++) {
+        const lv_area_t * r = &rects[i];
+        lv_area_t com;
+        if(!_lv_area_intersect(&com, r, cut)) {
+            if(res_cnt >= LV_OCCLUSION_CULLING_MAX_RECTS) return false;
+            res[res_cnt++] = *r;
+            continue;
+        }
+
+        /*Split the remaining part into up to 4 areas: top, bottom, left and right of the common part*/
+        lv_area_t parts[4];
+        uint32_t part_cnt = 0;
+        if(r->y1 < com.y1) lv_area_set(&parts[part_cnt++], r->x1, r->y1, r->x2, com.y1 - 1);
+        if(r->y2 > com.y2) lv_area_set(&parts[part_cnt++], r->x1, com.y2 + 1, r->x2, r->y2);
+        if(r->x1 < com.x1) lv_area_set(&parts[part_cnt++], r->x1, com.y1, com.x1 - 1, com.y2);
+        if(r->x2 > com.x2) lv_area_set(&parts[part_cnt++], com.x2 + 1, com.y1, r->x2, com.y2);
+
+        if(res_cnt + part_cnt > LV_OCCLUSION_CULLING_MAX_RECTS) return false;
+        uint32_t j;
+        for(j = 0; j < part_cnt; j++) res[res_cnt++] = parts[j];
+    }
+
+    lv_memcpy_small(rects, res, res_cnt * sizeof(lv_area_t));
+    *rect_cnt = res_cnt;
+    return true;
+}
+
+/**
+ * Get an area of an object which is surely covered if the object reports cover.
+ * With radius the rounded corners are excluded by taking the larger of the
+ * vertical and horizontal bands of the cross shape without the corners.
+ * @param obj       pointer to an object
+ * @param band      store the area here
+ * @return          false if there is no such area
+ */
+static bool occlusion_get_cover_band(lv_obj_t * obj, lv_area_t * band)
+{
+    const lv_area_t * c = &obj->coords;
+    lv_coord_t w = lv_area_get_width(c);
+    lv_coord_t h = lv_area_get_height(c);
+    lv_coord_t r = lv_obj_get_style_radius(obj, LV_PART_MAIN);
+    if(r > LV_MIN(w, h) / 2) r = LV_MIN(w, h) / 2;
+
+    if(r <= 0) {
+        *band = *c;
+        return true;
+    }
+
+    /*+1 to be out of the corner area of `_lv_area_is_point_on`*/
+    r++;
+    if(w - 2 * r <= 0 && h - 2 * r <= 0) return false;
+
+    /*Take the band with the larger area, using both would fragment the visible area a lot*/
+    if((int32_t)(w - 2 * r) * h >= (int32_t)(h - 2 * r) * w) lv_area_set(band, c->x1 + r, c->y1, c->x2 - r, c->y2);
+    else lv_area_set(band, c->x1, c->y1 + r, c->x2, c->y2 - r);
+    return true;
+}
+
+/**
+ * Draw the main part only on the parts of the clip area which are not covered by opaque children.
+ * The children are drawn later anyway, so the covered parts would be overwritten.
+ * `LV_EVENT_DRAW_MAIN_BEGIN/END` are sent once with the whole clip area and only the widget's own
+ * `LV_EVENT_DRAW_MAIN` is repeated for each visible part. Objects with their own draw event handlers
+ * are not culled, so the handlers see each event once per refresh.
+ * @param draw_ctx  pointer to the draw context, its `clip_area` is the clip area of `obj`
+ * @param obj       pointer to an object
+ */
+static void obj_draw_main_culled(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
+{
+    const lv_area_t * clip_area = draw_ctx->clip_area;
+    uint32_t clip_size = lv_area_get_size(clip_area);
+
+    lv_area_t rects[LV_OCCLUSION_CULLING_MAX_RECTS];
+    uint32_t rect_cnt = 1;
+    rects[0] = *clip_area;
+
+    /*Children with overflow visible or masks applied by the parent might not cover what they report*/
+    /*The events of the main part would reach user handlers once per visible part*/
+    bool cull = lv_obj_get_child_cnt(obj) > 0 &&
+                !lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE) &&
+                !lv_obj_has_flag(obj, LV_OBJ_FLAG_EVENT_BUBBLE) &&
+                !lv_obj_get_style_clip_corner(obj, LV_PART_MAIN) &&
+                !_lv_obj_has_draw_main_event_cb(obj);
+
+    uint32_t i;
+    uint32_t child_cnt = lv_obj_get_child_cnt(obj);
+    for(i = 0; cull && i < child_cnt && rect_cnt > 0; i++) {
+        lv_obj_t * child = obj->spec_attr->children[i];
+        if(lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN)) continue;
+        if(_lv_obj_get_layer_type(child) != LV_LAYER_TYPE_NONE) continue;
+
+        /*The child is visible only on the parent*/
+        lv_area_t cut;
+        if(!occlusion_get_cover_band(child, &cut)) continue;
+        if(!_lv_area_intersect(&cut, &cut, &obj->coords)) continue;
+        if(!_lv_area_intersect(&cut, &cut, clip_area)) continue;
+
+        lv_cover_check_info_t info;
+        info.res = LV_COVER_RES_COVER;
+        info.area = &cut;
+        lv_event_send(child, LV_EVENT_COVER_CHECK, &info);
+        if(info.res != LV_COVER_RES_COVER) continue;
+
+        /*If the visible area would be too fragmented just don't cull this child*/
+        occlusion_subtract(rects, &rect_cnt, &cut);
+    }
+
+    uint32_t drawn = 0;
+    lv_event_send(obj, LV_EVENT_DRAW_MAIN_BEGIN, draw_ctx);
+    for(i = 0; i < rect_cnt; i++) {
+        draw_ctx->clip_area = &rects[i];
+        lv_event_send(obj, LV_EVENT_DRAW_MAIN, draw_ctx);
+        drawn += lv_area_get_size(&rects[i]);
+    }
+    draw_ctx->clip_area = clip_area;
+    lv_event_send(obj, LV_EVENT_DRAW_MAIN_END, draw_ctx);
+
+    occlusion_stats.drawn_px += drawn;
+    occlusion_stats.culled_px += clip_size - drawn;
+}
+#endif /*LV_USE_OCCLUSION_CULLING*/
+
 static uint32_t get_max_row(lv_disp_t * disp, lv_coord_t area_w, lv_coord_t area_h)
 {
     int32_t max_row = (uint32_t)disp->driver->draw_buf->size / area_w;
@@ -1272,6 +1683,11 @@ static void draw_buf_flush(lv_disp_t * disp)
     lv_draw_ctx_t * draw_ctx = disp->driver->draw_ctx;
     if(draw_ctx->wait_for_finish) draw_ctx->wait_for_finish(draw_ctx);
 
+#if LV_USE_REFR_BUDGET
+    /*From here only the display is waited for (also inside a blocking flush_cb), don't count it as rendering*/
+    uint64_t wait_start = REFR_BUDGET_TIME_US();
+#endif
+
     /* In partial double buffered mode wait until the other buffer is freed
      * and driver is ready to receive the new buffer */
     bool full_sized = draw_buf->size == (uint32_t)disp_refr->driver->hor_res * disp_refr->driver->ver_res;
@@ -1298,6 +1714,10 @@ static void draw_buf_flush(lv_disp_t * disp)
         }
     }
 
+#if LV_USE_REFR_BUDGET
+    refr_budget.wait_time += (uint32_t)(REFR_BUDGET_TIME_US() - wait_start);
+#endif
+
     /*If there are 2 buffers swap them. With direct mode swap only on the last area*/
     if(draw_buf->buf1 && draw_buf->buf2 && (!disp->driver->direct_mode || flushing_last)) {
         if(draw_buf->buf_act == draw_buf->buf1)
@@ -26,6 +26,19 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+#if LV_USE_REFR_BUDGET
+typedef struct {
+    uint32_t frames;            /**< Number of refreshes which drew something*/
+    uint32_t over_budget;       /**< Number of refreshes longer than `LV_REFR_BUDGET_MS`*/
+    uint32_t last_time;         /**< Time of the last refresh [ms]*/
+    uint32_t max_time;          /**< Time of the longest refresh [ms]*/
+    uint32_t sum_time;          /**< Sum of the refresh times [ms], `sum_time / frames` is the average*/
+    uint32_t deferred_areas;    /**< Number of areas deferred to a later refresh*/
+    uint32_t deferred_px;       /**< Number of pixels in the deferred areas*/
+    uint32_t px_cost_ns;        /**< Estimated time to render a pixel, without waiting for the display [ns]*/
+} lv_refr_budget_stats_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -71,6 +84,16 @@ void lv_obj_redraw(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj);
  */
 void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p);
 
+/**
+ * Invalidate an area on display to redraw it with a given priority.
+ * With `LV_USE_REFR_BUDGET` lower priority areas are drawn in a later refresh if the time budget is exceeded.
+ * @param disp pointer to display where the area should be invalidated (NULL can be used if there is
+ * only one display)
+ * @param area_p pointer to area which should be invalidated (NULL: delete the invalidated areas)
+ * @param prio `LV_REFR_PRIO_LOW/MID/HIGH`
+ */
+void _lv_inv_area_prio(lv_disp_t * disp, const lv_area_t * area_p, lv_refr_prio_t prio);
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
@@ -98,6 +121,34 @@ void lv_refr_reset_fps_counter(void);
 uint32_t lv_refr_get_fps_avg(void);
 #endif
 
+#if LV_USE_OCCLUSION_CULLING
+/**
+ * Get the number of pixels drawn and skipped by occlusion culling since the last reset.
+ * Only the main draw of objects is counted.
+ * @param drawn_px  store the number of drawn pixels here (can be NULL)
+ * @param culled_px store the number of pixels covered by opaque children and not drawn here (can be NULL)
+ */
+void lv_refr_get_occlusion_stats(uint32_t * drawn_px, uint32_t * culled_px);
+
+/**
+ * Reset the occlusion culling counters
+ */
+void lv_refr_reset_occlusion_stats(void);
+#endif
+
+#if LV_USE_REFR_BUDGET
+/**
+ * Get the refresh time and deferral statistics since the last reset
+ * @param stats     store the statistics here
+ */
+void lv_refr_get_budget_stats(lv_refr_budget_stats_t * stats);
+
+/**
+ * Reset the refresh budget statistics. The cost estimation is kept.
+ */
+void lv_refr_reset_budget_stats(void);
+#endif
+
 /**
  * Called periodically to handle the refreshing
  * @param timer pointer to the timer itself
@@ -34,6 +34,10 @@ typedef struct {
 
     /** Fill an area of the destination buffer with a color*/
     void (*blend)(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc);
+
+    /** `blend` waits for its own unfinished operations where they overlap the area it draws,
+     * so `wait_for_finish` is not called before every blend*/
+    uint8_t blend_waits : 1;
 } lv_draw_sw_ctx_t;
 
 typedef struct {
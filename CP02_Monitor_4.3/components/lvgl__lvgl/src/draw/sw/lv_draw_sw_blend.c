@@ -100,9 +100,10 @@ void lv_draw_sw_blend(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * d
     lv_area_t blend_area;
     if(!_lv_area_intersect(&blend_area, dsc->blend_area, draw_ctx->clip_area)) return;
 
-    if(draw_ctx->wait_for_finish) draw_ctx->wait_for_finish(draw_ctx);
+    lv_draw_sw_ctx_t * sw_ctx = (lv_draw_sw_ctx_t *)draw_ctx;
+    if(draw_ctx->wait_for_finish && !sw_ctx->blend_waits) draw_ctx->wait_for_finish(draw_ctx);
 
-    ((lv_draw_sw_ctx_t *)draw_ctx)->blend(draw_ctx, dsc);
+    sw_ctx->blend(draw_ctx, dsc);
 }
 
 void LV_ATTRIBUTE_FAST_MEM lv_draw_sw_blend_basic(lv_draw_ctx_t * draw_ctx,
@@ -45,6 +45,16 @@ struct _lv_disp_t;
 struct _lv_disp_drv_t;
 struct _lv_theme_t;
 
+/**
+ * Priority of an invalidated area. Used by `LV_USE_REFR_BUDGET` to decide what to draw first.
+ */
+enum {
+    LV_REFR_PRIO_LOW,   /**< Decorations, can be deferred first*/
+    LV_REFR_PRIO_MID,   /**< Default, e.g. values*/
+    LV_REFR_PRIO_HIGH,  /**< Feedback to user input, never deferred*/
+};
+typedef uint8_t lv_refr_prio_t;
+
 /**
  * Structure for holding display buffer information.
  */
@@ -136,6 +146,11 @@ typedef struct _lv_disp_drv_t {
     /** OPTIONAL: called when start rendering */
     void (*render_start_cb)(struct _lv_disp_drv_t * disp_drv);
 
+#if LV_USE_REFR_BUDGET
+    /** OPTIONAL: Get the priority of the area invalidated by an object. `LV_REFR_PRIO_MID` is used if not set*/
+    lv_refr_prio_t (*refr_prio_cb)(struct _lv_disp_drv_t * disp_drv, const struct _lv_obj_t * obj);
+#endif
+
     /** On CHROMA_KEYED images this color will be transparent.
      * `LV_COLOR_CHROMA_KEY` by default. (lv_conf.h)*/
     lv_color_t color_chroma_key;
@@ -184,6 +199,9 @@ typedef struct _lv_disp_t {
     /** Invalidated (marked to redraw) areas*/
     lv_area_t inv_areas[LV_INV_BUF_SIZE];
     uint8_t inv_area_joined[LV_INV_BUF_SIZE];
+#if LV_USE_REFR_BUDGET
+    lv_refr_prio_t inv_area_prio[LV_INV_BUF_SIZE];
+#endif
     uint16_t inv_p;
     int32_t inv_en_cnt;
 
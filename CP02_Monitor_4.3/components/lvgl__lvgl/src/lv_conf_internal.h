@@ -256,6 +256,8 @@
     /*If using lvgl as ESP32 component*/
     // #define LV_TICK_CUSTOM_INCLUDE "esp_timer.h"
     // #define LV_TICK_CUSTOM_SYS_TIME_EXPR ((esp_timer_get_time() / 1000LL))
+    /*Optional separate time source for the animations, e.g. a clock latched at each displayed frame*/
+    // #define LV_ANIM_TIME_CUSTOM_EXPR (ui_clock_ms())
 #endif   /*LV_TICK_CUSTOM*/
 
 /*Default Dot Per Inch. Used to initialize default sizes such as widgets sized, style paddings.
@@ -796,6 +798,54 @@
     #endif
 #endif
 
+/*1: Don't draw the parts of an object which are covered by opaque children*/
+#ifndef LV_USE_OCCLUSION_CULLING
+    #ifdef CONFIG_LV_USE_OCCLUSION_CULLING
+        #define LV_USE_OCCLUSION_CULLING CONFIG_LV_USE_OCCLUSION_CULLING
+    #else
+        #define LV_USE_OCCLUSION_CULLING 0
+    #endif
+#endif
+#if LV_USE_OCCLUSION_CULLING
+    /*Max. number of visible areas an object's clip area can be split into. Above it the whole area is drawn*/
+    #ifndef LV_OCCLUSION_CULLING_MAX_RECTS
+        #ifdef CONFIG_LV_OCCLUSION_CULLING_MAX_RECTS
+            #define LV_OCCLUSION_CULLING_MAX_RECTS CONFIG_LV_OCCLUSION_CULLING_MAX_RECTS
+        #else
+            #define LV_OCCLUSION_CULLING_MAX_RECTS 8
+        #endif
+    #endif
+#endif
+
+/*1: Limit the time of a refresh. Areas invalidated with lower priority are deferred to the next refresh if needed*/
+#ifndef LV_USE_REFR_BUDGET
+    #ifdef CONFIG_LV_USE_REFR_BUDGET
+        #define LV_USE_REFR_BUDGET CONFIG_LV_USE_REFR_BUDGET
+    #else
+        #define LV_USE_REFR_BUDGET 0
+    #endif
+#endif
+#if LV_USE_REFR_BUDGET
+    /*Time budget of a refresh [ms]. Areas with `LV_REFR_PRIO_HIGH` are always drawn*/
+    #ifndef LV_REFR_BUDGET_MS
+        #ifdef CONFIG_LV_REFR_BUDGET_MS
+            #define LV_REFR_BUDGET_MS CONFIG_LV_REFR_BUDGET_MS
+        #else
+            #define LV_REFR_BUDGET_MS LV_DISP_DEF_REFR_PERIOD
+        #endif
+    #endif
+
+    /*Microsecond clock to time the rendering. If not set `lv_tick` is used which can be too coarse*/
+    #ifndef LV_REFR_BUDGET_TIME_INCLUDE
+        #ifdef CONFIG_LV_REFR_BUDGET_TIME_INCLUDE
+            #define LV_REFR_BUDGET_TIME_INCLUDE CONFIG_LV_REFR_BUDGET_TIME_INCLUDE
+        #else
+            #define LV_REFR_BUDGET_TIME_INCLUDE "esp_timer.h"
+        #endif
+    #endif
+    // #define LV_REFR_BUDGET_TIME_US_EXPR (esp_timer_get_time())
+#endif
+
 /*Change the built in (v)snprintf functions*/
 #ifndef LV_SPRINTF_CUSTOM
     #ifdef CONFIG_LV_SPRINTF_CUSTOM
@@ -14,6 +14,9 @@
 #include "lv_math.h"
 #include "lv_mem.h"
 #include "lv_gc.h"
+#if LV_TICK_CUSTOM && defined(LV_ANIM_TIME_CUSTOM_EXPR)
+    #include LV_TICK_CUSTOM_INCLUDE
+#endif
 
 /*********************
  *      DEFINES
@@ -21,6 +24,14 @@
 #define LV_ANIM_RESOLUTION 1024
 #define LV_ANIM_RES_SHIFT 10
 
+/*Animations can run on their own clock (e.g. one latched at the start of each displayed frame)
+ *while the timers keep using the real tick*/
+#if LV_TICK_CUSTOM && defined(LV_ANIM_TIME_CUSTOM_EXPR)
+    #define ANIM_TIME_GET() ((uint32_t)(LV_ANIM_TIME_CUSTOM_EXPR))
+#else
+    #define ANIM_TIME_GET() lv_tick_get()
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -81,7 +92,7 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
 
     /*If the list is empty the anim timer was suspended and it's last run measure is invalid*/
     if(_lv_ll_is_empty(&LV_GC_ROOT(_lv_anim_ll))) {
-        last_timer_run = lv_tick_get();
+        last_timer_run = ANIM_TIME_GET();
     }
 
     /*Add the new animation to the animation linked list*/
@@ -350,7 +361,7 @@ static void anim_timer(lv_timer_t * param)
 {
     LV_UNUSED(param);
 
-    uint32_t elaps = lv_tick_elaps(last_timer_run);
+    uint32_t elaps = ANIM_TIME_GET() - last_timer_run;
 
     /*Flip the run round*/
     anim_run_round = anim_run_round ? false : true;
@@ -406,7 +417,7 @@ static void anim_timer(lv_timer_t * param)
             a = _lv_ll_get_next(&LV_GC_ROOT(_lv_anim_ll), a);
     }
 
-    last_timer_run = lv_tick_get();
+    last_timer_run = ANIM_TIME_GET();
 }
 
 /**
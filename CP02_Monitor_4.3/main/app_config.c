@@ -0,0 +1,171 @@
+/**
+ * @file     app_config.c
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    Application Config Module Implementation
+ */
+
+#include "app_config.h"
+#include <string.h>
+#include "esp_log.h"
+#include "nvs.h"
+
+static const char *TAG = "APP_CONFIG";
+
+#define CONFIG_NVS_NAMESPACE    "app_config"
+#define CONFIG_NVS_URL_KEY      "metrics_url"
+#define CONFIG_NVS_REFRESH_KEY  "refresh_ms"
+#define MAX_SUBSCRIBERS         8
+
+// 默认值定义在main.c中
+extern const char DATA_URL[128];
+extern const int REFRESH_INTERVAL;
+
+typedef struct {
+    uint32_t items;
+    app_config_cb_t cb;
+} subscriber_t;
+
+static app_config_t config;
+static subscriber_t subscribers[MAX_SUBSCRIBERS];
+static int subscriber_count = 0;
+
+static void notify(uint32_t changed)
+{
+    for (int i = 0; i < subscriber_count; i++) {
+        uint32_t hit = subscribers[i].items & changed;
+        if (hit != 0) {
+            subscribers[i].cb(hit, &config);
+        }
+    }
+}
+
+static esp_err_t save_str(const char *key, const char *value)
+{
+    nvs_handle_t nvs_handle;
+    esp_err_t err = nvs_open(CONFIG_NVS_NAMESPACE, NVS_READWRITE, &nvs_handle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "打开NVS失败: %s", esp_err_to_name(err));
+        return err;
+    }
+    err = nvs_set_str(nvs_handle, key, value);
+    if (err == ESP_OK) {
+        err = nvs_commit(nvs_handle);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "保存 %s 失败: %s", key, esp_err_to_name(err));
+    }
+    nvs_close(nvs_handle);
+    return err;
+}
+
+static esp_err_t save_u32(const char *key, uint32_t value)
+{
+    nvs_handle_t nvs_handle;
+    esp_err_t err = nvs_open(CONFIG_NVS_NAMESPACE, NVS_READWRITE, &nvs_handle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "打开NVS失败: %s", esp_err_to_name(err));
+        return err;
+    }
+    err = nvs_set_u32(nvs_handle, key, value);
+    if (err == ESP_OK) {
+        err = nvs_commit(nvs_handle);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "保存 %s 失败: %s", key, esp_err_to_name(err));
+    }
+    nvs_close(nvs_handle);
+    return err;
+}
+
+esp_err_t app_config_init(void)
+{
+    strlcpy(config.metrics_url, DATA_URL, sizeof(config.metrics_url));
+    config.refresh_ms = REFRESH_INTERVAL;
+
+    nvs_handle_t nvs_handle;
+    if (nvs_open(CONFIG_NVS_NAMESPACE, NVS_READONLY, &nvs_handle) == ESP_OK) {
+        size_t len = sizeof(config.metrics_url);
+        if (nvs_get_str(nvs_handle, CONFIG_NVS_URL_KEY, config.metrics_url, &len) != ESP_OK) {
+            strlcpy(config.metrics_url, DATA_URL, sizeof(config.metrics_url));
+        }
+        uint32_t refresh_ms;
+        if (nvs_get_u32(nvs_handle, CONFIG_NVS_REFRESH_KEY, &refresh_ms) == ESP_OK &&
+            refresh_ms >= APP_CONFIG_MIN_REFRESH) {
+            config.refresh_ms = refresh_ms;
+        }
+        nvs_close(nvs_handle);
+    }
+
+    ESP_LOGI(TAG, "数据地址: %s, 刷新间隔: %lu ms", config.metrics_url, (unsigned long)config.refresh_ms);
+    return ESP_OK;
+}
+
+const app_config_t *app_config_get(void)
+{
+    return &config;
+}
+
+esp_err_t app_config_subscribe(uint32_t items, app_config_cb_t cb)
+{
+    if (cb == NULL || subscriber_count >= MAX_SUBSCRIBERS) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    subscribers[subscriber_count].items = items;
+    subscribers[subscriber_count].cb = cb;
+    subscriber_count++;
+    return ESP_OK;
+}
+
+esp_err_t app_config_set_metrics_url(const char *url)
+{
+    if (url == NULL || url[0] == '\0' || strlen(url) >= sizeof(config.metrics_url)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (strcmp(url, config.metrics_url) == 0) {
+        return ESP_OK;
+    }
+
+    esp_err_t err = save_str(CONFIG_NVS_URL_KEY, url);
+    if (err != ESP_OK) {
+        return err;
+    }
+    strlcpy(config.metrics_url, url, sizeof(config.metrics_url));
+    ESP_LOGI(TAG, "数据地址改为: %s", config.metrics_url);
+    notify(APP_CONFIG_METRICS_URL);
+    return ESP_OK;
+}
+
+esp_err_t app_config_set_refresh_ms(uint32_t refresh_ms)
+{
+    if (refresh_ms < APP_CONFIG_MIN_REFRESH) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (refresh_ms == config.refresh_ms) {
+        return ESP_OK;
+    }
+
+    esp_err_t err = save_u32(CONFIG_NVS_REFRESH_KEY, refresh_ms);
+    if (err != ESP_OK) {
+        return err;
+    }
+    config.refresh_ms = refresh_ms;
+    ESP_LOGI(TAG, "刷新间隔改为: %lu ms", (unsigned long)refresh_ms);
+    notify(APP_CONFIG_REFRESH);
+    return ESP_OK;
+}
+
+esp_err_t app_config_set_wifi(const char *ssid, const char *password)
+{
+    if (ssid == NULL || ssid[0] == '\0' || strlen(ssid) >= sizeof(config.wifi_ssid) ||
+        password == NULL || strlen(password) >= sizeof(config.wifi_password)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // 由订阅者在连接成功后保存，这里每次都通知，重新输入同一个网络也会重连
+    strlcpy(config.wifi_ssid, ssid, sizeof(config.wifi_ssid));
+    strlcpy(config.wifi_password, password, sizeof(config.wifi_password));
+    notify(APP_CONFIG_WIFI);
+    return ESP_OK;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file     app_config.h
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    Application Config Module Header
+ *
+ * 应用配置和修改通知。设置页面修改配置后调用app_config_set_*()，本模块
+ * 保存到NVS并通知订阅了对应配置项的模块，由它们各自在运行中生效：
+ * 数据地址在下一次采集时换用，刷新间隔直接修改定时器周期，WiFi在后台
+ * 切换，新网络连上之前保持原来的连接。修改配置不需要重启。
+ *
+ * WiFi名称和密码由wifi_manager在新网络连上之后保存，本模块只转发请求。
+ */
+
+#ifndef APP_CONFIG_H
+#define APP_CONFIG_H
+
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 配置项，按位组合
+#define APP_CONFIG_WIFI         (1U << 0)   // WiFi名称和密码
+#define APP_CONFIG_METRICS_URL  (1U << 1)   // 小电拼数据地址
+#define APP_CONFIG_REFRESH      (1U << 2)   // 数据刷新间隔
+
+#define APP_CONFIG_URL_LEN      128
+#define APP_CONFIG_MIN_REFRESH  500         // 最小刷新间隔 (ms)
+
+typedef struct {
+    char metrics_url[APP_CONFIG_URL_LEN];
+    uint32_t refresh_ms;
+    // 最近一次请求的WiFi设置，只在APP_CONFIG_WIFI通知中有效
+    char wifi_ssid[33];
+    char wifi_password[65];
+} app_config_t;
+
+// 配置修改回调，changed是本次修改的配置项中订阅了的部分
+typedef void (*app_config_cb_t)(uint32_t changed, const app_config_t *config);
+
+// 从NVS加载配置，需要在NVS初始化之后调用
+esp_err_t app_config_init(void);
+
+// 当前配置
+const app_config_t *app_config_get(void);
+
+// 订阅配置项，可以在app_config_init()之前调用
+esp_err_t app_config_subscribe(uint32_t items, app_config_cb_t cb);
+
+/**
+ * @brief 修改配置
+ *
+ * 保存后在调用者的上下文中依次通知订阅者，需要持有LVGL锁。
+ * 值没有变化时不保存也不通知。
+ */
+esp_err_t app_config_set_metrics_url(const char *url);
+esp_err_t app_config_set_refresh_ms(uint32_t refresh_ms);
+esp_err_t app_config_set_wifi(const char *ssid, const char *password);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_CONFIG_H */
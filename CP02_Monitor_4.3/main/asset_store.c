@@ -0,0 +1,287 @@
+/**
+ * @file     asset_store.c
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    Asset Store Module Implementation
+ */
+
+#include "asset_store.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "esp_littlefs.h"
+#include "mem_tag.h"
+#include "sdkconfig.h"
+
+static const char *TAG = "ASSETS";
+
+#define ASSET_PARTITION_LABEL   "assets"
+#define ASSET_MOUNT_PATH        CONFIG_LV_FS_STDIO_PATH    // 与LVGL文件驱动的工作目录一致
+#define ASSET_MAX_PATH          96
+
+#if CONFIG_EXAMPLE_ASSETS
+
+typedef enum {
+    ASSET_IMAGE,
+    ASSET_FONT,
+} asset_kind_t;
+
+// 常驻资源，挂在单链表上，只增不删
+typedef struct asset_entry {
+    struct asset_entry *next;
+    asset_kind_t kind;
+    uint32_t bytes;             // 计入缓存的字节数，只有路径时为0
+    lv_img_dsc_t img;           // 图片：data为NULL时只记录路径
+    lv_font_t *font;
+    char path[];                // LVGL路径，例如"A:/img/logo.bin"
+} asset_entry_t;
+
+static bool mounted = false;
+static asset_entry_t *asset_list = NULL;
+static asset_store_stats_t asset_stats;
+
+esp_err_t asset_store_init(void)
+{
+    esp_vfs_littlefs_conf_t conf = {
+        .base_path = ASSET_MOUNT_PATH,
+        .partition_label = ASSET_PARTITION_LABEL,
+        .format_if_mount_failed = true,
+        .dont_mount = false,
+    };
+
+    int64_t start = esp_timer_get_time();
+    esp_err_t ret = esp_vfs_littlefs_register(&conf);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "挂载资源分区失败: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    mounted = true;
+
+    esp_littlefs_info(ASSET_PARTITION_LABEL, &asset_stats.fs_total, &asset_stats.fs_used);
+    asset_stats.cache_limit = CONFIG_EXAMPLE_ASSETS_CACHE_KB * 1024;
+    ESP_LOGI(TAG, "资源分区已挂载到 %c: (%s), 已用 %u/%u KB, 耗时 %d ms",
+             CONFIG_LV_FS_STDIO_LETTER, ASSET_MOUNT_PATH,
+             (unsigned)(asset_stats.fs_used / 1024), (unsigned)(asset_stats.fs_total / 1024),
+             (int)((esp_timer_get_time() - start) / 1000));
+    return ESP_OK;
+}
+
+bool asset_store_is_mounted(void)
+{
+    return mounted;
+}
+
+bool asset_store_exists(const char *name)
+{
+    char path[ASSET_MAX_PATH];
+    struct stat st;
+    snprintf(path, sizeof(path), ASSET_MOUNT_PATH "/%s", name);
+    return mounted && stat(path, &st) == 0;
+}
+
+esp_err_t asset_store_load(const char *name, void **data, size_t *size)
+{
+    if (!mounted) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    char path[ASSET_MAX_PATH];
+    snprintf(path, sizeof(path), ASSET_MOUNT_PATH "/%s", name);
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    int64_t start = esp_timer_get_time();
+    esp_err_t ret = ESP_OK;
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    // 整个文件一次读入，LittleFS直接按块读取，不经过stdio的小缓冲区
+    uint8_t *buf = len > 0 ? MEM_TAG_CAPS_MALLOC(MEM_TAG_ASSETS, len, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT) : NULL;
+    if (buf == NULL) {
+        ret = len > 0 ? ESP_ERR_NO_MEM : ESP_ERR_INVALID_SIZE;
+    } else if (fread(buf, 1, len, f) != (size_t)len) {
+        MEM_TAG_FREE(buf);
+        buf = NULL;
+        ret = ESP_FAIL;
+    }
+    fclose(f);
+
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "读取 %s 失败: %s", name, esp_err_to_name(ret));
+        return ret;
+    }
+
+    uint32_t us = (uint32_t)(esp_timer_get_time() - start);
+    asset_stats.misses++;
+    asset_stats.load_us_total += us;
+    if (us > asset_stats.load_us_max) {
+        asset_stats.load_us_max = us;
+    }
+    ESP_LOGD(TAG, "读取 %s: %ld 字节, %u us", name, len, (unsigned)us);
+
+    *data = buf;
+    *size = len;
+    return ESP_OK;
+}
+
+void asset_store_free(void *data)
+{
+    MEM_TAG_FREE(data);
+}
+
+static asset_entry_t *asset_find(asset_kind_t kind, const char *name)
+{
+    for (asset_entry_t *e = asset_list; e != NULL; e = e->next) {
+        // 跳过"A:/"前缀比较
+        if (e->kind == kind && strcmp(e->path + 3, name) == 0) {
+            asset_stats.hits++;
+            return e;
+        }
+    }
+    return NULL;
+}
+
+static asset_entry_t *asset_add(asset_kind_t kind, const char *name)
+{
+    size_t len = strlen(name);
+    asset_entry_t *e = MEM_TAG_CALLOC(MEM_TAG_ASSETS, 1, sizeof(asset_entry_t) + len + 4);
+    if (e == NULL) {
+        return NULL;
+    }
+    e->kind = kind;
+    snprintf(e->path, len + 4, "%c:/%s", CONFIG_LV_FS_STDIO_LETTER, name);
+    e->next = asset_list;
+    asset_list = e;
+    return e;
+}
+
+const void *asset_store_get_image(const char *name)
+{
+    asset_entry_t *e = asset_find(ASSET_IMAGE, name);
+    if (e != NULL) {
+        return e->img.data != NULL ? (const void *)&e->img : (const void *)e->path;
+    }
+    if (!asset_store_exists(name)) {
+        ESP_LOGW(TAG, "图片 %s 不存在", name);
+        return NULL;
+    }
+
+    e = asset_add(ASSET_IMAGE, name);
+    if (e == NULL) {
+        return NULL;
+    }
+
+    // 超过缓存上限的图片由LVGL绘制时从文件读取
+    void *data;
+    size_t size;
+    if (asset_store_load(name, &data, &size) != ESP_OK) {
+        return e->path;
+    }
+    if (size <= sizeof(lv_img_header_t) || asset_stats.cache_bytes + size > asset_stats.cache_limit) {
+        ESP_LOGI(TAG, "图片 %s 不常驻内存 (%u 字节)", name, (unsigned)size);
+        asset_store_free(data);
+        return e->path;
+    }
+
+    // .bin图片为4字节的图片头加像素数据
+    memcpy(&e->img.header, data, sizeof(lv_img_header_t));
+    e->img.data = (const uint8_t *)data + sizeof(lv_img_header_t);
+    e->img.data_size = size - sizeof(lv_img_header_t);
+    e->bytes = size;
+    asset_stats.cache_bytes += size;
+    return &e->img;
+}
+
+const lv_font_t *asset_store_get_font(const char *name)
+{
+    asset_entry_t *e = asset_find(ASSET_FONT, name);
+    if (e != NULL) {
+        return e->font;
+    }
+    if (!asset_store_exists(name)) {
+        ESP_LOGW(TAG, "字体 %s 不存在", name);
+        return NULL;
+    }
+
+    e = asset_add(ASSET_FONT, name);
+    if (e == NULL) {
+        return NULL;
+    }
+
+    int64_t start = esp_timer_get_time();
+    e->font = lv_font_load(e->path);
+    uint32_t us = (uint32_t)(esp_timer_get_time() - start);
+    asset_stats.misses++;
+    asset_stats.load_us_total += us;
+    if (us > asset_stats.load_us_max) {
+        asset_stats.load_us_max = us;
+    }
+
+    if (e->font == NULL) {
+        ESP_LOGW(TAG, "加载字体 %s 失败", name);
+        return NULL;
+    }
+    ESP_LOGI(TAG, "加载字体 %s, 行高 %d, 耗时 %u ms", name, e->font->line_height, (unsigned)(us / 1000));
+    return e->font;
+}
+
+void asset_store_get_stats(asset_store_stats_t *stats)
+{
+    if (mounted) {
+        esp_littlefs_info(ASSET_PARTITION_LABEL, &asset_stats.fs_total, &asset_stats.fs_used);
+    }
+    *stats = asset_stats;
+}
+
+#else /* !CONFIG_EXAMPLE_ASSETS */
+
+// 未启用资源存储时所有资源都不存在，调用方使用编译进固件的资源
+esp_err_t asset_store_init(void)
+{
+    ESP_LOGI(TAG, "资源存储未启用");
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+bool asset_store_is_mounted(void)
+{
+    return false;
+}
+
+bool asset_store_exists(const char *name)
+{
+    return false;
+}
+
+esp_err_t asset_store_load(const char *name, void **data, size_t *size)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+void asset_store_free(void *data)
+{
+}
+
+const void *asset_store_get_image(const char *name)
+{
+    return NULL;
+}
+
+const lv_font_t *asset_store_get_font(const char *name)
+{
+    return NULL;
+}
+
+void asset_store_get_stats(asset_store_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+}
+
+#endif /* CONFIG_EXAMPLE_ASSETS */
@@ -0,0 +1,83 @@
+/**
+ * @file     asset_store.h
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    Asset Store Module Header
+ *
+ * 资源存储。assets分区使用LittleFS（带磨损均衡），挂载后通过LVGL的stdio
+ * 文件驱动作为盘符访问，字体、图片和主题文件可以单独更新，不需要重新
+ * 烧录固件。读取过的图片和字体常驻在PSRAM中，总字节数有上限，超过上限
+ * 的图片改为由LVGL按需从文件读取。
+ */
+
+#ifndef ASSET_STORE_H
+#define ASSET_STORE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 统计信息
+typedef struct {
+    uint32_t hits;              // 缓存命中次数
+    uint32_t misses;            // 从文件读取的次数
+    uint32_t load_us_max;       // 单个资源的最长读取时间
+    uint64_t load_us_total;     // 读取资源的总时间
+    uint32_t cache_bytes;       // 常驻资源占用的字节数
+    uint32_t cache_limit;       // 常驻资源字节数上限
+    size_t fs_total;            // 分区总字节数
+    size_t fs_used;             // 分区已用字节数
+} asset_store_stats_t;
+
+/**
+ * @brief 挂载资源分区
+ *
+ * 需要在lv_init之后调用。分区无法挂载时会格式化。
+ */
+esp_err_t asset_store_init(void);
+
+// 资源分区是否已挂载
+bool asset_store_is_mounted(void);
+
+// 资源文件是否存在，name为相对资源目录的路径，例如"img/logo.bin"
+bool asset_store_exists(const char *name);
+
+/**
+ * @brief 把整个资源文件读入PSRAM
+ *
+ * 不经过缓存，用完后用asset_store_free释放。用于主题等只读一次的文件。
+ */
+esp_err_t asset_store_load(const char *name, void **data, size_t *size);
+
+void asset_store_free(void *data);
+
+/**
+ * @brief 获取图片，返回值可直接传给lv_img_set_src
+ *
+ * 文件为LVGL转换工具生成的.bin格式。第一次读取后常驻PSRAM；超过缓存
+ * 上限时返回文件路径，由LVGL绘制时从文件读取。文件不存在时返回NULL。
+ */
+const void *asset_store_get_image(const char *name);
+
+/**
+ * @brief 获取字体
+ *
+ * 文件为lv_font_conv生成的.bin格式，第一次读取后常驻内存。失败时返回NULL。
+ */
+const lv_font_t *asset_store_get_font(const char *name);
+
+// 获取统计信息
+void asset_store_get_stats(asset_store_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ASSET_STORE_H */
@@ -0,0 +1,318 @@
+/**
+ * @file     font_manager.c
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    Font Manager Module Implementation
+ */
+
+#include "font_manager.h"
+#include <string.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "esp_partition.h"
+#include "mem_tag.h"
+#include "sdkconfig.h"
+#include "src/misc/lv_lru.h"
+
+static const char *TAG = "FONT";
+
+#if CONFIG_EXAMPLE_FONT_TTF
+
+#define FONT_PARTITION_NAME     "fonts"
+#define FONT_PARTITION_SUBTYPE  0x40    // 自定义数据分区子类型
+#define FONT_MAX_SIZES          4       // 最多同时使用的字号数
+#define FONT_TTF_CACHE_GLYPHS   4       // tiny_ttf自身的缓存只需要放下刚渲染的几个字形
+#define FONT_GLYPH_AVG_BYTES    512     // 估计的平均字形大小，用于确定哈希表大小
+
+// 缓存的字形：字形描述和8bpp位图放在同一块PSRAM里
+typedef struct {
+    uint16_t adv_w;
+    uint16_t box_w;
+    uint16_t box_h;
+    int16_t ofs_x;
+    int16_t ofs_y;
+    uint8_t bitmap[];
+} font_glyph_t;
+
+typedef struct {
+    uint32_t letter;
+    uint32_t size;
+} font_glyph_key_t;
+
+// 每个字号一个实例，lv_font_t必须是第一个成员
+typedef struct {
+    lv_font_t font;             // 交给LVGL使用的字体
+    lv_font_t *ttf;             // tiny_ttf字体，只在缓存未命中时使用
+    uint16_t size;
+    uint32_t last_letter;       // LVGL取完字形描述后紧接着取位图，记住上一次查找
+    font_glyph_t *last_glyph;
+} font_slot_t;
+
+static const uint8_t *font_data = NULL;
+static size_t font_data_size = 0;
+static esp_partition_mmap_handle_t font_mmap_handle;
+static lv_lru_t *glyph_cache = NULL;
+static font_slot_t font_slots[FONT_MAX_SIZES];
+static uint8_t font_slot_cnt = 0;
+static font_manager_stats_t font_stats;
+
+static void glyph_free(void *glyph)
+{
+    MEM_TAG_FREE(glyph);
+}
+
+// 渲染一个字形并放入缓存
+static font_glyph_t *glyph_render(font_slot_t *slot, uint32_t letter)
+{
+    int64_t start = esp_timer_get_time();
+
+    lv_font_glyph_dsc_t dsc;
+    if (!slot->ttf->get_glyph_dsc(slot->ttf, &dsc, letter, 0)) {
+        return NULL; // 字体中没有该字，由LVGL使用后备字体
+    }
+
+    size_t bitmap_size = (size_t)dsc.box_w * dsc.box_h;
+    const uint8_t *bitmap = NULL;
+    if (bitmap_size > 0) {
+        bitmap = slot->ttf->get_glyph_bitmap(slot->ttf, letter);
+        if (bitmap == NULL) {
+            return NULL;
+        }
+    }
+
+    size_t glyph_size = sizeof(font_glyph_t) + bitmap_size;
+    font_glyph_t *glyph = MEM_TAG_CAPS_MALLOC(MEM_TAG_FONT, glyph_size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (glyph == NULL) {
+        ESP_LOGW(TAG, "字形缓存内存不足");
+        return NULL;
+    }
+    glyph->adv_w = dsc.adv_w;
+    glyph->box_w = dsc.box_w;
+    glyph->box_h = dsc.box_h;
+    glyph->ofs_x = dsc.ofs_x;
+    glyph->ofs_y = dsc.ofs_y;
+    if (bitmap_size > 0) {
+        memcpy(glyph->bitmap, bitmap, bitmap_size);
+    }
+
+    // 插入可能淘汰其他字形，清除所有字号记住的查找结果
+    for (int i = 0; i < font_slot_cnt; i++) {
+        font_slots[i].last_glyph = NULL;
+    }
+
+    font_glyph_key_t key = {
+        .letter = letter,
+        .size = slot->size,
+    };
+    if (lv_lru_set(glyph_cache, &key, sizeof(key), glyph, glyph_size) != LV_LRU_OK) {
+        MEM_TAG_FREE(glyph);
+        return NULL;
+    }
+
+    uint32_t render_us = (uint32_t)(esp_timer_get_time() - start);
+    font_stats.misses++;
+    font_stats.render_us_total += render_us;
+    if (render_us > font_stats.render_us_max) {
+        font_stats.render_us_max = render_us;
+    }
+    return glyph;
+}
+
+static font_glyph_t *glyph_lookup(font_slot_t *slot, uint32_t letter)
+{
+    if (slot->last_glyph != NULL && slot->last_letter == letter) {
+        font_stats.hits++;
+        return slot->last_glyph;
+    }
+
+    font_glyph_key_t key = {
+        .letter = letter,
+        .size = slot->size,
+    };
+    font_glyph_t *glyph = NULL;
+    lv_lru_get(glyph_cache, &key, sizeof(key), (void **)&glyph);
+    if (glyph != NULL) {
+        font_stats.hits++;
+    } else {
+        glyph = glyph_render(slot, letter);
+        if (glyph == NULL) {
+            return NULL;
+        }
+    }
+
+    slot->last_letter = letter;
+    slot->last_glyph = glyph;
+    return glyph;
+}
+
+// 子集字体不含字距表，字形描述与后一个字无关，可以和位图一起缓存
+static bool font_get_glyph_dsc(const lv_font_t *font, lv_font_glyph_dsc_t *dsc_out, uint32_t letter,
+                               uint32_t letter_next)
+{
+    font_slot_t *slot = (font_slot_t *)font;
+
+    // 控制字符由tiny_ttf处理为空字形
+    if (letter < 0x20) {
+        return slot->ttf->get_glyph_dsc(slot->ttf, dsc_out, letter, letter_next);
+    }
+
+    font_glyph_t *glyph = glyph_lookup(slot, letter);
+    if (glyph == NULL) {
+        return false;
+    }
+    dsc_out->adv_w = glyph->adv_w;
+    dsc_out->box_w = glyph->box_w;
+    dsc_out->box_h = glyph->box_h;
+    dsc_out->ofs_x = glyph->ofs_x;
+    dsc_out->ofs_y = glyph->ofs_y;
+    dsc_out->bpp = 8;
+    dsc_out->is_placeholder = false;
+    return true;
+}
+
+static const uint8_t *font_get_glyph_bitmap(const lv_font_t *font, uint32_t letter)
+{
+    font_glyph_t *glyph = glyph_lookup((font_slot_t *)font, letter);
+    return glyph ? glyph->bitmap : NULL;
+}
+
+static font_slot_t *font_create(uint16_t size)
+{
+    if (font_slot_cnt >= FONT_MAX_SIZES) {
+        return NULL;
+    }
+
+    lv_font_t *ttf = lv_tiny_ttf_create_data_ex(font_data, font_data_size, size,
+                                                (size_t)size * size * FONT_TTF_CACHE_GLYPHS);
+    if (ttf == NULL) {
+        return NULL;
+    }
+
+    font_slot_t *slot = &font_slots[font_slot_cnt++];
+    memset(slot, 0, sizeof(*slot));
+    slot->ttf = ttf;
+    slot->size = size;
+    slot->font.get_glyph_dsc = font_get_glyph_dsc;
+    slot->font.get_glyph_bitmap = font_get_glyph_bitmap;
+    slot->font.line_height = ttf->line_height;
+    slot->font.base_line = ttf->base_line;
+    slot->font.fallback = LV_FONT_DEFAULT; // 图标等字体中没有的字符
+    ESP_LOGI(TAG, "创建%d号字体", size);
+    return slot;
+}
+
+#endif /* CONFIG_EXAMPLE_FONT_TTF */
+
+static const lv_font_t *font_builtin(void)
+{
+#if CONFIG_EXAMPLE_FONT_NO_CN16
+    return LV_FONT_DEFAULT;
+#else
+    return &cn_16;
+#endif
+}
+
+esp_err_t font_manager_init(void)
+{
+#if CONFIG_EXAMPLE_FONT_TTF
+    const esp_partition_t *part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, FONT_PARTITION_SUBTYPE,
+                                                           FONT_PARTITION_NAME);
+    if (part == NULL) {
+        ESP_LOGW(TAG, "未找到字体分区，使用内置字体");
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    const void *ptr = NULL;
+    esp_err_t ret = esp_partition_mmap(part, 0, part->size, ESP_PARTITION_MMAP_DATA, &ptr, &font_mmap_handle);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "映射字体分区失败: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    // 检查TrueType/OpenType文件头，未烧录的分区全是0xFF
+    const uint8_t *p = ptr;
+    bool valid = (p[0] == 0x00 && p[1] == 0x01 && p[2] == 0x00 && p[3] == 0x00) ||
+                 memcmp(p, "OTTO", 4) == 0 || memcmp(p, "true", 4) == 0;
+    if (!valid) {
+        ESP_LOGW(TAG, "字体分区中没有TrueType字体，使用内置字体");
+        esp_partition_munmap(font_mmap_handle);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    glyph_cache = lv_lru_create(CONFIG_EXAMPLE_FONT_CACHE_KB * 1024, FONT_GLYPH_AVG_BYTES, glyph_free, NULL);
+    if (glyph_cache == NULL) {
+        ESP_LOGE(TAG, "创建字形缓存失败");
+        esp_partition_munmap(font_mmap_handle);
+        return ESP_ERR_NO_MEM;
+    }
+
+    font_data = ptr;
+    font_data_size = part->size;
+    font_stats.font_bytes = part->size;
+    font_stats.cache_limit = CONFIG_EXAMPLE_FONT_CACHE_KB * 1024;
+    ESP_LOGI(TAG, "已映射字体分区 %u KB，字形缓存 %d KB", (unsigned)(part->size / 1024), CONFIG_EXAMPLE_FONT_CACHE_KB);
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+bool font_manager_is_ttf(void)
+{
+#if CONFIG_EXAMPLE_FONT_TTF
+    return font_data != NULL;
+#else
+    return false;
+#endif
+}
+
+const lv_font_t *font_manager_get(uint16_t size)
+{
+#if CONFIG_EXAMPLE_FONT_TTF
+    if (font_data != NULL) {
+        for (int i = 0; i < font_slot_cnt; i++) {
+            if (font_slots[i].size == size) {
+                return &font_slots[i].font;
+            }
+        }
+        font_slot_t *slot = font_create(size);
+        if (slot != NULL) {
+            return &slot->font;
+        }
+        ESP_LOGW(TAG, "无法创建%d号字体，使用内置字体", size);
+    }
+#endif
+    return font_builtin();
+}
+
+void font_manager_warm_up(const lv_font_t *font, const char *text)
+{
+#if CONFIG_EXAMPLE_FONT_TTF
+    if (font_data == NULL || font == NULL || text == NULL || font->get_glyph_dsc != font_get_glyph_dsc) {
+        return;
+    }
+
+    int64_t start = esp_timer_get_time();
+    uint32_t i = 0;
+    while (text[i] != '\0') {
+        uint32_t letter = _lv_txt_encoded_next(text, &i);
+        uint32_t misses = font_stats.misses;
+        lv_font_glyph_dsc_t dsc;
+        font_get_glyph_dsc(font, &dsc, letter, 0);
+        if (font_stats.misses != misses) {
+            font_stats.warm_glyphs++;
+        }
+    }
+    font_stats.warm_ms += (uint32_t)((esp_timer_get_time() - start) / 1000);
+#endif
+}
+
+void font_manager_get_stats(font_manager_stats_t *stats)
+{
+#if CONFIG_EXAMPLE_FONT_TTF
+    font_stats.cache_bytes = glyph_cache ? (uint32_t)(glyph_cache->total_memory - glyph_cache->free_memory) : 0;
+#endif
+    *stats = font_stats;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file     font_manager.h
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    Font Manager Module Header
+ *
+ * 中文字体的统一入口。开启CONFIG_EXAMPLE_FONT_TTF时，从fonts分区映射
+ * TrueType字体，由tiny_ttf按需渲染任意字号；渲染好的字形连同字形描述
+ * 缓存在PSRAM中，总字节数有上限，按最近最少使用淘汰。
+ * 没有可用的字体分区时回退到编译进固件的cn_16。
+ */
+
+#ifndef FONT_MANAGER_H
+#define FONT_MANAGER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 统计信息
+typedef struct {
+    uint32_t hits;              // 字形缓存命中次数
+    uint32_t misses;            // 需要渲染的次数
+    uint32_t render_us_max;     // 单个字形的最长渲染时间
+    uint64_t render_us_total;   // 渲染字形的总时间
+    uint32_t cache_bytes;       // 缓存当前占用的字节数
+    uint32_t cache_limit;       // 缓存字节数上限
+    uint32_t warm_glyphs;       // 预热渲染的字形数
+    uint32_t warm_ms;           // 预热耗时
+    uint32_t font_bytes;        // 映射的字体分区大小
+} font_manager_stats_t;
+
+/**
+ * @brief 初始化字体管理器
+ *
+ * 需要在lv_init之后、持有LVGL锁时调用。找不到字体分区或分区内容
+ * 不是TrueType字体时返回错误，此时font_manager_get回退到内置字体。
+ */
+esp_err_t font_manager_init(void);
+
+// 是否正在使用TrueType字体
+bool font_manager_is_ttf(void);
+
+/**
+ * @brief 获取指定字号的中文字体
+ *
+ * 同一字号只创建一次。使用内置字体时忽略字号，总是返回cn_16。
+ */
+const lv_font_t *font_manager_get(uint16_t size);
+
+/**
+ * @brief 预先渲染一段文字中的字形
+ *
+ * 在启动时对界面上已知的文字调用，避免第一次显示时逐字渲染造成卡顿。
+ * 使用内置字体时不做任何事。
+ */
+void font_manager_warm_up(const lv_font_t *font, const char *text);
+
+// 获取统计信息
+void font_manager_get_stats(font_manager_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FONT_MANAGER_H */
@@ -0,0 +1,165 @@
+/**
+ * @file     gauge_geom.c
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    Gauge Geometry Module Implementation
+ */
+
+#include "gauge_geom.h"
+#include <math.h>
+
+#define GAUGE_PI        3.14159265358979f
+#define QUARTER_UNITS   (90 * GAUGE_GEOM_STEPS)     // 90度对应的角度单位数
+
+static float clamp01(float v)
+{
+    return v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+}
+
+// 指示位置换算成角度单位（度 * GAUGE_GEOM_STEPS），起始角已规整到0~359
+static int32_t step_units(const gauge_geom_t *geom, uint16_t step)
+{
+    return (int32_t)geom->cfg.start_deg * GAUGE_GEOM_STEPS + (int32_t)geom->cfg.sweep_deg * step;
+}
+
+size_t gauge_geom_buf_size(const gauge_geom_config_t *cfg)
+{
+    size_t size = cfg->size;
+    return size * 2 * sizeof(int16_t) + size * size * 2;
+}
+
+void gauge_geom_init(gauge_geom_t *geom, const gauge_geom_config_t *cfg, void *buf)
+{
+    geom->cfg = *cfg;
+    geom->cfg.start_deg = (int16_t)(((cfg->start_deg % 360) + 360) % 360);
+    if (geom->cfg.sweep_deg == 0 || geom->cfg.sweep_deg > 360) {
+        geom->cfg.sweep_deg = 360;
+    }
+
+    uint16_t size = geom->cfg.size;
+    geom->row_x1 = (int16_t *)buf;
+    geom->row_x2 = geom->row_x1 + size;
+    geom->step_map = (uint8_t *)(geom->row_x2 + size);
+    geom->coverage = geom->step_map + (size_t)size * size;
+
+    for (int s = 0; s <= GAUGE_GEOM_STEPS; s++) {
+        float rad = (float)step_units(geom, (uint16_t)s) / GAUGE_GEOM_STEPS * GAUGE_PI / 180.0f;
+        geom->cos_q14[s] = (int16_t)lrintf(cosf(rad) * 16384.0f);
+        geom->sin_q14[s] = (int16_t)lrintf(sinf(rad) * 16384.0f);
+    }
+
+    // 以像素中心计算到圆心的距离和角度，只在创建时做一次
+    float c = size / 2.0f;
+    float r_out = geom->cfg.r_outer;
+    float r_in = geom->cfg.r_inner;
+    for (int y = 0; y < size; y++) {
+        geom->row_x1[y] = (int16_t)size;
+        geom->row_x2[y] = -1;
+        for (int x = 0; x < size; x++) {
+            size_t i = (size_t)y * size + x;
+            float dx = x + 0.5f - c;
+            float dy = y + 0.5f - c;
+            float d = sqrtf(dx * dx + dy * dy);
+            // 内外两条边各有一个像素宽的过渡
+            uint8_t cov = (uint8_t)lrintf(clamp01(r_out + 0.5f - d) * clamp01(d - r_in + 0.5f) * 255.0f);
+
+            float rel = atan2f(dy, dx) * 180.0f / GAUGE_PI - geom->cfg.start_deg;
+            while (rel < 0.0f) {
+                rel += 360.0f;
+            }
+            while (rel >= 360.0f) {
+                rel -= 360.0f;
+            }
+
+            if (cov == 0 || rel >= geom->cfg.sweep_deg) {
+                geom->step_map[i] = GAUGE_GEOM_OUTSIDE;
+                geom->coverage[i] = 0;
+                continue;
+            }
+
+            int step = (int)(rel * GAUGE_GEOM_STEPS / geom->cfg.sweep_deg);
+            geom->step_map[i] = (uint8_t)(step < GAUGE_GEOM_STEPS ? step : GAUGE_GEOM_STEPS - 1);
+            geom->coverage[i] = cov;
+            if (x < geom->row_x1[y]) {
+                geom->row_x1[y] = (int16_t)x;
+            }
+            geom->row_x2[y] = (int16_t)x;
+        }
+    }
+}
+
+uint16_t gauge_geom_step(float value, float max)
+{
+    if (!(max > 0.0f) || !(value > 0.0f)) {
+        return 0;
+    }
+    if (value >= max) {
+        return GAUGE_GEOM_STEPS;
+    }
+    return (uint16_t)(value * GAUGE_GEOM_STEPS / max + 0.5f);
+}
+
+void gauge_geom_point(const gauge_geom_t *geom, uint16_t step, uint16_t radius, int16_t *x, int16_t *y)
+{
+    if (step > GAUGE_GEOM_STEPS) {
+        step = GAUGE_GEOM_STEPS;
+    }
+    // 圆心在size/2，Q14下是size << 13
+    int32_t c = (int32_t)geom->cfg.size << 13;
+    *x = (int16_t)((c + (int32_t)radius * geom->cos_q14[step]) >> 14);
+    *y = (int16_t)((c + (int32_t)radius * geom->sin_q14[step]) >> 14);
+}
+
+static void area_add(gauge_area_t *area, int16_t x, int16_t y)
+{
+    if (x < area->x1) area->x1 = x;
+    if (x > area->x2) area->x2 = x;
+    if (y < area->y1) area->y1 = y;
+    if (y > area->y2) area->y2 = y;
+}
+
+bool gauge_geom_sector_area(const gauge_geom_t *geom, uint16_t step_a, uint16_t step_b, gauge_area_t *area)
+{
+    if (step_a == step_b) {
+        return false;
+    }
+    uint16_t lo = step_a < step_b ? step_a : step_b;
+    uint16_t hi = step_a < step_b ? step_b : step_a;
+    if (hi > GAUGE_GEOM_STEPS) {
+        hi = GAUGE_GEOM_STEPS;
+    }
+
+    int16_t x, y;
+    gauge_geom_point(geom, lo, geom->cfg.r_inner, &x, &y);
+    area->x1 = area->x2 = x;
+    area->y1 = area->y2 = y;
+    gauge_geom_point(geom, lo, geom->cfg.r_outer, &x, &y);
+    area_add(area, x, y);
+    gauge_geom_point(geom, hi, geom->cfg.r_inner, &x, &y);
+    area_add(area, x, y);
+    gauge_geom_point(geom, hi, geom->cfg.r_outer, &x, &y);
+    area_add(area, x, y);
+
+    // 扇形经过坐标轴方向时，最远点在外半径和坐标轴的交点上
+    int32_t u_lo = step_units(geom, lo);
+    int32_t u_hi = step_units(geom, hi);
+    int16_t c = (int16_t)(geom->cfg.size / 2);
+    int16_t r = (int16_t)geom->cfg.r_outer;
+    for (int32_t k = (u_lo + QUARTER_UNITS - 1) / QUARTER_UNITS; k * QUARTER_UNITS <= u_hi; k++) {
+        switch (k % 4) {
+            case 0: area_add(area, c + r, c); break;
+            case 1: area_add(area, c, c + r); break;
+            case 2: area_add(area, c - r, c); break;
+            default: area_add(area, c, c - r); break;
+        }
+    }
+
+    // 加上抗锯齿边缘和定点取整误差，裁剪到仪表范围内
+    int16_t last = (int16_t)(geom->cfg.size - 1);
+    area->x1 = area->x1 > 1 ? area->x1 - 1 : 0;
+    area->y1 = area->y1 > 1 ? area->y1 - 1 : 0;
+    area->x2 = area->x2 + 1 < last ? area->x2 + 1 : last;
+    area->y2 = area->y2 + 1 < last ? area->y2 + 1 : last;
+    return true;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file     gauge_geom.h
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    Gauge Geometry Module Header
+ *
+ * 圆形仪表的预计算几何。创建时把指示弧所在的圆环按指示分辨率分成
+ * GAUGE_GEOM_STEPS格，给环内每个像素记下它所在的格号和边缘的覆盖率，
+ * 再记下每行圆环的左右边界；起止角按格号查正余弦表。
+ *
+ * 数值变化时只需要重绘新旧位置之间的扇形：用查表得到的端点和经过的
+ * 坐标轴方向算出扇形的包围框，绘制时逐行只看环内的像素，格号小于当前
+ * 位置的像素填指示色。运行中不做三角函数和开方运算。
+ *
+ * 只依赖标准C头文件，可以在主机上验证。
+ */
+
+#ifndef GAUGE_GEOM_H
+#define GAUGE_GEOM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GAUGE_GEOM_STEPS        240     // 指示弧的分辨率（格数）
+#define GAUGE_GEOM_OUTSIDE      0xFF    // 像素不在圆环内
+
+// 矩形区域，相对仪表左上角，包含两端
+typedef struct {
+    int16_t x1;
+    int16_t y1;
+    int16_t x2;
+    int16_t y2;
+} gauge_area_t;
+
+// 圆环参数，角度0度指向右，顺时针为正，和LVGL一致
+typedef struct {
+    uint16_t size;          // 仪表边长（像素）
+    uint16_t r_outer;       // 圆环外半径
+    uint16_t r_inner;       // 圆环内半径
+    int16_t start_deg;      // 起始角
+    uint16_t sweep_deg;     // 扫过的角度，1~360
+} gauge_geom_config_t;
+
+typedef struct {
+    gauge_geom_config_t cfg;
+    int16_t cos_q14[GAUGE_GEOM_STEPS + 1];  // 每格边界的余弦，Q14定点
+    int16_t sin_q14[GAUGE_GEOM_STEPS + 1];
+    uint8_t *step_map;      // size*size，像素所在的格号，环外为GAUGE_GEOM_OUTSIDE
+    uint8_t *coverage;      // size*size，像素被圆环覆盖的比例，255为完全覆盖
+    int16_t *row_x1;        // 每行第一个环内像素，没有时大于row_x2
+    int16_t *row_x2;
+} gauge_geom_t;
+
+// 预计算需要的缓冲区大小
+size_t gauge_geom_buf_size(const gauge_geom_config_t *cfg);
+
+/**
+ * @brief 预计算圆环
+ *
+ * buf由调用者分配，大小为gauge_geom_buf_size()，在geom使用期间保持有效。
+ * 同样参数的多个仪表可以共用一份。
+ */
+void gauge_geom_init(gauge_geom_t *geom, const gauge_geom_config_t *cfg, void *buf);
+
+// 数值换算成指示位置（0~GAUGE_GEOM_STEPS），超出范围时取边界
+uint16_t gauge_geom_step(float value, float max);
+
+// 指示位置step处半径为radius的点，相对仪表左上角
+void gauge_geom_point(const gauge_geom_t *geom, uint16_t step, uint16_t radius, int16_t *x, int16_t *y);
+
+/**
+ * @brief 两个指示位置之间的扇形的包围框
+ *
+ * 包含抗锯齿边缘。两个位置相同时返回false。
+ */
+bool gauge_geom_sector_area(const gauge_geom_t *geom, uint16_t step_a, uint16_t step_b, gauge_area_t *area);
+
+// 像素(x, y)是否在指示位置step以内，是的话返回覆盖率，否则返回0
+static inline uint8_t gauge_geom_lit(const gauge_geom_t *geom, int16_t x, int16_t y, uint16_t step)
+{
+    size_t i = (size_t)y * geom->cfg.size + x;
+    return geom->step_map[i] < step ? geom->coverage[i] : 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GAUGE_GEOM_H */
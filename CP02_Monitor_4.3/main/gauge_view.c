@@ -0,0 +1,377 @@
+/**
+ * @file     gauge_view.c
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    Gauge View Module Implementation
+ */
+
+#include "gauge_view.h"
+#include "gauge_geom.h"
+#include "power_monitor.h"
+#include "font_manager.h"
+#include "ui_theme.h"
+#include "ui_nav.h"
+#include "mem_tag.h"
+#include "esp_log.h"
+#include <stdio.h>
+#include <string.h>
+
+static const char *TAG = "GAUGE_VIEW";
+
+#define GAUGE_COUNT     5
+#define TICK_GAP        3       // 刻度和圆环之间的间距
+
+extern const float MAX_PORT_WATTS;
+
+typedef struct {
+    lv_obj_t *img;
+    lv_obj_t *value_label;
+    lv_obj_t *name_label;
+    lv_obj_t *info_label;
+    uint16_t shown;             // 当前画出的指示位置
+    uint16_t target;            // 最新数据对应的指示位置
+} gauge_t;
+
+static gauge_view_config_t view_cfg = GAUGE_VIEW_DEFAULT_CONFIG();
+
+// 以下只在页面存在期间有效
+static gauge_t gauges[GAUGE_COUNT];
+static gauge_geom_t geom;
+static void *geom_buf = NULL;
+static lv_img_dsc_t *scale_img = NULL;
+static lv_coord_t ring_ofs = 0;                 // 圆环在底图中的偏移（截图的扩展绘制区）
+static lv_color_t arc_lut[GAUGE_GEOM_STEPS];    // 每格的指示色，沿扫过方向渐变
+static lv_obj_t *total_label = NULL;
+static lv_timer_t *anim_timer = NULL;
+
+// 显示顺序与主界面一致：C1, C2, C3, C4, A
+static const int display_order[GAUGE_COUNT] = {1, 2, 3, 4, 0};
+
+static void gauge_view_create(lv_obj_t *parent);
+static void gauge_view_destroy(void);
+static void gauge_view_on_data(uint32_t topics);
+
+// 离开时销毁，回来时按当前主题重新画刻度
+static ui_nav_screen_t gauge_screen = {
+    .name = "gauges",
+    .cached = false,
+    .topics = UI_NAV_TOPIC_POWER,
+    .create = gauge_view_create,
+    .destroy = gauge_view_destroy,
+    .on_data = gauge_view_on_data,
+};
+
+static float max_watts(void)
+{
+    return view_cfg.max_watts > 0 ? view_cfg.max_watts : MAX_PORT_WATTS;
+}
+
+// 从共享样式中取颜色，和主界面的功率条保持一致
+static lv_color_t style_color(ui_style_id_t id, lv_style_prop_t prop)
+{
+    lv_style_value_t value = { .color = lv_color_black() };
+    lv_style_get_prop(ui_theme_style(id), prop, &value);
+    return value.color;
+}
+
+// 在底图或绘制缓冲区中画到指示位置step为止的圆环，lut为NULL时整环用color
+static void arc_fill(lv_color_t *buf, lv_coord_t stride, const lv_area_t *clip, uint16_t step,
+                     const lv_color_t *lut, lv_color_t color)
+{
+    for (lv_coord_t y = clip->y1; y <= clip->y2; y++) {
+        lv_coord_t x1 = LV_MAX(clip->x1, geom.row_x1[y]);
+        lv_coord_t x2 = LV_MIN(clip->x2, geom.row_x2[y]);
+        const uint8_t *map = geom.step_map + (size_t)y * geom.cfg.size;
+        const uint8_t *cov = geom.coverage + (size_t)y * geom.cfg.size;
+        lv_color_t *row = buf + (y - clip->y1) * stride - clip->x1;
+        for (lv_coord_t x = x1; x <= x2; x++) {
+            uint8_t idx = map[x];
+            if (idx >= step) {
+                continue;
+            }
+            lv_color_t c = lut ? lut[idx] : color;
+            row[x] = cov[x] == LV_OPA_COVER ? c : lv_color_mix(c, row[x], cov[x]);
+        }
+    }
+}
+
+// 用lv_meter画出刻度和刻度值，截图后补上底环
+static lv_img_dsc_t *scale_create(lv_obj_t *parent)
+{
+    lv_coord_t size = view_cfg.size;
+    lv_obj_t *meter = lv_meter_create(parent);
+    lv_obj_remove_style_all(meter);
+    lv_obj_set_size(meter, size, size);
+    ui_theme_apply(meter, UI_STYLE_SCREEN, LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(meter, LV_OPA_COVER, LV_PART_MAIN);
+    // 内边距决定刻度所在的半径，刻度画在圆环内侧
+    lv_obj_set_style_pad_all(meter, size / 2 - (geom.cfg.r_inner - TICK_GAP), LV_PART_MAIN);
+    ui_theme_apply(meter, UI_STYLE_MUTED, LV_PART_TICKS);
+    lv_obj_set_style_text_font(meter, &lv_font_montserrat_12, LV_PART_TICKS);
+
+    lv_color_t muted = style_color(UI_STYLE_MUTED, LV_STYLE_TEXT_COLOR);
+    lv_color_t text = style_color(UI_STYLE_TEXT, LV_STYLE_TEXT_COLOR);
+    lv_meter_scale_t *scale = lv_meter_add_scale(meter);
+    lv_meter_set_scale_ticks(meter, scale, view_cfg.tick_count, 1, 5, muted);
+    lv_meter_set_scale_major_ticks(meter, scale, view_cfg.major_every, 2, 9, text, 6);
+    lv_meter_set_scale_range(meter, scale, 0, (int32_t)max_watts(), view_cfg.sweep_deg, view_cfg.start_deg);
+
+    lv_obj_update_layout(meter);
+    lv_img_dsc_t *img = lv_snapshot_take(meter, LV_IMG_CF_TRUE_COLOR);
+    lv_obj_del(meter);
+    if (img == NULL) {
+        return NULL;
+    }
+
+    // 底环和指示弧用同一份圆环数据，边缘完全重合。截图四周可能带有扩展绘制区
+    ring_ofs = (img->header.w - size) / 2;
+    lv_color_t *origin = (lv_color_t *)img->data + ring_ofs * img->header.w + ring_ofs;
+    lv_area_t all = { 0, 0, size - 1, size - 1 };
+    arc_fill(origin, img->header.w, &all, GAUGE_GEOM_STEPS, NULL, style_color(UI_STYLE_BAR, LV_STYLE_BG_COLOR));
+    return img;
+}
+
+// 圆环所在的屏幕区域
+static void ring_coords(const gauge_t *g, lv_area_t *coords)
+{
+    lv_obj_get_coords(g->img, coords);
+    coords->x1 += ring_ofs;
+    coords->y1 += ring_ofs;
+    coords->x2 = coords->x1 + geom.cfg.size - 1;
+    coords->y2 = coords->y1 + geom.cfg.size - 1;
+}
+
+// 在lv_img画完底图之后补画指示弧，只处理本次刷新的区域
+static void gauge_draw_cb(lv_event_t *e)
+{
+    gauge_t *g = lv_event_get_user_data(e);
+    if (g->shown == 0) {
+        return;
+    }
+
+    lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+    lv_area_t coords;
+    lv_area_t clip;
+    ring_coords(g, &coords);
+    if (!_lv_area_intersect(&clip, draw_ctx->clip_area, &coords)) {
+        return;
+    }
+
+    // 底图可能还在用DMA拷贝，等它完成后再直接写缓冲区
+    if (draw_ctx->wait_for_finish) {
+        draw_ctx->wait_for_finish(draw_ctx);
+    }
+
+    lv_coord_t stride = lv_area_get_width(draw_ctx->buf_area);
+    lv_color_t *buf = (lv_color_t *)draw_ctx->buf + stride * (clip.y1 - draw_ctx->buf_area->y1) +
+                      (clip.x1 - draw_ctx->buf_area->x1);
+    lv_area_move(&clip, -coords.x1, -coords.y1);
+    arc_fill(buf, stride, &clip, g->shown, arc_lut, lv_color_black());
+}
+
+// 只刷新新旧指示位置之间的扇形
+static void gauge_invalidate(gauge_t *g, uint16_t from, uint16_t to)
+{
+    gauge_area_t sector;
+    if (!gauge_geom_sector_area(&geom, from, to, &sector)) {
+        return;
+    }
+    lv_area_t coords;
+    ring_coords(g, &coords);
+    lv_area_t area = {
+        coords.x1 + sector.x1, coords.y1 + sector.y1,
+        coords.x1 + sector.x2, coords.y1 + sector.y2,
+    };
+    lv_obj_invalidate_area(g->img, &area);
+}
+
+// 指示弧动画：每帧走剩余距离的一半，全部到位后暂停
+static void anim_timer_cb(lv_timer_t *timer)
+{
+    bool moving = false;
+    for (int i = 0; i < GAUGE_COUNT; i++) {
+        gauge_t *g = &gauges[i];
+        if (g->shown == g->target) {
+            continue;
+        }
+        int delta = (int)g->target - (int)g->shown;
+        int next = g->shown + (delta > 0 ? (delta + 1) / 2 : (delta - 1) / 2);
+        gauge_invalidate(g, g->shown, (uint16_t)next);
+        g->shown = (uint16_t)next;
+        moving = true;
+    }
+    if (!moving) {
+        lv_timer_pause(timer);
+    }
+}
+
+// 文字不变时不调用lv_label_set_text，避免无谓的重绘
+static void label_update(lv_obj_t *label, const char *text)
+{
+    if (strcmp(lv_label_get_text(label), text) != 0) {
+        lv_label_set_text(label, text);
+    }
+}
+
+static void gauge_view_update(void)
+{
+    port_info_t *ports = power_monitor_get_port_info();
+    char text_buf[32];
+    bool moved = false;
+
+    for (int i = 0; i < GAUGE_COUNT; i++) {
+        gauge_t *g = &gauges[i];
+        port_info_t *port = &ports[display_order[i]];
+
+        g->target = gauge_geom_step(port->power, max_watts());
+        moved |= g->target != g->shown;
+
+        snprintf(text_buf, sizeof(text_buf), "%.1fW", port->power);
+        label_update(g->value_label, text_buf);
+        snprintf(text_buf, sizeof(text_buf), "%.1fV  %.2fA", port->voltage / 1000.0f, port->current / 1000.0f);
+        label_update(g->info_label, text_buf);
+        ui_theme_set_voltage(g->name_label, port->voltage);
+    }
+
+    snprintf(text_buf, sizeof(text_buf), "总功率 %.2fW", power_monitor_get_total_power());
+    label_update(total_label, text_buf);
+
+    if (moved) {
+        lv_timer_resume(anim_timer);
+    }
+}
+
+static void gauge_view_create(lv_obj_t *parent)
+{
+    ESP_LOGI(TAG, "创建仪表页面");
+
+    lv_coord_t size = view_cfg.size;
+    const gauge_geom_config_t geom_cfg = {
+        .size = size,
+        .r_outer = size / 2 - 2,
+        .r_inner = size / 2 - 2 - view_cfg.arc_width,
+        .start_deg = view_cfg.start_deg,
+        .sweep_deg = view_cfg.sweep_deg,
+    };
+    geom_buf = MEM_TAG_CAPS_MALLOC(MEM_TAG_UI, gauge_geom_buf_size(&geom_cfg), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (geom_buf == NULL) {
+        ESP_LOGE(TAG, "无法分配圆环数据");
+        return;
+    }
+    gauge_geom_init(&geom, &geom_cfg, geom_buf);
+
+    lv_color_t arc_start = style_color(UI_STYLE_BAR_INDICATOR, LV_STYLE_BG_COLOR);
+    lv_color_t arc_end = style_color(UI_STYLE_BAR_INDICATOR, LV_STYLE_BG_GRAD_COLOR);
+    for (int i = 0; i < GAUGE_GEOM_STEPS; i++) {
+        arc_lut[i] = lv_color_mix(arc_end, arc_start, (uint8_t)(i * 255 / (GAUGE_GEOM_STEPS - 1)));
+    }
+
+    scale_img = scale_create(parent);
+    if (scale_img == NULL) {
+        ESP_LOGE(TAG, "无法生成刻度底图");
+        return;
+    }
+
+    lv_obj_t *title = lv_label_create(parent);
+    lv_label_set_text(title, "CP-02 Monitor");
+    ui_theme_apply(title, UI_STYLE_TITLE, LV_PART_MAIN);
+    lv_obj_set_style_text_font(title, &lv_font_montserrat_24, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 10);
+
+    // 五个仪表一行排开，间距相等
+    lv_coord_t gap = (800 - GAUGE_COUNT * size) / (GAUGE_COUNT + 1);
+    lv_coord_t top = 110;
+    port_info_t *ports = power_monitor_get_port_info();
+
+    for (int i = 0; i < GAUGE_COUNT; i++) {
+        gauge_t *g = &gauges[i];
+        lv_coord_t x = gap + i * (size + gap);
+        memset(g, 0, sizeof(*g));
+
+        g->img = lv_img_create(parent);
+        lv_img_set_src(g->img, scale_img);
+        lv_obj_set_pos(g->img, x, top);
+        lv_obj_add_event_cb(g->img, gauge_draw_cb, LV_EVENT_DRAW_MAIN_END, g);
+
+        g->value_label = lv_label_create(g->img);
+        ui_theme_apply(g->value_label, UI_STYLE_TEXT, LV_PART_MAIN);
+        lv_obj_set_style_text_font(g->value_label, &lv_font_montserrat_20, LV_PART_MAIN | LV_STATE_DEFAULT);
+        lv_label_set_text(g->value_label, "0.0W");
+        lv_obj_align(g->value_label, LV_ALIGN_CENTER, 0, size / 16);
+
+        g->name_label = lv_label_create(parent);
+        lv_label_set_text(g->name_label, ports[display_order[i]].name);
+        lv_obj_set_style_text_font(g->name_label, &lv_font_montserrat_24, LV_PART_MAIN | LV_STATE_DEFAULT);
+        lv_obj_align_to(g->name_label, g->img, LV_ALIGN_OUT_BOTTOM_MID, 0, 8);
+
+        g->info_label = lv_label_create(parent);
+        ui_theme_apply(g->info_label, UI_STYLE_MUTED, LV_PART_MAIN);
+        lv_obj_set_style_text_font(g->info_label, &lv_font_montserrat_16, LV_PART_MAIN | LV_STATE_DEFAULT);
+        lv_label_set_text(g->info_label, "0.0V  0.00A");
+        lv_obj_set_width(g->info_label, size);
+        lv_obj_set_style_text_align(g->info_label, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN | LV_STATE_DEFAULT);
+        lv_obj_align_to(g->info_label, g->name_label, LV_ALIGN_OUT_BOTTOM_MID, 0, 6);
+    }
+
+    total_label = lv_label_create(parent);
+    ui_theme_apply(total_label, UI_STYLE_TEXT, LV_PART_MAIN);
+    lv_obj_set_style_text_font(total_label, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_label_set_text(total_label, "");
+    lv_obj_align(total_label, LV_ALIGN_BOTTOM_MID, 0, -50);
+
+    lv_obj_t *hint_label = lv_label_create(parent);
+    lv_label_set_text(hint_label, "下滑返回");
+    ui_theme_apply(hint_label, UI_STYLE_MUTED, LV_PART_MAIN);
+    lv_obj_set_style_text_font(hint_label, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_align(hint_label, LV_ALIGN_BOTTOM_MID, 0, -15);
+
+    anim_timer = ui_nav_timer_create(&gauge_screen, anim_timer_cb, view_cfg.frame_ms, NULL);
+    gauge_view_update();
+}
+
+// 控件随页面一起删除，这里释放共用的底图和圆环数据
+static void gauge_view_destroy(void)
+{
+    if (scale_img != NULL) {
+        lv_snapshot_free(scale_img);
+        scale_img = NULL;
+    }
+    if (geom_buf != NULL) {
+        MEM_TAG_FREE(geom_buf);
+        geom_buf = NULL;
+    }
+    total_label = NULL;
+    anim_timer = NULL;
+}
+
+static void gauge_view_on_data(uint32_t topics)
+{
+    if ((topics & UI_NAV_TOPIC_POWER) && total_label != NULL) {
+        gauge_view_update();
+    }
+}
+
+void gauge_view_init(const gauge_view_config_t *cfg)
+{
+    if (cfg != NULL) {
+        view_cfg = *cfg;
+    }
+}
+
+esp_err_t gauge_view_open(void)
+{
+    return ui_nav_push(&gauge_screen);
+}
+
+void gauge_view_close(void)
+{
+    if (ui_nav_is_top(&gauge_screen)) {
+        ui_nav_pop();
+    }
+}
+
+bool gauge_view_is_open(void)
+{
+    return ui_nav_is_top(&gauge_screen);
+}
@@ -0,0 +1,67 @@
+/**
+ * @file     gauge_view.h
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    Gauge View Module Header
+ *
+ * 仪表页面，每个端口一个圆形功率表，在主界面上滑打开，下滑或右滑返回。
+ *
+ * 刻度、刻度值和底环不随数值变化，进入页面时用lv_meter画一次，截图成
+ * 一张不透明的图片，五个仪表共用。仪表本身就是显示这张图片的lv_img，
+ * 指示弧在它的绘制回调中按gauge_geom预计算的圆环直接写进绘制缓冲区。
+ * 数值变化时只刷新新旧位置之间的扇形包围框，LVGL在这个区域内拷贝
+ * 一次底图再补画指示弧，不需要重算整段圆弧的角度遮罩。
+ */
+
+#ifndef GAUGE_VIEW_H
+#define GAUGE_VIEW_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 仪表参数
+typedef struct {
+    float max_watts;            // 满量程，0表示使用单端口最大功率MAX_PORT_WATTS
+    uint16_t size;              // 仪表边长（像素）
+    uint16_t arc_width;         // 指示弧宽度
+    int16_t start_deg;          // 起始角，0度指向右，顺时针
+    uint16_t sweep_deg;         // 扫过的角度
+    uint8_t tick_count;         // 刻度总数
+    uint8_t major_every;        // 每隔几个刻度一个带数值的主刻度
+    uint16_t frame_ms;          // 指示弧动画的帧间隔
+} gauge_view_config_t;
+
+#define GAUGE_VIEW_DEFAULT_CONFIG() {   \
+    .max_watts = 0,                     \
+    .size = 144,                        \
+    .arc_width = 12,                    \
+    .start_deg = 135,                   \
+    .sweep_deg = 270,                   \
+    .tick_count = 29,                   \
+    .major_every = 7,                   \
+    .frame_ms = 50,                     \
+}
+
+// 设置仪表参数，下次打开页面时生效
+void gauge_view_init(const gauge_view_config_t *cfg);
+
+// 打开仪表页面
+esp_err_t gauge_view_open(void);
+
+// 仪表页面在前台时返回上一页
+void gauge_view_close(void);
+
+// 仪表页面是否在前台
+bool gauge_view_is_open(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GAUGE_VIEW_H */
@@ -0,0 +1,298 @@
+/**
+ * @file     gdma_blend.c
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    DMA Blend Module Implementation
+ */
+
+#include "gdma_blend.h"
+#include <string.h>
+
+// CPU后端
+static bool cpu_copy(void *user_ctx, void *dst, const void *src, size_t len)
+{
+    (void)user_ctx;
+    memcpy(dst, src, len);
+    return true;
+}
+
+static void cpu_wait(void *user_ctx)
+{
+    (void)user_ctx;
+}
+
+static bool cpu_can_access(void *user_ctx, const void *ptr)
+{
+    (void)user_ctx;
+    return ptr != NULL;
+}
+
+const gdma_blend_backend_t gdma_blend_cpu_backend = {
+    .copy = cpu_copy,
+    .wait = cpu_wait,
+    .can_access = cpu_can_access,
+    .sync_src = NULL,
+    .sync_dst = NULL,
+    .user_ctx = NULL,
+};
+
+static inline uintptr_t align_up(uintptr_t v, size_t align)
+{
+    return (v + align - 1) & ~(uintptr_t)(align - 1);
+}
+
+static inline uintptr_t align_down(uintptr_t v, size_t align)
+{
+    return v & ~(uintptr_t)(align - 1);
+}
+
+static void cpu_fill16(uint16_t *dst, size_t px, uint16_t color)
+{
+    for (size_t i = 0; i < px; i++) {
+        dst[i] = color;
+    }
+}
+
+// 提交一次传输，队列满时等待后重试，仍失败则由CPU完成
+static void submit(gdma_blend_t *gb, void *dst, const void *src, size_t len)
+{
+    const gdma_blend_backend_t *be = gb->cfg.backend;
+
+    if (be->copy(be->user_ctx, dst, src, len)) {
+        gb->pending++;
+        gb->stats.submits++;
+        gb->stats.dma_bytes += len;
+        return;
+    }
+
+    gdma_blend_wait(gb);
+    gb->stats.retries++;
+    if (be->copy(be->user_ctx, dst, src, len)) {
+        gb->pending++;
+        gb->stats.submits++;
+        gb->stats.dma_bytes += len;
+        return;
+    }
+
+    memcpy(dst, src, len);
+    gb->stats.cpu_bytes += len;
+}
+
+// 矩形区域相对未完成区域原点的位置，x按字节、y按行，右边和下边不包含
+static void area_rect(const gdma_blend_t *gb, uintptr_t start, size_t row_bytes, size_t h, intptr_t rect[4])
+{
+    intptr_t stride = (intptr_t)gb->pending_stride;
+    intptr_t diff = (intptr_t)(start - gb->pending_origin);
+    intptr_t y = diff / stride;
+    intptr_t x = diff % stride;
+    if (x < 0) {
+        x += stride;
+        y--;
+    }
+    rect[0] = x;
+    rect[1] = x + (intptr_t)row_bytes;
+    rect[2] = y;
+    rect[3] = y + (intptr_t)h;
+}
+
+// 区域是否可能和未完成的传输重叠，行宽不同的缓冲区无法比较，按重叠处理
+static bool area_busy(const gdma_blend_t *gb, uintptr_t start, size_t stride_bytes, size_t row_bytes, size_t h)
+{
+    if (gb->pending == 0) {
+        return false;
+    }
+    if (stride_bytes != gb->pending_stride) {
+        return true;
+    }
+    intptr_t r[4];
+    area_rect(gb, start, row_bytes, h, r);
+    return r[0] < gb->pending_x2 && gb->pending_x1 < r[1] && r[2] < gb->pending_y2 && gb->pending_y1 < r[3];
+}
+
+// 把一次填充的区域并入未完成区域的包围框，调用前已经等待过行宽不同的传输
+static void area_add(gdma_blend_t *gb, uintptr_t start, size_t stride_bytes, size_t row_bytes, size_t h)
+{
+    if (gb->pending == 0) {
+        return;
+    }
+    if (gb->pending_x1 >= gb->pending_x2) {
+        gb->pending_origin = start;
+        gb->pending_stride = stride_bytes;
+        gb->pending_x1 = 0;
+        gb->pending_x2 = (intptr_t)row_bytes;
+        gb->pending_y1 = 0;
+        gb->pending_y2 = (intptr_t)h;
+        return;
+    }
+    intptr_t r[4];
+    area_rect(gb, start, row_bytes, h, r);
+    gb->pending_x1 = r[0] < gb->pending_x1 ? r[0] : gb->pending_x1;
+    gb->pending_x2 = r[1] > gb->pending_x2 ? r[1] : gb->pending_x2;
+    gb->pending_y1 = r[2] < gb->pending_y1 ? r[2] : gb->pending_y1;
+    gb->pending_y2 = r[3] > gb->pending_y2 ? r[3] : gb->pending_y2;
+}
+
+// 计算一行中可以交给DMA的对齐区间，返回false表示整行由CPU完成
+static bool row_span(const gdma_blend_t *gb, uintptr_t start, size_t len, uintptr_t *mid_start, uintptr_t *mid_end)
+{
+    *mid_start = align_up(start, gb->cfg.align);
+    *mid_end = align_down(start + len, gb->cfg.align);
+    return *mid_end > *mid_start && (*mid_end - *mid_start) >= gb->cfg.min_span_bytes;
+}
+
+void gdma_blend_init(gdma_blend_t *gb, const gdma_blend_config_t *cfg)
+{
+    memset(gb, 0, sizeof(*gb));
+    gb->cfg = *cfg;
+    if (gb->cfg.backend == NULL) {
+        gb->cfg.backend = &gdma_blend_cpu_backend;
+    }
+    if (gb->cfg.align < sizeof(uint32_t)) {
+        gb->cfg.align = sizeof(uint32_t);
+    }
+    if (gb->cfg.min_span_bytes < gb->cfg.align) {
+        gb->cfg.min_span_bytes = gb->cfg.align;
+    }
+}
+
+bool gdma_blend_fill16(gdma_blend_t *gb, uint16_t *dst, size_t dst_stride, size_t w, size_t h, uint16_t color)
+{
+    const gdma_blend_backend_t *be = gb->cfg.backend;
+
+    if (w * h < gb->cfg.min_pixels || gb->cfg.fill_row == NULL || !be->can_access(be->user_ctx, dst)) {
+        gb->stats.rejected++;
+        return false;
+    }
+
+    // 行首行尾由CPU写入，不能和之前未完成的传输重叠；行宽不同时area_add也需要先等待
+    gdma_blend_wait_area(gb, dst, dst_stride, w, h);
+
+    // 模板行正在被DMA读取时不能改写
+    if (!gb->fill_row_valid || gb->fill_color != color) {
+        if (gb->pending > 0) {
+            gdma_blend_wait(gb);
+        }
+        cpu_fill16(gb->cfg.fill_row, gb->cfg.fill_row_px, color);
+        gb->fill_color = color;
+        gb->fill_row_valid = true;
+    }
+
+    // 行首尾相连时整块作为一行，按模板行的长度分段
+    const bool merged = dst_stride == w;
+    const size_t rows = merged ? 1 : h;
+    const size_t row_px = merged ? w * h : w;
+    const size_t chunk_max = align_down(gb->cfg.fill_row_px * sizeof(uint16_t), gb->cfg.align);
+    const size_t row_bytes = row_px * sizeof(uint16_t);
+
+    for (size_t y = 0; y < rows; y++) {
+        uint16_t *row = dst + y * dst_stride;
+        uintptr_t start = (uintptr_t)row;
+        uintptr_t mid_start, mid_end;
+
+        if (chunk_max == 0 || !row_span(gb, start, row_bytes, &mid_start, &mid_end)) {
+            cpu_fill16(row, row_px, color);
+            gb->stats.cpu_bytes += row_bytes;
+            continue;
+        }
+
+        // 行首行尾由CPU填充
+        size_t head_px = (mid_start - start) / sizeof(uint16_t);
+        size_t tail_px = (start + row_bytes - mid_end) / sizeof(uint16_t);
+        cpu_fill16(row, head_px, color);
+        cpu_fill16((uint16_t *)mid_end, tail_px, color);
+        gb->stats.cpu_bytes += (head_px + tail_px) * sizeof(uint16_t);
+
+        if (be->sync_dst) {
+            be->sync_dst(be->user_ctx, (void *)mid_start, mid_end - mid_start);
+        }
+        for (uintptr_t p = mid_start; p < mid_end; p += chunk_max) {
+            size_t len = mid_end - p;
+            if (len > chunk_max) {
+                len = chunk_max;
+            }
+            submit(gb, (void *)p, gb->cfg.fill_row, len);
+        }
+    }
+
+    area_add(gb, (uintptr_t)dst, dst_stride * sizeof(uint16_t), w * sizeof(uint16_t), h);
+    gb->stats.fills++;
+    return true;
+}
+
+bool gdma_blend_copy16(gdma_blend_t *gb, uint16_t *dst, size_t dst_stride,
+                       const uint16_t *src, size_t src_stride, size_t w, size_t h)
+{
+    const gdma_blend_backend_t *be = gb->cfg.backend;
+
+    if (w * h < gb->cfg.min_pixels || !be->can_access(be->user_ctx, dst) || !be->can_access(be->user_ctx, src)) {
+        gb->stats.rejected++;
+        return false;
+    }
+
+    gdma_blend_wait_area(gb, dst, dst_stride, w, h);
+    // 源数据可能还在被之前的填充写入
+    gdma_blend_wait_area(gb, src, src_stride, w, h);
+
+    const bool merged = dst_stride == w && src_stride == w;
+    const size_t rows = merged ? 1 : h;
+    const size_t row_bytes = (merged ? w * h : w) * sizeof(uint16_t);
+
+    for (size_t y = 0; y < rows; y++) {
+        uint16_t *drow = dst + y * dst_stride;
+        const uint16_t *srow = src + y * src_stride;
+        uintptr_t start = (uintptr_t)drow;
+        uintptr_t mid_start, mid_end;
+
+        // 源地址相对目标的偏移也必须满足对齐，否则整行由CPU拷贝
+        bool dma_row = row_span(gb, start, row_bytes, &mid_start, &mid_end) &&
+                       (((uintptr_t)srow + (mid_start - start)) & (gb->cfg.align - 1)) == 0;
+        if (!dma_row) {
+            memcpy(drow, srow, row_bytes);
+            gb->stats.cpu_bytes += row_bytes;
+            continue;
+        }
+
+        size_t head = mid_start - start;
+        size_t tail = start + row_bytes - mid_end;
+        const uint8_t *smid = (const uint8_t *)srow + head;
+        memcpy(drow, srow, head);
+        memcpy((void *)mid_end, smid + (mid_end - mid_start), tail);
+        gb->stats.cpu_bytes += head + tail;
+
+        if (be->sync_src) {
+            be->sync_src(be->user_ctx, smid, mid_end - mid_start);
+        }
+        if (be->sync_dst) {
+            be->sync_dst(be->user_ctx, (void *)mid_start, mid_end - mid_start);
+        }
+        submit(gb, (void *)mid_start, smid, mid_end - mid_start);
+    }
+
+    // 返回后调用者可能改写源数据
+    gdma_blend_wait(gb);
+    gb->stats.copies++;
+    return true;
+}
+
+void gdma_blend_wait(gdma_blend_t *gb)
+{
+    if (gb->pending > 0) {
+        gb->cfg.backend->wait(gb->cfg.backend->user_ctx);
+        gb->pending = 0;
+        gb->stats.waits++;
+    }
+    gb->pending_x1 = gb->pending_x2 = 0;
+}
+
+void gdma_blend_wait_area(gdma_blend_t *gb, const uint16_t *dst, size_t dst_stride, size_t w, size_t h)
+{
+    if (area_busy(gb, (uintptr_t)dst, dst_stride * sizeof(uint16_t), w * sizeof(uint16_t), h)) {
+        gdma_blend_wait(gb);
+    }
+}
+
+const gdma_blend_stats_t *gdma_blend_get_stats(const gdma_blend_t *gb)
+{
+    return &gb->stats;
+}
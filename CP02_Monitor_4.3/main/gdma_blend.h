@@ -0,0 +1,115 @@
+/**
+ * @file     gdma_blend.h
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    DMA Blend Module Header
+ *
+ * 把大面积的不透明填充和拷贝拆成按行的DMA传输。每行只把按缓存行对齐的
+ * 中间部分交给DMA，行首行尾不足一个缓存行的部分由CPU完成，避免CPU和DMA
+ * 写同一个缓存行。区域的各行首尾相连时（行宽等于缓冲区宽度）整块作为一行
+ * 处理，减少传输次数。DMA的具体实现通过后端接口注入，本模块只依赖标准C头文件。
+ *
+ * 填充返回时DMA可能还在写目标区域，记下这些区域的包围框；CPU要读写某个区域
+ * 之前调用gdma_blend_wait_area()，只有和未完成的填充重叠时才等待。拷贝的源数据
+ * 在返回后可能被调用者改写（比如LVGL按块解码图片用的临时缓冲区），所以拷贝在
+ * 返回前等自己的传输完成，只有各行之间的DMA和CPU首尾拷贝是重叠的。
+ */
+
+#ifndef GDMA_BLEND_H
+#define GDMA_BLEND_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// DMA后端接口
+typedef struct {
+    // 提交一次异步拷贝，返回false表示当前无法提交（如队列已满）
+    bool (*copy)(void *user_ctx, void *dst, const void *src, size_t len);
+    // 等待所有已提交的拷贝完成
+    void (*wait)(void *user_ctx);
+    // DMA能否访问该地址
+    bool (*can_access)(void *user_ctx, const void *ptr);
+    // DMA读取前同步源数据（写回缓存），可以为NULL
+    void (*sync_src)(void *user_ctx, const void *addr, size_t len);
+    // DMA写入前同步目标区域（写回并失效缓存），可以为NULL
+    void (*sync_dst)(void *user_ctx, void *addr, size_t len);
+    void *user_ctx;
+} gdma_blend_backend_t;
+
+// 统计信息
+typedef struct {
+    uint32_t fills;             // 由本模块处理的填充次数
+    uint32_t copies;            // 由本模块处理的拷贝次数
+    uint32_t rejected;          // 不满足条件交回软件渲染的次数
+    uint32_t submits;           // 提交给后端的传输次数
+    uint32_t retries;           // 后端队列满时等待后重试的次数
+    uint32_t waits;             // 实际等待后端的次数
+    uint64_t dma_bytes;         // DMA传输的字节数
+    uint64_t cpu_bytes;         // 行首行尾等由CPU完成的字节数
+} gdma_blend_stats_t;
+
+// 配置
+typedef struct {
+    const gdma_blend_backend_t *backend;
+    size_t align;               // DMA区域的对齐字节数，通常为缓存行大小
+    size_t min_span_bytes;      // 每行DMA部分的最小长度，更短的行由CPU完成
+    uint32_t min_pixels;        // 面积小于该值的操作不处理
+    uint16_t *fill_row;         // 填充模板行，必须DMA可访问并按align对齐
+    size_t fill_row_px;         // 模板行的像素数
+} gdma_blend_config_t;
+
+// 实例
+typedef struct {
+    gdma_blend_config_t cfg;
+    uint16_t fill_color;        // 模板行当前的颜色
+    bool fill_row_valid;
+    uint32_t pending;           // 已提交但未等待的传输数
+    // 未完成的传输所写区域的包围框，以pending_origin为原点，x按字节、y按行
+    uintptr_t pending_origin;
+    size_t pending_stride;      // 字节
+    intptr_t pending_x1, pending_x2, pending_y1, pending_y2;
+    gdma_blend_stats_t stats;
+} gdma_blend_t;
+
+// CPU后端：同步memcpy，用于没有DMA时的回退以及主机上验证
+extern const gdma_blend_backend_t gdma_blend_cpu_backend;
+
+// 初始化
+void gdma_blend_init(gdma_blend_t *gb, const gdma_blend_config_t *cfg);
+
+/**
+ * @brief 用16位颜色填充矩形区域
+ *
+ * @param dst        目标区域左上角
+ * @param dst_stride 目标缓冲区每行像素数
+ *
+ * @return true表示已处理（传输可能尚未完成，CPU访问这个区域前需调用
+ *         gdma_blend_wait_area或gdma_blend_wait），false表示不满足条件，
+ *         调用者应使用软件渲染
+ */
+bool gdma_blend_fill16(gdma_blend_t *gb, uint16_t *dst, size_t dst_stride, size_t w, size_t h, uint16_t color);
+
+// 拷贝16位像素的矩形区域，返回时拷贝已完成，返回false时调用者应使用软件渲染
+bool gdma_blend_copy16(gdma_blend_t *gb, uint16_t *dst, size_t dst_stride,
+                       const uint16_t *src, size_t src_stride, size_t w, size_t h);
+
+// 等待所有传输完成
+void gdma_blend_wait(gdma_blend_t *gb);
+
+// CPU读写矩形区域之前调用，和未完成的传输重叠时等待全部完成
+void gdma_blend_wait_area(gdma_blend_t *gb, const uint16_t *dst, size_t dst_stride, size_t w, size_t h);
+
+// 获取统计信息
+const gdma_blend_stats_t *gdma_blend_get_stats(const gdma_blend_t *gb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GDMA_BLEND_H */
@@ -0,0 +1,201 @@
+/**
+ * @file     gesture.c
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    Gesture Recognizer Module Implementation
+ */
+
+#include "gesture.h"
+#include <stddef.h>
+#include <stdlib.h>
+
+#define GESTURE_VELOCITY_SMOOTH 0.5f    // 速度估计的平滑系数
+
+static void gesture_emit(gesture_t *g, gesture_type_t type, uint32_t now_ms, float velocity, bool fling)
+{
+    if (g->cb == NULL) {
+        return;
+    }
+
+    gesture_event_t event = {
+        .type = type,
+        .x = g->start_x,
+        .y = g->start_y,
+        .dx = (int16_t)(g->last_x - g->start_x),
+        .dy = (int16_t)(g->last_y - g->start_y),
+        .duration_ms = now_ms - g->start_ms,
+        .velocity_px_s = velocity,
+        .fling = fling,
+    };
+    g->cb(&event, g->user_data);
+}
+
+// 发出等待中的单击，事件坐标为单击的位置
+static gesture_type_t gesture_flush_tap(gesture_t *g)
+{
+    if (!g->tap_pending) {
+        return GESTURE_NONE;
+    }
+
+    g->tap_pending = false;
+    if (g->cb != NULL) {
+        gesture_event_t event = {
+            .type = GESTURE_TAP,
+            .x = g->tap_x,
+            .y = g->tap_y,
+            .duration_ms = g->tap_duration_ms,
+        };
+        g->cb(&event, g->user_data);
+    }
+    return GESTURE_TAP;
+}
+
+// 按下期间的采样：更新速度，检测长按
+static gesture_type_t gesture_track(gesture_t *g, int16_t x, int16_t y, uint32_t now_ms)
+{
+    uint32_t dt = now_ms - g->last_ms;
+    if (dt > 0) {
+        float ivx = (float)(x - g->last_x) * 1000.0f / dt;
+        float ivy = (float)(y - g->last_y) * 1000.0f / dt;
+        g->vx = GESTURE_VELOCITY_SMOOTH * ivx + (1.0f - GESTURE_VELOCITY_SMOOTH) * g->vx;
+        g->vy = GESTURE_VELOCITY_SMOOTH * ivy + (1.0f - GESTURE_VELOCITY_SMOOTH) * g->vy;
+    }
+    g->last_x = x;
+    g->last_y = y;
+    g->last_ms = now_ms;
+
+    if (!g->moved && (abs(x - g->start_x) > g->cfg.tap_slop_px || abs(y - g->start_y) > g->cfg.tap_slop_px)) {
+        g->moved = true;
+        gesture_flush_tap(g);    // 这次按下不会成为双击，先发出之前的单击
+    }
+
+    if (!g->moved && !g->long_press_fired && now_ms - g->start_ms >= g->cfg.long_press_ms) {
+        g->long_press_fired = true;
+        gesture_flush_tap(g);
+        gesture_emit(g, GESTURE_LONG_PRESS, now_ms, 0.0f, false);
+        return GESTURE_LONG_PRESS;
+    }
+    return GESTURE_NONE;
+}
+
+// 抬起：根据位移、时间和速度分类
+static gesture_type_t gesture_release(gesture_t *g, uint32_t now_ms)
+{
+    if (g->long_press_fired) {
+        return GESTURE_NONE;
+    }
+
+    int dx = g->last_x - g->start_x;
+    int dy = g->last_y - g->start_y;
+    uint32_t duration = now_ms - g->start_ms;
+    bool horizontal = abs(dx) >= abs(dy);
+    int dist = horizontal ? abs(dx) : abs(dy);
+    float velocity = horizontal ? g->vx : g->vy;
+    float speed = velocity < 0 ? -velocity : velocity;
+
+    if (g->moved) {
+        bool fling = speed >= g->cfg.fling_min_px_s;
+        // 快速滑动时允许较短的距离
+        bool is_swipe = (dist >= g->cfg.swipe_min_px && duration <= g->cfg.swipe_max_ms) ||
+                        (fling && dist >= g->cfg.swipe_min_px / 2);
+        if (!is_swipe) {
+            return GESTURE_NONE;
+        }
+
+        gesture_type_t type;
+        if (horizontal) {
+            type = dx < 0 ? GESTURE_SWIPE_LEFT : GESTURE_SWIPE_RIGHT;
+        } else {
+            type = dy < 0 ? GESTURE_SWIPE_UP : GESTURE_SWIPE_DOWN;
+        }
+        gesture_emit(g, type, now_ms, speed, fling);
+        return type;
+    }
+
+    if (duration > g->cfg.tap_max_ms) {
+        gesture_flush_tap(g);
+        return GESTURE_NONE;
+    }
+
+    if (g->tap_pending && now_ms - g->tap_ms <= g->cfg.double_tap_gap_ms &&
+        abs(g->start_x - g->tap_x) <= g->cfg.double_tap_slop_px &&
+        abs(g->start_y - g->tap_y) <= g->cfg.double_tap_slop_px) {
+        g->tap_pending = false;
+        gesture_emit(g, GESTURE_DOUBLE_TAP, now_ms, 0.0f, false);
+        return GESTURE_DOUBLE_TAP;
+    }
+
+    // 不能与前一次组成双击，前一次单独发出；这一次等待双击窗口
+    gesture_type_t flushed = gesture_flush_tap(g);
+    g->tap_pending = true;
+    g->tap_x = g->start_x;
+    g->tap_y = g->start_y;
+    g->tap_ms = now_ms;
+    g->tap_duration_ms = duration;
+    return flushed;
+}
+
+void gesture_init(gesture_t *g, const gesture_config_t *cfg, gesture_cb_t cb, void *user_data)
+{
+    const gesture_config_t def = GESTURE_DEFAULT_CONFIG();
+    g->cfg = (cfg != NULL) ? *cfg : def;
+    g->cb = cb;
+    g->user_data = user_data;
+    g->pressed = false;
+    gesture_cancel(g);
+}
+
+void gesture_cancel(gesture_t *g)
+{
+    g->cancelled = g->pressed;
+    g->pressed = false;
+    g->tap_pending = false;
+    g->long_press_fired = false;
+    g->moved = false;
+    g->vx = 0.0f;
+    g->vy = 0.0f;
+}
+
+gesture_type_t gesture_feed(gesture_t *g, bool pressed, int16_t x, int16_t y, uint32_t now_ms)
+{
+    // 双击窗口已过，单击确认
+    gesture_type_t flushed = GESTURE_NONE;
+    if (g->tap_pending && now_ms - g->tap_ms > g->cfg.double_tap_gap_ms) {
+        flushed = gesture_flush_tap(g);
+    }
+
+    // 被取消的按下：等手指抬起，否则抬起时会被当成一次新的单击
+    if (g->cancelled) {
+        g->cancelled = pressed;
+        return flushed;
+    }
+
+    if (pressed && !g->pressed) {
+        // 新的按下
+        g->pressed = true;
+        g->long_press_fired = false;
+        g->moved = false;
+        g->start_x = g->last_x = x;
+        g->start_y = g->last_y = y;
+        g->start_ms = g->last_ms = now_ms;
+        g->vx = 0.0f;
+        g->vy = 0.0f;
+        return flushed;
+    }
+
+    gesture_type_t type = GESTURE_NONE;
+    if (pressed) {
+        type = gesture_track(g, x, y, now_ms);
+    } else if (g->pressed) {
+        g->pressed = false;
+        type = gesture_release(g, now_ms);
+    }
+
+    return type != GESTURE_NONE ? type : flushed;
+}
+
+bool gesture_is_tracking(const gesture_t *g)
+{
+    return g->pressed || g->tap_pending || g->cancelled;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file     gesture.h
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    Gesture Recognizer Module Header
+ *
+ * 基于触摸采样的手势识别：滑动、快速滑动(fling)、长按、双击。
+ * 只依赖标准C头文件，可以在主机上用合成的触摸轨迹验证。
+ * 只在有触摸采样时计算，空闲时没有任何开销。
+ */
+
+#ifndef GESTURE_H
+#define GESTURE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 手势类型
+typedef enum {
+    GESTURE_NONE,
+    GESTURE_TAP,            // 单击（双击窗口结束后才触发，与双击互斥）
+    GESTURE_DOUBLE_TAP,     // 双击（第二次单击时触发，两次单击都不再触发GESTURE_TAP）
+    GESTURE_LONG_PRESS,     // 长按（按住期间触发，不必等抬起）
+    GESTURE_SWIPE_LEFT,
+    GESTURE_SWIPE_RIGHT,
+    GESTURE_SWIPE_UP,
+    GESTURE_SWIPE_DOWN,
+} gesture_type_t;
+
+// 识别阈值
+typedef struct {
+    uint16_t tap_slop_px;           // 单击/长按允许的最大移动距离
+    uint16_t tap_max_ms;            // 单击的最大按下时间
+    uint16_t double_tap_gap_ms;     // 两次单击的最大间隔
+    uint16_t double_tap_slop_px;    // 两次单击位置的最大距离
+    uint16_t long_press_ms;         // 长按时间
+    uint16_t swipe_min_px;          // 滑动的最小距离
+    uint16_t swipe_max_ms;          // 滑动的最大持续时间
+    uint16_t fling_min_px_s;        // 抬起时速度超过该值认为是fling
+} gesture_config_t;
+
+#define GESTURE_DEFAULT_CONFIG() {      \
+    .tap_slop_px = 15,                  \
+    .tap_max_ms = 300,                  \
+    .double_tap_gap_ms = 350,           \
+    .double_tap_slop_px = 40,           \
+    .long_press_ms = 600,               \
+    .swipe_min_px = 80,                 \
+    .swipe_max_ms = 800,                \
+    .fling_min_px_s = 800,              \
+}
+
+// 手势事件
+typedef struct {
+    gesture_type_t type;
+    int16_t x, y;                   // 起点坐标
+    int16_t dx, dy;                 // 总位移
+    uint32_t duration_ms;           // 按下持续时间
+    float velocity_px_s;            // 抬起时沿主方向的速度
+    bool fling;                     // 滑动是否为快速滑动
+} gesture_event_t;
+
+typedef void (*gesture_cb_t)(const gesture_event_t *event, void *user_data);
+
+// 识别器实例
+typedef struct {
+    gesture_config_t cfg;
+    gesture_cb_t cb;
+    void *user_data;
+    bool pressed;
+    bool long_press_fired;          // 本次按下已触发长按，抬起时不再识别其他手势
+    bool moved;                     // 本次按下已超出单击范围
+    bool cancelled;                 // 本次按下已被取消，抬起之前的采样都忽略
+    int16_t start_x, start_y;
+    uint32_t start_ms;
+    int16_t last_x, last_y;
+    uint32_t last_ms;
+    float vx, vy;                   // 速度估计 (px/s)
+    bool tap_pending;               // 上一次单击还在双击窗口内，尚未发出
+    int16_t tap_x, tap_y;
+    uint32_t tap_ms;                // 上一次单击抬起的时间
+    uint32_t tap_duration_ms;       // 上一次单击的按下时间
+} gesture_t;
+
+// 初始化识别器，cfg为NULL时使用默认阈值
+void gesture_init(gesture_t *g, const gesture_config_t *cfg, gesture_cb_t cb, void *user_data);
+
+// 取消当前手势（如界面切换时），不触发回调；手指还按着时，抬起前的采样都忽略
+void gesture_cancel(gesture_t *g);
+
+/**
+ * @brief 输入一个去抖后的触摸采样
+ *
+ * 只需在gesture_is_tracking()为真以及按下时调用，其余空闲时间无需调用。
+ * 单击在双击窗口结束后的第一次调用中发出。
+ *
+ * @return 本次采样识别出的手势，没有则为GESTURE_NONE
+ */
+gesture_type_t gesture_feed(gesture_t *g, bool pressed, int16_t x, int16_t y, uint32_t now_ms);
+
+// 是否正在跟踪一次按下（包括被取消、还没抬起的），或有单击在等待双击窗口结束
+bool gesture_is_tracking(const gesture_t *g);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GESTURE_H */
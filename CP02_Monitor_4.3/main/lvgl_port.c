@@ -12,14 +12,26 @@
 #include "esp_lcd_touch.h"
 #include "esp_timer.h"
 #include "esp_log.h"
+#include "esp_check.h"
 #include "lvgl.h"
 #include "lvgl_port.h"
+#include "ui_clock.h"
+#include "stack_profiler.h"
+#include "panel_rotate.h"
+#if LVGL_PORT_GDMA_BLEND_ENABLE
+#include "esp_async_memcpy.h"
+#include "esp_cache.h"
+#include "esp_heap_caps.h"
+#include "esp_memory_utils.h"
+#include "draw/sw/lv_draw_sw.h"
+#include "gdma_blend.h"
+#endif
 
 static const char *TAG = "lv_port";                      // Tag for logging
 static SemaphoreHandle_t lvgl_mux;                       // LVGL mutex for synchronization
 static TaskHandle_t lvgl_task_handle = NULL;             // Handle for the LVGL task
 
-#if EXAMPLE_LVGL_PORT_ROTATION_DEGREE != 0
+#if EXAMPLE_LVGL_PORT_ROTATION_DEGREE != 0 && !LVGL_PORT_BOUNCE_SCANOUT
 // Function to get the next frame buffer for double buffering
 static void *get_next_frame_buffer(esp_lcd_panel_handle_t panel_handle)
 {
@@ -34,58 +46,91 @@ static void *get_next_frame_buffer(esp_lcd_panel_handle_t panel_handle)
     }
     return next_fb;                                       // Return the next frame buffer
 }
+#endif /* EXAMPLE_LVGL_PORT_ROTATION_DEGREE */
+
+#if LVGL_PORT_BOUNCE_SCANOUT
+static const lv_color_t *scanout_buf = NULL;             // LVGL buffer currently sent to the panel
+static const lv_color_t *volatile scanout_next = NULL;   // Buffer flushed last, sent from the next frame on
+
+#if LVGL_PORT_COLOR_L8
+DRAM_ATTR static uint16_t l8_lut[256];                   // RGB332 to RGB565, in internal RAM for the bounce ISR
 
-// Function to rotate and copy pixels from one buffer to another
-IRAM_ATTR static void rotate_copy_pixel(const uint16_t *from, uint16_t *to, uint16_t x_start, uint16_t y_start, uint16_t x_end, uint16_t y_end, uint16_t w, uint16_t h, uint16_t rotation)
+static void l8_lut_init(void)
 {
-    int from_index = 0;                                   // Index for source buffer
-    int to_index = 0;                                     // Index for destination buffer
-    int to_index_const = 0;                               // Constant index for destination buffer
+    for (int i = 0; i < 256; i++) {
+        uint32_t r = (i >> 5) & 0x7;
+        uint32_t g = (i >> 2) & 0x7;
+        uint32_t b = i & 0x3;
+        // Scale each channel to the full range, so white stays white
+        l8_lut[i] = ((r * 31 + 3) / 7) << 11 | ((g * 63 + 3) / 7) << 5 | ((b * 31 + 1) / 3);
+    }
+}
 
-    switch (rotation) {
-    case 90:
-        to_index_const = (w - x_start - 1) * h;          // Calculate constant index for 90-degree rotation
-        for (int from_y = y_start; from_y < y_end + 1; from_y++) {
-            from_index = from_y * w + x_start;           // Calculate index in the source buffer
-            to_index = to_index_const + from_y;          // Calculate index in the destination buffer
-            for (int from_x = x_start; from_x < x_end + 1; from_x++) {
-                *(to + to_index) = *(from + from_index);  // Copy pixel
-                from_index += 1;                          // Move to the next pixel in the source
-                to_index -= h;                            // Move to the next pixel in the destination
-            }
-        }
-        break;
-    case 180:
-        to_index_const = h * w - x_start - 1;            // Calculate constant index for 180-degree rotation
-        for (int from_y = y_start; from_y < y_end + 1; from_y++) {
-            from_index = from_y * w + x_start;           // Calculate index in the source buffer
-            to_index = to_index_const - from_y * w;      // Calculate index in the destination buffer
-            for (int from_x = x_start; from_x < x_end + 1; from_x++) {
-                *(to + to_index) = *(from + from_index);  // Copy pixel
-                from_index += 1;                          // Move to the next pixel in the source
-                to_index -= 1;                            // Move to the next pixel in the destination
-            }
-        }
-        break;
-    case 270:
-        to_index_const = (x_start + 1) * h - 1;          // Calculate constant index for 270-degree rotation
-        for (int from_y = y_start; from_y < y_end + 1; from_y++) {
-            from_index = from_y * w + x_start;           // Calculate index in the source buffer
-            to_index = to_index_const - from_y;          // Calculate index in the destination buffer
-            for (int from_x = x_start; from_x < x_end + 1; from_x++) {
-                *(to + to_index) = *(from + from_index);  // Copy pixel
-                from_index += 1;                          // Move to the next pixel in the source
-                to_index += h;                            // Move to the next pixel in the destination
-            }
-        }
-        break;
-    default:
-        break;                                             // Do nothing for unsupported rotation angles
+#if EXAMPLE_LVGL_PORT_ROTATION_DEGREE == 0
+// Expand 8-bpp pixels to RGB565, four pixels per 32-bit read (bounce buffers always hold whole lines)
+IRAM_ATTR static void l8_expand(const uint8_t *from, uint16_t *to, int px)
+{
+    const uint32_t *src = (const uint32_t *)from;
+    uint32_t *dst = (uint32_t *)to;
+    for (int i = 0; i < px / 4; i++) {
+        uint32_t p = src[i];
+        dst[0] = l8_lut[p & 0xFF] | (uint32_t)l8_lut[(p >> 8) & 0xFF] << 16;
+        dst[1] = l8_lut[(p >> 16) & 0xFF] | (uint32_t)l8_lut[p >> 24] << 16;
+        dst += 2;
     }
 }
-#endif /* EXAMPLE_LVGL_PORT_ROTATION_DEGREE */
+#endif
+#endif /* LVGL_PORT_COLOR_L8 */
+
+static void flush_callback(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
+{
+    /* Action after last area refresh */
+    if (lv_disp_flush_is_last(drv)) {
+        /* Send `color_map` from the next frame on, the bounce buffer callback switches at the frame start */
+        ulTaskNotifyValueClear(NULL, ULONG_MAX);
+        scanout_next = color_map;
+
+        /* Wait until the panel stops reading the other buffer, LVGL draws into it next */
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+
+    lv_disp_flush_ready(drv); // Mark the display flush as complete
+}
+
+IRAM_ATTR bool lvgl_port_fill_bounce_buf(void *bounce_buf, int pos_px, int len_bytes)
+{
+    BaseType_t need_yield = pdFALSE; // Flag to check if a yield is needed
+    if (pos_px == 0) {
+        ui_clock_frame(); // A new frame starts scanning out, latch the UI time
+    }
+    if (pos_px == 0 && scanout_next != NULL) {
+        scanout_buf = scanout_next; // Switch buffers only between frames
+        scanout_next = NULL;
+        xTaskNotifyFromISR(lvgl_task_handle, ULONG_MAX, eNoAction, &need_yield); // Notify the LVGL task
+    }
+#if EXAMPLE_LVGL_PORT_ROTATION_DEGREE != 0
+    // Size of the unrotated LVGL buffer
+#if EXAMPLE_LVGL_PORT_ROTATION_90 || EXAMPLE_LVGL_PORT_ROTATION_270
+    const int w = LVGL_PORT_V_RES, h = LVGL_PORT_H_RES;
+#else
+    const int w = LVGL_PORT_H_RES, h = LVGL_PORT_V_RES;
+#endif
+    int y_start = pos_px / LVGL_PORT_H_RES;
+    int lines = len_bytes / sizeof(uint16_t) / LVGL_PORT_H_RES;
+#if LVGL_PORT_COLOR_L8
+    panel_rotate_fill_8((const uint8_t *)scanout_buf, bounce_buf, y_start, lines, w, h, LVGL_PORT_H_RES,
+                        EXAMPLE_LVGL_PORT_ROTATION_DEGREE, l8_lut);
+#else
+    panel_rotate_fill_16((const uint16_t *)scanout_buf, bounce_buf, y_start, lines, w, h, LVGL_PORT_H_RES,
+                         EXAMPLE_LVGL_PORT_ROTATION_DEGREE);
+#endif
+#else
+    l8_expand((const uint8_t *)(scanout_buf + pos_px), bounce_buf, len_bytes / sizeof(uint16_t));
+#endif
+    return (need_yield == pdTRUE);
+}
 
-#if LVGL_PORT_AVOID_TEAR_ENABLE
+#elif LVGL_PORT_AVOID_TEAR_ENABLE
 #if LVGL_PORT_DIRECT_MODE
 #if EXAMPLE_LVGL_PORT_ROTATION_DEGREE != 0
 
@@ -186,7 +231,7 @@ static void flush_dirty_copy(void *dst, void *src, lv_port_dirty_area_t *dirty_a
             y_end = dirty_area->inv_areas[i].y2;   // End Y coordinate
 
             // Rotate and copy pixel data from source to destination buffer
-            rotate_copy_pixel(src, dst, x_start, y_start, x_end, y_end, LV_HOR_RES, LV_VER_RES, EXAMPLE_LVGL_PORT_ROTATION_DEGREE);
+            panel_rotate_copy(src, dst, x_start, y_start, x_end, y_end, LV_HOR_RES, LV_VER_RES, EXAMPLE_LVGL_PORT_ROTATION_DEGREE);
         }
     }
 }
@@ -212,7 +257,7 @@ static void flush_callback(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t
 
             // Rotate and copy data from the whole screen LVGL's buffer to the next frame buffer
             next_fb = flush_get_next_buf(panel_handle);
-            rotate_copy_pixel((uint16_t *)color_map, next_fb, offsetx1, offsety1, offsetx2, offsety2, LV_HOR_RES, LV_VER_RES, EXAMPLE_LVGL_PORT_ROTATION_DEGREE);
+            panel_rotate_copy((uint16_t *)color_map, next_fb, offsetx1, offsety1, offsetx2, offsety2, LV_HOR_RES, LV_VER_RES, EXAMPLE_LVGL_PORT_ROTATION_DEGREE);
 
             /* Switch the current RGB frame buffer to `next_fb` */
             esp_lcd_panel_draw_bitmap(panel_handle, offsetx1, offsety1, offsetx2 + 1, offsety2 + 1, next_fb);
@@ -329,7 +374,7 @@ void flush_callback(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color
     void *next_fb = get_next_frame_buffer(panel_handle); // Get the next frame buffer
 
     /* Rotate and copy dirty area from the current LVGL's buffer to the next RGB frame buffer */
-    rotate_copy_pixel((uint16_t *)color_map, next_fb, offsetx1, offsety1, offsetx2, offsety2, LV_HOR_RES, LV_VER_RES, EXAMPLE_LVGL_PORT_ROTATION_DEGREE);
+    panel_rotate_copy((uint16_t *)color_map, next_fb, offsetx1, offsety1, offsetx2, offsety2, LV_HOR_RES, LV_VER_RES, EXAMPLE_LVGL_PORT_ROTATION_DEGREE);
 
     /* Switch the current RGB frame buffer to `next_fb` */
     esp_lcd_panel_draw_bitmap(panel_handle, offsetx1, offsety1, offsetx2 + 1, offsety2 + 1, next_fb);
@@ -366,6 +411,254 @@ void flush_callback(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color
 
 #endif /* LVGL_PORT_AVOID_TEAR_ENABLE */
 
+#if LVGL_PORT_GDMA_BLEND_ENABLE
+static gdma_blend_t gdma_blend;                         // Splits fills and copies into cache-aligned DMA rows
+static async_memcpy_handle_t gdma_mcp = NULL;           // Async memcpy (GDMA) driver handle
+static SemaphoreHandle_t gdma_done_sem = NULL;          // Given when the last in-flight transfer finishes
+static volatile uint32_t gdma_inflight = 0;             // Number of in-flight transfers
+
+static bool IRAM_ATTR gdma_done_cb(async_memcpy_handle_t mcp, async_memcpy_event_t *event, void *cb_args)
+{
+    BaseType_t need_yield = pdFALSE;
+    if (__atomic_sub_fetch(&gdma_inflight, 1, __ATOMIC_SEQ_CST) == 0) {
+        xSemaphoreGiveFromISR(gdma_done_sem, &need_yield); // All transfers are done
+    }
+    return need_yield == pdTRUE;
+}
+
+static bool gdma_backend_copy(void *user_ctx, void *dst, const void *src, size_t len)
+{
+    __atomic_add_fetch(&gdma_inflight, 1, __ATOMIC_SEQ_CST);
+    if (esp_async_memcpy(gdma_mcp, dst, (void *)src, len, gdma_done_cb, NULL) != ESP_OK) {
+        __atomic_sub_fetch(&gdma_inflight, 1, __ATOMIC_SEQ_CST); // Descriptor pool is full
+        return false;
+    }
+    return true;
+}
+
+static void gdma_backend_wait(void *user_ctx)
+{
+    // A stale token from an earlier batch only causes one extra loop
+    while (__atomic_load_n(&gdma_inflight, __ATOMIC_SEQ_CST) > 0) {
+        xSemaphoreTake(gdma_done_sem, portMAX_DELAY);
+    }
+}
+
+static bool gdma_backend_can_access(void *user_ctx, const void *ptr)
+{
+    return esp_ptr_dma_capable(ptr) || esp_ptr_dma_ext_capable(ptr); // Flash-mapped images can not be read by DMA
+}
+
+static void gdma_backend_sync_src(void *user_ctx, const void *addr, size_t len)
+{
+    if (esp_ptr_external_ram(addr)) {
+        esp_cache_msync((void *)addr, len, ESP_CACHE_MSYNC_FLAG_DIR_C2M); // Write back what the CPU drew
+    }
+}
+
+static void gdma_backend_sync_dst(void *user_ctx, void *addr, size_t len)
+{
+    if (esp_ptr_external_ram(addr)) {
+        // Write back and drop the lines, so neither a later eviction nor a CPU read sees stale data
+        esp_cache_msync(addr, len, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_INVALIDATE);
+    }
+}
+
+static const gdma_blend_backend_t gdma_backend = {
+    .copy = gdma_backend_copy,
+    .wait = gdma_backend_wait,
+    .can_access = gdma_backend_can_access,
+    .sync_src = gdma_backend_sync_src,
+    .sync_dst = gdma_backend_sync_dst,
+    .user_ctx = NULL,
+};
+
+static void gdma_blend_cb(lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc)
+{
+    lv_area_t blend_area;
+    if (!_lv_area_intersect(&blend_area, dsc->blend_area, draw_ctx->clip_area)) {
+        return;
+    }
+
+    lv_disp_t *disp = _lv_refr_get_disp_refreshing();
+    if (disp->driver->set_px_cb != NULL || disp->driver->screen_transp) {
+        gdma_blend_wait(&gdma_blend); // The destination is not plain RGB565 rows, wait for everything
+        lv_draw_sw_blend_basic(draw_ctx, dsc);
+        return;
+    }
+
+    lv_coord_t dest_stride = lv_area_get_width(draw_ctx->buf_area);
+    lv_color_t *dest_buf = (lv_color_t *)draw_ctx->buf + dest_stride * (blend_area.y1 - draw_ctx->buf_area->y1) +
+                           (blend_area.x1 - draw_ctx->buf_area->x1);
+    lv_coord_t w = lv_area_get_width(&blend_area);
+    lv_coord_t h = lv_area_get_height(&blend_area);
+
+    // Only opaque, unmasked, normal blending maps to a plain memory fill or copy
+    bool plain = dsc->opa >= LV_OPA_MAX && dsc->blend_mode == LV_BLEND_MODE_NORMAL &&
+                 (dsc->mask_buf == NULL || dsc->mask_res == LV_DRAW_MASK_RES_FULL_COVER);
+    if (plain) {
+        bool handled;
+        if (dsc->src_buf == NULL) {
+            handled = gdma_blend_fill16(&gdma_blend, (uint16_t *)dest_buf, dest_stride, w, h, dsc->color.full);
+        } else {
+            lv_coord_t src_stride = lv_area_get_width(dsc->blend_area);
+            const lv_color_t *src_buf = dsc->src_buf + src_stride * (blend_area.y1 - dsc->blend_area->y1) +
+                                        (blend_area.x1 - dsc->blend_area->x1);
+            handled = gdma_blend_copy16(&gdma_blend, (uint16_t *)dest_buf, dest_stride,
+                                        (const uint16_t *)src_buf, src_stride, w, h);
+        }
+        if (handled) {
+            return;
+        }
+    }
+
+    // Small, masked or translucent: software blending, once the DMA fills below it are done
+    gdma_blend_wait_area(&gdma_blend, (const uint16_t *)dest_buf, dest_stride, w, h);
+    if (dsc->src_buf != NULL) {
+        lv_coord_t src_w = lv_area_get_width(dsc->blend_area);
+        gdma_blend_wait_area(&gdma_blend, (const uint16_t *)dsc->src_buf, src_w, src_w,
+                             lv_area_get_height(dsc->blend_area));
+    }
+    lv_draw_sw_blend_basic(draw_ctx, dsc);
+}
+
+static void gdma_wait_for_finish(lv_draw_ctx_t *draw_ctx)
+{
+    gdma_blend_wait(&gdma_blend); // Called by LVGL before flushing and around layers, blends wait for themselves
+    lv_draw_sw_wait_for_finish(draw_ctx);
+}
+
+static void gdma_draw_ctx_init(lv_disp_drv_t *drv, lv_draw_ctx_t *draw_ctx)
+{
+    lv_draw_sw_init_ctx(drv, draw_ctx);
+    lv_draw_sw_ctx_t *sw_ctx = (lv_draw_sw_ctx_t *)draw_ctx;
+    sw_ctx->blend = gdma_blend_cb;
+    sw_ctx->blend_waits = 1;
+    sw_ctx->base_draw.wait_for_finish = gdma_wait_for_finish;
+}
+
+static void gdma_draw_ctx_deinit(lv_disp_drv_t *drv, lv_draw_ctx_t *draw_ctx)
+{
+    gdma_blend_wait(&gdma_blend);
+    lv_draw_sw_deinit_ctx(drv, draw_ctx);
+}
+
+static esp_err_t gdma_blend_setup(lv_disp_drv_t *disp_drv)
+{
+    gdma_done_sem = xSemaphoreCreateBinary();
+    ESP_RETURN_ON_FALSE(gdma_done_sem, ESP_ERR_NO_MEM, TAG, "Create GDMA semaphore failed");
+
+    async_memcpy_config_t mcp_config = ASYNC_MEMCPY_DEFAULT_CONFIG();
+    mcp_config.backlog = LVGL_PORT_GDMA_BLEND_BACKLOG;
+    mcp_config.psram_trans_align = LVGL_PORT_GDMA_BLEND_ALIGN;
+    mcp_config.sram_trans_align = 4;
+    ESP_RETURN_ON_ERROR(esp_async_memcpy_install(&mcp_config, &gdma_mcp), TAG, "Install async memcpy failed");
+
+    // Template row for fills, kept in internal RAM so DMA reads it without touching the cache
+    uint16_t *fill_row = heap_caps_aligned_alloc(LVGL_PORT_GDMA_BLEND_ALIGN, LVGL_PORT_H_RES * sizeof(uint16_t),
+                                                 MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    ESP_RETURN_ON_FALSE(fill_row, ESP_ERR_NO_MEM, TAG, "Allocate GDMA fill row failed");
+
+    const gdma_blend_config_t blend_config = {
+        .backend = &gdma_backend,
+        .align = LVGL_PORT_GDMA_BLEND_ALIGN,
+        .min_span_bytes = 2 * LVGL_PORT_GDMA_BLEND_ALIGN,
+        .min_pixels = LVGL_PORT_GDMA_BLEND_MIN_PIXELS,
+        .fill_row = fill_row,
+        .fill_row_px = LVGL_PORT_H_RES,
+    };
+    gdma_blend_init(&gdma_blend, &blend_config);
+
+    disp_drv->draw_ctx_init = gdma_draw_ctx_init;
+    disp_drv->draw_ctx_deinit = gdma_draw_ctx_deinit;
+    disp_drv->draw_ctx_size = sizeof(lv_draw_sw_ctx_t);
+    ESP_LOGI(TAG, "GDMA blend enabled, min %d pixels", LVGL_PORT_GDMA_BLEND_MIN_PIXELS);
+    return ESP_OK;
+}
+#endif /* LVGL_PORT_GDMA_BLEND_ENABLE */
+
+#if LVGL_PORT_REFR_BUDGET_ENABLE
+static lv_refr_prio_t refr_prio_callback(lv_disp_drv_t *drv, const lv_obj_t *obj)
+{
+    lv_disp_t *disp = lv_obj_get_disp(obj);
+
+    // Message boxes and other modal UI live on the top layer
+    if (lv_obj_get_screen(obj) == lv_disp_get_layer_top(disp)) {
+        return LV_REFR_PRIO_HIGH;
+    }
+
+    // The pressed object (and e.g. its label) gives the touch feedback, a scroll moves all children
+    lv_indev_t *indev = NULL;
+    while ((indev = lv_indev_get_next(indev)) != NULL) {
+        if (indev->driver->disp != disp || indev->driver->type != LV_INDEV_TYPE_POINTER) {
+            continue;
+        }
+        lv_obj_t *act_obj = indev->proc.types.pointer.act_obj;
+        if (act_obj && (obj == act_obj || lv_obj_get_parent(obj) == act_obj)) {
+            return LV_REFR_PRIO_HIGH;
+        }
+        lv_obj_t *scroll_obj = indev->proc.types.pointer.scroll_obj;
+        for (const lv_obj_t *o = obj; scroll_obj && o; o = lv_obj_get_parent(o)) {
+            if (o == scroll_obj) {
+                return LV_REFR_PRIO_HIGH;
+            }
+        }
+    }
+
+    for (const lv_obj_t *o = obj; o; o = lv_obj_get_parent(o)) {
+        if (lv_obj_has_flag(o, LVGL_PORT_OBJ_FLAG_DECOR)) {
+            return LV_REFR_PRIO_LOW;
+        }
+    }
+    return LV_REFR_PRIO_MID;
+}
+#endif /* LVGL_PORT_REFR_BUDGET_ENABLE */
+
+static lvgl_port_render_stats_t render_stats;           // Render and flush timing
+static int64_t frame_flush_us = 0;                      // Flush time accumulated in the current refresh
+static uint32_t frame_flush_count = 0;                  // Flushes in the current refresh
+static uint32_t flush_depth = 0;                        // A full-copy flush re-renders inside the flush callback
+
+static void flush_timed_callback(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
+{
+    if (flush_depth++ > 0) {
+        flush_callback(drv, area, color_map); // Nested flush, already timed by the outer one
+        flush_depth--;
+        return;
+    }
+    int64_t start_us = esp_timer_get_time();
+    flush_callback(drv, area, color_map);
+    frame_flush_us += esp_timer_get_time() - start_us;
+    frame_flush_count++;
+    flush_depth--;
+}
+
+static void refr_timer_timed_cb(lv_timer_t *timer)
+{
+    frame_flush_us = 0;
+    frame_flush_count = 0;
+    int64_t start_us = esp_timer_get_time();
+    _lv_disp_refr_timer(timer);
+    if (frame_flush_count == 0) {
+        return; // Nothing was invalidated
+    }
+
+    uint32_t total_us = (uint32_t)(esp_timer_get_time() - start_us);
+    uint32_t flush_us = (uint32_t)frame_flush_us;
+    uint32_t render_us = total_us > flush_us ? total_us - flush_us : 0;
+    render_stats.frames++;
+    render_stats.render_us = render_us;
+    render_stats.flush_us = flush_us;
+    render_stats.render_total_us += render_us;
+    render_stats.flush_total_us += flush_us;
+    if (render_us > render_stats.render_max_us) {
+        render_stats.render_max_us = render_us;
+    }
+    if (flush_us > render_stats.flush_max_us) {
+        render_stats.flush_max_us = flush_us;
+    }
+}
+
 static lv_disp_t *display_init(esp_lcd_panel_handle_t panel_handle)
 {
     assert(panel_handle); // Ensure the panel handle is valid
@@ -379,7 +672,19 @@ static lv_disp_t *display_init(esp_lcd_panel_handle_t panel_handle)
     int buffer_size = 0; // Size of the buffer
 
     ESP_LOGD(TAG, "Malloc memory for LVGL buffer");
-#if LVGL_PORT_AVOID_TEAR_ENABLE
+#if LVGL_PORT_BOUNCE_SCANOUT
+    // Two unrotated buffers for LVGL, the RGB panel has no frame buffer of its own in this mode
+    buffer_size = LVGL_PORT_H_RES * LVGL_PORT_V_RES;
+    buf1 = heap_caps_calloc(1, buffer_size * sizeof(lv_color_t), MALLOC_CAP_SPIRAM);
+    buf2 = heap_caps_calloc(1, buffer_size * sizeof(lv_color_t), MALLOC_CAP_SPIRAM);
+    assert(buf1 && buf2); // Ensure allocation succeeded
+#if LVGL_PORT_COLOR_L8
+    l8_lut_init();
+#endif
+    scanout_buf = buf2; // Send the cleared buffer while LVGL draws the first frame into buf1
+    ESP_LOGI(TAG, "Bounce buffer scanout, %d-bpp, rotation %d, LVGL buffer size: 2 x %dKB", LV_COLOR_DEPTH,
+             EXAMPLE_LVGL_PORT_ROTATION_DEGREE, buffer_size * sizeof(lv_color_t) / 1024);
+#elif LVGL_PORT_AVOID_TEAR_ENABLE
     // To avoid tearing effect, at least two frame buffers are needed: one for LVGL rendering and another for RGB output
     buffer_size = LVGL_PORT_H_RES * LVGL_PORT_V_RES;
 #if (LVGL_PORT_LCD_RGB_BUFFER_NUMS == 3) && (EXAMPLE_LVGL_PORT_ROTATION_DEGREE == 0) && LVGL_PORT_FULL_REFRESH
@@ -415,7 +720,7 @@ static lv_disp_t *display_init(esp_lcd_panel_handle_t panel_handle)
     disp_drv.hor_res = LVGL_PORT_H_RES; // Set horizontal resolution
     disp_drv.ver_res = LVGL_PORT_V_RES; // Set vertical resolution
 #endif
-    disp_drv.flush_cb = flush_callback; // Set the flush callback
+    disp_drv.flush_cb = flush_timed_callback; // Set the flush callback, timed for the render statistics
     disp_drv.draw_buf = &disp_buf; // Set the draw buffer
     disp_drv.user_data = panel_handle; // Set user data to panel handle
 #if LVGL_PORT_FULL_REFRESH
@@ -423,7 +728,43 @@ static lv_disp_t *display_init(esp_lcd_panel_handle_t panel_handle)
 #elif LVGL_PORT_DIRECT_MODE
     disp_drv.direct_mode = 1; // Enable direct mode
 #endif
-    return lv_disp_drv_register(&disp_drv); // Register the display driver
+#if LVGL_PORT_REFR_BUDGET_ENABLE
+    disp_drv.refr_prio_cb = refr_prio_callback; // Redraw priority of the invalidated areas
+#endif
+#if LVGL_PORT_GDMA_BLEND_ENABLE
+    if (gdma_blend_setup(&disp_drv) != ESP_OK) {
+        ESP_LOGW(TAG, "GDMA blend unavailable, using software blending"); // Keep the default draw context
+    }
+#endif
+    lv_disp_t *disp = lv_disp_drv_register(&disp_drv); // Register the display driver
+    lv_timer_set_cb(disp->refr_timer, refr_timer_timed_cb); // Time each refresh, split into render and flush
+    return disp;
+}
+
+static touch_filter_t touch_filter;                     // Touch coordinate filter and debounce state machine
+static gesture_t touch_gesture;                         // Gesture recognizer fed with the filtered samples
+static lvgl_port_touch_stats_t touch_stats;             // Touch input statistics
+static uint64_t touch_i2c_total_us = 0;                 // Accumulated I2C read time, for the average
+static int64_t touch_last_read_us = 0;                  // Timestamp of the previous read
+static int64_t touch_first_raw_us = 0;                  // Timestamp of the first raw press sample of the current touch
+
+static void touch_gesture_init(gesture_cb_t cb, void *user_data)
+{
+    gesture_config_t gesture_cfg = GESTURE_DEFAULT_CONFIG();
+    gesture_cfg.tap_slop_px = LVGL_PORT_GESTURE_TAP_SLOP_PX;
+    gesture_cfg.double_tap_gap_ms = LVGL_PORT_GESTURE_DOUBLE_TAP_MS;
+    gesture_cfg.long_press_ms = LVGL_PORT_GESTURE_LONG_PRESS_MS;
+    gesture_cfg.swipe_min_px = LVGL_PORT_GESTURE_SWIPE_MIN_PX;
+    gesture_cfg.fling_min_px_s = LVGL_PORT_GESTURE_FLING_PX_S;
+    gesture_init(&touch_gesture, &gesture_cfg, cb, user_data);
+}
+
+static void touchpad_set_period(lv_indev_drv_t *indev_drv, uint32_t period_ms)
+{
+    if (indev_drv->read_timer && touch_stats.poll_period_ms != period_ms) {
+        lv_timer_set_period(indev_drv->read_timer, period_ms); // Switch the polling rate
+        touch_stats.poll_period_ms = period_ms;
+    }
 }
 
 static void touchpad_read(lv_indev_drv_t *indev_drv, lv_indev_data_t *data)
@@ -431,23 +772,64 @@ static void touchpad_read(lv_indev_drv_t *indev_drv, lv_indev_data_t *data)
     esp_lcd_touch_handle_t tp = (esp_lcd_touch_handle_t)indev_drv->user_data; // Get touchpad handle from user data
     assert(tp); // Ensure touchpad handle is valid
 
-    uint16_t touchpad_x; // Variable for X coordinate
-    uint16_t touchpad_y; // Variable for Y coordinate
+    uint16_t touchpad_x = 0; // Variable for X coordinate
+    uint16_t touchpad_y = 0; // Variable for Y coordinate
     uint8_t touchpad_cnt = 0; // Variable for touch count
 
     /* Read data from touch controller into memory */
+    int64_t start_us = esp_timer_get_time();
     esp_lcd_touch_read_data(tp); // Read data from touch controller
+    int64_t now_us = esp_timer_get_time();
+
+    uint32_t i2c_us = (uint32_t)(now_us - start_us);
+    touch_stats.read_count++;
+    touch_i2c_total_us += i2c_us;
+    touch_stats.i2c_avg_us = (uint32_t)(touch_i2c_total_us / touch_stats.read_count);
+    if (i2c_us > touch_stats.i2c_max_us) {
+        touch_stats.i2c_max_us = i2c_us;
+    }
 
     /* Read data from touch controller */
     bool touchpad_pressed = esp_lcd_touch_get_coordinates(tp, &touchpad_x, &touchpad_y, NULL, &touchpad_cnt, 1); // Get touch coordinates
-    if (touchpad_pressed && touchpad_cnt > 0) {
-        data->point.x = touchpad_x; // Set the X coordinate
-        data->point.y = touchpad_y; // Set the Y coordinate
+    bool raw_pressed = touchpad_pressed && touchpad_cnt > 0;
+
+    touch_state_t prev_state = touch_filter_get_state(&touch_filter);
+    if (raw_pressed && prev_state == TOUCH_STATE_IDLE) {
+        // The touch may have started any time since the previous read
+        touch_first_raw_us = (touch_last_read_us > 0) ? touch_last_read_us : now_us;
+    }
+    touch_last_read_us = now_us;
+
+    int16_t x, y;
+    bool pressed = touch_filter_update(&touch_filter, raw_pressed, (int16_t)touchpad_x, (int16_t)touchpad_y,
+                                       (uint32_t)(now_us / 1000), &x, &y);
+    if (pressed && (prev_state == TOUCH_STATE_IDLE || prev_state == TOUCH_STATE_PRESS_PENDING)) {
+        // Worst-case latency from finger contact to the press reported to LVGL
+        uint32_t latency_ms = (uint32_t)((now_us - touch_first_raw_us) / 1000);
+        touch_stats.press_count++;
+        touch_stats.press_latency_ms = latency_ms;
+        if (latency_ms > touch_stats.press_latency_max_ms) {
+            touch_stats.press_latency_max_ms = latency_ms;
+        }
+    }
+
+    data->point.x = x; // Set the filtered X coordinate
+    data->point.y = y; // Set the filtered Y coordinate
+    if (pressed) {
         data->state = LV_INDEV_STATE_PRESSED; // Set state to pressed
-        ESP_LOGD(TAG, "Touch position: %d,%d", touchpad_x, touchpad_y); // Log touch position
+        ESP_LOGD(TAG, "Touch position: %d,%d (raw %d,%d)", x, y, touchpad_x, touchpad_y); // Log touch position
     } else {
         data->state = LV_INDEV_STATE_RELEASED; // Set state to released
     }
+
+    // Only feed the gesture recognizer while a touch or a pending tap is in progress, idle reads cost nothing
+    if (pressed || gesture_is_tracking(&touch_gesture)) {
+        gesture_feed(&touch_gesture, pressed, x, y, (uint32_t)(now_us / 1000));
+    }
+
+    // Poll fast while touched or waiting for a second tap, slow down when idle
+    bool active = touch_filter_is_active(&touch_filter) || gesture_is_tracking(&touch_gesture);
+    touchpad_set_period(indev_drv, active ? LVGL_PORT_TOUCH_ACTIVE_PERIOD_MS : LVGL_PORT_TOUCH_IDLE_PERIOD_MS);
 }
 
 static lv_indev_t *indev_init(esp_lcd_touch_handle_t tp)
@@ -456,15 +838,27 @@ static lv_indev_t *indev_init(esp_lcd_touch_handle_t tp)
 
     static lv_indev_drv_t indev_drv_tp; // Static input device driver
 
+    touch_filter_config_t filter_cfg = TOUCH_FILTER_DEFAULT_CONFIG();
+    filter_cfg.dead_zone_px = LVGL_PORT_TOUCH_DEAD_ZONE_PX;
+    filter_cfg.predict_ms = LVGL_PORT_TOUCH_PREDICT_MS;
+    filter_cfg.width = LVGL_PORT_H_RES;
+    filter_cfg.height = LVGL_PORT_V_RES;
+    filter_cfg.release_debounce = LVGL_PORT_TOUCH_RELEASE_DEBOUNCE;
+    touch_filter_init(&touch_filter, &filter_cfg); // Initialize the touch filter
+    touch_gesture_init(NULL, NULL); // No gesture callback until a view registers one
+
     /* Register a touchpad input device */
     lv_indev_drv_init(&indev_drv_tp); // Initialize the input device driver
     indev_drv_tp.type = LV_INDEV_TYPE_POINTER; // Set the device type to pointer (touchpad)
     indev_drv_tp.read_cb = touchpad_read; // Set the read callback function
     indev_drv_tp.user_data = tp; // Set user data to the touch panel handle
 
-    return lv_indev_drv_register(&indev_drv_tp); // Register the input device driver
+    lv_indev_t *indev = lv_indev_drv_register(&indev_drv_tp); // Register the input device driver
+    touchpad_set_period(&indev_drv_tp, LVGL_PORT_TOUCH_IDLE_PERIOD_MS); // Start with the idle polling rate
+    return indev;
 }
 
+#if !LV_TICK_CUSTOM
 static void tick_increment(void *arg)
 {
     /* Tell LVGL how many milliseconds have elapsed */
@@ -482,6 +876,7 @@ static esp_err_t tick_init(void)
     ESP_ERROR_CHECK(esp_timer_create(&lvgl_tick_timer_args, &lvgl_tick_timer)); // Create the timer
     return esp_timer_start_periodic(lvgl_tick_timer, LVGL_PORT_TICK_PERIOD_MS * 1000); // Start the timer
 }
+#endif
 
 static void lvgl_port_task(void *arg)
 {
@@ -506,7 +901,9 @@ static void lvgl_port_task(void *arg)
 esp_err_t lvgl_port_init(esp_lcd_panel_handle_t lcd_handle, esp_lcd_touch_handle_t tp_handle)
 {
     lv_init(); // Initialize LVGL
+#if !LV_TICK_CUSTOM
     ESP_ERROR_CHECK(tick_init()); // Initialize the tick timer
+#endif
 
     lv_disp_t *disp = display_init(lcd_handle); // Initialize the display
     assert(disp); // Ensure the display initialization was successful
@@ -539,6 +936,7 @@ esp_err_t lvgl_port_init(esp_lcd_panel_handle_t lcd_handle, esp_lcd_touch_handle
         ESP_LOGE(TAG, "Failed to create LVGL task"); // Log error if task creation fails
         return ESP_FAIL; // Return failure
     }
+    stack_profiler_register("lvgl", LVGL_PORT_TASK_STACK_SIZE, "CONFIG_EXAMPLE_LVGL_PORT_TASK_STACK_SIZE_KB"); // Track the stack high-water mark
 
     return ESP_OK; // Return success
 }
@@ -560,7 +958,10 @@ void lvgl_port_unlock(void)
 bool lvgl_port_notify_rgb_vsync(void)
 {
     BaseType_t need_yield = pdFALSE; // Flag to check if a yield is needed
-#if LVGL_PORT_FULL_REFRESH && (LVGL_PORT_LCD_RGB_BUFFER_NUMS == 3) && (EXAMPLE_LVGL_PORT_ROTATION_DEGREE == 0)
+    ui_clock_frame(); // Latch the UI time to the frame that starts now
+#if LVGL_PORT_BOUNCE_SCANOUT
+    // Buffers are switched at the frame start in `lvgl_port_fill_bounce_buf()`
+#elif LVGL_PORT_FULL_REFRESH && (LVGL_PORT_LCD_RGB_BUFFER_NUMS == 3) && (EXAMPLE_LVGL_PORT_ROTATION_DEGREE == 0)
     if (lvgl_port_rgb_next_buf != lvgl_port_rgb_last_buf) {
         lvgl_port_flush_next_buf = lvgl_port_rgb_last_buf; // Set next buffer for flushing
         lvgl_port_rgb_last_buf = lvgl_port_rgb_next_buf; // Update the last buffer
@@ -571,3 +972,29 @@ bool lvgl_port_notify_rgb_vsync(void)
 #endif
     return (need_yield == pdTRUE); // Return whether a yield is needed
 }
+
+void lvgl_port_get_touch_stats(lvgl_port_touch_stats_t *stats)
+{
+    assert(stats);
+    if (lvgl_port_lock(-1)) {
+        *stats = touch_stats; // Copy under the LVGL mutex, the read callback runs in the LVGL task
+        lvgl_port_unlock();
+    }
+}
+
+void lvgl_port_get_render_stats(lvgl_port_render_stats_t *stats)
+{
+    assert(stats);
+    if (lvgl_port_lock(-1)) {
+        *stats = render_stats; // Copy under the LVGL mutex, the refresh timer runs in the LVGL task
+        lvgl_port_unlock();
+    }
+}
+
+void lvgl_port_set_gesture_cb(gesture_cb_t cb, void *user_data)
+{
+    if (lvgl_port_lock(-1)) {
+        touch_gesture_init(cb, user_data); // Reset the recognizer with the new callback
+        lvgl_port_unlock();
+    }
+}
@@ -12,6 +12,8 @@
 #include "esp_lcd_types.h"
 #include "esp_lcd_touch.h"
 #include "lvgl.h"
+#include "touch_filter.h"
+#include "gesture.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -53,6 +55,53 @@ extern "C" {
 #endif
 #define LVGL_PORT_BUFFER_HEIGHT         (CONFIG_EXAMPLE_LVGL_PORT_BUF_HEIGHT)
 
+/**
+ * GDMA blend related parameters, can be adjusted by users:
+ *  Large opaque fills and copies are offloaded to the async memcpy (GDMA) engine.
+ *  Only the cache-line aligned middle of each row is transferred by DMA, the CPU handles the row edges.
+ *  Rows that follow each other in memory are sent as one transfer.
+ *
+ */
+#if CONFIG_EXAMPLE_LVGL_PORT_GDMA_BLEND
+#define LVGL_PORT_GDMA_BLEND_ENABLE     (1)
+#define LVGL_PORT_GDMA_BLEND_MIN_PIXELS (CONFIG_EXAMPLE_LVGL_PORT_GDMA_BLEND_MIN_PIXELS)   // Smaller areas are drawn by the CPU
+#define LVGL_PORT_GDMA_BLEND_BACKLOG    (32)    // Maximum number of queued DMA transfers
+#define LVGL_PORT_GDMA_BLEND_ALIGN      (64)    // PSRAM transfer alignment, also the largest data cache line size
+#else
+#define LVGL_PORT_GDMA_BLEND_ENABLE     (0)
+#endif
+
+/**
+ * Refresh budget related parameters (`CONFIG_LV_USE_REFR_BUDGET`):
+ *  When a refresh would take longer than `CONFIG_LV_REFR_BUDGET_MS`, areas are drawn by priority
+ *  and the rest is deferred to the next refresh:
+ *      - High: the pressed or scrolled object, and the top layer (message boxes)
+ *      - Mid: everything else, e.g. values
+ *      - Low: objects with `LVGL_PORT_OBJ_FLAG_DECOR` and their children
+ *
+ */
+#if CONFIG_LV_USE_REFR_BUDGET
+#define LVGL_PORT_REFR_BUDGET_ENABLE    (1)
+#else
+#define LVGL_PORT_REFR_BUDGET_ENABLE    (0)
+#endif
+#define LVGL_PORT_OBJ_FLAG_DECOR        (LV_OBJ_FLAG_USER_1)    // Mark decorations which can be redrawn late
+
+/**
+ * Touch input related parameters, can be adjusted by users
+ *
+ */
+#define LVGL_PORT_TOUCH_IDLE_PERIOD_MS      (CONFIG_EXAMPLE_TOUCH_IDLE_PERIOD_MS)       // Touch polling period when idle, in milliseconds
+#define LVGL_PORT_TOUCH_ACTIVE_PERIOD_MS    (CONFIG_EXAMPLE_TOUCH_ACTIVE_PERIOD_MS)     // Touch polling period when touched, in milliseconds
+#define LVGL_PORT_TOUCH_DEAD_ZONE_PX        (CONFIG_EXAMPLE_TOUCH_DEAD_ZONE_PX)         // Jitter smaller than this is not reported
+#define LVGL_PORT_TOUCH_PREDICT_MS          (CONFIG_EXAMPLE_TOUCH_PREDICT_MS)           // Touch position prediction time, `0` disables it
+#define LVGL_PORT_TOUCH_RELEASE_DEBOUNCE    (CONFIG_EXAMPLE_TOUCH_RELEASE_DEBOUNCE)     // Released samples needed to confirm a release
+#define LVGL_PORT_GESTURE_TAP_SLOP_PX       (CONFIG_EXAMPLE_GESTURE_TAP_SLOP_PX)        // Movement allowed for a tap or long press
+#define LVGL_PORT_GESTURE_DOUBLE_TAP_MS     (CONFIG_EXAMPLE_GESTURE_DOUBLE_TAP_MS)      // Double-tap window, a tap is reported after it
+#define LVGL_PORT_GESTURE_LONG_PRESS_MS     (CONFIG_EXAMPLE_GESTURE_LONG_PRESS_MS)      // Hold time of a long press
+#define LVGL_PORT_GESTURE_SWIPE_MIN_PX      (CONFIG_EXAMPLE_GESTURE_SWIPE_MIN_PX)       // Minimum swipe distance
+#define LVGL_PORT_GESTURE_FLING_PX_S        (CONFIG_EXAMPLE_GESTURE_FLING_PX_S)         // Release speed of a fling, which halves the swipe distance
+
 /**
  * Avoid tering related configurations, can be adjusted by users.
  *
@@ -104,7 +153,7 @@ extern "C" {
 #elif EXAMPLE_LVGL_PORT_ROTATION_DEGREE == 270
 #define EXAMPLE_LVGL_PORT_ROTATION_270  (1)
 #endif
-#ifdef LVGL_PORT_LCD_RGB_BUFFER_NUMS
+#if defined(LVGL_PORT_LCD_RGB_BUFFER_NUMS) && !CONFIG_EXAMPLE_LVGL_PORT_ROTATION_BOUNCE
 #undef LVGL_PORT_LCD_RGB_BUFFER_NUMS
 #define LVGL_PORT_LCD_RGB_BUFFER_NUMS   (3)
 #endif
@@ -115,6 +164,39 @@ extern "C" {
 #define LVGL_PORT_DIRECT_MODE           (0)
 #endif /* LVGL_PORT_AVOID_TEAR_ENABLE */
 
+/**
+ * Bounce buffer scanout related parameters:
+ *  The RGB panel runs without frame buffers. LVGL draws into two buffers in PSRAM and the bounce buffer callback
+ *  converts each block of lines while filling the bounce buffer in internal RAM, in one of these modes:
+ *      - 8-bpp colour (`CONFIG_EXAMPLE_LCD_COLOR_L8`): LVGL renders RGB332 (`LV_COLOR_DEPTH` 8), half the size of
+ *        RGB565, and a 256-entry LUT expands it. Gradients use ordered dithering to hide the 3-3-2 banding.
+ *      - Rotation (`CONFIG_EXAMPLE_LVGL_PORT_ROTATION_BOUNCE`): the unrotated LVGL buffer is read in rotated order,
+ *        so rotation costs no extra PSRAM pass.
+ *
+ */
+#if CONFIG_EXAMPLE_LCD_COLOR_L8
+#define LVGL_PORT_COLOR_L8              (1)
+#else
+#define LVGL_PORT_COLOR_L8              (0)
+#if LV_COLOR_DEPTH != 16
+#error "The RGB panel takes RGB565, enable CONFIG_EXAMPLE_LCD_COLOR_L8 for LV_COLOR_DEPTH 8"
+#endif
+#endif
+#if CONFIG_EXAMPLE_LVGL_PORT_ROTATION_BOUNCE
+#define LVGL_PORT_ROTATION_BOUNCE       (1)
+#else
+#define LVGL_PORT_ROTATION_BOUNCE       (0)
+#endif
+#define LVGL_PORT_BOUNCE_SCANOUT        (LVGL_PORT_COLOR_L8 || LVGL_PORT_ROTATION_BOUNCE)
+#if LVGL_PORT_BOUNCE_SCANOUT
+#if !LVGL_PORT_AVOID_TEAR_ENABLE || LVGL_PORT_LCD_RGB_BUFFER_NUMS != 2
+#error "Bounce buffer scanout needs avoid tearing mode 1 or 3"
+#endif
+#if EXAMPLE_LVGL_PORT_ROTATION_DEGREE != 0 && !LVGL_PORT_ROTATION_BOUNCE
+#error "8-bpp colour mode only supports rotation in the bounce buffer"
+#endif
+#endif
+
 /**
  * @brief Initialize LVGL port
  *
@@ -154,6 +236,77 @@ void lvgl_port_unlock(void);
  */
 bool lvgl_port_notify_rgb_vsync(void);
 
+/**
+ * @brief Fill a bounce buffer of the RGB panel from the LVGL buffer (bounce buffer scanout only)
+ *
+ * Called from the `on_bounce_empty` ISR callback. At the start of each frame it switches to the buffer
+ * flushed last, so the panel never shows a frame that LVGL is still drawing.
+ *
+ * @param[out] bounce_buf: Bounce buffer to fill with RGB565 pixels
+ * @param[in] pos_px: Position of the first pixel in the frame
+ * @param[in] len_bytes: Length of the bounce buffer, in bytes
+ *
+ * @return
+ *      - true:  The tasks need to be re-scheduled
+ *      - false: The tasks don't need to be re-scheduled
+ */
+bool lvgl_port_fill_bounce_buf(void *bounce_buf, int pos_px, int len_bytes);
+
+/**
+ * @brief Touch input statistics
+ *
+ */
+typedef struct {
+    uint32_t read_count;            // Number of touch controller reads
+    uint32_t i2c_avg_us;            // Average I2C read time, in microseconds
+    uint32_t i2c_max_us;            // Maximum I2C read time, in microseconds
+    uint32_t press_count;           // Number of confirmed presses
+    uint32_t press_latency_ms;      // Worst-case latency of the last press (contact to report), in milliseconds
+    uint32_t press_latency_max_ms;  // Maximum press latency, in milliseconds
+    uint32_t poll_period_ms;        // Current touch polling period, in milliseconds
+} lvgl_port_touch_stats_t;
+
+/**
+ * @brief Get touch input statistics
+ *
+ * @param[out] stats: Statistics output
+ */
+void lvgl_port_get_touch_stats(lvgl_port_touch_stats_t *stats);
+
+/**
+ * @brief Render statistics
+ *
+ * Each refresh that redraws something is split into render time (drawing into the LVGL buffer) and flush time
+ * (copying to the frame buffer and waiting for the panel). A full-copy flush re-renders the whole screen inside
+ * the flush callback and is counted as flush time.
+ */
+typedef struct {
+    uint32_t frames;                // Number of refreshes that redrew something
+    uint32_t render_us;             // Render time of the last frame, in microseconds
+    uint32_t render_max_us;         // Maximum render time, in microseconds
+    uint32_t flush_us;              // Flush time of the last frame, in microseconds
+    uint32_t flush_max_us;          // Maximum flush time, in microseconds
+    uint64_t render_total_us;       // Accumulated render time, for averages over an interval
+    uint64_t flush_total_us;        // Accumulated flush time
+} lvgl_port_render_stats_t;
+
+/**
+ * @brief Get render statistics
+ *
+ * @param[out] stats: Statistics output
+ */
+void lvgl_port_get_render_stats(lvgl_port_render_stats_t *stats);
+
+/**
+ * @brief Set the gesture callback
+ *
+ * The callback runs in the LVGL task with the LVGL mutex held, so it can operate LVGL objects directly.
+ *
+ * @param[in] cb: Gesture callback, NULL to disable
+ * @param[in] user_data: User data passed to the callback
+ */
+void lvgl_port_set_gesture_cb(gesture_cb_t cb, void *user_data);
+
 #ifdef __cplusplus
 }
 #endif
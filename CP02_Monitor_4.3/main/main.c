@@ -8,6 +8,15 @@
 #include "wifi_manager.h"
 #include "power_monitor.h"
 #include "settings_ui.h"
+#include "font_manager.h"
+#include "asset_store.h"
+#include "ui_theme.h"
+#include "ui_nav.h"
+#include "app_config.h"
+#include "gauge_view.h"
+#include "perf_hud.h"
+#include "stack_profiler.h"
+#include "stack_soak.h"
 #include "esp_log.h"
 
 static const char *TAG = "MAIN";
@@ -18,13 +27,6 @@ const float MAX_PORT_WATTS = 140;      // 每个端口最大功率
 const int REFRESH_INTERVAL = 500;    // 刷新间隔 (ms)
 const char DATA_URL[128] = "http://192.168.1.19/metrics"; // API URL
 
-// 设置更改回调函数
-static void settings_change_callback(void)
-{
-    ESP_LOGI(TAG, "设置已更改，更新监控配置");
-    power_monitor_on_settings_change();
-}
-
 // WiFi状态更改回调函数
 static void wifi_status_callback(wifi_status_t status)
 {
@@ -61,29 +63,57 @@ void app_main()
 {
     ESP_LOGI(TAG, "初始化CP02监控系统");
     
+    // 启动栈水位统计，之后创建的任务都会被采样
+    stack_profiler_init();
+    
     // 初始化Waveshare ESP32-S3 RGB LCD
     waveshare_esp32_s3_rgb_lcd_init();
     
     // 锁定互斥量，因为LVGL API不是线程安全的
     if (lvgl_port_lock(-1)) {
+        // 挂载资源分区，失败时只使用编译进固件的资源
+        asset_store_init();
+        
+        // 初始化字体管理器，失败时使用内置字体
+        font_manager_init();
+        
         // 初始化WiFi管理器
         wifi_manager_init();
         
         // 注册WiFi状态变化回调
         wifi_manager_register_cb(wifi_status_callback);
         
+        // 加载数据地址和刷新间隔，需要在NVS初始化之后；各模块订阅自己关心的配置项
+        app_config_init();
+        
+        // 初始化主题，需要在NVS初始化之后、创建界面之前
+        ui_theme_init();
+        
+        // 初始化页面导航栈，主界面和设置页面都通过它切换
+        ui_nav_init();
+        
         // 初始化设置UI
         settings_ui_init();
         
-        // 注册设置改变回调
-        settings_ui_register_change_cb(settings_change_callback);
+        // 仪表页面参数，在主界面上滑打开
+        const gauge_view_config_t gauge_cfg = GAUGE_VIEW_DEFAULT_CONFIG();
+        gauge_view_init(&gauge_cfg);
         
         // 初始化电源监控
         power_monitor_init();
         
+        // 性能信息，每秒采样一次，需要在WiFi和电源监控初始化之后
+        perf_hud_init();
+        
+        // 测试固件：反复进入各个页面，让栈水位统计覆盖只有触摸才会进入的路径
+        stack_soak_start();
+        
         // 释放互斥量
         lvgl_port_unlock();
     }
     
+    // main任务返回后就被删除，退出前记下它的水位
+    stack_profiler_sample();
+    
     ESP_LOGI(TAG, "CP02监控系统已启动");
 }
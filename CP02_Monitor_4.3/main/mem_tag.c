@@ -0,0 +1,370 @@
+/**
+ * @file     mem_tag.c
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    Memory Tag Module Implementation
+ */
+
+#include "mem_tag.h"
+#include <stdio.h>
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+
+static const char *TAG = "MEM_TAG";
+
+static const char *const tag_names[MEM_TAG_MAX] = {
+    [MEM_TAG_LVGL] = "LVGL",
+    [MEM_TAG_HTTP] = "HTTP",
+    [MEM_TAG_PARSE] = "PARSE",
+    [MEM_TAG_UI] = "UI",
+    [MEM_TAG_ASSETS] = "ASSETS",
+    [MEM_TAG_FONT] = "FONT",
+};
+
+const char *mem_tag_name(mem_tag_t tag)
+{
+    return tag < MEM_TAG_MAX ? tag_names[tag] : "?";
+}
+
+#if CONFIG_EXAMPLE_MEM_TAG
+
+#define MEM_HDR_MAGIC       0xA7
+#define SITE_SLOTS          128         // 分配位置直方图的槽数，必须是2的幂
+#define SITE_OVERFLOW       0           // 槽满之后的分配都计入0号槽
+#define SITE_REPORT_MAX     5           // 每次报告的分配位置数量
+#define LEAK_WINDOWS        3           // 连续增长多少个对比周期后报告疑似泄漏
+#define LV_SIZE_CLASSES     8           // LVGL分配按大小分级记录
+
+// 分配块头，紧挨在返回给调用者的指针前面
+typedef struct {
+    uint16_t site;              // 分配位置的槽号
+    uint8_t tag;
+    uint8_t magic;
+    uint32_t size;              // 调用者申请的字节数
+} mem_hdr_t;
+
+_Static_assert(sizeof(mem_hdr_t) == 8, "mem_hdr_t must keep 8-byte alignment");
+
+// 分配位置，按文件名指针和行号区分
+typedef struct {
+    const char *file;
+    uint16_t line;
+    uint8_t tag;
+    uint32_t live_bytes;
+    uint32_t live_count;
+    uint32_t total_count;
+    uint32_t snap_bytes;        // 上次对比时的live_bytes
+} mem_site_t;
+
+static portMUX_TYPE mem_lock = portMUX_INITIALIZER_UNLOCKED;
+static mem_tag_stats_t tag_stats[MEM_TAG_MAX];
+static mem_site_t sites[SITE_SLOTS] = {
+    [SITE_OVERFLOW] = { .file = "(other)" },
+};
+
+// 对比快照用，只在mem_tag_cycle中访问
+static uint32_t cycle_count = 0;
+static bool snap_valid = false;
+static uint32_t snap_tag_bytes[MEM_TAG_MAX];
+static int32_t snap_untagged = 0;
+static uint8_t grow_windows[MEM_TAG_MAX];
+static int32_t site_delta[SITE_SLOTS];
+
+// LVGL的分配只经过lv_mem_alloc，拿不到真正的调用位置，按大小分级记为不同的位置
+static const char *const lv_size_class[LV_SIZE_CLASSES] = {
+    "lvgl <=16B", "lvgl <=64B", "lvgl <=256B", "lvgl <=1KB",
+    "lvgl <=4KB", "lvgl <=16KB", "lvgl <=64KB", "lvgl >64KB",
+};
+
+static const char *lv_site(size_t size)
+{
+    int cls = 0;
+    for (size_t limit = 16; cls < LV_SIZE_CLASSES - 1 && size > limit; limit <<= 2) {
+        cls++;
+    }
+    return lv_size_class[cls];
+}
+
+// 默认能力的分配走malloc，这样超过CONFIG_SPIRAM_MALLOC_ALWAYSINTERNAL的块优先放到PSRAM
+static void *hdr_alloc(size_t size, uint32_t caps)
+{
+    return caps == MALLOC_CAP_DEFAULT ? malloc(size) : heap_caps_malloc(size, caps);
+}
+
+static void *hdr_realloc(void *ptr, size_t size, uint32_t caps)
+{
+    return caps == MALLOC_CAP_DEFAULT ? realloc(ptr, size) : heap_caps_realloc(ptr, size, caps);
+}
+
+// 块头损坏、重复释放或者释放了未标记的内存，继续下去会释放错误的地址
+static void hdr_check(const mem_hdr_t *hdr, const void *ptr, const char *op)
+{
+    if (hdr->magic != MEM_HDR_MAGIC) {
+        ESP_LOGE(TAG, "%s未标记或已释放的内存 %p", op, ptr);
+        abort();
+    }
+}
+
+// 查找或登记分配位置，需要持有mem_lock
+static uint16_t site_lookup(mem_tag_t tag, const char *file, int line)
+{
+    uint32_t h = ((uint32_t)(uintptr_t)file >> 2) ^ ((uint32_t)line * 2654435761u);
+    for (uint32_t i = 0; i < SITE_SLOTS; i++) {
+        uint16_t slot = (h + i) & (SITE_SLOTS - 1);
+        if (slot == SITE_OVERFLOW) {
+            continue;
+        }
+        mem_site_t *s = &sites[slot];
+        if (s->file == file && s->line == (uint16_t)line) {
+            return slot;
+        }
+        if (s->file == NULL) {
+            s->file = file;
+            s->line = (uint16_t)line;
+            s->tag = tag;
+            return slot;
+        }
+    }
+    return SITE_OVERFLOW;
+}
+
+// 记录一次分配，需要持有mem_lock
+static void account_add(mem_hdr_t *hdr, mem_tag_t tag, size_t size, const char *file, int line)
+{
+    hdr->site = site_lookup(tag, file, line);
+    hdr->tag = tag;
+    hdr->magic = MEM_HDR_MAGIC;
+    hdr->size = size;
+
+    mem_tag_stats_t *t = &tag_stats[tag];
+    t->live_bytes += size;
+    t->live_count++;
+    t->total_count++;
+    if (t->live_bytes > t->peak_bytes) {
+        t->peak_bytes = t->live_bytes;
+    }
+    mem_site_t *s = &sites[hdr->site];
+    s->live_bytes += size;
+    s->live_count++;
+    s->total_count++;
+}
+
+// 记录一次释放，需要持有mem_lock
+static void account_remove(const mem_hdr_t *hdr)
+{
+    mem_tag_stats_t *t = &tag_stats[hdr->tag];
+    t->live_bytes -= hdr->size;
+    t->live_count--;
+    mem_site_t *s = &sites[hdr->site];
+    s->live_bytes -= hdr->size;
+    s->live_count--;
+}
+
+void *mem_tag_alloc_at(mem_tag_t tag, size_t size, uint32_t caps, const char *file, int line)
+{
+    mem_hdr_t *hdr = hdr_alloc(sizeof(mem_hdr_t) + size, caps);
+    if (hdr == NULL) {
+        return NULL;
+    }
+    portENTER_CRITICAL(&mem_lock);
+    account_add(hdr, tag, size, file, line);
+    portEXIT_CRITICAL(&mem_lock);
+    return hdr + 1;
+}
+
+void *mem_tag_calloc_at(mem_tag_t tag, size_t n, size_t size, uint32_t caps, const char *file, int line)
+{
+    if (size != 0 && n > (SIZE_MAX - sizeof(mem_hdr_t)) / size) {
+        return NULL;
+    }
+    void *ptr = mem_tag_alloc_at(tag, n * size, caps, file, line);
+    if (ptr != NULL) {
+        memset(ptr, 0, n * size);
+    }
+    return ptr;
+}
+
+void *mem_tag_realloc_at(mem_tag_t tag, void *ptr, size_t size, uint32_t caps, const char *file, int line)
+{
+    if (ptr == NULL) {
+        return mem_tag_alloc_at(tag, size, caps, file, line);
+    }
+    if (size == 0) {
+        mem_tag_free(ptr);
+        return NULL;
+    }
+
+    mem_hdr_t *old = (mem_hdr_t *)ptr - 1;
+    hdr_check(old, ptr, "realloc");
+    mem_hdr_t saved = *old;
+
+    // 失败时原内存块保持不变，统计也不变
+    mem_hdr_t *hdr = hdr_realloc(old, sizeof(mem_hdr_t) + size, caps);
+    if (hdr == NULL) {
+        return NULL;
+    }
+    portENTER_CRITICAL(&mem_lock);
+    account_remove(&saved);
+    account_add(hdr, tag, size, file, line);
+    portEXIT_CRITICAL(&mem_lock);
+    return hdr + 1;
+}
+
+char *mem_tag_strdup_at(mem_tag_t tag, const char *s, const char *file, int line)
+{
+    size_t len = strlen(s) + 1;
+    char *copy = mem_tag_alloc_at(tag, len, MALLOC_CAP_DEFAULT, file, line);
+    if (copy != NULL) {
+        memcpy(copy, s, len);
+    }
+    return copy;
+}
+
+void mem_tag_free(void *ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+    mem_hdr_t *hdr = (mem_hdr_t *)ptr - 1;
+    hdr_check(hdr, ptr, "释放");
+    portENTER_CRITICAL(&mem_lock);
+    account_remove(hdr);
+    portEXIT_CRITICAL(&mem_lock);
+    hdr->magic = 0;
+    free(hdr);
+}
+
+void *mem_tag_lv_alloc(size_t size)
+{
+    return mem_tag_alloc_at(MEM_TAG_LVGL, size, MALLOC_CAP_DEFAULT, lv_site(size), 0);
+}
+
+void *mem_tag_lv_realloc(void *ptr, size_t size)
+{
+    return mem_tag_realloc_at(MEM_TAG_LVGL, ptr, size, MALLOC_CAP_DEFAULT, lv_site(size), 0);
+}
+
+void mem_tag_get_stats(mem_tag_t tag, mem_tag_stats_t *stats)
+{
+    portENTER_CRITICAL(&mem_lock);
+    *stats = tag_stats[tag];
+    portEXIT_CRITICAL(&mem_lock);
+}
+
+// 分配位置的显示名称，文件名加行号，LVGL的大小分级没有行号
+static const char *site_name(const mem_site_t *s, char *buf, size_t len)
+{
+    const char *name = strrchr(s->file, '/');
+    name = name != NULL ? name + 1 : s->file;
+    if (s->line == 0) {
+        return name;
+    }
+    snprintf(buf, len, "%s:%u", name, s->line);
+    return buf;
+}
+
+// 堆已用字节数减去标记的字节数（含块头），得到未经过本模块的分配
+static int32_t untagged_bytes(const uint32_t *tag_bytes, uint32_t tagged_count)
+{
+    size_t used = heap_caps_get_total_size(MALLOC_CAP_8BIT) - heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    uint32_t tagged = tagged_count * sizeof(mem_hdr_t);
+    for (int i = 0; i < MEM_TAG_MAX; i++) {
+        tagged += tag_bytes[i];
+    }
+    return (int32_t)(used - tagged);
+}
+
+void mem_tag_cycle(void)
+{
+    if (++cycle_count < CONFIG_EXAMPLE_MEM_TAG_LEAK_CYCLES) {
+        return;
+    }
+    cycle_count = 0;
+
+    uint32_t tag_bytes[MEM_TAG_MAX];
+    uint32_t tagged_count = 0;
+    portENTER_CRITICAL(&mem_lock);
+    for (int i = 0; i < MEM_TAG_MAX; i++) {
+        tag_bytes[i] = tag_stats[i].live_bytes;
+        tagged_count += tag_stats[i].live_count;
+    }
+    for (int i = 0; i < SITE_SLOTS; i++) {
+        site_delta[i] = (int32_t)(sites[i].live_bytes - sites[i].snap_bytes);
+        sites[i].snap_bytes = sites[i].live_bytes;
+    }
+    portEXIT_CRITICAL(&mem_lock);
+    int32_t untagged = untagged_bytes(tag_bytes, tagged_count);
+
+    if (!snap_valid) {
+        // 第一次只记录基线
+        memcpy(snap_tag_bytes, tag_bytes, sizeof(snap_tag_bytes));
+        snap_untagged = untagged;
+        snap_valid = true;
+        ESP_LOGI(TAG, "记录内存基线，每%d个刷新周期对比一次", CONFIG_EXAMPLE_MEM_TAG_LEAK_CYCLES);
+        return;
+    }
+
+    char line[160];
+    int pos = 0;
+    for (int i = 0; i < MEM_TAG_MAX && pos < (int)sizeof(line); i++) {
+        int32_t delta = (int32_t)(tag_bytes[i] - snap_tag_bytes[i]);
+        pos += snprintf(line + pos, sizeof(line) - pos, "%s %lu(%+ld) ", tag_names[i],
+                        (unsigned long)tag_bytes[i], (long)delta);
+        grow_windows[i] = delta > 0 ? grow_windows[i] + (grow_windows[i] < UINT8_MAX) : 0;
+    }
+    ESP_LOGI(TAG, "%s未标记 %ld(%+ld)", line, (long)untagged, (long)(untagged - snap_untagged));
+
+    for (int i = 0; i < MEM_TAG_MAX; i++) {
+        if (grow_windows[i] >= LEAK_WINDOWS) {
+            ESP_LOGW(TAG, "疑似泄漏: %s 已连续%d次对比增长", tag_names[i], grow_windows[i]);
+        }
+    }
+
+    // 按增长量列出前几个分配位置，每次取剩余中最大的一个
+    for (int n = 0; n < SITE_REPORT_MAX; n++) {
+        int best = -1;
+        for (int i = 0; i < SITE_SLOTS; i++) {
+            if (site_delta[i] > 0 && (best < 0 || site_delta[i] > site_delta[best])) {
+                best = i;
+            }
+        }
+        if (best < 0) {
+            break;
+        }
+        const mem_site_t *s = &sites[best];
+        char name[48];
+        ESP_LOGI(TAG, "  %s [%s] %+ld, 当前%lu字节/%lu块", site_name(s, name, sizeof(name)),
+                 tag_names[s->tag], (long)site_delta[best],
+                 (unsigned long)s->live_bytes, (unsigned long)s->live_count);
+        site_delta[best] = 0;
+    }
+
+    memcpy(snap_tag_bytes, tag_bytes, sizeof(snap_tag_bytes));
+    snap_untagged = untagged;
+}
+
+void mem_tag_dump(void)
+{
+    mem_tag_stats_t stats[MEM_TAG_MAX];
+    portENTER_CRITICAL(&mem_lock);
+    memcpy(stats, tag_stats, sizeof(stats));
+    portEXIT_CRITICAL(&mem_lock);
+
+    for (int i = 0; i < MEM_TAG_MAX; i++) {
+        ESP_LOGI(TAG, "%-6s 当前%lu字节/%lu块 峰值%lu 累计分配%lu次", tag_names[i],
+                 (unsigned long)stats[i].live_bytes, (unsigned long)stats[i].live_count,
+                 (unsigned long)stats[i].peak_bytes, (unsigned long)stats[i].total_count);
+    }
+    for (int i = 0; i < SITE_SLOTS; i++) {
+        const mem_site_t *s = &sites[i];
+        if (s->file != NULL && s->live_count > 0) {
+            char name[48];
+            ESP_LOGI(TAG, "  %s [%s] %lu字节/%lu块 累计%lu次", site_name(s, name, sizeof(name)),
+                     tag_names[s->tag], (unsigned long)s->live_bytes,
+                     (unsigned long)s->live_count, (unsigned long)s->total_count);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,129 @@
+/**
+ * @file     mem_tag.h
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    Memory Tag Module Header
+ *
+ * 内存分配标签。经过本模块的分配都带一个子系统标签，分配块前面有8字节
+ * 的块头记录标签、分配位置和大小，按标签统计当前占用的字节数和块数，
+ * 按分配位置（文件+行号）统计一个小直方图。每隔若干个刷新周期对比一次
+ * 快照，报告占用持续增长的标签和分配位置。没有经过本模块的分配（WiFi、
+ * lwIP、HTTP客户端内部等）合计为"未标记"，用堆已用字节数减去已标记字节
+ * 数得到。每次分配只多一次自旋锁和几次加减，可以在长时间测试中一直开着。
+ *
+ * 默认能力的分配仍然走malloc/realloc，PSRAM的放置规则不变。释放时块头
+ * 不对（重复释放、释放未标记的内存）直接abort，不去释放错误的地址。
+ *
+ * LVGL通过CONFIG_LV_MEM_CUSTOM_INCLUDE包含本文件，它的内存分配全部
+ * 计入MEM_TAG_LVGL，分配位置按块大小分级记录。
+ */
+
+#ifndef MEM_TAG_H
+#define MEM_TAG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_heap_caps.h"
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    MEM_TAG_LVGL = 0,           // LVGL对象、样式、绘制缓存
+    MEM_TAG_HTTP,               // HTTP响应缓冲区
+    MEM_TAG_PARSE,              // 数据解析
+    MEM_TAG_UI,                 // 界面模块自己的数据
+    MEM_TAG_ASSETS,             // 常驻资源
+    MEM_TAG_FONT,               // 字形缓存
+    MEM_TAG_MAX,
+} mem_tag_t;
+
+// 单个标签的统计
+typedef struct {
+    uint32_t live_bytes;        // 当前占用的字节数，不含块头
+    uint32_t live_count;        // 当前占用的块数
+    uint32_t peak_bytes;        // 占用字节数的峰值
+    uint32_t total_count;       // 累计分配次数
+} mem_tag_stats_t;
+
+#if CONFIG_EXAMPLE_MEM_TAG
+
+void *mem_tag_alloc_at(mem_tag_t tag, size_t size, uint32_t caps, const char *file, int line);
+void *mem_tag_calloc_at(mem_tag_t tag, size_t n, size_t size, uint32_t caps, const char *file, int line);
+void *mem_tag_realloc_at(mem_tag_t tag, void *ptr, size_t size, uint32_t caps, const char *file, int line);
+char *mem_tag_strdup_at(mem_tag_t tag, const char *s, const char *file, int line);
+void mem_tag_free(void *ptr);
+
+#define MEM_TAG_MALLOC(tag, size) \
+    mem_tag_alloc_at((tag), (size), MALLOC_CAP_DEFAULT, __FILE__, __LINE__)
+#define MEM_TAG_CAPS_MALLOC(tag, size, caps) \
+    mem_tag_alloc_at((tag), (size), (caps), __FILE__, __LINE__)
+#define MEM_TAG_CALLOC(tag, n, size) \
+    mem_tag_calloc_at((tag), (n), (size), MALLOC_CAP_DEFAULT, __FILE__, __LINE__)
+#define MEM_TAG_REALLOC(tag, ptr, size) \
+    mem_tag_realloc_at((tag), (ptr), (size), MALLOC_CAP_DEFAULT, __FILE__, __LINE__)
+#define MEM_TAG_STRDUP(tag, s) \
+    mem_tag_strdup_at((tag), (s), __FILE__, __LINE__)
+#define MEM_TAG_FREE(ptr)       mem_tag_free(ptr)
+
+// 供LVGL使用的分配函数
+void *mem_tag_lv_alloc(size_t size);
+void *mem_tag_lv_realloc(void *ptr, size_t size);
+
+/**
+ * @brief 一个刷新周期结束
+ *
+ * 每CONFIG_EXAMPLE_MEM_TAG_LEAK_CYCLES个周期对比一次快照，把占用增长的
+ * 标签和分配位置打印出来。在数据刷新任务中每次刷新后调用。
+ */
+void mem_tag_cycle(void);
+
+// 打印所有标签和占用最多的分配位置
+void mem_tag_dump(void);
+
+// 获取单个标签的统计
+void mem_tag_get_stats(mem_tag_t tag, mem_tag_stats_t *stats);
+
+#else
+
+#define MEM_TAG_MALLOC(tag, size)               malloc(size)
+#define MEM_TAG_CAPS_MALLOC(tag, size, caps)    heap_caps_malloc((size), (caps))
+#define MEM_TAG_CALLOC(tag, n, size)            calloc((n), (size))
+#define MEM_TAG_REALLOC(tag, ptr, size)         realloc((ptr), (size))
+#define MEM_TAG_STRDUP(tag, s)                  strdup(s)
+#define MEM_TAG_FREE(ptr)                       free(ptr)
+
+static inline void mem_tag_cycle(void) {}
+static inline void mem_tag_dump(void) {}
+static inline void mem_tag_get_stats(mem_tag_t tag, mem_tag_stats_t *stats)
+{
+    (void)tag;
+    memset(stats, 0, sizeof(*stats));
+}
+
+#endif
+
+// 标签名称
+const char *mem_tag_name(mem_tag_t tag);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEM_TAG_H */
+
+// lv_mem.c包含本文件时LV_MEM_CUSTOM_*已经定义为标准库函数，在这里换掉
+#if CONFIG_EXAMPLE_MEM_TAG && defined(LV_MEM_CUSTOM_ALLOC)
+#undef LV_MEM_CUSTOM_ALLOC
+#undef LV_MEM_CUSTOM_FREE
+#undef LV_MEM_CUSTOM_REALLOC
+#define LV_MEM_CUSTOM_ALLOC     mem_tag_lv_alloc
+#define LV_MEM_CUSTOM_FREE      mem_tag_free
+#define LV_MEM_CUSTOM_REALLOC   mem_tag_lv_realloc
+#endif
@@ -0,0 +1,119 @@
+/**
+ * @file     panel_rotate.c
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    Panel Rotation Module Implementation
+ */
+
+#include "panel_rotate.h"
+#include <stddef.h>
+
+#ifdef ESP_PLATFORM
+#include "esp_attr.h"
+#else
+#define IRAM_ATTR
+#endif
+
+IRAM_ATTR void panel_rotate_copy(const uint16_t *from, uint16_t *to, uint16_t x_start, uint16_t y_start,
+                                 uint16_t x_end, uint16_t y_end, uint16_t w, uint16_t h, uint16_t rotation)
+{
+    int from_index = 0;                                   // Index for source buffer
+    int to_index = 0;                                     // Index for destination buffer
+    int to_index_const = 0;                               // Constant index for destination buffer
+
+    switch (rotation) {
+    case 90:
+        to_index_const = (w - x_start - 1) * h;          // Calculate constant index for 90-degree rotation
+        for (int from_y = y_start; from_y < y_end + 1; from_y++) {
+            from_index = from_y * w + x_start;           // Calculate index in the source buffer
+            to_index = to_index_const + from_y;          // Calculate index in the destination buffer
+            for (int from_x = x_start; from_x < x_end + 1; from_x++) {
+                *(to + to_index) = *(from + from_index);  // Copy pixel
+                from_index += 1;                          // Move to the next pixel in the source
+                to_index -= h;                            // Move to the next pixel in the destination
+            }
+        }
+        break;
+    case 180:
+        to_index_const = h * w - x_start - 1;            // Calculate constant index for 180-degree rotation
+        for (int from_y = y_start; from_y < y_end + 1; from_y++) {
+            from_index = from_y * w + x_start;           // Calculate index in the source buffer
+            to_index = to_index_const - from_y * w;      // Calculate index in the destination buffer
+            for (int from_x = x_start; from_x < x_end + 1; from_x++) {
+                *(to + to_index) = *(from + from_index);  // Copy pixel
+                from_index += 1;                          // Move to the next pixel in the source
+                to_index -= 1;                            // Move to the next pixel in the destination
+            }
+        }
+        break;
+    case 270:
+        to_index_const = (x_start + 1) * h - 1;          // Calculate constant index for 270-degree rotation
+        for (int from_y = y_start; from_y < y_end + 1; from_y++) {
+            from_index = from_y * w + x_start;           // Calculate index in the source buffer
+            to_index = to_index_const - from_y;          // Calculate index in the destination buffer
+            for (int from_x = x_start; from_x < x_end + 1; from_x++) {
+                *(to + to_index) = *(from + from_index);  // Copy pixel
+                from_index += 1;                          // Move to the next pixel in the source
+                to_index += h;                            // Move to the next pixel in the destination
+            }
+        }
+        break;
+    default:
+        break;                                             // Do nothing for unsupported rotation angles
+    }
+}
+
+// 16-bpp和8-bpp共用同一个读取顺序，只有像素转换不同
+#define ROTATE_FILL_LINES(PIXEL)                                                    \
+    switch (rotation) {                                                             \
+    case 90:                                                                        \
+        /* Panel (x, y) comes from LVGL (w - 1 - y, x) */                           \
+        for (int x = 0; x < to_w; x++) {                                            \
+            const size_t src = (size_t)x * w + (w - y_start - lines);               \
+            uint16_t *dst = to + (lines - 1) * to_w + x;                            \
+            for (int i = 0; i < lines; i++) {                                       \
+                *dst = PIXEL(from[src + i]);                                        \
+                dst -= to_w;                                                        \
+            }                                                                       \
+        }                                                                           \
+        break;                                                                      \
+    case 180:                                                                       \
+        /* Panel (x, y) comes from LVGL (w - 1 - x, h - 1 - y) */                   \
+        for (int i = 0; i < lines; i++) {                                           \
+            const size_t src = (size_t)(h - 1 - y_start - i) * w + (w - 1);         \
+            uint16_t *dst = to + i * to_w;                                          \
+            for (int x = 0; x < to_w; x++) {                                        \
+                dst[x] = PIXEL(from[src - x]);                                      \
+            }                                                                       \
+        }                                                                           \
+        break;                                                                      \
+    case 270:                                                                       \
+        /* Panel (x, y) comes from LVGL (y, h - 1 - x) */                           \
+        for (int x = 0; x < to_w; x++) {                                            \
+            const size_t src = (size_t)(h - 1 - x) * w + y_start;                   \
+            uint16_t *dst = to + x;                                                 \
+            for (int i = 0; i < lines; i++) {                                       \
+                *dst = PIXEL(from[src + i]);                                        \
+                dst += to_w;                                                        \
+            }                                                                       \
+        }                                                                           \
+        break;                                                                      \
+    default:                                                                        \
+        break;                                                                      \
+    }
+
+#define PIXEL_16(c)     (c)
+#define PIXEL_8(c)      (lut[(c)])
+
+IRAM_ATTR void panel_rotate_fill_16(const uint16_t *from, uint16_t *to, int y_start, int lines, int w, int h, int to_w,
+                                    uint16_t rotation)
+{
+    ROTATE_FILL_LINES(PIXEL_16)
+}
+
+IRAM_ATTR void panel_rotate_fill_8(const uint8_t *from, uint16_t *to, int y_start, int lines, int w, int h, int to_w,
+                                   uint16_t rotation, const uint16_t *lut)
+{
+    ROTATE_FILL_LINES(PIXEL_8)
+}
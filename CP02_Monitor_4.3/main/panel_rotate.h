@@ -0,0 +1,50 @@
+/**
+ * @file     panel_rotate.h
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    Panel Rotation Module Header
+ *
+ * RGB面板的软件旋转。panel_rotate_copy()把LVGL刷新的区域旋转后写入面板帧缓冲，
+ * panel_rotate_fill_*()在bounce buffer回调中按面板行顺序从未旋转的LVGL缓冲读取，
+ * 两者的坐标映射相同。
+ *
+ * 只依赖标准C头文件，可以在主机上用panel_rotate_copy()作为参考验证bounce填充。
+ */
+
+#ifndef PANEL_ROTATE_H
+#define PANEL_ROTATE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 旋转并复制LVGL缓冲中的一个区域
+ *
+ * from和to都是完整的帧，from为w x h像素，区域坐标包含两端。rotation为90/180/270，其他值不做任何事。
+ */
+void panel_rotate_copy(const uint16_t *from, uint16_t *to, uint16_t x_start, uint16_t y_start,
+                       uint16_t x_end, uint16_t y_end, uint16_t w, uint16_t h, uint16_t rotation);
+
+/**
+ * @brief 从旋转的16-bpp LVGL缓冲填充面板行 [y_start, y_start + lines)
+ *
+ * 面板宽to_w像素，LVGL缓冲为w x h像素（90/270度时w为面板高度，h为面板宽度）。
+ * 90和270度时每个LVGL行给出lines个相邻像素，缓冲按lines像素 x to_w行的块读取。
+ * 一列块大于数据缓存，只有块完整覆盖一个PSRAM缓存行（16-bpp时32行）时每帧才只读一次。
+ */
+void panel_rotate_fill_16(const uint16_t *from, uint16_t *to, int y_start, int lines, int w, int h, int to_w,
+                          uint16_t rotation);
+
+// 同panel_rotate_fill_16()，8-bpp的LVGL像素经lut扩展为RGB565
+void panel_rotate_fill_8(const uint8_t *from, uint16_t *to, int y_start, int lines, int w, int h, int to_w,
+                         uint16_t rotation, const uint16_t *lut);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PANEL_ROTATE_H */
@@ -0,0 +1,358 @@
+/**
+ * @file     perf_hud.c
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    Performance HUD Module Implementation
+ */
+
+#include "perf_hud.h"
+
+#if CONFIG_EXAMPLE_PERF_HUD
+
+#include <stdio.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "esp_http_server.h"
+#include "esp_wifi.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "lvgl.h"
+#include "lvgl_port.h"
+#include "power_monitor.h"
+#include "wifi_manager.h"
+#include "ui_theme.h"
+#include "ui_nav.h"
+#include "stack_profiler.h"
+
+static const char *TAG = "PERF_HUD";
+
+#define SAMPLE_PERIOD_MS    1000
+#define STATUS_SLOTS        32          // 一次采样最多读取的任务数
+#define HUD_HEIGHT          34          // 底部显示区域的高度
+#define HUD_LINE_LEN        160         // 每行标签的固定容量
+#define JSON_BUF_LEN        1536        // 16个任务名都取最长时约1.4KB
+
+// 上一次采样时每个任务的累计运行时间
+typedef struct {
+    TaskHandle_t handle;
+    configRUN_TIME_COUNTER_TYPE runtime;
+} task_prev_t;
+
+static portMUX_TYPE sample_lock = portMUX_INITIALIZER_UNLOCKED;
+static perf_hud_sample_t latest;        // 最近一次采样，由sample_lock保护
+static perf_hud_sample_t work;          // 只在LVGL任务中使用
+
+static TaskStatus_t status_buf[STATUS_SLOTS];
+static task_prev_t prev_tasks[STATUS_SLOTS];
+static int prev_task_count = 0;
+static configRUN_TIME_COUNTER_TYPE prev_total_runtime = 0;
+static lvgl_port_render_stats_t prev_render;
+static int64_t prev_sample_us = 0;
+
+static lv_obj_t *hud_strip = NULL;
+static lv_obj_t *hud_labels[2];
+static char hud_text[2][HUD_LINE_LEN];
+static httpd_handle_t server = NULL;
+
+// 按上一秒的运行时间差计算每个任务的CPU占用，从高到低保留前PERF_HUD_MAX_TASKS个
+static void sample_tasks(perf_hud_sample_t *s)
+{
+    configRUN_TIME_COUNTER_TYPE total = 0;
+    UBaseType_t count = uxTaskGetSystemState(status_buf, STATUS_SLOTS, &total);
+    // 每个核各自累计运行时间，总时间按核数计算
+    uint64_t elapsed = (uint64_t)(configRUN_TIME_COUNTER_TYPE)(total - prev_total_runtime) * portNUM_PROCESSORS;
+
+    s->task_count = 0;
+    for (UBaseType_t i = 0; i < count; i++) {
+        configRUN_TIME_COUNTER_TYPE delta = status_buf[i].ulRunTimeCounter;
+        for (int j = 0; j < prev_task_count; j++) {
+            if (prev_tasks[j].handle == status_buf[i].xHandle) {
+                delta = status_buf[i].ulRunTimeCounter - prev_tasks[j].runtime;
+                break;
+            }
+        }
+        uint16_t permille = elapsed > 0 ? (uint16_t)LV_MIN((uint64_t)delta * 1000 / elapsed, 1000) : 0;
+
+        // 插入排序，列表满时丢弃占用最少的
+        int pos = s->task_count;
+        while (pos > 0 && s->tasks[pos - 1].cpu_permille < permille) {
+            pos--;
+        }
+        if (pos >= PERF_HUD_MAX_TASKS) {
+            continue;
+        }
+        int last = s->task_count < PERF_HUD_MAX_TASKS ? s->task_count : PERF_HUD_MAX_TASKS - 1;
+        memmove(&s->tasks[pos + 1], &s->tasks[pos], (last - pos) * sizeof(s->tasks[0]));
+        strlcpy(s->tasks[pos].name, status_buf[i].pcTaskName, sizeof(s->tasks[pos].name));
+        s->tasks[pos].cpu_permille = permille;
+        if (s->task_count < PERF_HUD_MAX_TASKS) {
+            s->task_count++;
+        }
+    }
+
+    for (UBaseType_t i = 0; i < count; i++) {
+        prev_tasks[i].handle = status_buf[i].xHandle;
+        prev_tasks[i].runtime = status_buf[i].ulRunTimeCounter;
+    }
+    prev_task_count = (int)count;
+    prev_total_runtime = total;
+}
+
+// 上一秒的帧率和平均耗时
+static void sample_render(perf_hud_sample_t *s, int64_t now_us)
+{
+    lvgl_port_render_stats_t render;
+    lvgl_port_get_render_stats(&render);
+
+    uint32_t frames = render.frames - prev_render.frames;
+    int64_t period_us = now_us - prev_sample_us;
+    s->fps_x10 = period_us > 0 ? (uint16_t)((int64_t)frames * 10000000 / period_us) : 0;
+    s->render_avg_us = frames > 0 ? (uint32_t)((render.render_total_us - prev_render.render_total_us) / frames) : 0;
+    s->flush_avg_us = frames > 0 ? (uint32_t)((render.flush_total_us - prev_render.flush_total_us) / frames) : 0;
+    s->render_max_us = render.render_max_us;
+    s->flush_max_us = render.flush_max_us;
+    prev_render = render;
+}
+
+static void sample_collect(perf_hud_sample_t *s)
+{
+    int64_t now_us = esp_timer_get_time();
+    s->uptime_s = (uint32_t)(now_us / 1000000);
+    sample_render(s, now_us);
+    prev_sample_us = now_us;
+
+    power_monitor_stats_t monitor;
+    power_monitor_get_stats(&monitor);
+    s->fetch_ms = monitor.fetch_ms;
+    s->parse_us = monitor.parse_us;
+    s->data_age_ms = monitor.last_data_ms > 0 ? esp_log_timestamp() - monitor.last_data_ms : PERF_HUD_NO_DATA;
+    s->row_updates = monitor.row_updates;
+    s->row_skips = monitor.row_skips;
+
+    s->heap_free = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    s->heap_min_free = heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL);
+    s->psram_free = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+
+    wifi_ap_record_t ap;
+    s->rssi = (WIFI_GotIP && esp_wifi_sta_get_ap_info(&ap) == ESP_OK) ? ap.rssi : PERF_HUD_NO_RSSI;
+
+    sample_tasks(s);
+}
+
+// 微秒格式化为"12.3"毫秒
+static int fmt_ms(char *buf, size_t len, uint32_t us)
+{
+    return snprintf(buf, len, "%lu.%lu", (unsigned long)(us / 1000), (unsigned long)(us % 1000 / 100));
+}
+
+static void hud_render(const perf_hud_sample_t *s)
+{
+    char render_avg[16], render_max[16], flush_avg[16], flush_max[16], parse[16], age[16], rssi[8];
+    fmt_ms(render_avg, sizeof(render_avg), s->render_avg_us);
+    fmt_ms(render_max, sizeof(render_max), s->render_max_us);
+    fmt_ms(flush_avg, sizeof(flush_avg), s->flush_avg_us);
+    fmt_ms(flush_max, sizeof(flush_max), s->flush_max_us);
+    fmt_ms(parse, sizeof(parse), s->parse_us);
+    if (s->data_age_ms == PERF_HUD_NO_DATA) {
+        strlcpy(age, "--", sizeof(age));
+    } else {
+        snprintf(age, sizeof(age), "%lu.%lus", (unsigned long)(s->data_age_ms / 1000),
+                 (unsigned long)(s->data_age_ms % 1000 / 100));
+    }
+    if (s->rssi == PERF_HUD_NO_RSSI) {
+        strlcpy(rssi, "--", sizeof(rssi));
+    } else {
+        snprintf(rssi, sizeof(rssi), "%d", s->rssi);
+    }
+
+    snprintf(hud_text[0], HUD_LINE_LEN,
+             "%u.%u fps  render %s/%s ms  flush %s/%s ms  fetch %lu ms  parse %s ms  age %s  "
+             "heap %luk/%luk  psram %luk  rssi %s",
+             s->fps_x10 / 10, s->fps_x10 % 10, render_avg, render_max, flush_avg, flush_max,
+             (unsigned long)s->fetch_ms, parse, age, (unsigned long)(s->heap_free / 1024),
+             (unsigned long)(s->heap_min_free / 1024), (unsigned long)(s->psram_free / 1024), rssi);
+
+    int pos = snprintf(hud_text[1], HUD_LINE_LEN, "CPU");
+    for (int i = 0; i < s->task_count && pos < HUD_LINE_LEN - 1; i++) {
+        pos += snprintf(hud_text[1] + pos, HUD_LINE_LEN - pos, "  %s %u.%u%%", s->tasks[i].name,
+                        s->tasks[i].cpu_permille / 10, s->tasks[i].cpu_permille % 10);
+    }
+
+    // 缓冲区地址不变，重新设置一次让标签按新内容重绘
+    lv_label_set_text_static(hud_labels[0], hud_text[0]);
+    lv_label_set_text_static(hud_labels[1], hud_text[1]);
+}
+
+static void sample_timer_cb(lv_timer_t *timer)
+{
+    (void)timer;
+    sample_collect(&work);
+
+    portENTER_CRITICAL(&sample_lock);
+    latest = work;
+    portEXIT_CRITICAL(&sample_lock);
+
+    if (perf_hud_is_visible()) {
+        hud_render(&work);
+    }
+}
+
+// 屏幕底部的显示区域，在顶层上，所有页面都能看到，显示时页面让出这块区域
+static void hud_create(void)
+{
+    hud_strip = lv_obj_create(lv_layer_top());
+    lv_obj_remove_style_all(hud_strip);
+    lv_obj_set_size(hud_strip, LV_PCT(100), HUD_HEIGHT);
+    lv_obj_align(hud_strip, LV_ALIGN_BOTTOM_MID, 0, 0);
+    ui_theme_apply(hud_strip, UI_STYLE_SCREEN, LV_PART_MAIN);
+    ui_theme_apply(hud_strip, UI_STYLE_MUTED, LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(hud_strip, LV_OPA_COVER, LV_PART_MAIN);  // 不透明，重绘时不需要画下面的页面
+    lv_obj_set_style_pad_hor(hud_strip, 6, LV_PART_MAIN);
+    lv_obj_clear_flag(hud_strip, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_flag(hud_strip, LVGL_PORT_OBJ_FLAG_DECOR);   // 帧时间不够时可以延后重绘
+    lv_obj_add_flag(hud_strip, LV_OBJ_FLAG_HIDDEN);
+
+    for (int i = 0; i < 2; i++) {
+        hud_text[i][0] = '\0';
+        hud_labels[i] = lv_label_create(hud_strip);
+        lv_obj_set_width(hud_labels[i], LV_PCT(100));
+        lv_label_set_long_mode(hud_labels[i], LV_LABEL_LONG_CLIP);
+        lv_obj_set_style_text_font(hud_labels[i], &lv_font_montserrat_12, LV_PART_MAIN | LV_STATE_DEFAULT);
+        lv_label_set_text_static(hud_labels[i], hud_text[i]);
+        lv_obj_set_pos(hud_labels[i], 0, 2 + i * 16);
+    }
+}
+
+// JSON中的任务名，去掉会破坏格式的字符
+static void json_name(char *dst, size_t len, const char *src)
+{
+    size_t i = 0;
+    for (; src[i] != '\0' && i < len - 1; i++) {
+        char c = src[i];
+        dst[i] = (c == '"' || c == '\\' || (unsigned char)c < 0x20) ? '_' : c;
+    }
+    dst[i] = '\0';
+}
+
+static esp_err_t perf_get_handler(httpd_req_t *req)
+{
+    perf_hud_sample_t s;
+    perf_hud_get_sample(&s);
+
+    // HTTP服务只有一个任务，缓冲区放在静态区，不占用它的栈
+    static char buf[JSON_BUF_LEN];
+    int pos = snprintf(buf, sizeof(buf),
+                       "{\"uptime_s\":%lu,\"fps\":%u.%u,"
+                       "\"render_us\":{\"avg\":%lu,\"max\":%lu},\"flush_us\":{\"avg\":%lu,\"max\":%lu},"
+                       "\"fetch_ms\":%lu,\"parse_us\":%lu,",
+                       (unsigned long)s.uptime_s, s.fps_x10 / 10, s.fps_x10 % 10,
+                       (unsigned long)s.render_avg_us, (unsigned long)s.render_max_us,
+                       (unsigned long)s.flush_avg_us, (unsigned long)s.flush_max_us,
+                       (unsigned long)s.fetch_ms, (unsigned long)s.parse_us);
+    if (s.data_age_ms == PERF_HUD_NO_DATA) {
+        pos += snprintf(buf + pos, sizeof(buf) - pos, "\"data_age_ms\":null,");
+    } else {
+        pos += snprintf(buf + pos, sizeof(buf) - pos, "\"data_age_ms\":%lu,", (unsigned long)s.data_age_ms);
+    }
+    pos += snprintf(buf + pos, sizeof(buf) - pos,
+                    "\"rows\":{\"updated\":%lu,\"skipped\":%lu},"
+                    "\"heap\":{\"free\":%lu,\"min_free\":%lu},\"psram_free\":%lu,",
+                    (unsigned long)s.row_updates, (unsigned long)s.row_skips,
+                    (unsigned long)s.heap_free, (unsigned long)s.heap_min_free, (unsigned long)s.psram_free);
+    if (s.rssi == PERF_HUD_NO_RSSI) {
+        pos += snprintf(buf + pos, sizeof(buf) - pos, "\"rssi\":null,\"tasks\":[");
+    } else {
+        pos += snprintf(buf + pos, sizeof(buf) - pos, "\"rssi\":%d,\"tasks\":[", s.rssi);
+    }
+    for (int i = 0; i < s.task_count; i++) {
+        char name[sizeof(s.tasks[i].name)];
+        json_name(name, sizeof(name), s.tasks[i].name);
+        pos += snprintf(buf + pos, sizeof(buf) - pos, "%s{\"name\":\"%s\",\"cpu\":%u.%u}", i > 0 ? "," : "",
+                        name, s.tasks[i].cpu_permille / 10, s.tasks[i].cpu_permille % 10);
+    }
+    pos += snprintf(buf + pos, sizeof(buf) - pos, "]}");
+    if (pos >= (int)sizeof(buf)) {
+        ESP_LOGE(TAG, "JSON超过 %d 字节", JSON_BUF_LEN);
+        return httpd_resp_send_500(req);
+    }
+
+    httpd_resp_set_type(req, "application/json");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-store");
+    return httpd_resp_send(req, buf, pos);
+}
+
+static esp_err_t server_start(void)
+{
+    httpd_config_t config = HTTPD_DEFAULT_CONFIG();
+    config.server_port = CONFIG_EXAMPLE_PERF_HUD_HTTP_PORT;
+    config.ctrl_port = CONFIG_EXAMPLE_PERF_HUD_HTTP_PORT + 1;
+    config.max_open_sockets = 2;
+    config.lru_purge_enable = true;
+
+    esp_err_t err = httpd_start(&server, &config);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "无法启动HTTP服务: %s", esp_err_to_name(err));
+        return err;
+    }
+    stack_profiler_register("httpd", config.stack_size, "HTTPD_DEFAULT_CONFIG().stack_size");
+
+    static const httpd_uri_t perf_uri = {
+        .uri = "/api/perf",
+        .method = HTTP_GET,
+        .handler = perf_get_handler,
+    };
+    httpd_register_uri_handler(server, &perf_uri);
+    ESP_LOGI(TAG, "性能数据: http://<设备IP>:%d/api/perf", CONFIG_EXAMPLE_PERF_HUD_HTTP_PORT);
+    return ESP_OK;
+}
+
+esp_err_t perf_hud_init(void)
+{
+    if (hud_strip != NULL) {
+        return ESP_OK;
+    }
+
+    hud_create();
+    prev_sample_us = esp_timer_get_time();
+    lv_timer_create(sample_timer_cb, SAMPLE_PERIOD_MS, NULL);
+#if CONFIG_EXAMPLE_PERF_HUD_SHOW
+    perf_hud_set_visible(true);
+#endif
+
+    if (CONFIG_EXAMPLE_PERF_HUD_HTTP_PORT > 0) {
+        server_start();
+    }
+    return ESP_OK;
+}
+
+void perf_hud_set_visible(bool visible)
+{
+    if (hud_strip == NULL) {
+        return;
+    }
+    if (visible) {
+        lv_obj_clear_flag(hud_strip, LV_OBJ_FLAG_HIDDEN);
+        ui_nav_set_bottom_inset(HUD_HEIGHT);
+        hud_render(&work);
+    } else {
+        lv_obj_add_flag(hud_strip, LV_OBJ_FLAG_HIDDEN);
+        ui_nav_set_bottom_inset(0);
+    }
+}
+
+bool perf_hud_is_visible(void)
+{
+    return hud_strip != NULL && !lv_obj_has_flag(hud_strip, LV_OBJ_FLAG_HIDDEN);
+}
+
+void perf_hud_get_sample(perf_hud_sample_t *sample)
+{
+    portENTER_CRITICAL(&sample_lock);
+    *sample = latest;
+    portEXIT_CRITICAL(&sample_lock);
+}
+
+#endif
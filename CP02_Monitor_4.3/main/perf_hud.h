@@ -0,0 +1,92 @@
+/**
+ * @file     perf_hud.h
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    Performance HUD Module Header
+ *
+ * 性能信息，代替LVGL自带的性能监视器。每秒在LVGL任务中采样一次：渲染和
+ * 刷屏耗时、帧率、数据请求的网络耗时和解析耗时、数据新鲜度、内部RAM和
+ * PSRAM剩余、WiFi信号强度，以及每个任务上一秒占用的CPU（FreeRTOS运行
+ * 时间统计的差值）。
+ *
+ * 采样结果显示在屏幕底部一条固定的区域里，两行标签使用固定大小的静态
+ * 缓冲区，每秒只重绘这条区域，不显示时只采样不绘制，显示时页面让出底部
+ * 的区域。同样的数据可以通过HTTP以JSON格式提供（GET /api/perf），方便远程
+ * 采集；接口没有认证，默认关闭，需要在menuconfig中设置端口。
+ */
+
+#ifndef PERF_HUD_H
+#define PERF_HUD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PERF_HUD_MAX_TASKS      16
+#define PERF_HUD_NO_DATA        UINT32_MAX  // 还没有收到数据时的data_age_ms
+#define PERF_HUD_NO_RSSI        0           // WiFi未连接时的rssi
+
+// 单个任务上一秒的CPU占用
+typedef struct {
+    char name[16];
+    uint16_t cpu_permille;      // 占所有核总时间的千分比
+} perf_hud_task_t;
+
+// 一次采样
+typedef struct {
+    uint32_t uptime_s;
+    uint16_t fps_x10;           // 上一秒的帧率，乘以10
+    uint32_t render_avg_us;     // 上一秒每帧平均渲染耗时
+    uint32_t render_max_us;     // 运行以来最大渲染耗时
+    uint32_t flush_avg_us;      // 上一秒每帧平均刷屏耗时
+    uint32_t flush_max_us;
+    uint32_t fetch_ms;          // 最近一次请求的网络耗时
+    uint32_t parse_us;          // 最近一次解析耗时
+    uint32_t data_age_ms;       // 距离最近一次收到数据的时间
+    uint32_t row_updates;       // 运行以来主界面端口行的重绘次数
+    uint32_t row_skips;         // 运行以来跳过重绘的次数
+    uint32_t heap_free;         // 内部RAM剩余字节数
+    uint32_t heap_min_free;     // 内部RAM运行以来最少剩余字节数
+    uint32_t psram_free;        // PSRAM剩余字节数
+    int8_t rssi;                // WiFi信号强度（dBm）
+    uint8_t task_count;
+    perf_hud_task_t tasks[PERF_HUD_MAX_TASKS];  // 按CPU占用从高到低
+} perf_hud_sample_t;
+
+#if CONFIG_EXAMPLE_PERF_HUD
+
+/**
+ * @brief 开始每秒采样，创建显示区域并启动JSON接口
+ *
+ * 需要在WiFi初始化之后、持有LVGL锁时调用。
+ */
+esp_err_t perf_hud_init(void);
+
+// 显示或隐藏性能信息，需要持有LVGL锁
+void perf_hud_set_visible(bool visible);
+
+bool perf_hud_is_visible(void);
+
+// 复制最近一次采样，可以在任意任务中调用
+void perf_hud_get_sample(perf_hud_sample_t *sample);
+
+#else
+
+static inline esp_err_t perf_hud_init(void) { return ESP_OK; }
+static inline void perf_hud_set_visible(bool visible) { (void)visible; }
+static inline bool perf_hud_is_visible(void) { return false; }
+static inline void perf_hud_get_sample(perf_hud_sample_t *sample) { *sample = (perf_hud_sample_t){ 0 }; }
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PERF_HUD_H */
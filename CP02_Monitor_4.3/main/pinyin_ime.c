@@ -0,0 +1,315 @@
+/**
+ * @file     pinyin_ime.c
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    Pinyin Input Method Module Implementation
+ */
+
+#include "pinyin_ime.h"
+#include <string.h>
+
+uint32_t pinyin_dict_step(const pinyin_dict_t *dict, uint32_t node, char letter)
+{
+    if (node == PINYIN_NODE_NONE || letter < 'a' || letter > 'z') {
+        return PINYIN_NODE_NONE;
+    }
+
+    const pinyin_node_t *n = &dict->nodes[node];
+    uint32_t bit = 1u << (letter - 'a');
+    if ((n->child_mask & bit) == 0) {
+        return PINYIN_NODE_NONE;
+    }
+    // 子节点按字母顺序连续存放，序号等于掩码中排在前面的位数
+    return n->first_child + __builtin_popcount(n->child_mask & (bit - 1));
+}
+
+uint32_t pinyin_dict_find(const pinyin_dict_t *dict, const char *py, size_t len)
+{
+    uint32_t node = 0;
+    for (size_t i = 0; i < len && node != PINYIN_NODE_NONE; i++) {
+        node = pinyin_dict_step(dict, node, py[i]);
+    }
+    return node;
+}
+
+#if CONFIG_EXAMPLE_PINYIN_IME
+#include "esp_log.h"
+
+static const char *TAG = "PINYIN";
+
+#define IME_BAR_HEIGHT  44
+#define IME_CAND_NUM    CONFIG_EXAMPLE_PINYIN_CAND_NUM
+
+typedef struct {
+    lv_obj_t *kb;
+    lv_obj_t *bar;
+    lv_obj_t *mode_label;
+    lv_obj_t *prev_btn;
+    lv_obj_t *next_btn;
+    lv_obj_t *cand_btns[IME_CAND_NUM];
+    lv_obj_t *cand_labels[IME_CAND_NUM];
+    const char *cand_text[IME_CAND_NUM];    // 按钮当前显示的候选，用于增量更新
+    lv_obj_t *ta;                           // 正在输入的输入框
+    bool chinese;
+    uint8_t input_len;                      // 已输入到输入框中的拼音字母数
+    uint32_t path[PINYIN_MAX_INPUT + 1];    // path[i]为输入前i个字母后所在的节点
+    uint32_t page;
+} pinyin_ime_t;
+
+static pinyin_ime_t ime;
+
+static void set_hidden(lv_obj_t *obj, bool hidden)
+{
+    if (lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN) != hidden) {
+        if (hidden) {
+            lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+        } else {
+            lv_obj_clear_flag(obj, LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+}
+
+static void set_disabled(lv_obj_t *obj, bool disabled)
+{
+    if (lv_obj_has_state(obj, LV_STATE_DISABLED) != disabled) {
+        if (disabled) {
+            lv_obj_add_state(obj, LV_STATE_DISABLED);
+        } else {
+            lv_obj_clear_state(obj, LV_STATE_DISABLED);
+        }
+    }
+}
+
+// 当前拼音的候选范围
+static void cand_range(uint32_t *start, uint32_t *total)
+{
+    uint32_t node = ime.path[ime.input_len];
+    if (ime.input_len == 0 || node == PINYIN_NODE_NONE) {
+        *start = 0;
+        *total = 0;
+        return;
+    }
+    *start = pinyin_dict.nodes[node].cand_start;
+    *total = pinyin_dict.nodes[node].cand_total;
+}
+
+// 只更新内容变化的候选按钮，其余按钮不会重绘
+static void bar_update(void)
+{
+    uint32_t start, total;
+    cand_range(&start, &total);
+
+    uint32_t first = ime.page * IME_CAND_NUM;
+    for (int i = 0; i < IME_CAND_NUM; i++) {
+        const char *text = first + i < total ? pinyin_dict.cands[start + first + i] : NULL;
+        if (text == ime.cand_text[i]) {
+            continue;
+        }
+        if (text != NULL) {
+            lv_label_set_text_static(ime.cand_labels[i], text);
+        }
+        set_hidden(ime.cand_btns[i], text == NULL);
+        ime.cand_text[i] = text;
+    }
+
+    set_disabled(ime.prev_btn, ime.page == 0);
+    set_disabled(ime.next_btn, first + IME_CAND_NUM >= total);
+}
+
+static void ime_clear(void)
+{
+    ime.input_len = 0;
+    ime.page = 0;
+    ime.path[0] = 0;
+    bar_update();
+}
+
+// 拼音输入是否适用于该输入框
+static bool ime_usable(lv_obj_t *ta)
+{
+    return ime.chinese && ta != NULL && !lv_textarea_get_password_mode(ta) &&
+           lv_textarea_get_accepted_chars(ta) == NULL;
+}
+
+// 用候选替换输入框中的拼音字母
+static void ime_commit(const char *text)
+{
+    for (int i = 0; i < ime.input_len; i++) {
+        lv_textarea_del_char(ime.ta);
+    }
+    lv_textarea_add_text(ime.ta, text);
+    ime_clear();
+}
+
+// 在键盘默认的处理之后调用，此时字母已经插入输入框
+static void kb_event_cb(lv_event_t *e)
+{
+    lv_event_code_t code = lv_event_get_code(e);
+    if (code == LV_EVENT_READY || code == LV_EVENT_CANCEL) {
+        ime_clear();
+        return;
+    }
+
+    uint16_t btn_id = lv_btnmatrix_get_selected_btn(ime.kb);
+    if (btn_id == LV_BTNMATRIX_BTN_NONE) {
+        return;
+    }
+    const char *txt = lv_btnmatrix_get_btn_text(ime.kb, btn_id);
+    if (txt == NULL) {
+        return;
+    }
+
+    lv_obj_t *ta = lv_keyboard_get_textarea(ime.kb);
+    if (ta != ime.ta) {
+        ime.ta = ta;
+        ime_clear();
+    }
+    if (!ime_usable(ta)) {
+        return;
+    }
+
+    if (txt[0] >= 'a' && txt[0] <= 'z' && txt[1] == '\0') {
+        if (ime.input_len >= PINYIN_MAX_INPUT) {
+            ime_clear(); // 拼音过长，已输入的字母作为英文保留
+            return;
+        }
+        ime.path[ime.input_len + 1] = pinyin_dict_step(&pinyin_dict, ime.path[ime.input_len], txt[0]);
+        ime.input_len++;
+        ime.page = 0;
+        bar_update();
+    } else if (strcmp(txt, LV_SYMBOL_BACKSPACE) == 0) {
+        if (ime.input_len > 0) {
+            ime.input_len--;
+            ime.page = 0;
+            bar_update();
+        }
+    } else if (strcmp(txt, " ") == 0 && ime.cand_text[0] != NULL) {
+        // 空格选择第一个候选
+        lv_textarea_del_char(ta);
+        ime_commit(ime.cand_text[0]);
+    } else if (ime.input_len > 0) {
+        ime_clear(); // 其他按键结束拼音输入，字母保留
+    }
+}
+
+static void cand_btn_event_cb(lv_event_t *e)
+{
+    int idx = (int)(intptr_t)lv_event_get_user_data(e);
+    const char *text = ime.cand_text[idx];
+
+    if (text == NULL || ime.ta == NULL || lv_keyboard_get_textarea(ime.kb) != ime.ta) {
+        ime_clear();
+        return;
+    }
+    ime_commit(text);
+}
+
+static void page_btn_event_cb(lv_event_t *e)
+{
+    if (lv_event_get_target(e) == ime.prev_btn) {
+        if (ime.page > 0) {
+            ime.page--;
+        }
+    } else {
+        uint32_t start, total;
+        cand_range(&start, &total);
+        if ((ime.page + 1) * IME_CAND_NUM < total) {
+            ime.page++;
+        }
+    }
+    bar_update();
+}
+
+static void mode_btn_event_cb(lv_event_t *e)
+{
+    ime.chinese = !ime.chinese;
+    lv_label_set_text_static(ime.mode_label, ime.chinese ? "中" : "EN");
+    if (ime.chinese) {
+        lv_keyboard_set_mode(ime.kb, LV_KEYBOARD_MODE_TEXT_LOWER);
+    }
+    ime_clear();
+}
+
+static lv_obj_t *bar_btn_create(lv_obj_t *parent, lv_obj_t **label, const lv_font_t *font)
+{
+    lv_obj_t *btn = lv_btn_create(parent);
+    lv_obj_set_height(btn, LV_PCT(100));
+    lv_obj_set_style_pad_hor(btn, 8, LV_PART_MAIN);
+    lv_obj_set_style_pad_ver(btn, 0, LV_PART_MAIN);
+    lv_obj_set_style_shadow_width(btn, 0, LV_PART_MAIN);
+    lv_obj_set_style_bg_color(btn, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_bg_color(btn, lv_color_hex(0xD0D0D0), LV_PART_MAIN | LV_STATE_PRESSED);
+    lv_obj_set_style_text_color(btn, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
+
+    *label = lv_label_create(btn);
+    lv_obj_set_style_text_font(*label, font, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_center(*label);
+    return btn;
+}
+
+void pinyin_ime_attach(lv_obj_t *kb, const lv_font_t *font)
+{
+    memset(&ime, 0, sizeof(ime));
+    ime.kb = kb;
+    ime.chinese = true;
+
+    // 候选栏放在加大的键盘上边距中，随键盘一起显示隐藏，不需要单独同步
+    lv_coord_t pad_top = lv_obj_get_style_pad_top(kb, LV_PART_MAIN);
+    lv_obj_set_style_pad_top(kb, pad_top + IME_BAR_HEIGHT, LV_PART_MAIN);
+
+    ime.bar = lv_obj_create(kb);
+    lv_obj_add_flag(ime.bar, LV_OBJ_FLAG_FLOATING);
+    lv_obj_clear_flag(ime.bar, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_size(ime.bar, LV_PCT(100), IME_BAR_HEIGHT - 4);
+    lv_obj_set_pos(ime.bar, 0, -IME_BAR_HEIGHT);
+    lv_obj_set_style_bg_opa(ime.bar, LV_OPA_TRANSP, LV_PART_MAIN);
+    lv_obj_set_style_border_width(ime.bar, 0, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(ime.bar, 0, LV_PART_MAIN);
+    lv_obj_set_style_pad_column(ime.bar, 4, LV_PART_MAIN);
+    lv_obj_set_flex_flow(ime.bar, LV_FLEX_FLOW_ROW);
+
+    lv_obj_t *mode_btn = bar_btn_create(ime.bar, &ime.mode_label, font);
+    lv_label_set_text_static(ime.mode_label, "中");
+    lv_obj_set_style_bg_color(mode_btn, lv_color_hex(0x2196F3), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_color(mode_btn, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_event_cb(mode_btn, mode_btn_event_cb, LV_EVENT_CLICKED, NULL);
+
+    for (int i = 0; i < IME_CAND_NUM; i++) {
+        ime.cand_btns[i] = bar_btn_create(ime.bar, &ime.cand_labels[i], font);
+        lv_obj_add_flag(ime.cand_btns[i], LV_OBJ_FLAG_HIDDEN);
+        lv_obj_add_event_cb(ime.cand_btns[i], cand_btn_event_cb, LV_EVENT_CLICKED, (void *)(intptr_t)i);
+    }
+
+    // 翻页按钮靠右，候选数量变化时不会移动
+    lv_obj_t *spacer = lv_obj_create(ime.bar);
+    lv_obj_remove_style_all(spacer);
+    lv_obj_set_height(spacer, 1);
+    lv_obj_set_flex_grow(spacer, 1);
+
+    lv_obj_t *label;
+    ime.prev_btn = bar_btn_create(ime.bar, &label, LV_FONT_DEFAULT);
+    lv_label_set_text_static(label, LV_SYMBOL_LEFT);
+    lv_obj_add_event_cb(ime.prev_btn, page_btn_event_cb, LV_EVENT_CLICKED, NULL);
+
+    ime.next_btn = bar_btn_create(ime.bar, &label, LV_FONT_DEFAULT);
+    lv_label_set_text_static(label, LV_SYMBOL_RIGHT);
+    lv_obj_add_event_cb(ime.next_btn, page_btn_event_cb, LV_EVENT_CLICKED, NULL);
+
+    lv_obj_add_event_cb(kb, kb_event_cb, LV_EVENT_VALUE_CHANGED, NULL);
+    lv_obj_add_event_cb(kb, kb_event_cb, LV_EVENT_READY, NULL);
+    lv_obj_add_event_cb(kb, kb_event_cb, LV_EVENT_CANCEL, NULL);
+
+    ime_clear();
+    ESP_LOGI(TAG, "拼音词典: %u 个候选, %u 个节点", (unsigned)pinyin_dict.cand_cnt, (unsigned)pinyin_dict.node_cnt);
+}
+
+void pinyin_ime_reset(void)
+{
+    if (ime.kb != NULL) {
+        ime.ta = lv_keyboard_get_textarea(ime.kb);
+        ime_clear();
+    }
+}
+
+#endif /* CONFIG_EXAMPLE_PINYIN_IME */
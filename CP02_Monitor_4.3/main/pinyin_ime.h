@@ -0,0 +1,77 @@
+/**
+ * @file     pinyin_ime.h
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    Pinyin Input Method Module Header
+ *
+ * 设置界面键盘的拼音输入法。词典在构建时由tools/gen_pinyin_dict.py生成
+ * 前缀树放在flash中，每输入一个字母只需沿树走一步，任意前缀的候选都是
+ * 候选表中连续的一段，与词典大小无关。
+ * 候选栏位于键盘顶部，翻页或输入时只更新内容变化的候选按钮。
+ */
+
+#ifndef PINYIN_IME_H
+#define PINYIN_IME_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PINYIN_NODE_NONE    0xFFFFFFFFu
+#define PINYIN_MAX_INPUT    16      // 一次最多输入的字母数
+
+// 前缀树节点，由生成工具输出
+typedef struct {
+    uint32_t child_mask;    // 第i位表示存在字母'a'+i的子节点
+    uint32_t first_child;   // 第一个子节点的序号，子节点按字母顺序连续存放
+    uint32_t cand_start;    // 本节点及所有子孙的候选在候选表中的起始位置
+    uint32_t cand_own;      // 完全匹配本节点拼音的候选数，排在最前
+    uint32_t cand_total;    // 本节点及所有子孙的候选总数
+} pinyin_node_t;
+
+typedef struct {
+    const pinyin_node_t *nodes;     // 节点0为根
+    uint32_t node_cnt;
+    const char *const *cands;       // UTF-8候选
+    uint32_t cand_cnt;
+} pinyin_dict_t;
+
+// 构建时生成的词典
+extern const pinyin_dict_t pinyin_dict;
+
+// 从节点走一个字母，不存在时返回PINYIN_NODE_NONE
+uint32_t pinyin_dict_step(const pinyin_dict_t *dict, uint32_t node, char letter);
+
+/**
+ * @brief 查找拼音前缀对应的节点
+ *
+ * @return 节点序号，没有以此为前缀的拼音时返回PINYIN_NODE_NONE
+ */
+uint32_t pinyin_dict_find(const pinyin_dict_t *dict, const char *py, size_t len);
+
+#if CONFIG_EXAMPLE_PINYIN_IME
+#include "lvgl.h"
+
+/**
+ * @brief 为键盘加上拼音输入
+ *
+ * 候选栏作为键盘的子对象放在键盘顶部，随键盘一起显示和隐藏。
+ * 候选栏左侧的按钮切换中英文，密码框和限制了字符的输入框不使用拼音。
+ */
+void pinyin_ime_attach(lv_obj_t *kb, const lv_font_t *font);
+
+// 放弃正在输入的拼音（已输入的字母保留在输入框中）
+void pinyin_ime_reset(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PINYIN_IME_H */
@@ -0,0 +1,98 @@
+/**
+ * @file     port_filter.c
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    Port Display Filter Module Implementation
+ */
+
+#include "port_filter.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 平滑值直接采用新读数
+static void filter_snap(port_filter_t *filter, int voltage_mv, int current_ma)
+{
+    filter->voltage_ema = (float)voltage_mv;
+    filter->current_ema = (float)current_ma;
+}
+
+// 显示值更新为当前平滑值
+static void filter_show(port_filter_t *filter)
+{
+    filter->shown_mv = (int)lrintf(filter->voltage_ema);
+    filter->shown_ma = (int)lrintf(filter->current_ema);
+}
+
+void port_filter_reset(port_filter_t *filter)
+{
+    memset(filter, 0, sizeof(*filter));
+}
+
+uint32_t port_filter_update(port_filter_t *filter, const port_filter_config_t *cfg, int voltage_mv, int current_ma,
+                            int protocol)
+{
+    bool no_output = voltage_mv < cfg->off_mv;
+    if (!no_output) {
+        filter->off_count = 0;
+    } else if (filter->off_count < UINT8_MAX) {
+        filter->off_count++;
+    }
+
+    if (!filter->primed) {
+        filter->primed = true;
+        filter->off = no_output;
+        filter->shown_protocol = protocol;
+        filter_snap(filter, voltage_mv, current_ma);
+        filter_show(filter);
+        if (filter->off) {
+            filter->shown_mv = 0;
+            filter->shown_ma = 0;
+        }
+        return PORT_FILTER_VALUE | PORT_FILTER_STATE;
+    }
+
+    // 关闭状态下不再更新显示，重新上电时立即退出
+    if (filter->off) {
+        filter_snap(filter, voltage_mv, current_ma);
+        if (no_output) {
+            return 0;
+        }
+        filter->off = false;
+        filter->shown_protocol = protocol;
+        filter_show(filter);
+        return PORT_FILTER_VALUE | PORT_FILTER_STATE;
+    }
+    if (filter->off_count >= cfg->off_samples) {
+        filter->off = true;
+        filter_snap(filter, voltage_mv, current_ma);
+        filter->shown_mv = 0;
+        filter->shown_ma = 0;
+        return PORT_FILTER_STATE;
+    }
+
+    if (fabsf(voltage_mv - filter->voltage_ema) >= cfg->snap_mv ||
+        fabsf(current_ma - filter->current_ema) >= cfg->snap_ma) {
+        filter_snap(filter, voltage_mv, current_ma);
+    } else {
+        float alpha = cfg->alpha_pct / 100.0f;
+        filter->voltage_ema += alpha * (voltage_mv - filter->voltage_ema);
+        filter->current_ema += alpha * (current_ma - filter->current_ema);
+    }
+
+    int mv = (int)lrintf(filter->voltage_ema);
+    int ma = (int)lrintf(filter->current_ema);
+    // 电流回落到0时即使变化小于死区也要更新，否则会一直显示残留的小电流
+    bool changed = abs(mv - filter->shown_mv) >= cfg->deadband_mv ||
+                   abs(ma - filter->shown_ma) >= cfg->deadband_ma ||
+                   (ma == 0 && filter->shown_ma != 0) ||
+                   protocol != filter->shown_protocol;
+    if (!changed) {
+        return 0;
+    }
+    filter->shown_mv = mv;
+    filter->shown_ma = ma;
+    filter->shown_protocol = protocol;
+    return PORT_FILTER_VALUE;
+}
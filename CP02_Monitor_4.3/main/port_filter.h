@@ -0,0 +1,89 @@
+/**
+ * @file     port_filter.h
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    Port Display Filter Module Header
+ *
+ * 主界面端口行的显示过滤。传感器读数在最后一位上下跳动，空载和未接入
+ * 的端口也每次刷新都重绘，实际内容却没有变化。
+ *
+ * 每个端口的读数先做指数平滑，读数跳变超过snap阈值时（插拔、协议切换
+ * 电压）直接采用新值，不让平滑拖慢响应。平滑后的值与当前显示的值相差
+ * 超过死区才更新显示，读数归零时总是更新，不会停在一个很小的残留值上。
+ * 快充协议也显示在端口行上，协议变化时同样更新显示。
+ * 电压连续几次低于off_mv时端口进入关闭状态，之后只在重新上电时通知。
+ *
+ * 只依赖标准C头文件，可以在主机上回放数据验证。目前只用合成的数据回放过
+ * （tests/host/traces），还没有设备上的实测记录。
+ */
+
+#ifndef PORT_FILTER_H
+#define PORT_FILTER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PORT_FILTER_VALUE       (1u << 0)   // 显示的电压电流或协议有变化
+#define PORT_FILTER_STATE       (1u << 1)   // 进入或离开关闭状态
+
+// 过滤参数
+typedef struct {
+    uint16_t deadband_mv;       // 电压变化小于这个值时不更新显示
+    uint16_t deadband_ma;       // 电流变化小于这个值时不更新显示
+    uint16_t snap_mv;           // 电压跳变超过这个值时不做平滑
+    uint16_t snap_ma;           // 电流跳变超过这个值时不做平滑
+    uint8_t alpha_pct;          // 平滑时新读数所占的比例（%）
+    uint16_t off_mv;            // 电压低于这个值时认为端口没有输出
+    uint8_t off_samples;        // 连续多少次没有输出后进入关闭状态
+} port_filter_config_t;
+
+#define PORT_FILTER_DEFAULT_CONFIG() {  \
+    .deadband_mv = 100,                 \
+    .deadband_ma = 20,                  \
+    .snap_mv = 1000,                    \
+    .snap_ma = 300,                     \
+    .alpha_pct = 30,                    \
+    .off_mv = 1000,                     \
+    .off_samples = 3,                   \
+}
+
+// 单个端口的过滤状态
+typedef struct {
+    float voltage_ema;
+    float current_ema;
+    int shown_mv;               // 当前显示的电压，关闭状态下为0
+    int shown_ma;               // 当前显示的电流，关闭状态下为0
+    int shown_protocol;         // 当前显示的快充协议
+    uint8_t off_count;          // 连续没有输出的次数
+    bool off;                   // 是否处于关闭状态
+    bool primed;                // 是否已经收到第一个读数
+} port_filter_t;
+
+// 清空过滤状态，下一个读数总是更新显示
+void port_filter_reset(port_filter_t *filter);
+
+/**
+ * @brief 输入一次读数
+ *
+ * @return PORT_FILTER_VALUE、PORT_FILTER_STATE的组合，0表示显示不需要更新。
+ *         更新后的显示值在shown_mv、shown_ma、shown_protocol中。
+ */
+uint32_t port_filter_update(port_filter_t *filter, const port_filter_config_t *cfg, int voltage_mv, int current_ma,
+                            int protocol);
+
+// 当前显示的功率（W）
+static inline float port_filter_power(const port_filter_t *filter)
+{
+    return filter->shown_mv * (float)filter->shown_ma / 1000000.0f;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORT_FILTER_H */
@@ -9,9 +9,20 @@
 #include "power_monitor.h"
 #include "wifi_manager.h"
 #include "settings_ui.h"
+#include "gauge_view.h"
+#include "lvgl_port.h"
+#include "font_manager.h"
+#include "ui_theme.h"
+#include "ui_nav.h"
+#include "mem_tag.h"
+#include "app_config.h"
+#include "port_filter.h"
 #include "esp_system.h"
 #include "esp_log.h"
 #include "esp_http_client.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include <string.h>
 #include <stdlib.h>
 #include <math.h>
@@ -22,8 +33,6 @@ static const char *TAG = "POWER_MONITOR";
 #define MAX_PORTS 5
 extern const float MAX_POWER_WATTS;
 extern const float MAX_PORT_WATTS;
-extern const char DATA_URL[128];
-extern const int REFRESH_INTERVAL;
 
 // 本地可修改变量
 static char local_data_url[128] = {0};
@@ -39,6 +48,10 @@ static esp_http_client_handle_t client = NULL;
 static uint32_t last_data_fetch_time = 0;
 static int consecutive_errors = 0;  // 新增：连续错误计数器
 
+// 采集统计，解析在esp_http_client_perform()中进行，网络耗时要减去解析耗时
+static power_monitor_stats_t monitor_stats;
+static int64_t parse_call_us = 0;
+
 // UI组件
 static lv_obj_t *ui_screen;
 static lv_obj_t *ui_title;
@@ -55,6 +68,19 @@ static lv_timer_t *wifi_timer = NULL;
 static lv_timer_t *wifi_blink_timer = NULL;
 static lv_timer_t *startup_anim_timer = NULL;
 
+// 端口详情面板（长按端口打开）
+static lv_obj_t *ui_detail_panel = NULL;
+static lv_obj_t *ui_detail_label = NULL;
+static int detail_port_idx = -1;
+
+// 每个端口的峰值功率，双击清零
+static float port_peak_power[MAX_PORTS] = {0};
+
+// 主界面每行的显示过滤，读数没有明显变化时不重绘
+static const port_filter_config_t filter_cfg = PORT_FILTER_DEFAULT_CONFIG();
+static port_filter_t port_filters[MAX_PORTS];
+static char total_text[16] = "";
+
 // WiFi图标闪烁控制
 static bool wifi_icon_state = false;
 
@@ -69,28 +95,46 @@ static void wifi_blink_timer_cb(lv_timer_t *timer);
 static esp_err_t http_event_handler(esp_http_client_event_t *evt);
 static void power_monitor_timer_callback(lv_timer_t *timer);
 static void settings_btn_event_cb(lv_event_t *e);
+static void power_monitor_gesture_cb(const gesture_event_t *event, void *user_data);
+static void detail_panel_update(void);
+static void detail_panel_close(void);
+static void dashboard_create(lv_obj_t *parent);
+static void dashboard_on_data(uint32_t topics);
+
+// 主界面页面：离开时保留，定时器随页面暂停
+static ui_nav_screen_t dashboard_screen = {
+    .name = "dashboard",
+    .cached = true,
+    .topics = UI_NAV_TOPIC_POWER,
+    .create = dashboard_create,
+    .hide = detail_panel_close,
+    .on_data = dashboard_on_data,
+};
 
-// 设置回调函数
-static settings_change_cb_t settings_change_callback = NULL;
+// 颜色统一由ui_theme管理，见ui_theme.c中的调色板
 
-// 定义颜色宏，与原始Power_Monitor.c保持一致
-#define COLOR_WHITE     lv_color_hex(0xFFFFFF)
-#define COLOR_GREEN     lv_color_hex(0x00FF00)
-#define COLOR_YELLOW    lv_color_hex(0xFFFF00)
-#define COLOR_ORANGE    lv_color_hex(0xFF8800)
-#define COLOR_RED       lv_color_hex(0xFF0000)
-#define COLOR_PURPLE    lv_color_hex(0xFF00FF)
-#define COLOR_GRAY      lv_color_hex(0x888888)
+// 设置页面修改了数据地址或刷新间隔，在LVGL任务中调用，下一次采集时生效
+static void config_changed(uint32_t changed, const app_config_t *config)
+{
+    if (changed & APP_CONFIG_METRICS_URL) {
+        power_monitor_set_data_url(config->metrics_url);
+    }
+    if (changed & APP_CONFIG_REFRESH) {
+        power_monitor_set_refresh_interval(config->refresh_ms);
+    }
+}
 
 // 初始化电源监控
 esp_err_t power_monitor_init(void)
 {
     ESP_LOGI(TAG, "初始化电源监控模块...");
     
-    // 初始化本地变量
-    strncpy(local_data_url, DATA_URL, sizeof(local_data_url) - 1);
+    // 初始化本地变量，设置页面修改后由config_changed()更新
+    const app_config_t *config = app_config_get();
+    strncpy(local_data_url, config->metrics_url, sizeof(local_data_url) - 1);
     local_data_url[sizeof(local_data_url) - 1] = '\0';
-    local_refresh_interval = REFRESH_INTERVAL;
+    local_refresh_interval = config->refresh_ms;
+    app_config_subscribe(APP_CONFIG_METRICS_URL | APP_CONFIG_REFRESH, config_changed);
     
     // 初始化端口信息
     for (int i = 0; i < MAX_PORTS; i++) {
@@ -112,15 +156,29 @@ esp_err_t power_monitor_init(void)
     // 初始化数据获取时间戳
     last_data_fetch_time = esp_log_timestamp();
     
+    // 预先渲染界面上固定的文字和数字，避免首次显示时逐字渲染
+    if (font_manager_is_ttf()) {
+        font_manager_warm_up(font_manager_get(16),
+                             "0123456789.:W%mAV 总功率设置返回连接保存提示错误未连接数据获取中单击关闭双击清零峰值"
+                             "密码输入名称小电拼当前设备");
+        font_manager_stats_t font_stats;
+        font_manager_get_stats(&font_stats);
+        ESP_LOGI(TAG, "字体预热: %u个字形, %u ms, 缓存 %u/%u 字节", (unsigned)font_stats.warm_glyphs,
+                 (unsigned)font_stats.warm_ms, (unsigned)font_stats.cache_bytes, (unsigned)font_stats.cache_limit);
+    }
+    
     // 创建电源监控UI
     power_monitor_create_ui();
     
+    // 注册手势回调，主界面作为视图控制器
+    lvgl_port_set_gesture_cb(power_monitor_gesture_cb, NULL);
+    
     // 启动动画 - 缩短动画间隔为5ms，加快启动速度
     startup_anim_progress = 0;
     startup_anim_timer = lv_timer_create(startup_animation_cb, 5, NULL);
     
     // 创建WiFi状态监控定时器 - 它会在启动动画完成后启动数据刷新定时器
-    wifi_timer = lv_timer_create(wifi_status_timer_cb, 1000, NULL);
+    wifi_timer = ui_nav_timer_create(&dashboard_screen, wifi_status_timer_cb, 1000, NULL);
     
     ESP_LOGI(TAG, "电源监控模块已初始化");
     
@@ -145,7 +203,7 @@ static void wifi_status_timer_cb(lv_timer_t *timer)
             ESP_LOGI(TAG, "WiFi未连接或未获取IP，界面将显示但无数据更新");
         }
         
-        refresh_timer = lv_timer_create(power_monitor_timer_callback, local_refresh_interval, NULL);
+        refresh_timer = ui_nav_timer_create(&dashboard_screen, power_monitor_timer_callback, local_refresh_interval, NULL);
         ESP_LOGI(TAG, "刷新定时器已创建，间隔: %d ms", local_refresh_interval);
     }
 }
@@ -184,22 +242,16 @@ static void wifi_blink_timer_cb(lv_timer_t *timer)
     // 只有当WiFi连接成功且没有数据错误时才闪烁
     if (WIFI_Connection && WIFI_GotIP && !dataError) {
         wifi_icon_state = !wifi_icon_state;
-        if (wifi_icon_state) {
-            // 绿色
-            lv_obj_set_style_text_color(ui_wifi_status, lv_color_hex(0x00FF00), LV_PART_MAIN | LV_STATE_DEFAULT);
-        } else {
-            // 白色
-            lv_obj_set_style_text_color(ui_wifi_status, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
-        }
+        ui_theme_set_status(ui_wifi_status, wifi_icon_state ? UI_STATUS_OK : UI_STATUS_BLINK);
     } else if (dataError) {
         // 数据错误时保持红色
-        lv_obj_set_style_text_color(ui_wifi_status, lv_color_hex(0xFF0000), LV_PART_MAIN | LV_STATE_DEFAULT);
+        ui_theme_set_status(ui_wifi_status, UI_STATUS_ERROR);
     } else if (!WIFI_Connection) {
         // WiFi断开连接时保持红色
-        lv_obj_set_style_text_color(ui_wifi_status, lv_color_hex(0xFF0000), LV_PART_MAIN | LV_STATE_DEFAULT);
+        ui_theme_set_status(ui_wifi_status, UI_STATUS_ERROR);
     } else if (WIFI_Connection && !WIFI_GotIP) {
         // 正在获取IP
-        lv_obj_set_style_text_color(ui_wifi_status, lv_color_hex(0xFFFF00), LV_PART_MAIN | LV_STATE_DEFAULT);
+        ui_theme_set_status(ui_wifi_status, UI_STATUS_WARN);
     }
 }
 
@@ -236,7 +288,7 @@ static esp_err_t http_event_handler(esp_http_client_event_t *evt)
         case HTTP_EVENT_ON_CONNECTED:
             // 在连接时重置缓冲区
             if (output_buffer != NULL) {
-                free(output_buffer);
+                MEM_TAG_FREE(output_buffer);
             }
             output_buffer = NULL;
             output_len = 0;
@@ -255,7 +307,7 @@ static esp_err_t http_event_handler(esp_http_client_event_t *evt)
                 // 第一次收到数据，需要分配内存
                 if (output_buffer == NULL) {
                     int initial_size = 8192;
-                    output_buffer = (char *)malloc(initial_size);
+                    output_buffer = (char *)MEM_TAG_MALLOC(MEM_TAG_HTTP, initial_size);
                     if (output_buffer == NULL) {
                         ESP_LOGE(TAG, "无法为输出缓冲区分配内存");
                         return ESP_FAIL;
@@ -289,7 +341,7 @@ static esp_err_t http_event_handler(esp_http_client_event_t *evt)
             if (output_buffer != NULL && output_len > 0) {
                 output_buffer[output_len] = '\0';
                 power_monitor_parse_data(output_buffer);
-                free(output_buffer);
+                MEM_TAG_FREE(output_buffer);
             } else {
                 ESP_LOGW(TAG, "未收到数据");
             }
@@ -305,7 +357,7 @@ static esp_err_t http_event_handler(esp_http_client_event_t *evt)
                     output_buffer[output_len] = '\0';
                     power_monitor_parse_data(output_buffer);
                 }
-                free(output_buffer);
+                MEM_TAG_FREE(output_buffer);
                 output_buffer = NULL;
             }
             output_len = 0;
@@ -376,46 +428,16 @@ float power_monitor_get_total_power(void)
     return totalPower;
 }
 
-// 是否有数据错误
-bool power_monitor_has_error(void)
+// 获取数据采集统计
+void power_monitor_get_stats(power_monitor_stats_t *stats)
 {
-    return dataError;
+    *stats = monitor_stats;
 }
 
-// 注册设置改变回调
-void power_monitor_on_settings_change(void)
-{
-    ESP_LOGI(TAG, "设置已更改，更新配置");
-    
-    // 可以在这里添加任何设置更改后的处理逻辑
-    
-    // 如果有需要更新数据URL，可以在这里获取新的IP地址
-    wifi_user_config_t config;
-    if (wifi_manager_get_config(&config) == ESP_OK) {
-        char url[128];
-        snprintf(url, sizeof(url), "http://%s/metrics", config.device_ip);
-        power_monitor_set_data_url(url);
-    }
-}
-
-// 获取基于电压的颜色 - 与原Power_Monitor.c保持一致的逻辑
-static lv_color_t get_voltage_color(int voltage_mv)
+// 是否有数据错误
+bool power_monitor_has_error(void)
 {
-    if (voltage_mv > 21000) {                           // 21V以上
-        return lv_color_hex(0xFF00FF);                  // 紫色
-    } else if (voltage_mv > 16000 && voltage_mv <= 21000) { // 16V~21V
-        return lv_color_hex(0xFF0000);                  // 红色
-    } else if (voltage_mv > 13000 && voltage_mv <= 16000) { // 13V~16V
-        return lv_color_hex(0xFF8800);                  // 橙色
-    } else if (voltage_mv > 10000 && voltage_mv <= 13000) { // 10V~13V
-        return lv_color_hex(0x88FF00);                  // 黄色
-    } else if (voltage_mv > 6000 && voltage_mv <= 10000) {  // 6V~10V
-        return lv_color_hex(0x00FF00);                  // 绿色
-    } else if (voltage_mv >= 0 && voltage_mv <= 6000) {     // 0V~6V
-        return lv_color_hex(0x444444);                  // 黑色（白底黑字）
-    } else {
-        return lv_color_hex(0x888888);                  // 灰色（未识别电压）
-    }
+    return dataError;
 }
 
 // 根据协议ID获取协议名称
@@ -450,12 +472,23 @@ static const char* get_fc_protocol_name(uint8_t protocol)
 
 // 创建电源显示UI
 esp_err_t power_monitor_create_ui(void)
+{
+    return ui_nav_push(&dashboard_screen);
+}
+
+// 页面高度变化时调整功率条容器，下边距保持20
+static void dashboard_size_cb(lv_event_t *e)
+{
+    lv_obj_t *power_container = lv_event_get_user_data(e);
+    lv_obj_set_height(power_container, lv_obj_get_height(lv_event_get_target(e)) - 80);
+}
+
+// 主界面页面的创建回调 - 屏幕背景由ui_nav设置
+static void dashboard_create(lv_obj_t *parent)
 {
     ESP_LOGI(TAG, "创建电源监控UI");
     
-    // 创建屏幕 - 改为亮色背景
-    ui_screen = lv_obj_create(NULL);
-    lv_obj_set_style_bg_color(ui_screen, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
+    ui_screen = parent;
     
     // 计算布局参数 - 调整为800*480屏幕
     int screen_width = 800;  // 屏幕宽度
@@ -464,7 +497,7 @@ esp_err_t power_monitor_create_ui(void)
     // 标题 - 字体加大到24
     ui_title = lv_label_create(ui_screen);
     lv_label_set_text(ui_title, "CP-02 Monitor");
-    lv_obj_set_style_text_color(ui_title, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
+    ui_theme_apply(ui_title, UI_STYLE_TITLE, LV_PART_MAIN);
     lv_obj_set_style_text_font(ui_title, &lv_font_montserrat_24, LV_PART_MAIN | LV_STATE_DEFAULT);  // 字号改为24
     lv_obj_align(ui_title, LV_ALIGN_TOP_MID, 0, 10);
     
@@ -472,33 +505,32 @@ esp_err_t power_monitor_create_ui(void)
     ui_settings_btn = lv_btn_create(ui_screen);
     lv_obj_set_size(ui_settings_btn, 80, 40);
     lv_obj_align(ui_settings_btn, LV_ALIGN_TOP_RIGHT, -15, 10);
-    lv_obj_set_style_bg_color(ui_settings_btn, lv_color_hex(0x2196F3), LV_PART_MAIN | LV_STATE_DEFAULT);
+    ui_theme_apply(ui_settings_btn, UI_STYLE_BUTTON, LV_PART_MAIN);
     lv_obj_add_event_cb(ui_settings_btn, settings_btn_event_cb, LV_EVENT_CLICKED, NULL);
     
     lv_obj_t *btn_label = lv_label_create(ui_settings_btn);
     lv_label_set_text(btn_label, "设置");
-    lv_obj_set_style_text_font(btn_label, &cn_16, LV_PART_MAIN | LV_STATE_DEFAULT);  // 中文字体
+    lv_obj_set_style_text_font(btn_label, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);  // 中文字体
     lv_obj_center(btn_label);
     
     // WiFi状态 - 与设置按钮对齐
     ui_wifi_status = lv_label_create(ui_screen);
     lv_label_set_text(ui_wifi_status, "WiFi");
-    lv_obj_set_style_text_color(ui_wifi_status, lv_color_hex(0x0000FF), LV_PART_MAIN | LV_STATE_DEFAULT);
+    ui_theme_set_status(ui_wifi_status, UI_STATUS_IDLE);
     lv_obj_set_style_text_font(ui_wifi_status, &lv_font_montserrat_16, LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_align_to(ui_wifi_status, ui_settings_btn, LV_ALIGN_OUT_LEFT_MID, -10, 0);
+    lv_obj_add_flag(ui_wifi_status, LVGL_PORT_OBJ_FLAG_DECOR);  // 闪烁的图标，帧时间不够时可以延后重绘
     
     // 开始WiFi图标闪烁定时器
-    wifi_blink_timer = lv_timer_create(wifi_blink_timer_cb, 500, NULL);
+    wifi_blink_timer = ui_nav_timer_create(&dashboard_screen, wifi_blink_timer_cb, 500, NULL);
     
     // 创建一个大的容器，包含所有功率条 - 增加高度以容纳总功率显示
     lv_obj_t *power_container = lv_obj_create(ui_screen);
-    lv_obj_set_size(power_container, screen_width - 40, 400); // 从350增加到400
+    lv_obj_set_size(power_container, screen_width - 40, screen_height - 80); // 高400，底部留20
     lv_obj_align(power_container, LV_ALIGN_TOP_MID, 0, 60);
-    lv_obj_set_style_bg_color(power_container, lv_color_hex(0xFAFAFA), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_color(power_container, lv_color_hex(0xDDDDDD), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_width(power_container, 2, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_radius(power_container, 10, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_pad_all(power_container, 15, LV_PART_MAIN | LV_STATE_DEFAULT);
+    // 底部显示性能信息时页面变矮，容器跟着缩短，不被盖住
+    lv_obj_add_event_cb(ui_screen, dashboard_size_cb, LV_EVENT_SIZE_CHANGED, power_container);
+    ui_theme_apply(power_container, UI_STYLE_CARD, LV_PART_MAIN);
     
     // 为每个端口创建水平功率条和标签 - 调整尺寸以适应更大的屏幕
     int bar_height = 20;     // 条的高度
@@ -514,8 +546,8 @@ esp_err_t power_monitor_create_ui(void)
         // 创建端口标签
         ui_port_labels[i] = lv_label_create(power_container);
         lv_label_set_text(ui_port_labels[i], portInfos[port_idx].name);
-        lv_obj_set_style_text_color(ui_port_labels[i], get_voltage_color(portInfos[port_idx].voltage), LV_PART_MAIN | LV_STATE_DEFAULT);
-        lv_obj_set_style_text_font(ui_port_labels[i], &cn_16, LV_PART_MAIN | LV_STATE_DEFAULT);
+        ui_theme_set_voltage(ui_port_labels[i], portInfos[port_idx].voltage);
+        lv_obj_set_style_text_font(ui_port_labels[i], font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_pos(ui_port_labels[i], 20, i * port_spacing + 12);
         
         // 创建电压、电流、功率标签 - 给文字增加宽度
@@ -523,8 +555,8 @@ esp_err_t power_monitor_create_ui(void)
         sprintf(info_text, "0.00V  0.00A  0.00W");
         ui_power_values[i] = lv_label_create(power_container);
         lv_label_set_text(ui_power_values[i], info_text);
-        lv_obj_set_style_text_color(ui_power_values[i], get_voltage_color(portInfos[port_idx].voltage), LV_PART_MAIN | LV_STATE_DEFAULT);
-        lv_obj_set_style_text_font(ui_power_values[i], &cn_16, LV_PART_MAIN | LV_STATE_DEFAULT);
+        ui_theme_set_voltage(ui_power_values[i], portInfos[port_idx].voltage);
+        lv_obj_set_style_text_font(ui_power_values[i], font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_set_pos(ui_power_values[i], 80, i * port_spacing + 12);
         
         // 创建功率条（彩色水平条）- 向左移动位置
@@ -532,37 +564,31 @@ esp_err_t power_monitor_create_ui(void)
         lv_obj_set_size(ui_power_arcs[i], 400, bar_height); // 保持宽度不变
         lv_obj_set_pos(ui_power_arcs[i], 330, i * port_spacing + 12); // 右移到容器右侧
         
-        // 设置条的颜色
-        lv_obj_set_style_bg_color(ui_power_arcs[i], lv_color_hex(0xCCCCCC), LV_PART_MAIN);  // 背景色使用深灰色
-        lv_obj_set_style_bg_color(ui_power_arcs[i], lv_color_hex(0x88FF00), LV_PART_INDICATOR);  // 指示器颜色使用绿黄色
-        
-        // 启用水平渐变
-        lv_obj_set_style_bg_grad_dir(ui_power_arcs[i], LV_GRAD_DIR_HOR, LV_PART_INDICATOR | LV_STATE_DEFAULT);
-        
-        // 设置渐变终止颜色为橙色
-        lv_obj_set_style_bg_grad_color(ui_power_arcs[i], lv_color_hex(0xFF8800), LV_PART_INDICATOR | LV_STATE_DEFAULT);
-        
-        // 设置条的圆角
-        lv_obj_set_style_radius(ui_power_arcs[i], bar_height/2, LV_PART_MAIN);
-        lv_obj_set_style_radius(ui_power_arcs[i], bar_height/2, LV_PART_INDICATOR);
+        // 条的颜色、水平渐变和圆角都来自共享样式
+        ui_theme_apply(ui_power_arcs[i], UI_STYLE_BAR, LV_PART_MAIN);
+        ui_theme_apply(ui_power_arcs[i], UI_STYLE_BAR_INDICATOR, LV_PART_INDICATOR);
         
         // 设置初始值为0
         lv_bar_set_range(ui_power_arcs[i], 0, 100);
         lv_bar_set_value(ui_power_arcs[i], 0, LV_ANIM_OFF);
+        
+        // 第一次收到数据时每行都要更新
+        port_filter_reset(&port_filters[port_idx]);
     }
+    total_text[0] = '\0';
     
     // 添加总功率显示 - 与单端口保持风格一致
     ui_total_label = lv_label_create(power_container);
     lv_label_set_text(ui_total_label, "总功率"); // 仅显示"总功率"，不显示数值
-    lv_obj_set_style_text_color(ui_total_label, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_font(ui_total_label, &cn_16, LV_PART_MAIN | LV_STATE_DEFAULT); // 与端口标签一致
+    ui_theme_apply(ui_total_label, UI_STYLE_TEXT, LV_PART_MAIN);
+    lv_obj_set_style_text_font(ui_total_label, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT); // 与端口标签一致
     lv_obj_set_pos(ui_total_label, 20, MAX_PORTS * port_spacing + 12);
     
     // 创建总功率信息标签 - 与单端口电压电流功率标签风格一致
     lv_obj_t *ui_total_power_value = lv_label_create(power_container);
     lv_label_set_text(ui_total_power_value, "0.00W");
-    lv_obj_set_style_text_color(ui_total_power_value, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_font(ui_total_power_value, &cn_16, LV_PART_MAIN | LV_STATE_DEFAULT); // 与端口信息一致
+    ui_theme_apply(ui_total_power_value, UI_STYLE_TEXT, LV_PART_MAIN);
+    lv_obj_set_style_text_font(ui_total_power_value, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT); // 与端口信息一致
     lv_obj_set_pos(ui_total_power_value, 80, MAX_PORTS * port_spacing + 12);
     
     // 创建总功率条 - 与单端口功率条保持一致的风格
@@ -570,19 +596,9 @@ esp_err_t power_monitor_create_ui(void)
     lv_obj_set_size(ui_total_arc, 400, bar_height); // 与单端口宽度一致
     lv_obj_set_pos(ui_total_arc, 330, MAX_PORTS * port_spacing + 12); // 与单端口位置一致
     
-    // 设置总功率条的颜色 - 使用与单端口一致的颜色
-    lv_obj_set_style_bg_color(ui_total_arc, lv_color_hex(0xCCCCCC), LV_PART_MAIN); // 与单端口一致
-    lv_obj_set_style_bg_color(ui_total_arc, lv_color_hex(0x88FF00), LV_PART_INDICATOR); // 与单端口一致
-    
-    // 启用水平渐变
-    lv_obj_set_style_bg_grad_dir(ui_total_arc, LV_GRAD_DIR_HOR, LV_PART_INDICATOR | LV_STATE_DEFAULT);
-    
-    // 设置渐变终止颜色为橙色 - 与单端口一致
-    lv_obj_set_style_bg_grad_color(ui_total_arc, lv_color_hex(0xFF8800), LV_PART_INDICATOR | LV_STATE_DEFAULT);
-    
-    // 设置条的圆角
-    lv_obj_set_style_radius(ui_total_arc, bar_height/2, LV_PART_MAIN);
-    lv_obj_set_style_radius(ui_total_arc, bar_height/2, LV_PART_INDICATOR);
+    // 使用与单端口相同的共享样式
+    ui_theme_apply(ui_total_arc, UI_STYLE_BAR, LV_PART_MAIN);
+    ui_theme_apply(ui_total_arc, UI_STYLE_BAR_INDICATOR, LV_PART_INDICATOR);
     
     // 设置初始值为0
     lv_bar_set_range(ui_total_arc, 0, 100);
@@ -590,11 +606,14 @@ esp_err_t power_monitor_create_ui(void)
     
     // 不再需要表格
     ui_port_table = NULL;
-    
-    // 加载屏幕
-    lv_scr_load(ui_screen);
-    
-    return ESP_OK;
+}
+
+// 订阅的数据有更新，只在主界面位于前台时调用
+static void dashboard_on_data(uint32_t topics)
+{
+    if (topics & UI_NAV_TOPIC_POWER) {
+        power_monitor_update_ui();
+    }
 }
 
 // 设置按钮回调函数
@@ -604,6 +623,147 @@ static void settings_btn_event_cb(lv_event_t *e)
     settings_ui_open_wifi_settings();
 }
 
+// 根据屏幕坐标查找端口所在行，返回显示行号，没有则返回-1
+static int port_row_at(int16_t x, int16_t y)
+{
+    for (int i = 0; i < MAX_PORTS; i++) {
+        lv_area_t label_area;
+        lv_area_t bar_area;
+        lv_obj_get_coords(ui_port_labels[i], &label_area);
+        lv_obj_get_coords(ui_power_arcs[i], &bar_area);
+        // 每行从标签上方15px开始，高度与行间距一致
+        if (y >= label_area.y1 - 15 && y < label_area.y1 + 40 && x >= label_area.x1 - 20 && x <= bar_area.x2) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// 关闭端口详情面板
+static void detail_panel_close(void)
+{
+    if (ui_detail_panel != NULL) {
+        lv_obj_del(ui_detail_panel);
+        ui_detail_panel = NULL;
+        ui_detail_label = NULL;
+        detail_port_idx = -1;
+    }
+}
+
+// 打开端口详情面板，放大显示单个端口
+static void detail_panel_open(int port_idx)
+{
+    detail_panel_close();
+    detail_port_idx = port_idx;
+    
+    ui_detail_panel = lv_obj_create(ui_screen);
+    lv_obj_set_size(ui_detail_panel, 560, 280);
+    lv_obj_center(ui_detail_panel);
+    ui_theme_apply(ui_detail_panel, UI_STYLE_POPUP, LV_PART_MAIN);
+    lv_obj_clear_flag(ui_detail_panel, LV_OBJ_FLAG_SCROLLABLE);
+    
+    lv_obj_t *name_label = lv_label_create(ui_detail_panel);
+    lv_label_set_text(name_label, portInfos[port_idx].name);
+    lv_obj_set_style_text_font(name_label, &lv_font_montserrat_24, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_align(name_label, LV_ALIGN_TOP_MID, 0, 0);
+    
+    ui_detail_label = lv_label_create(ui_detail_panel);
+    lv_obj_set_style_text_font(ui_detail_label, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_line_space(ui_detail_label, 12, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_align(ui_detail_label, LV_ALIGN_TOP_LEFT, 20, 50);
+    
+    lv_obj_t *hint_label = lv_label_create(ui_detail_panel);
+    lv_label_set_text(hint_label, "单击关闭  双击清零峰值");
+    lv_obj_set_style_text_font(hint_label, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
+    ui_theme_apply(hint_label, UI_STYLE_MUTED, LV_PART_MAIN);
+    lv_obj_align(hint_label, LV_ALIGN_BOTTOM_MID, 0, 0);
+    
+    detail_panel_update();
+}
+
+// 刷新详情面板内容
+static void detail_panel_update(void)
+{
+    if (ui_detail_label == NULL || detail_port_idx < 0) {
+        return;
+    }
+    
+    port_info_t *port = &portInfos[detail_port_idx];
+    char text_buf[160];
+    snprintf(text_buf, sizeof(text_buf),
+             "电压:  %.2f V\n电流:  %.2f A\n功率:  %.2f W\n峰值:  %.2f W\n协议:  %s",
+             port->voltage / 1000.0f, port->current / 1000.0f, port->power,
+             port_peak_power[detail_port_idx], get_fc_protocol_name(port->fc_protocol));
+    lv_label_set_text(ui_detail_label, text_buf);
+    ui_theme_set_voltage(ui_detail_label, port->voltage);
+}
+
+// 手势回调 - 在LVGL任务中执行，已持有LVGL锁
+static void power_monitor_gesture_cb(const gesture_event_t *event, void *user_data)
+{
+    // 仪表页面：下滑或右滑返回主界面，左滑打开设置
+    if (gauge_view_is_open()) {
+        if (event->type == GESTURE_SWIPE_DOWN || event->type == GESTURE_SWIPE_RIGHT) {
+            ESP_LOGI(TAG, "手势: 返回主界面");
+            gauge_view_close();
+        } else if (event->type == GESTURE_SWIPE_LEFT) {
+            settings_ui_open_wifi_settings();
+        }
+        return;
+    }
+    
+    // 设置页面：右滑返回上一页
+    if (!ui_nav_is_top(&dashboard_screen)) {
+        if (event->type == GESTURE_SWIPE_RIGHT) {
+            ESP_LOGI(TAG, "手势: 右滑返回主界面");
+            settings_ui_close_wifi_settings();
+        }
+        return;
+    }
+    
+    switch (event->type) {
+        case GESTURE_SWIPE_LEFT:
+            // 左滑切换到设置页面
+            ESP_LOGI(TAG, "手势: 左滑打开设置 (%.0f px/s%s)", event->velocity_px_s, event->fling ? ", fling" : "");
+            settings_ui_open_wifi_settings();
+            break;
+            
+        case GESTURE_SWIPE_UP:
+            // 上滑切换到仪表页面
+            ESP_LOGI(TAG, "手势: 上滑打开仪表");
+            detail_panel_close();
+            gauge_view_open();
+            break;
+            
+        case GESTURE_LONG_PRESS: {
+            // 长按端口放大显示
+            int row = port_row_at(event->x, event->y);
+            if (row >= 0) {
+                int display_order[MAX_PORTS] = {1, 2, 3, 4, 0};
+                ESP_LOGI(TAG, "手势: 长按端口 %s", portInfos[display_order[row]].name);
+                detail_panel_open(display_order[row]);
+            }
+            break;
+        }
+            
+        case GESTURE_TAP:
+            // 单击关闭详情面板（识别器在双击窗口结束后才发出单击，双击不会先关闭面板）
+            detail_panel_close();
+            break;
+            
+        case GESTURE_DOUBLE_TAP:
+            // 双击清零峰值
+            ESP_LOGI(TAG, "手势: 双击清零峰值");
+            for (int i = 0; i < MAX_PORTS; i++) {
+                port_peak_power[i] = portInfos[i].power;
+            }
+            break;
+            
+        default:
+            break;
+    }
+}
+
 // 更新UI上的WiFi状态
 void power_monitor_update_wifi_status(void)
 {
@@ -611,10 +771,9 @@ void power_monitor_update_wifi_status(void)
     if (WIFI_Connection && WIFI_GotIP) {
         if (dataError) {
             // WiFi已连接但数据错误
-            lv_obj_t * label = ui_wifi_status;
-            lv_label_set_recolor(label, true);
-            lv_label_set_text(label, "WiFi: #FF0000 数据错误#");
-            lv_obj_set_style_text_font(label, &cn_16, LV_PART_MAIN | LV_STATE_DEFAULT);  // 中文字体
+            lv_label_set_text(ui_wifi_status, "WiFi: 数据错误");
+            lv_obj_set_style_text_font(ui_wifi_status, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);  // 中文字体
+            ui_theme_set_status(ui_wifi_status, UI_STATUS_ERROR);
             ESP_LOGW(TAG, "WiFi connected but data error");
         } else {
             // WiFi已连接且数据正常 - 颜色由闪烁定时器控制
@@ -624,13 +783,13 @@ void power_monitor_update_wifi_status(void)
     } else if (WIFI_Connection && !WIFI_GotIP) {
         // WiFi已连接但未获取IP
         lv_label_set_text(ui_wifi_status, "WiFi: 获取IP中");
-        lv_obj_set_style_text_font(ui_wifi_status, &cn_16, LV_PART_MAIN | LV_STATE_DEFAULT);  // 中文字体
-        lv_obj_set_style_text_color(ui_wifi_status, lv_color_hex(0xFFFF00), LV_PART_MAIN | LV_STATE_DEFAULT);
+        lv_obj_set_style_text_font(ui_wifi_status, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);  // 中文字体
+        ui_theme_set_status(ui_wifi_status, UI_STATUS_WARN);
         ESP_LOGW(TAG, "WiFi connected but no IP");
     } else {
         // WiFi断开连接
         lv_label_set_text(ui_wifi_status, "WiFi");
-        lv_obj_set_style_text_color(ui_wifi_status, lv_color_hex(0xFF0000), LV_PART_MAIN | LV_STATE_DEFAULT);
+        ui_theme_set_status(ui_wifi_status, UI_STATUS_ERROR);
         ESP_LOGW(TAG, "WiFi disconnected");
     }
     
@@ -641,7 +800,6 @@ void power_monitor_update_wifi_status(void)
 // 从网络获取数据
 esp_err_t power_monitor_fetch_data(void)
 {
-    static esp_http_client_handle_t client = NULL;
     uint32_t current_time = esp_log_timestamp();
     static uint32_t last_error_time = 0;
     
@@ -696,7 +854,12 @@ esp_err_t power_monitor_fetch_data(void)
     last_data_fetch_time = current_time;
     
     // 执行HTTP请求
+    int64_t start_us = esp_timer_get_time();
+    parse_call_us = 0;
     esp_err_t err = esp_http_client_perform(client);
+    int64_t fetch_us = esp_timer_get_time() - start_us - parse_call_us;
+    monitor_stats.fetch_ms = (uint32_t)(fetch_us / 1000);
+    monitor_stats.fetch_count++;
     
     if (err == ESP_OK) {
         int status_code = esp_http_client_get_status_code(client);
@@ -709,12 +872,14 @@ esp_err_t power_monitor_fetch_data(void)
             dataError = true;   // 设置数据错误标志
             consecutive_errors++;  // 增加连续错误计数
             last_error_time = current_time; // 记录错误时间
+            monitor_stats.error_count++;
             ESP_LOGE(TAG, "HTTP GET请求失败，状态码: %d (连续错误: %d)", status_code, consecutive_errors);
         }
     } else {
         dataError = true;   // 设置数据错误标志
         consecutive_errors++;  // 增加连续错误计数
         last_error_time = current_time; // 记录错误时间
+        monitor_stats.error_count++;
         ESP_LOGE(TAG, "HTTP GET请求失败: %s (错误码: %d, 连续错误: %d)", esp_err_to_name(err), err, consecutive_errors);
         
         // 每次错误后都重置HTTP客户端
@@ -728,6 +893,9 @@ esp_err_t power_monitor_fetch_data(void)
     
     // 更新WiFi状态以反映数据错误
     power_monitor_update_wifi_status();
+
+    // 每次请求算一个刷新周期，定期对比内存快照
+    mem_tag_cycle();
     
     // 让出更多CPU时间给其他任务
     vTaskDelay(10 / portTICK_PERIOD_MS);
@@ -738,6 +906,8 @@ esp_err_t power_monitor_fetch_data(void)
 // 解析数据
 void power_monitor_parse_data(char* payload)
 {
+    int64_t start_us = esp_timer_get_time();
+    
     // 检查有效载荷
     if (payload == NULL || strlen(payload) == 0) {
         ESP_LOGE(TAG, "收到空的数据有效载荷");
@@ -748,7 +918,7 @@ void power_monitor_parse_data(char* payload)
     totalPower = 0.0f;
     
     // 创建副本进行解析，避免修改原始数据
-    char* payload_copy = strdup(payload);
+    char* payload_copy = MEM_TAG_STRDUP(MEM_TAG_PARSE, payload);
     if (payload_copy == NULL) {
         ESP_LOGE(TAG, "无法为数据创建副本，内存不足");
         return;
@@ -834,7 +1004,7 @@ void power_monitor_parse_data(char* payload)
     }
     
     // 释放副本内存
-    free(payload_copy);
+    MEM_TAG_FREE(payload_copy);
     
     // 再次让出CPU时间，避免计算功率导致UI卡顿
     vTaskDelay(1 / portTICK_PERIOD_MS);
@@ -844,8 +1014,16 @@ void power_monitor_parse_data(char* payload)
         // 功率 = 电流(mA) * 电压(mV) / 1000000 (转换为W)
         portInfos[i].power = (portInfos[i].current * portInfos[i].voltage) / 1000000.0f;
         totalPower += portInfos[i].power;
+        
+        // 记录峰值功率
+        if (portInfos[i].power > port_peak_power[i]) {
+            port_peak_power[i] = portInfos[i].power;
+        }
     }
     
+    monitor_stats.parse_us = (uint32_t)(esp_timer_get_time() - start_us);
+    monitor_stats.last_data_ms = esp_log_timestamp();
+    
     // 添加一行日志显示所有端口的电源信息
     ESP_LOGI(TAG, "A=%.2fW(%dmA,%dmV), C1=%.2fW(%dmA,%dmV), C2=%.2fW(%dmA,%dmV), C3=%.2fW(%dmA,%dmV), C4=%.2fW(%dmA,%dmV), 总功率=%.2fW", 
              portInfos[0].power, portInfos[0].current, portInfos[0].voltage,
@@ -858,8 +1036,37 @@ void power_monitor_parse_data(char* payload)
     // 更新UI前添加短暂延迟
     vTaskDelay(1 / portTICK_PERIOD_MS);
     
-    // 更新UI
-    power_monitor_update_ui();
+    // 通知订阅了功率数据的页面，主界面不在前台时等返回后再更新
+    ui_nav_publish(UI_NAV_TOPIC_POWER);
+    
+    parse_call_us += esp_timer_get_time() - start_us;
+}
+
+// 功率占最大值的百分比，非零功率至少显示一些进度
+static int power_percent(float power, float max_watts)
+{
+    int percent = (int)((power / max_watts) * 100);
+    if (power > 0 && percent == 0) {
+        percent = 1;
+    }
+    // 限制最大值为100
+    if (percent > 100) {
+        percent = 100;
+    }
+    return percent;
+}
+
+// 端口行进入或离开关闭状态：关闭时收起功率条，只显示未连接
+static void port_row_set_off(int row, bool off)
+{
+    if (off) {
+        lv_obj_add_flag(ui_power_arcs[row], LV_OBJ_FLAG_HIDDEN);
+        lv_label_set_text(ui_power_values[row], "未连接");
+        ui_theme_set_voltage(ui_port_labels[row], 0);
+        ui_theme_set_voltage(ui_power_values[row], 0);
+    } else {
+        lv_obj_clear_flag(ui_power_arcs[row], LV_OBJ_FLAG_HIDDEN);
+    }
 }
 
 // 更新UI
@@ -874,131 +1081,71 @@ void power_monitor_update_ui(void)
     // 定义自定义顺序 - A口挪到C1~C4后面
     int display_order[MAX_PORTS] = {1, 2, 3, 4, 0}; // 显示顺序：C1, C2, C3, C4, A
     
-    // 更新端口数据
+    // 更新端口数据，总功率按显示的值求和，和各行保持一致
+    float shown_total = 0.0f;
     for (int i = 0; i < MAX_PORTS; i++) {
         // 根据自定义顺序获取实际的端口索引
         int port_idx = display_order[i];
+        port_filter_t *filter = &port_filters[port_idx];
         
-        // 计算并格式化值
-        float power_w = portInfos[port_idx].power;
-        float voltage_v = portInfos[port_idx].voltage / 1000.0f; // 转换为V
-        float current_a = portInfos[port_idx].current / 1000.0f; // 转换为A
+        uint32_t changes = port_filter_update(filter, &filter_cfg, portInfos[port_idx].voltage, portInfos[port_idx].current,
+                                              portInfos[port_idx].fc_protocol);
+        shown_total += port_filter_power(filter);
+        if (changes == 0) {
+            monitor_stats.row_skips++;
+            continue;
+        }
+        monitor_stats.row_updates++;
         
-        // 根据电压确定颜色
-        lv_color_t color = get_voltage_color(portInfos[port_idx].voltage);
+        if (changes & PORT_FILTER_STATE) {
+            port_row_set_off(i, filter->off);
+        }
+        if (filter->off || !(changes & PORT_FILTER_VALUE)) {
+            continue;
+        }
+        
+        // 计算并格式化值
+        float power_w = port_filter_power(filter);
+        float voltage_v = filter->shown_mv / 1000.0f; // 转换为V
+        float current_a = filter->shown_ma / 1000.0f; // 转换为A
         
-        // 更新端口标签颜色
-        lv_obj_set_style_text_color(ui_port_labels[i], color, LV_PART_MAIN | LV_STATE_DEFAULT);
+        // 根据电压切换颜色样式，电压等级不变时不会刷新样式
+        ui_theme_set_voltage(ui_port_labels[i], filter->shown_mv);
         
         // 获取充电协议名称
-        const char* protocol_name = get_fc_protocol_name(portInfos[port_idx].fc_protocol);
+        const char* protocol_name = get_fc_protocol_name(filter->shown_protocol);
         
         // 格式化并更新信息文本，添加协议信息
         sprintf(text_buf, "%.1fV  %.1fA  %.2fW %s", voltage_v, current_a, power_w, protocol_name);
         lv_label_set_text(ui_power_values[i], text_buf);
-        lv_obj_set_style_text_color(ui_power_values[i], color, LV_PART_MAIN | LV_STATE_DEFAULT);
-        
-        // 更新功率条的值（最大功率的百分比）
-        int percent = (int)((portInfos[port_idx].power / MAX_PORT_WATTS) * 100);
-        // 确保非零功率至少显示一些进度
-        if (portInfos[port_idx].power > 0 && percent == 0) {
-            percent = 1;
-        }
-        // 限制最大值为100
-        if (percent > 100) {
-            percent = 100;
-        }
-        
-        // 设置功率条的值
-        lv_bar_set_value(ui_power_arcs[i], percent, LV_ANIM_OFF);
+        ui_theme_set_voltage(ui_power_values[i], filter->shown_mv);
         
-        // 确保端口标签文本不变
-        lv_label_set_text(ui_port_labels[i], portInfos[port_idx].name);
+        // 设置功率条的值（最大功率的百分比），值不变时LVGL不会重绘
+        lv_bar_set_value(ui_power_arcs[i], power_percent(power_w, MAX_PORT_WATTS), LV_ANIM_OFF);
         
         // 每更新一个端口后添加短暂延迟
         vTaskDelay(1 / portTICK_PERIOD_MS);
     }
     
-    // 更新总功率显示 - 只更新功率值文本
-    if (ui_total_label != NULL) {
+    // 更新总功率显示 - 只更新功率值文本，文本不变时不重绘
+    snprintf(text_buf, sizeof(text_buf), "%.2fW", shown_total);
+    if (ui_total_label != NULL && strcmp(text_buf, total_text) != 0) {
         // 找到总功率值标签 - 它紧跟在ui_total_label之后
         lv_obj_t *value_label = lv_obj_get_child(lv_obj_get_parent(ui_total_label), lv_obj_get_index(ui_total_label) + 1);
         if (value_label != NULL) {
-            sprintf(text_buf, "%.2fW", totalPower);
-            lv_label_set_text(value_label, text_buf);
+            strlcpy(total_text, text_buf, sizeof(total_text));
+            lv_label_set_text(value_label, total_text);
         }
     }
     
     // 更新总功率条 - 使用MAX_POWER_WATTS作为最大值
     if (ui_total_arc != NULL) {
-        int total_percent = (int)((totalPower / MAX_POWER_WATTS) * 100);
-        // 确保非零功率至少显示一些进度
-        if (totalPower > 0 && total_percent == 0) {
-            total_percent = 1;
-        }
-        // 限制最大值为100
-        if (total_percent > 100) {
-            total_percent = 100;
-        }
-        
-        // 设置总功率条的值
-        lv_bar_set_value(ui_total_arc, total_percent, LV_ANIM_OFF);
+        lv_bar_set_value(ui_total_arc, power_percent(shown_total, MAX_POWER_WATTS), LV_ANIM_OFF);
     }
     
+    // 刷新打开的详情面板
+    detail_panel_update();
+    
     // UI更新完成后添加短暂延迟
     vTaskDelay(1 / portTICK_PERIOD_MS);
 }
-
-// 暂停主程序定时器
-void pause_main_timer(void)
-{
-    ESP_LOGI(TAG, "暂停主程序定时器");
-    
-    // 暂停数据刷新定时器
-    if (refresh_timer != NULL) {
-        lv_timer_pause(refresh_timer);
-        ESP_LOGI(TAG, "数据刷新定时器已暂停");
-    }
-    
-    // 暂停WiFi状态监测定时器
-    if (wifi_timer != NULL) {
-        lv_timer_pause(wifi_timer);
-        ESP_LOGI(TAG, "WiFi状态定时器已暂停");
-    }
-    
-    // 暂停WiFi闪烁定时器
-    if (wifi_blink_timer != NULL) {
-        lv_timer_pause(wifi_blink_timer);
-        ESP_LOGI(TAG, "WiFi闪烁定时器已暂停");
-    }
-}
-
-// 恢复主程序定时器
-void resume_main_timer(void)
-{
-    ESP_LOGI(TAG, "恢复主程序定时器");
-    
-    // 恢复数据刷新定时器
-    if (refresh_timer != NULL) {
-        lv_timer_resume(refresh_timer);
-        ESP_LOGI(TAG, "数据刷新定时器已恢复");
-    }
-    
-    // 恢复WiFi状态监测定时器
-    if (wifi_timer != NULL) {
-        lv_timer_resume(wifi_timer);
-        ESP_LOGI(TAG, "WiFi状态定时器已恢复");
-    }
-    
-    // 恢复WiFi闪烁定时器
-    if (wifi_blink_timer != NULL) {
-        lv_timer_resume(wifi_blink_timer);
-        ESP_LOGI(TAG, "WiFi闪烁定时器已恢复");
-    }
-}
-
-// 获取主屏幕对象引用，供其他模块访问
-lv_obj_t *get_main_screen(void)
-{
-    return ui_screen;
-} 
\ No newline at end of file
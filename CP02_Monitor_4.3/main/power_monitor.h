@@ -30,6 +30,17 @@ typedef struct {
     float power;            // 功率 (W)
 } port_info_t;
 
+// 数据采集统计
+typedef struct {
+    uint32_t fetch_ms;          // 最近一次请求的网络耗时，不含解析
+    uint32_t parse_us;          // 最近一次解析耗时
+    uint32_t last_data_ms;      // 最近一次解析出数据的时间（esp_log_timestamp），0表示还没有数据
+    uint32_t fetch_count;       // 请求次数
+    uint32_t error_count;       // 失败的请求次数
+    uint32_t row_updates;       // 主界面端口行的重绘次数
+    uint32_t row_skips;         // 读数没有明显变化、跳过重绘的次数
+} power_monitor_stats_t;
+
 // 初始化电源监控
 esp_err_t power_monitor_init(void);
 
@@ -66,11 +77,8 @@ float power_monitor_get_total_power(void);
 // 是否有数据错误
 bool power_monitor_has_error(void);
 
-// 添加设置界面回调
-void power_monitor_on_settings_change(void);
-
-// 获取主屏幕对象引用，供其他模块访问
-lv_obj_t *get_main_screen(void);
+// 获取数据采集统计，采集在LVGL任务中进行，需要持有LVGL锁
+void power_monitor_get_stats(power_monitor_stats_t *stats);
 
 #ifdef __cplusplus
 }
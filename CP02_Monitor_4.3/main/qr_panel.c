@@ -0,0 +1,248 @@
+/**
+ * @file     qr_panel.c
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    QR Code Panel Module Implementation
+ */
+
+#include "qr_panel.h"
+#include <stdio.h>
+#include <string.h>
+#include "esp_log.h"
+#include "src/extra/libs/qrcode/qrcodegen.h"
+
+static const char *TAG = "QR_PANEL";
+
+#define QR_MAX_VERSION      15      // 77x77模块，足够放下最长的WiFi字符串
+#define QR_QUIET_ZONE       2       // 静区宽度（模块数）
+#define QR_PALETTE_SIZE     8       // 两个lv_color32_t调色板项
+
+typedef struct {
+    lv_img_dsc_t img;               // 1bpp索引图像，每个模块一个像素，索引1为深色
+    char *text;                     // 当前编码的文字
+    lv_color_t dark;
+} qr_panel_t;
+
+static inline bool qr_module(const qr_panel_t *qr, int32_t x, int32_t y)
+{
+    uint32_t stride = (qr->img.header.w + 7) / 8;
+    const uint8_t *row = qr->img.data + QR_PALETTE_SIZE + y * stride;
+    return (row[x >> 3] >> (7 - (x & 7))) & 1;
+}
+
+// 绘制时放大：每行深色模块合并成一段，只绘制与刷新区域相交的行
+static void qr_panel_draw_cb(lv_event_t *e)
+{
+    lv_obj_t *obj = lv_event_get_target(e);
+    qr_panel_t *qr = lv_obj_get_user_data(obj);
+    if (qr == NULL || qr->img.data == NULL) {
+        return;
+    }
+
+    lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+    const lv_area_t *clip = draw_ctx->clip_area;
+
+    lv_area_t content;
+    lv_obj_get_content_coords(obj, &content);
+    int32_t n = qr->img.header.w;
+    int32_t scale = LV_MIN(lv_area_get_width(&content), lv_area_get_height(&content)) / n;
+    if (scale < 1) {
+        return;
+    }
+    lv_coord_t x0 = content.x1 + (lv_area_get_width(&content) - n * scale) / 2;
+    lv_coord_t y0 = content.y1 + (lv_area_get_height(&content) - n * scale) / 2;
+
+    if (clip->y2 < y0 || clip->y1 >= y0 + n * scale) {
+        return;
+    }
+    int32_t row_first = clip->y1 > y0 ? (clip->y1 - y0) / scale : 0;
+    int32_t row_last = LV_MIN(n - 1, (clip->y2 - y0) / scale);
+
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = qr->dark;
+    dsc.bg_opa = LV_OPA_COVER;
+
+    for (int32_t y = row_first; y <= row_last; y++) {
+        int32_t x = 0;
+        while (x < n) {
+            if (!qr_module(qr, x, y)) {
+                x++;
+                continue;
+            }
+            int32_t run = x;
+            while (x < n && qr_module(qr, x, y)) {
+                x++;
+            }
+            lv_area_t area = {
+                .x1 = x0 + run * scale,
+                .y1 = y0 + y * scale,
+                .x2 = x0 + x * scale - 1,
+                .y2 = y0 + (y + 1) * scale - 1,
+            };
+            lv_draw_rect(draw_ctx, &dsc, &area);
+        }
+    }
+}
+
+// 释放图像和文字，文字可能含有WiFi密码，释放前清零
+static void qr_panel_free_content(qr_panel_t *qr)
+{
+    if (qr->text != NULL) {
+        memset(qr->text, 0, strlen(qr->text));
+    }
+    lv_mem_free(qr->text);
+    lv_mem_free((void *)qr->img.data);
+    qr->text = NULL;
+    qr->img.data = NULL;
+}
+
+static void qr_panel_delete_cb(lv_event_t *e)
+{
+    qr_panel_t *qr = lv_obj_get_user_data(lv_event_get_target(e));
+    if (qr != NULL) {
+        qr_panel_free_content(qr);
+        lv_mem_free(qr);
+    }
+}
+
+lv_obj_t *qr_panel_create(lv_obj_t *parent, lv_coord_t size, lv_color_t dark, lv_color_t light)
+{
+    qr_panel_t *qr = lv_mem_alloc(sizeof(qr_panel_t));
+    if (qr == NULL) {
+        ESP_LOGE(TAG, "内存不足");
+        return NULL;
+    }
+    memset(qr, 0, sizeof(*qr));
+    qr->dark = dark;
+
+    lv_obj_t *obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_set_size(obj, size, size);
+    lv_obj_set_style_bg_color(obj, light, LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, LV_PART_MAIN);
+    lv_obj_set_user_data(obj, qr);
+    lv_obj_add_event_cb(obj, qr_panel_draw_cb, LV_EVENT_DRAW_MAIN, NULL);
+    lv_obj_add_event_cb(obj, qr_panel_delete_cb, LV_EVENT_DELETE, NULL);
+    return obj;
+}
+
+esp_err_t qr_panel_set_text(lv_obj_t *panel, const char *text)
+{
+    qr_panel_t *qr = lv_obj_get_user_data(panel);
+    if (qr == NULL || text == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (qr->text != NULL && strcmp(qr->text, text) == 0) {
+        return ESP_OK;
+    }
+
+    size_t buf_len = qrcodegen_BUFFER_LEN_FOR_VERSION(QR_MAX_VERSION);
+    uint8_t *qr_buf = lv_mem_alloc(buf_len);
+    uint8_t *tmp_buf = lv_mem_alloc(buf_len);
+    char *text_copy = lv_mem_alloc(strlen(text) + 1);
+    esp_err_t ret = ESP_OK;
+
+    if (qr_buf == NULL || tmp_buf == NULL || text_copy == NULL) {
+        ret = ESP_ERR_NO_MEM;
+        goto out;
+    }
+    strcpy(text_copy, text);
+
+    if (!qrcodegen_encodeText(text, tmp_buf, qr_buf, qrcodegen_Ecc_LOW, qrcodegen_VERSION_MIN,
+                              QR_MAX_VERSION, qrcodegen_Mask_AUTO, true)) {
+        ESP_LOGW(TAG, "文字过长，无法生成二维码");
+        ret = ESP_ERR_INVALID_SIZE;
+        goto out;
+    }
+
+    // 生成带静区的1bpp索引图像
+    int32_t size = qrcodegen_getSize(qr_buf);
+    int32_t n = size + 2 * QR_QUIET_ZONE;
+    uint32_t stride = (n + 7) / 8;
+    uint32_t data_size = QR_PALETTE_SIZE + stride * n;
+    uint8_t *data = lv_mem_alloc(data_size);
+    if (data == NULL) {
+        ret = ESP_ERR_NO_MEM;
+        goto out;
+    }
+    memset(data, 0, data_size);
+    lv_color32_t *palette = (lv_color32_t *)data;
+    lv_color_t light = lv_obj_get_style_bg_color(panel, LV_PART_MAIN);
+    palette[0].full = lv_color_to32(light);
+    palette[1].full = lv_color_to32(qr->dark);
+    for (int32_t y = 0; y < size; y++) {
+        uint8_t *row = data + QR_PALETTE_SIZE + (y + QR_QUIET_ZONE) * stride;
+        for (int32_t x = 0; x < size; x++) {
+            if (qrcodegen_getModule(qr_buf, x, y)) {
+                int32_t px = x + QR_QUIET_ZONE;
+                row[px >> 3] |= 0x80 >> (px & 7);
+            }
+        }
+    }
+
+    qr_panel_free_content(qr);
+    qr->img.header.cf = LV_IMG_CF_INDEXED_1BIT;
+    qr->img.header.always_zero = 0;
+    qr->img.header.w = n;
+    qr->img.header.h = n;
+    qr->img.data_size = data_size;
+    qr->img.data = data;
+    qr->text = text_copy;
+    text_copy = NULL;
+    lv_obj_invalidate(panel);
+    ESP_LOGI(TAG, "二维码 %dx%d 模块, %u 字节", (int)size, (int)size, (unsigned)data_size);
+
+out:
+    lv_mem_free(qr_buf);
+    lv_mem_free(tmp_buf);
+    lv_mem_free(text_copy);
+    return ret;
+}
+
+void qr_panel_clear(lv_obj_t *panel)
+{
+    qr_panel_t *qr = lv_obj_get_user_data(panel);
+    if (qr == NULL || qr->text == NULL) {
+        return;
+    }
+
+    qr_panel_free_content(qr);
+    lv_obj_invalidate(panel);
+}
+
+// WiFi字符串中的 \ ; , : " 需要转义
+static size_t wifi_escape(char *dst, size_t len, const char *src)
+{
+    size_t n = 0;
+    for (; *src != '\0'; src++) {
+        bool esc = strchr("\\;,:\"", *src) != NULL;
+        if (n + (esc ? 2 : 1) >= len) {
+            break;
+        }
+        if (esc) {
+            dst[n++] = '\\';
+        }
+        dst[n++] = *src;
+    }
+    dst[n] = '\0';
+    return n;
+}
+
+esp_err_t qr_panel_wifi_string(char *buf, size_t len, const char *ssid, const char *password)
+{
+    char ssid_esc[2 * 32 + 1];
+    char pass_esc[2 * 64 + 1];
+    wifi_escape(ssid_esc, sizeof(ssid_esc), ssid);
+
+    int n;
+    if (password == NULL || password[0] == '\0') {
+        n = snprintf(buf, len, "WIFI:T:nopass;S:%s;;", ssid_esc);
+    } else {
+        wifi_escape(pass_esc, sizeof(pass_esc), password);
+        n = snprintf(buf, len, "WIFI:T:WPA;S:%s;P:%s;;", ssid_esc, pass_esc);
+    }
+    return (n < 0 || (size_t)n >= len) ? ESP_ERR_INVALID_SIZE : ESP_OK;
+}
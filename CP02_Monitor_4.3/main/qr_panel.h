@@ -0,0 +1,57 @@
+/**
+ * @file     qr_panel.h
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    QR Code Panel Module Header
+ *
+ * 二维码面板。二维码以每个模块一个像素的1bpp索引图像保存，绘制时按面板
+ * 大小放大，只填充与刷新区域相交的深色模块，不需要整块的画布缓冲区。
+ * 编码的文字不变时不会重新生成。
+ */
+
+#ifndef QR_PANEL_H
+#define QR_PANEL_H
+
+#include <stddef.h>
+#include "esp_err.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 创建二维码面板
+ *
+ * 面板背景为浅色，二维码周围留有两个模块宽的静区，按面板大小取整数倍放大后居中。
+ */
+lv_obj_t *qr_panel_create(lv_obj_t *parent, lv_coord_t size, lv_color_t dark, lv_color_t light);
+
+/**
+ * @brief 设置二维码内容
+ *
+ * 与当前内容相同时直接返回，不重新编码也不重绘。
+ * @return 文字过长无法编码时返回ESP_ERR_INVALID_SIZE
+ */
+esp_err_t qr_panel_set_text(lv_obj_t *panel, const char *text);
+
+/**
+ * @brief 清除二维码内容
+ *
+ * 释放图像和保存的文字，文字先清零，适合编码过密码等敏感内容的面板。
+ */
+void qr_panel_clear(lv_obj_t *panel);
+
+/**
+ * @brief 生成手机扫码加入WiFi的字符串 WIFI:T:WPA;S:<ssid>;P:<password>;;
+ *
+ * password为空时生成开放网络的字符串。
+ */
+esp_err_t qr_panel_wifi_string(char *buf, size_t len, const char *ssid, const char *password);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* QR_PANEL_H */
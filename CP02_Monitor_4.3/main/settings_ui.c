@@ -9,6 +9,14 @@
 #include "settings_ui.h"
 #include "wifi_manager.h"
 #include "power_monitor.h"
+#include "font_manager.h"
+#include "pinyin_ime.h"
+#include "qr_panel.h"
+#include "ui_theme.h"
+#include "ui_nav.h"
+#include "app_config.h"
+#include "lvgl_port.h"
+#include "perf_hud.h"
 #include "esp_log.h"
 #include <string.h>
 
@@ -21,9 +29,11 @@ static lv_obj_t *ui_password_input = NULL;
 static lv_obj_t *ui_device_ip_label = NULL;   // 改为只读标签
 static lv_obj_t *ui_device_ip_input = NULL;   // 小电拼IP输入
 static lv_obj_t *ui_keyboard = NULL;
+static lv_obj_t *ui_wifi_qr = NULL;           // 当前WiFi的扫码连接二维码，含密码，点击按钮后才显示
+static lv_obj_t *ui_wifi_qr_label = NULL;
+static lv_timer_t *wifi_qr_hide_timer = NULL;   // 显示一段时间后自动隐藏二维码
 
-// 设置改变回调
-static settings_change_cb_t change_callback = NULL;
+#define WIFI_QR_SHOW_MS     30000               // 二维码显示时间
 
 // 前向声明
 static void settings_save_btn_event_cb(lv_event_t *e);
@@ -31,12 +41,27 @@ static void settings_return_btn_event_cb(lv_event_t *e);
 static void wifi_connect_btn_event_cb(lv_event_t *e);
 static void input_focused_cb(lv_event_t *e);
 static void keyboard_ready_cb(lv_event_t *e);
+static void update_wifi_qr(const wifi_user_config_t *config);
+static void wifi_qr_btn_event_cb(lv_event_t *e);
+static void wifi_qr_hide(void);
+static void theme_changed_cb(lv_event_t *e);
+static void refresh_changed_cb(lv_event_t *e);
+#if CONFIG_EXAMPLE_PERF_HUD
+static void perf_hud_changed_cb(lv_event_t *e);
+#endif
+static void settings_ui_destroy(void);
 
-// 添加外部声明，让settings_ui能够调用power_monitor的函数
-extern lv_obj_t *get_main_screen(void);
-// 添加外部声明，用于暂停和恢复主程序定时器
-extern void pause_main_timer(void);
-extern void resume_main_timer(void);
+// 设置页面：离开时销毁，下次打开重新创建
+static ui_nav_screen_t settings_screen = {
+    .name = "settings",
+    .cached = false,
+    .create = settings_ui_create,
+    .destroy = settings_ui_destroy,
+};
+
+// 刷新间隔选项 (ms)，和下拉框的选项一一对应
+static const uint32_t refresh_options[] = {500, 1000, 2000, 5000};
+#define REFRESH_OPTIONS_TEXT    "0.5秒\n1秒\n2秒\n5秒"
 
 // 添加WiFi状态回调声明和全局变量
 static lv_obj_t *wifi_status_mbox = NULL;
@@ -66,7 +91,7 @@ static void wifi_connect_timeout_cb(lv_timer_t *timer)
         
         // 显示连接超时消息
         wifi_status_mbox = lv_msgbox_create(NULL, "错误", "WiFi连接超时，请检查网络设置", NULL, true);
-        lv_obj_set_style_text_font(wifi_status_mbox, &cn_16, LV_PART_MAIN | LV_STATE_DEFAULT);
+        lv_obj_set_style_text_font(wifi_status_mbox, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_center(wifi_status_mbox);
     }
     
@@ -86,7 +111,7 @@ static void update_wifi_status_display(const char *title, const char *msg)
     
     // 创建新的消息框
     wifi_status_mbox = lv_msgbox_create(NULL, title, msg, NULL, false);
-    lv_obj_set_style_text_font(wifi_status_mbox, &cn_16, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_font(wifi_status_mbox, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_center(wifi_status_mbox);
 }
 
@@ -95,6 +120,11 @@ static void wifi_status_callback(wifi_status_t status)
 {
     ESP_LOGI(TAG, "WiFi状态更新: %d", status);
     
+    // WiFi在后台切换，回调在事件任务中执行，操作控件前先拿LVGL锁
+    if (!lvgl_port_lock(-1)) {
+        return;
+    }
+    
     switch (status) {
         case WIFI_STATUS_CONNECTING:
             update_wifi_status_display("提示", "正在连接WiFi...");
@@ -111,10 +141,11 @@ static void wifi_status_callback(wifi_status_t status)
                 wifi_timeout_timer = NULL;
             }
             
-            // 获取当前IP显示在界面上
+            // 设置页面打开时把当前IP显示在界面上
             wifi_user_config_t config;
-            if (wifi_manager_get_config(&config) == ESP_OK) {
+            if (ui_device_ip_label != NULL && wifi_manager_get_config(&config) == ESP_OK) {
                 lv_label_set_text(ui_device_ip_label, config.device_ip);
+                update_wifi_qr(&config);
             }
             
             update_wifi_status_display("成功", "WiFi连接成功");
@@ -141,6 +172,8 @@ static void wifi_status_callback(wifi_status_t status)
         default:
             break;
     }
+    
+    lvgl_port_unlock();
 }
 
 // 初始化设置UI
@@ -151,59 +184,55 @@ void settings_ui_init(void)
     // 注册WiFi状态回调
     wifi_manager_register_cb(wifi_status_callback);
     
-    // 预先创建设置页面，但不显示
-    settings_ui_create();
+    // 设置页面在打开时才创建，关闭后释放
 }
 
 // 创建设置UI
-void settings_ui_create(void)
+void settings_ui_create(lv_obj_t *parent)
 {
-    // 创建统一的设置页面
-    ui_settings_screen = lv_obj_create(NULL);
-    lv_obj_set_style_bg_color(ui_settings_screen, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
+    // 统一的设置页面，放在ui_nav提供的容器中，弹出键盘时整体上移
+    ui_settings_screen = parent;
+    ui_theme_apply(ui_settings_screen, UI_STYLE_SCREEN, LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(ui_settings_screen, LV_OPA_COVER, LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_set_style_pad_all(ui_settings_screen, 10, LV_PART_MAIN);  // 增加内边距
     
     // 页面标题
     lv_obj_t *settings_title = lv_label_create(ui_settings_screen);
     lv_label_set_text(settings_title, "设置");
-    lv_obj_set_style_text_color(settings_title, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_font(settings_title, &cn_16, LV_PART_MAIN | LV_STATE_DEFAULT);
+    ui_theme_apply(settings_title, UI_STYLE_TITLE, LV_PART_MAIN);
+    lv_obj_set_style_text_font(settings_title, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_align(settings_title, LV_ALIGN_TOP_MID, 0, 10);
     
     // 返回按钮 - 移到右上角
     lv_obj_t *return_btn = lv_btn_create(ui_settings_screen);
     lv_obj_set_size(return_btn, 80, 40);
     lv_obj_align(return_btn, LV_ALIGN_TOP_RIGHT, -10, 10);
-    lv_obj_set_style_bg_color(return_btn, lv_color_hex(0x999999), LV_PART_MAIN | LV_STATE_DEFAULT);
+    ui_theme_apply(return_btn, UI_STYLE_BUTTON_SECONDARY, LV_PART_MAIN);
     lv_obj_add_event_cb(return_btn, settings_return_btn_event_cb, LV_EVENT_CLICKED, NULL);
     
     lv_obj_t *return_label = lv_label_create(return_btn);
     lv_label_set_text(return_label, "返回");
-    lv_obj_set_style_text_font(return_label, &cn_16, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_font(return_label, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_center(return_label);
     
     // 分隔线1 - 标题下方
     lv_obj_t *separator1 = lv_line_create(ui_settings_screen);
     static lv_point_t sep1_points[] = {{0, 0}, {320, 0}};
     lv_line_set_points(separator1, sep1_points, 2);
-    lv_obj_set_style_line_width(separator1, 1, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_color(separator1, lv_color_hex(0xDDDDDD), LV_PART_MAIN | LV_STATE_DEFAULT);
+    ui_theme_apply(separator1, UI_STYLE_SEPARATOR, LV_PART_MAIN);
     lv_obj_align(separator1, LV_ALIGN_TOP_MID, 0, 50);
     
     // 创建SSID输入区域 - 增加20%宽度
     lv_obj_t *ssid_cont = lv_obj_create(ui_settings_screen);
     lv_obj_set_size(ssid_cont, 360, 60); // 从300增加到360
     lv_obj_align(ssid_cont, LV_ALIGN_TOP_MID, 0, 80);
-    lv_obj_set_style_pad_all(ssid_cont, 5, LV_PART_MAIN);
-    lv_obj_set_style_bg_color(ssid_cont, lv_color_hex(0xF5F5F5), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_width(ssid_cont, 1, LV_PART_MAIN);
-    lv_obj_set_style_border_color(ssid_cont, lv_color_hex(0xDDDDDD), LV_PART_MAIN | LV_STATE_DEFAULT);
+    ui_theme_apply(ssid_cont, UI_STYLE_FIELD, LV_PART_MAIN);
 
     // SSID标签
     lv_obj_t *ssid_label = lv_label_create(ssid_cont);
     lv_label_set_text(ssid_label, "SSID:");
-    lv_obj_set_style_text_color(ssid_label, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_font(ssid_label, &cn_16, LV_PART_MAIN | LV_STATE_DEFAULT);
+    ui_theme_apply(ssid_label, UI_STYLE_TEXT, LV_PART_MAIN);
+    lv_obj_set_style_text_font(ssid_label, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_align(ssid_label, LV_ALIGN_LEFT_MID, 5, 0);
     
     // SSID输入框 - 增加宽度
@@ -211,23 +240,20 @@ void settings_ui_create(void)
     lv_obj_set_size(ui_ssid_input, 280, 45); // 从220增加到280
     lv_obj_align(ui_ssid_input, LV_ALIGN_RIGHT_MID, -5, 0);
     lv_textarea_set_placeholder_text(ui_ssid_input, "输入WiFi名称");
-    lv_obj_set_style_text_font(ui_ssid_input, &cn_16, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_font(ui_ssid_input, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_add_event_cb(ui_ssid_input, input_focused_cb, LV_EVENT_CLICKED, NULL);
 
     // 创建密码输入区域 - 增加20%宽度
     lv_obj_t *pwd_cont = lv_obj_create(ui_settings_screen);
     lv_obj_set_size(pwd_cont, 360, 60); // 从300增加到360
     lv_obj_align_to(pwd_cont, ssid_cont, LV_ALIGN_OUT_BOTTOM_MID, 0, 10);
-    lv_obj_set_style_pad_all(pwd_cont, 5, LV_PART_MAIN);
-    lv_obj_set_style_bg_color(pwd_cont, lv_color_hex(0xF5F5F5), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_width(pwd_cont, 1, LV_PART_MAIN);
-    lv_obj_set_style_border_color(pwd_cont, lv_color_hex(0xDDDDDD), LV_PART_MAIN | LV_STATE_DEFAULT);
+    ui_theme_apply(pwd_cont, UI_STYLE_FIELD, LV_PART_MAIN);
     
     // 密码标签
     lv_obj_t *password_label = lv_label_create(pwd_cont);
     lv_label_set_text(password_label, "密码:");
-    lv_obj_set_style_text_color(password_label, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_font(password_label, &cn_16, LV_PART_MAIN | LV_STATE_DEFAULT);
+    ui_theme_apply(password_label, UI_STYLE_TEXT, LV_PART_MAIN);
+    lv_obj_set_style_text_font(password_label, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_align(password_label, LV_ALIGN_LEFT_MID, 5, 0);
     
     // 密码输入框 - 增加宽度
@@ -235,7 +261,7 @@ void settings_ui_create(void)
     lv_obj_set_size(ui_password_input, 210, 45); // 从150增加到210
     lv_obj_align(ui_password_input, LV_ALIGN_LEFT_MID, 70, 0);
     lv_textarea_set_placeholder_text(ui_password_input, "输入密码");
-    lv_obj_set_style_text_font(ui_password_input, &cn_16, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_font(ui_password_input, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_textarea_set_password_mode(ui_password_input, true);
     lv_obj_add_event_cb(ui_password_input, input_focused_cb, LV_EVENT_CLICKED, NULL);
     
@@ -243,59 +269,52 @@ void settings_ui_create(void)
     lv_obj_t *wifi_connect_btn = lv_btn_create(pwd_cont);
     lv_obj_set_size(wifi_connect_btn, 60, 45);
     lv_obj_align(wifi_connect_btn, LV_ALIGN_RIGHT_MID, -5, 0);
-    lv_obj_set_style_bg_color(wifi_connect_btn, lv_color_hex(0x2196F3), LV_PART_MAIN | LV_STATE_DEFAULT);
+    ui_theme_apply(wifi_connect_btn, UI_STYLE_BUTTON, LV_PART_MAIN);
     lv_obj_add_event_cb(wifi_connect_btn, wifi_connect_btn_event_cb, LV_EVENT_CLICKED, NULL);
     
     lv_obj_t *connect_btn_label = lv_label_create(wifi_connect_btn);
     lv_label_set_text(connect_btn_label, "连接");
-    lv_obj_set_style_text_font(connect_btn_label, &cn_16, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_font(connect_btn_label, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_center(connect_btn_label);
     
     // 分隔线2 - IP部分上方
     lv_obj_t *separator2 = lv_line_create(ui_settings_screen);
     static lv_point_t sep2_points[] = {{0, 0}, {320, 0}};
     lv_line_set_points(separator2, sep2_points, 2);
-    lv_obj_set_style_line_width(separator2, 1, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_color(separator2, lv_color_hex(0xDDDDDD), LV_PART_MAIN | LV_STATE_DEFAULT);
+    ui_theme_apply(separator2, UI_STYLE_SEPARATOR, LV_PART_MAIN);
     lv_obj_align_to(separator2, pwd_cont, LV_ALIGN_OUT_BOTTOM_MID, 0, 15);
     
     // 创建设备IP显示区域 - 增加20%宽度
     lv_obj_t *ip_cont = lv_obj_create(ui_settings_screen);
     lv_obj_set_size(ip_cont, 360, 60); // 从300增加到360
     lv_obj_align_to(ip_cont, separator2, LV_ALIGN_OUT_BOTTOM_MID, 0, 15);
-    lv_obj_set_style_pad_all(ip_cont, 5, LV_PART_MAIN);
-    lv_obj_set_style_bg_color(ip_cont, lv_color_hex(0xF5F5F5), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_width(ip_cont, 1, LV_PART_MAIN);
-    lv_obj_set_style_border_color(ip_cont, lv_color_hex(0xDDDDDD), LV_PART_MAIN | LV_STATE_DEFAULT);
+    ui_theme_apply(ip_cont, UI_STYLE_FIELD, LV_PART_MAIN);
     
     // 设备IP标签
     lv_obj_t *ip_label = lv_label_create(ip_cont);
     lv_label_set_text(ip_label, "当前设备IP:");
-    lv_obj_set_style_text_color(ip_label, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_font(ip_label, &cn_16, LV_PART_MAIN | LV_STATE_DEFAULT);
+    ui_theme_apply(ip_label, UI_STYLE_TEXT, LV_PART_MAIN);
+    lv_obj_set_style_text_font(ip_label, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_align(ip_label, LV_ALIGN_LEFT_MID, 5, 0);
     
     // 设备IP显示标签（只读）
     ui_device_ip_label = lv_label_create(ip_cont);
     lv_label_set_text(ui_device_ip_label, "0.0.0.0");
-    lv_obj_set_style_text_color(ui_device_ip_label, lv_color_hex(0x444444), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_font(ui_device_ip_label, &cn_16, LV_PART_MAIN | LV_STATE_DEFAULT);
+    ui_theme_apply(ui_device_ip_label, UI_STYLE_MUTED, LV_PART_MAIN);
+    lv_obj_set_style_text_font(ui_device_ip_label, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_align(ui_device_ip_label, LV_ALIGN_RIGHT_MID, -10, 0);
     
     // 创建小电拼设备IP输入容器 - 调整位置与其他设置一致
     lv_obj_t *device_ip_cont = lv_obj_create(ui_settings_screen);
     lv_obj_set_size(device_ip_cont, 360, 60); // 从230增加到360
     lv_obj_align_to(device_ip_cont, ip_cont, LV_ALIGN_OUT_BOTTOM_MID, 0, 10); // 与其他设置项对齐
-    lv_obj_set_style_pad_all(device_ip_cont, 5, LV_PART_MAIN);
-    lv_obj_set_style_bg_color(device_ip_cont, lv_color_hex(0xF5F5F5), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_width(device_ip_cont, 1, LV_PART_MAIN);
-    lv_obj_set_style_border_color(device_ip_cont, lv_color_hex(0xDDDDDD), LV_PART_MAIN | LV_STATE_DEFAULT);
+    ui_theme_apply(device_ip_cont, UI_STYLE_FIELD, LV_PART_MAIN);
     
     // 小电拼设备IP标签
     lv_obj_t *device_ip_text = lv_label_create(device_ip_cont);
     lv_label_set_text(device_ip_text, "小电拼IP:");
-    lv_obj_set_style_text_color(device_ip_text, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_font(device_ip_text, &cn_16, LV_PART_MAIN | LV_STATE_DEFAULT);
+    ui_theme_apply(device_ip_text, UI_STYLE_TEXT, LV_PART_MAIN);
+    lv_obj_set_style_text_font(device_ip_text, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_align(device_ip_text, LV_ALIGN_LEFT_MID, 5, 0);
     
     // 小电拼设备IP输入框 - 增加宽度
@@ -303,23 +322,114 @@ void settings_ui_create(void)
     lv_obj_set_size(ui_device_ip_input, 210, 45); // 从140增加到210
     lv_obj_align(ui_device_ip_input, LV_ALIGN_LEFT_MID, 80, 0);
     lv_textarea_set_placeholder_text(ui_device_ip_input, "输入小电拼IP");
-    lv_obj_set_style_text_font(ui_device_ip_input, &cn_16, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_font(ui_device_ip_input, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_add_event_cb(ui_device_ip_input, input_focused_cb, LV_EVENT_CLICKED, NULL);
     
     // IP部分保存按钮 - 调整位置
     lv_obj_t *ip_save_btn = lv_btn_create(device_ip_cont);
     lv_obj_set_size(ip_save_btn, 60, 45);
     lv_obj_align(ip_save_btn, LV_ALIGN_RIGHT_MID, -5, 0);
-    lv_obj_set_style_bg_color(ip_save_btn, lv_color_hex(0x00AA00), LV_PART_MAIN | LV_STATE_DEFAULT);
+    ui_theme_apply(ip_save_btn, UI_STYLE_BUTTON_OK, LV_PART_MAIN);
     lv_obj_add_event_cb(ip_save_btn, settings_save_btn_event_cb, LV_EVENT_CLICKED, NULL);
     
     lv_obj_t *ip_save_label = lv_label_create(ip_save_btn);
     lv_label_set_text(ip_save_label, "保存");
-    lv_obj_set_style_text_font(ip_save_label, &cn_16, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_font(ip_save_label, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_center(ip_save_label);
     
-    // 创建键盘 - 占满底部
-    ui_keyboard = lv_keyboard_create(lv_scr_act());
+    // WiFi二维码 - 放在右侧，手机扫码即可加入当前网络
+    // 二维码包含密码，默认隐藏，点击按钮后才生成并显示，一段时间后自动隐藏
+    // 二维码不跟随主题，固定白底黑码，深色主题下也能可靠识别
+    ui_wifi_qr = qr_panel_create(ui_settings_screen, 180, lv_color_black(), lv_color_white());
+    if (ui_wifi_qr != NULL) {
+        lv_obj_align(ui_wifi_qr, LV_ALIGN_TOP_RIGHT, -20, 80);
+        lv_obj_add_flag(ui_wifi_qr, LV_OBJ_FLAG_HIDDEN);
+        
+        lv_obj_t *qr_btn = lv_btn_create(ui_settings_screen);
+        lv_obj_set_size(qr_btn, 140, 45);
+        lv_obj_align_to(qr_btn, ui_wifi_qr, LV_ALIGN_CENTER, 0, 0);
+        lv_obj_add_event_cb(qr_btn, wifi_qr_btn_event_cb, LV_EVENT_CLICKED, NULL);
+        
+        lv_obj_t *qr_btn_label = lv_label_create(qr_btn);
+        lv_label_set_text(qr_btn_label, "显示WiFi二维码");
+        lv_obj_set_style_text_font(qr_btn_label, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
+        lv_obj_center(qr_btn_label);
+        
+        ui_wifi_qr_label = lv_label_create(ui_settings_screen);
+        lv_label_set_text(ui_wifi_qr_label, "扫码连接WiFi，点击隐藏");
+        ui_theme_apply(ui_wifi_qr_label, UI_STYLE_MUTED, LV_PART_MAIN);
+        lv_obj_set_style_text_font(ui_wifi_qr_label, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
+        lv_obj_align_to(ui_wifi_qr_label, ui_wifi_qr, LV_ALIGN_OUT_BOTTOM_MID, 0, 5);
+        lv_obj_add_flag(ui_wifi_qr_label, LV_OBJ_FLAG_HIDDEN);
+        
+        // 二维码显示时盖住按钮，点击二维码隐藏
+        lv_obj_move_foreground(ui_wifi_qr);
+        lv_obj_add_flag(ui_wifi_qr, LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_add_event_cb(ui_wifi_qr, wifi_qr_btn_event_cb, LV_EVENT_CLICKED, NULL);
+    }
+    
+    // 主题选择 - 放在二维码下方
+    lv_obj_t *theme_dd = lv_dropdown_create(ui_settings_screen);
+    char theme_opts[64] = "";
+    for (int i = 0; i < UI_THEME_MAX; i++) {
+        if (i > 0) {
+            strcat(theme_opts, "\n");
+        }
+        strcat(theme_opts, ui_theme_name((ui_theme_id_t)i));
+    }
+    lv_dropdown_set_options(theme_dd, theme_opts);
+    lv_dropdown_set_selected(theme_dd, ui_theme_get());
+    lv_obj_set_width(theme_dd, 120);
+    lv_obj_align(theme_dd, LV_ALIGN_TOP_RIGHT, -20, 320);
+    lv_obj_set_style_text_font(theme_dd, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_font(lv_dropdown_get_list(theme_dd), font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_event_cb(theme_dd, theme_changed_cb, LV_EVENT_VALUE_CHANGED, NULL);
+    
+    lv_obj_t *theme_label = lv_label_create(ui_settings_screen);
+    lv_label_set_text(theme_label, "主题:");
+    ui_theme_apply(theme_label, UI_STYLE_TEXT, LV_PART_MAIN);
+    lv_obj_set_style_text_font(theme_label, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_align_to(theme_label, theme_dd, LV_ALIGN_OUT_LEFT_MID, -10, 0);
+    
+    // 刷新间隔 - 放在主题下方，修改后立即生效
+    lv_obj_t *refresh_dd = lv_dropdown_create(ui_settings_screen);
+    lv_dropdown_set_options(refresh_dd, REFRESH_OPTIONS_TEXT);
+    uint32_t refresh_ms = app_config_get()->refresh_ms;
+    for (size_t i = 0; i < sizeof(refresh_options) / sizeof(refresh_options[0]); i++) {
+        if (refresh_options[i] == refresh_ms) {
+            lv_dropdown_set_selected(refresh_dd, i);
+        }
+    }
+    lv_obj_set_width(refresh_dd, 120);
+    lv_obj_align_to(refresh_dd, theme_dd, LV_ALIGN_OUT_BOTTOM_MID, 0, 10);
+    lv_obj_set_style_text_font(refresh_dd, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_font(lv_dropdown_get_list(refresh_dd), font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_event_cb(refresh_dd, refresh_changed_cb, LV_EVENT_VALUE_CHANGED, NULL);
+    
+    lv_obj_t *refresh_label = lv_label_create(ui_settings_screen);
+    lv_label_set_text(refresh_label, "刷新:");
+    ui_theme_apply(refresh_label, UI_STYLE_TEXT, LV_PART_MAIN);
+    lv_obj_set_style_text_font(refresh_label, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_align_to(refresh_label, refresh_dd, LV_ALIGN_OUT_LEFT_MID, -10, 0);
+    
+#if CONFIG_EXAMPLE_PERF_HUD
+    // 性能信息开关 - 放在刷新间隔下方，只在本次运行有效
+    lv_obj_t *perf_sw = lv_switch_create(ui_settings_screen);
+    if (perf_hud_is_visible()) {
+        lv_obj_add_state(perf_sw, LV_STATE_CHECKED);
+    }
+    lv_obj_align_to(perf_sw, refresh_dd, LV_ALIGN_OUT_BOTTOM_RIGHT, 0, 10);
+    lv_obj_add_event_cb(perf_sw, perf_hud_changed_cb, LV_EVENT_VALUE_CHANGED, NULL);
+    
+    lv_obj_t *perf_label = lv_label_create(ui_settings_screen);
+    lv_label_set_text(perf_label, "性能信息:");
+    ui_theme_apply(perf_label, UI_STYLE_TEXT, LV_PART_MAIN);
+    lv_obj_set_style_text_font(perf_label, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_align_to(perf_label, perf_sw, LV_ALIGN_OUT_LEFT_MID, -10, 0);
+#endif
+    
+    // 创建键盘 - 占满底部，建在屏幕上，页面上移时键盘不动
+    ui_keyboard = lv_keyboard_create(lv_obj_get_screen(ui_settings_screen));
     lv_keyboard_set_mode(ui_keyboard, LV_KEYBOARD_MODE_TEXT_LOWER);
     lv_obj_add_flag(ui_keyboard, LV_OBJ_FLAG_HIDDEN);
     lv_obj_align(ui_keyboard, LV_ALIGN_BOTTOM_MID, 0, 0);
@@ -328,13 +438,26 @@ void settings_ui_create(void)
     lv_obj_add_event_cb(ui_keyboard, keyboard_ready_cb, LV_EVENT_READY, NULL);
     lv_obj_add_event_cb(ui_keyboard, keyboard_ready_cb, LV_EVENT_CANCEL, NULL);
     
+#if CONFIG_EXAMPLE_PINYIN_IME
+    // 键盘顶部加上拼音候选栏，用于输入中文WiFi名称
+    pinyin_ime_attach(ui_keyboard, font_manager_get(16));
+#endif
+    
     // 加载当前的WiFi和设备IP设置
     wifi_user_config_t config;
     if (wifi_manager_get_config(&config) == ESP_OK) {
         lv_textarea_set_text(ui_ssid_input, config.ssid);
         lv_textarea_set_text(ui_password_input, ""); // 不显示密码，即使配置中有密码
         lv_textarea_set_placeholder_text(ui_password_input, "输入密码");
-        lv_label_set_text(ui_device_ip_label, config.device_ip);
+        
+        // 获取当前实际IP而不是存储的IP
+        char ip[16] = "0.0.0.0";
+        if (wifi_manager_is_connected()) {
+            wifi_manager_get_ip(ip, sizeof(ip));
+            lv_label_set_text(ui_device_ip_label, ip);
+        } else {
+            lv_label_set_text(ui_device_ip_label, "未连接");
+        }
         
         // 设置小电拼IP默认值
         const char* metrics_url = power_monitor_get_data_url();
@@ -352,6 +475,23 @@ void settings_ui_create(void)
     }
 }
 
+// 设置页面即将删除，清空指向控件的指针，WiFi回调不再访问它们
+static void settings_ui_destroy(void)
+{
+    ui_settings_screen = NULL;
+    ui_ssid_input = NULL;
+    ui_password_input = NULL;
+    ui_device_ip_label = NULL;
+    ui_device_ip_input = NULL;
+    ui_keyboard = NULL;
+    ui_wifi_qr = NULL;
+    ui_wifi_qr_label = NULL;
+    if (wifi_qr_hide_timer != NULL) {
+        lv_timer_del(wifi_qr_hide_timer);
+        wifi_qr_hide_timer = NULL;
+    }
+}
+
 // 输入框聚焦回调
 static void input_focused_cb(lv_event_t *e)
 {
@@ -359,9 +499,11 @@ static void input_focused_cb(lv_event_t *e)
     
     // 显示键盘并设置目标
     lv_keyboard_set_textarea(ui_keyboard, textarea);
+#if CONFIG_EXAMPLE_PINYIN_IME
+    pinyin_ime_reset();
+#endif
     
-    // 将键盘添加到当前活动屏幕并显示
-    lv_obj_set_parent(ui_keyboard, lv_scr_act());
+    // 显示键盘
     lv_obj_clear_flag(ui_keyboard, LV_OBJ_FLAG_HIDDEN);
     lv_obj_align(ui_keyboard, LV_ALIGN_BOTTOM_MID, 0, 0);
     
@@ -418,27 +560,18 @@ static void wifi_connect_btn_event_cb(lv_event_t *e)
     if (strlen(ssid) == 0) {
         // 显示错误消息
         lv_obj_t *alert = lv_msgbox_create(NULL, "错误", "WiFi名称不能为空", NULL, true);
-        lv_obj_set_style_text_font(alert, &cn_16, LV_PART_MAIN | LV_STATE_DEFAULT);
+        lv_obj_set_style_text_font(alert, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_center(alert);
         return;
     }
     
-    // 创建配置
-    wifi_user_config_t config;
-    wifi_manager_get_config(&config); // 获取当前配置
-    
-    // 更新设置
-    strncpy(config.ssid, ssid, MAX_SSID_LEN);
-    strncpy(config.password, password, MAX_PASS_LEN);
-    config.auto_connect = true;  // 默认自动连接
-    
-    // 保存配置
-    esp_err_t err = wifi_manager_set_config(&config);
+    // 在后台切换，新网络连上之前保持原来的连接，连上之后由wifi_manager保存
+    esp_err_t err = app_config_set_wifi(ssid, password);
     if (err != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to save WiFi config: %s", esp_err_to_name(err));
+        ESP_LOGE(TAG, "Failed to apply WiFi config: %s", esp_err_to_name(err));
         // 显示错误消息
-        lv_obj_t *alert = lv_msgbox_create(NULL, "错误", "保存WiFi设置失败", NULL, true);
-        lv_obj_set_style_text_font(alert, &cn_16, LV_PART_MAIN | LV_STATE_DEFAULT);
+        lv_obj_t *alert = lv_msgbox_create(NULL, "错误", "WiFi设置无效", NULL, true);
+        lv_obj_set_style_text_font(alert, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_center(alert);
         return;
     }
@@ -448,15 +581,12 @@ static void wifi_connect_btn_event_cb(lv_event_t *e)
     // 恢复设置屏幕的位置
     lv_obj_set_y(ui_settings_screen, 0);
     
-    // 创建超时定时器
+    // 创建超时定时器，包括扫描和重试的时间
     if (wifi_timeout_timer != NULL) {
         lv_timer_del(wifi_timeout_timer);
     }
-    wifi_timeout_timer = lv_timer_create(wifi_connect_timeout_cb, 10000, NULL);
+    wifi_timeout_timer = lv_timer_create(wifi_connect_timeout_cb, 20000, NULL);
     lv_timer_set_repeat_count(wifi_timeout_timer, 1);
-    
-    // 连接WiFi - 状态更新将通过回调函数处理
-    wifi_manager_connect();
 }
 
 // 设置保存按钮回调
@@ -474,16 +604,16 @@ static void settings_save_btn_event_cb(lv_event_t *e)
         lv_obj_set_y(ui_settings_screen, 0);
     }
     
-    // 保存小电拼IP设置（通过更新数据URL）
-    char url[128];
+    // 保存小电拼IP设置，电源监控在下一次采集时换用新地址
+    char url[APP_CONFIG_URL_LEN];
     snprintf(url, sizeof(url), "http://%s/metrics", metrics_ip);
-    esp_err_t err = power_monitor_set_data_url(url);
+    esp_err_t err = app_config_set_metrics_url(url);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Error saving metrics URL: %s", esp_err_to_name(err));
         
         // 创建一个消息框显示错误
         lv_obj_t *mbox = lv_msgbox_create(NULL, "错误", "保存小电拼IP设置失败", NULL, true);
-        lv_obj_set_style_text_font(mbox, &cn_16, LV_PART_MAIN | LV_STATE_DEFAULT);
+        lv_obj_set_style_text_font(mbox, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
         lv_obj_center(mbox);
         return;
     }
@@ -493,13 +623,8 @@ static void settings_save_btn_event_cb(lv_event_t *e)
     
     // 显示保存成功消息
     lv_obj_t *success_mbox = lv_msgbox_create(NULL, "提示", "设置已保存", NULL, true);
-    lv_obj_set_style_text_font(success_mbox, &cn_16, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_font(success_mbox, font_manager_get(16), LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_center(success_mbox);
-    
-    // 通知设置已更改
-    if (change_callback != NULL) {
-        change_callback();
-    }
 }
 
 // 返回按钮回调
@@ -507,19 +632,8 @@ static void settings_return_btn_event_cb(lv_event_t *e)
 {
     ESP_LOGI(TAG, "Returning to main screen");
     
-    // 隐藏键盘
-    lv_obj_add_flag(ui_keyboard, LV_OBJ_FLAG_HIDDEN);
-    // 恢复设置屏幕的位置
-    lv_obj_set_y(ui_settings_screen, 0);
-    
-    // 获取主屏幕并加载
-    lv_obj_t *main_screen = get_main_screen();
-    if (main_screen != NULL) {
-        lv_scr_load_anim(main_screen, LV_SCR_LOAD_ANIM_FADE_ON, 300, 0, false);
-        
-        // 恢复主程序定时器
-        resume_main_timer();
-    }
+    // 返回上一页，设置页面连同键盘一起释放
+    settings_ui_close_wifi_settings();
 }
 
 // 打开设置页面
@@ -527,46 +641,99 @@ void settings_ui_open_wifi_settings(void)
 {
     ESP_LOGI(TAG, "Opening settings page");
     
-    // 暂停主程序定时器
-    pause_main_timer();
-    
-    // 加载当前的WiFi和IP设置
-    wifi_user_config_t config;
-    if (wifi_manager_get_config(&config) == ESP_OK) {
-        lv_textarea_set_text(ui_ssid_input, config.ssid);
-        lv_textarea_set_text(ui_password_input, ""); // 不显示密码，即使配置中有密码
-        lv_textarea_set_placeholder_text(ui_password_input, "输入密码");
-        
-        // 获取当前实际IP而不是存储的IP
-        char ip[16] = "0.0.0.0";
-        if (wifi_manager_is_connected()) {
-            wifi_manager_get_ip(ip, sizeof(ip));
-            lv_label_set_text(ui_device_ip_label, ip);
-        } else {
-            lv_label_set_text(ui_device_ip_label, "未连接");
-        }
-        
-        // 设置小电拼IP
-        const char* metrics_url = power_monitor_get_data_url();
-        if (metrics_url != NULL) {
-            // 从URL中解析IP地址
-            char device_ip[128] = "";
-            if (sscanf(metrics_url, "http://%[^/]/metrics", device_ip) == 1) {
-                lv_textarea_set_text(ui_device_ip_input, device_ip);
-            }
-        }
+    // 打开时创建页面并读取当前设置，主界面的定时器由ui_nav暂停
+    ui_nav_push(&settings_screen);
+}
+
+// 更新WiFi二维码，只在二维码显示时生成，内容不变时不会重新生成
+static void update_wifi_qr(const wifi_user_config_t *config)
+{
+    if (ui_wifi_qr == NULL || lv_obj_has_flag(ui_wifi_qr, LV_OBJ_FLAG_HIDDEN)) {
+        return;
     }
     
-    // 确保设置屏幕位置正确
-    lv_obj_set_y(ui_settings_screen, 0);
-    
-    // 加载设置页面
-    lv_scr_load(ui_settings_screen);
+    char text[192];
+    esp_err_t ret = ESP_FAIL;
+    if (config->ssid[0] != '\0' &&
+        qr_panel_wifi_string(text, sizeof(text), config->ssid, config->password) == ESP_OK) {
+        ret = qr_panel_set_text(ui_wifi_qr, text);
+    }
+    memset(text, 0, sizeof(text));
+    if (ret != ESP_OK) {
+        wifi_qr_hide();
+    }
+}
+
+// 隐藏二维码并清除其中的密码
+static void wifi_qr_hide(void)
+{
+    if (wifi_qr_hide_timer != NULL) {
+        lv_timer_del(wifi_qr_hide_timer);
+        wifi_qr_hide_timer = NULL;
+    }
+    if (ui_wifi_qr == NULL) {
+        return;
+    }
+    qr_panel_clear(ui_wifi_qr);
+    lv_obj_add_flag(ui_wifi_qr, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_flag(ui_wifi_qr_label, LV_OBJ_FLAG_HIDDEN);
+}
+
+static void wifi_qr_hide_timer_cb(lv_timer_t *timer)
+{
+    wifi_qr_hide_timer = NULL;  // 只执行一次，LVGL随后删除定时器
+    wifi_qr_hide();
+}
+
+// 显示/隐藏WiFi二维码按钮回调
+static void wifi_qr_btn_event_cb(lv_event_t *e)
+{
+    if (!lv_obj_has_flag(ui_wifi_qr, LV_OBJ_FLAG_HIDDEN)) {
+        wifi_qr_hide();
+        return;
+    }
     
-    // 确保键盘隐藏
-    lv_obj_add_flag(ui_keyboard, LV_OBJ_FLAG_HIDDEN);
+    wifi_user_config_t config;
+    if (wifi_manager_get_config(&config) != ESP_OK) {
+        return;
+    }
+    lv_obj_clear_flag(ui_wifi_qr, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_clear_flag(ui_wifi_qr_label, LV_OBJ_FLAG_HIDDEN);
+    update_wifi_qr(&config);
+    memset(&config, 0, sizeof(config));
+    
+    if (!lv_obj_has_flag(ui_wifi_qr, LV_OBJ_FLAG_HIDDEN)) {
+        wifi_qr_hide_timer = lv_timer_create(wifi_qr_hide_timer_cb, WIFI_QR_SHOW_MS, NULL);
+        lv_timer_set_repeat_count(wifi_qr_hide_timer, 1);
+    }
+}
+
+// 主题切换回调 - 只改写共享样式，主界面返回时已是新主题
+static void theme_changed_cb(lv_event_t *e)
+{
+    lv_obj_t *dd = lv_event_get_target(e);
+    ui_theme_set((ui_theme_id_t)lv_dropdown_get_selected(dd));
+}
+
+// 刷新间隔切换回调 - 电源监控的刷新定时器立即改为新周期
+static void refresh_changed_cb(lv_event_t *e)
+{
+    lv_obj_t *dd = lv_event_get_target(e);
+    uint16_t selected = lv_dropdown_get_selected(dd);
+    if (selected < sizeof(refresh_options) / sizeof(refresh_options[0])) {
+        app_config_set_refresh_ms(refresh_options[selected]);
+    }
 }
 
+#if CONFIG_EXAMPLE_PERF_HUD
+// 性能信息开关回调 - 显示区域在顶层上，返回主界面后仍然显示
+static void perf_hud_changed_cb(lv_event_t *e)
+{
+    lv_obj_t *sw = lv_event_get_target(e);
+    perf_hud_set_visible(lv_obj_has_state(sw, LV_STATE_CHECKED));
+}
+#endif
+
 // 为兼容性保留的函数，现在直接调用打开设置页面的函数
 void settings_ui_open_ip_settings(void)
 {
@@ -578,19 +745,9 @@ void settings_ui_close_wifi_settings(void)
 {
     ESP_LOGI(TAG, "Closing settings page");
     
-    // 隐藏键盘
-    lv_obj_add_flag(ui_keyboard, LV_OBJ_FLAG_HIDDEN);
-    
-    // 确保设置屏幕位置正确
-    lv_obj_set_y(ui_settings_screen, 0);
-    
-    // 获取主屏幕并加载
-    lv_obj_t *main_screen = get_main_screen();
-    if (main_screen != NULL) {
-        lv_scr_load_anim(main_screen, LV_SCR_LOAD_ANIM_FADE_ON, 300, 0, false);
-        
-        // 恢复主程序定时器
-        resume_main_timer();
+    // 只有设置页面在前台时才返回，主界面的定时器由ui_nav恢复
+    if (ui_nav_is_top(&settings_screen)) {
+        ui_nav_pop();
     }
 }
 
@@ -600,12 +757,6 @@ void settings_ui_close_ip_settings(void)
     settings_ui_close_wifi_settings();
 }
 
-// 设置UI回调函数
-void settings_ui_register_change_cb(settings_change_cb_t callback)
-{
-    change_callback = callback;
-}
-
 // 检查设置按钮是否被按下
 void settings_ui_check_button(void)
 {
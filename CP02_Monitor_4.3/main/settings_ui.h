@@ -20,8 +20,8 @@ extern "C" {
 // 初始化设置UI
 void settings_ui_init(void);
 
-// 创建设置UI
-void settings_ui_create(void);
+// 在parent中创建设置UI，由ui_nav在打开设置页面时调用
+void settings_ui_create(lv_obj_t *parent);
 
 // 打开WiFi设置页面
 void settings_ui_open_wifi_settings(void);
@@ -38,10 +38,6 @@ void settings_ui_close_ip_settings(void);
 // 检查设置按钮是否被按下
 void settings_ui_check_button(void);
 
-// 设置UI回调接口 - 当设置改变时调用
-typedef void (*settings_change_cb_t)(void);
-void settings_ui_register_change_cb(settings_change_cb_t callback);
-
 #ifdef __cplusplus
 }
 #endif
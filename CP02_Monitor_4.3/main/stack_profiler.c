@@ -0,0 +1,240 @@
+/**
+ * @file     stack_profiler.c
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    Task Stack Profiler Module Implementation
+ */
+
+#include "stack_profiler.h"
+
+#if CONFIG_EXAMPLE_STACK_PROFILER
+
+#include <stdbool.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+static const char *TAG = "STACK";
+
+#define PROFILER_MAX_TASKS  24          // 记录的任务数，退出的任务也保留
+#define STATUS_SLOTS        32          // 一次采样最多读取的任务数
+#define STACK_ROUND         256         // 建议大小按此取整
+#define STACK_MIN_MARGIN    512         // 最小余量，剩余低于此值时报警
+
+// sdkconfig中能查到栈大小的系统任务
+typedef struct {
+    const char *name;
+    bool prefix;                // 按前缀匹配，用于每个核一个的任务
+    uint32_t stack_size;
+    const char *option;
+} known_task_t;
+
+static const known_task_t known_tasks[] = {
+    { "main", false, CONFIG_ESP_MAIN_TASK_STACK_SIZE, "CONFIG_ESP_MAIN_TASK_STACK_SIZE" },
+    { "esp_timer", false, CONFIG_ESP_TIMER_TASK_STACK_SIZE, "CONFIG_ESP_TIMER_TASK_STACK_SIZE" },
+    { "sys_evt", false, CONFIG_ESP_SYSTEM_EVENT_TASK_STACK_SIZE, "CONFIG_ESP_SYSTEM_EVENT_TASK_STACK_SIZE" },
+    { "tiT", false, CONFIG_LWIP_TCPIP_TASK_STACK_SIZE, "CONFIG_LWIP_TCPIP_TASK_STACK_SIZE" },
+    { "Tmr Svc", false, CONFIG_FREERTOS_TIMER_TASK_STACK_DEPTH, "CONFIG_FREERTOS_TIMER_TASK_STACK_DEPTH" },
+    { "ipc", true, CONFIG_ESP_IPC_TASK_STACK_SIZE, "CONFIG_ESP_IPC_TASK_STACK_SIZE" },
+    { "IDLE", true, CONFIG_FREERTOS_IDLE_TASK_STACKSIZE, "CONFIG_FREERTOS_IDLE_TASK_STACKSIZE" },
+};
+
+typedef struct {
+    stack_profiler_task_t info;
+    bool warned;                // 已经报过余量不足
+} profiler_entry_t;
+
+static portMUX_TYPE profiler_lock = portMUX_INITIALIZER_UNLOCKED;
+static profiler_entry_t entries[PROFILER_MAX_TASKS];
+static int entry_count = 0;
+
+static SemaphoreHandle_t sample_mutex = NULL;   // 保护status_buf
+static TaskStatus_t status_buf[STATUS_SLOTS];
+static esp_timer_handle_t sample_timer = NULL;
+static uint32_t samples_since_report = 0;
+static bool overflow_warned = false;
+
+static uint32_t recommend_size(uint32_t stack_size, uint32_t min_free)
+{
+    if (stack_size == 0 || min_free > stack_size) {
+        return 0;
+    }
+    uint32_t used = stack_size - min_free;
+    uint32_t margin = used * CONFIG_EXAMPLE_STACK_PROFILER_MARGIN / 100;
+    if (margin < STACK_MIN_MARGIN) {
+        margin = STACK_MIN_MARGIN;
+    }
+    return (used + margin + STACK_ROUND - 1) / STACK_ROUND * STACK_ROUND;
+}
+
+// 需要持有profiler_lock
+static profiler_entry_t *entry_get(const char *name)
+{
+    for (int i = 0; i < entry_count; i++) {
+        if (strncmp(entries[i].info.name, name, STACK_PROFILER_NAME_LEN - 1) == 0) {
+            return &entries[i];
+        }
+    }
+    if (entry_count >= PROFILER_MAX_TASKS) {
+        return NULL;
+    }
+
+    profiler_entry_t *entry = &entries[entry_count++];
+    memset(entry, 0, sizeof(*entry));
+    strlcpy(entry->info.name, name, sizeof(entry->info.name));
+    entry->info.min_free = UINT32_MAX;
+    for (size_t i = 0; i < sizeof(known_tasks) / sizeof(known_tasks[0]); i++) {
+        const known_task_t *known = &known_tasks[i];
+        bool match = known->prefix ? strncmp(name, known->name, strlen(known->name)) == 0
+                                   : strcmp(name, known->name) == 0;
+        if (match) {
+            entry->info.stack_size = known->stack_size;
+            entry->info.option = known->option;
+            break;
+        }
+    }
+    return entry;
+}
+
+static void entry_update(const char *name, uint32_t free_bytes)
+{
+    bool low = false;
+    uint32_t stack_size = 0;
+
+    portENTER_CRITICAL(&profiler_lock);
+    profiler_entry_t *entry = entry_get(name);
+    if (entry != NULL) {
+        if (free_bytes < entry->info.min_free) {
+            entry->info.min_free = free_bytes;
+            entry->info.recommended = recommend_size(entry->info.stack_size, free_bytes);
+        }
+        if (free_bytes < STACK_MIN_MARGIN && !entry->warned) {
+            entry->warned = true;
+            low = true;
+            stack_size = entry->info.stack_size;
+        }
+    }
+    portEXIT_CRITICAL(&profiler_lock);
+
+    if (low) {
+        ESP_LOGW(TAG, "%s 栈只剩 %lu 字节（栈大小 %lu）", name, (unsigned long)free_bytes,
+                 (unsigned long)stack_size);
+    }
+}
+
+static void sample_timer_cb(void *arg)
+{
+    (void)arg;
+    stack_profiler_sample();
+
+    if (++samples_since_report >= CONFIG_EXAMPLE_STACK_PROFILER_REPORT_S * 1000 / CONFIG_EXAMPLE_STACK_PROFILER_SAMPLE_MS) {
+        stack_profiler_report();
+    }
+}
+
+esp_err_t stack_profiler_init(void)
+{
+    if (sample_mutex != NULL) {
+        return ESP_OK;
+    }
+
+    sample_mutex = xSemaphoreCreateMutex();
+    if (sample_mutex == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    const esp_timer_create_args_t timer_args = {
+        .callback = sample_timer_cb,
+        .name = "stack_prof",
+    };
+    esp_err_t err = esp_timer_create(&timer_args, &sample_timer);
+    if (err == ESP_OK) {
+        err = esp_timer_start_periodic(sample_timer, CONFIG_EXAMPLE_STACK_PROFILER_SAMPLE_MS * 1000ULL);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "无法启动采样定时器: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    ESP_LOGI(TAG, "栈水位统计已启动，每 %d ms 采样，每 %d 秒报告", CONFIG_EXAMPLE_STACK_PROFILER_SAMPLE_MS,
+             CONFIG_EXAMPLE_STACK_PROFILER_REPORT_S);
+    return ESP_OK;
+}
+
+void stack_profiler_register(const char *name, uint32_t stack_size, const char *option)
+{
+    portENTER_CRITICAL(&profiler_lock);
+    profiler_entry_t *entry = entry_get(name);
+    if (entry != NULL) {
+        entry->info.stack_size = stack_size;
+        entry->info.option = option;
+        entry->info.recommended = recommend_size(stack_size, entry->info.min_free);
+    }
+    portEXIT_CRITICAL(&profiler_lock);
+}
+
+void stack_profiler_sample(void)
+{
+    if (sample_mutex == NULL) {
+        return;
+    }
+
+    xSemaphoreTake(sample_mutex, portMAX_DELAY);
+    // ESP-IDF中栈以字节为单位，usStackHighWaterMark就是剩余的字节数
+    UBaseType_t count = uxTaskGetSystemState(status_buf, STATUS_SLOTS, NULL);
+    if (count == 0 && !overflow_warned) {
+        overflow_warned = true;
+        ESP_LOGW(TAG, "任务数 %lu 超过 %d，无法采样", (unsigned long)uxTaskGetNumberOfTasks(), STATUS_SLOTS);
+    }
+    for (UBaseType_t i = 0; i < count; i++) {
+        entry_update(status_buf[i].pcTaskName, status_buf[i].usStackHighWaterMark);
+    }
+    xSemaphoreGive(sample_mutex);
+}
+
+void stack_profiler_report(void)
+{
+    static stack_profiler_task_t tasks[PROFILER_MAX_TASKS];
+
+    stack_profiler_sample();
+    samples_since_report = 0;
+
+    int count = stack_profiler_get_tasks(tasks, PROFILER_MAX_TASKS);
+    int32_t reclaim = 0;
+
+    ESP_LOGI(TAG, "任务栈水位（余量 %d%%，至少 %d 字节）:", CONFIG_EXAMPLE_STACK_PROFILER_MARGIN, STACK_MIN_MARGIN);
+    for (int i = 0; i < count; i++) {
+        const stack_profiler_task_t *t = &tasks[i];
+        if (t->recommended == 0) {
+            ESP_LOGI(TAG, "  %-16s 栈大小未知 剩余最少 %5lu", t->name, (unsigned long)t->min_free);
+            continue;
+        }
+        int32_t saving = (int32_t)t->stack_size - (int32_t)t->recommended;
+        reclaim += saving;
+        ESP_LOGI(TAG, "  %-16s 栈 %5lu 峰值 %5lu 剩余最少 %5lu 建议 %5lu (%+ld) %s", t->name,
+                 (unsigned long)t->stack_size, (unsigned long)(t->stack_size - t->min_free),
+                 (unsigned long)t->min_free, (unsigned long)t->recommended, (long)saving,
+                 t->option ? t->option : "");
+    }
+    ESP_LOGI(TAG, "按建议大小调整合计可回收 %ld 字节内部RAM", (long)reclaim);
+}
+
+int stack_profiler_get_tasks(stack_profiler_task_t *tasks, int max)
+{
+    int count = 0;
+    portENTER_CRITICAL(&profiler_lock);
+    for (int i = 0; i < entry_count && count < max; i++) {
+        // 登记之后还没采样到的任务不输出
+        if (entries[i].info.min_free != UINT32_MAX) {
+            tasks[count++] = entries[i].info;
+        }
+    }
+    portEXIT_CRITICAL(&profiler_lock);
+    return count;
+}
+
+#endif
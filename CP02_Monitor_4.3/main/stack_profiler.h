@@ -0,0 +1,90 @@
+/**
+ * @file     stack_profiler.h
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    Task Stack Profiler Module Header
+ *
+ * 任务栈水位统计。FreeRTOS创建任务时把栈填满0xA5，栈水位（剩余最少的
+ * 字节数）就是从栈底往上数还保持0xA5的字节数。本模块定时用
+ * uxTaskGetSystemState()读取所有任务的水位，按任务名记下运行以来的最小值，
+ * 定期打印每个任务的栈大小、峰值用量和建议大小（峰值加余量，按256字节
+ * 取整），以及要修改的配置项。余量低于下限的任务立即报警。
+ *
+ * 系统任务的栈大小从sdkconfig中得到，应用自己创建的任务用
+ * stack_profiler_register()登记。没有登记大小的任务只打印剩余最少的字节数。
+ *
+ * 水位只反映实际运行过的路径。调整栈大小之前用CONFIG_EXAMPLE_STACK_SOAK
+ * （stack_soak.h）跑一遍，让只有触摸才会进入的页面也被采样到。
+ */
+
+#ifndef STACK_PROFILER_H
+#define STACK_PROFILER_H
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define STACK_PROFILER_NAME_LEN     16
+
+// 单个任务的统计
+typedef struct {
+    char name[STACK_PROFILER_NAME_LEN];
+    uint32_t stack_size;        // 栈大小（字节），0表示未知
+    uint32_t min_free;          // 运行以来剩余最少的字节数
+    uint32_t recommended;       // 建议的栈大小（字节），栈大小未知时为0
+    const char *option;         // 对应的配置项，可能为NULL
+} stack_profiler_task_t;
+
+#if CONFIG_EXAMPLE_STACK_PROFILER
+
+// 启动定时采样，在创建应用任务之前调用
+esp_err_t stack_profiler_init(void);
+
+/**
+ * @brief 登记应用任务的栈大小
+ *
+ * @param name       任务名，和xTaskCreate()的名称一致
+ * @param stack_size 创建任务时给的栈大小（字节）
+ * @param option     修改栈大小的配置项或宏，用于报告，可以为NULL
+ */
+void stack_profiler_register(const char *name, uint32_t stack_size, const char *option);
+
+// 立即采样一次，任务退出前调用可以留下它的水位
+void stack_profiler_sample(void);
+
+// 采样并打印所有任务的报告
+void stack_profiler_report(void);
+
+// 复制所有任务的统计，返回任务数
+int stack_profiler_get_tasks(stack_profiler_task_t *tasks, int max);
+
+#else
+
+static inline esp_err_t stack_profiler_init(void) { return ESP_OK; }
+static inline void stack_profiler_register(const char *name, uint32_t stack_size, const char *option)
+{
+    (void)name;
+    (void)stack_size;
+    (void)option;
+}
+static inline void stack_profiler_sample(void) {}
+static inline void stack_profiler_report(void) {}
+static inline int stack_profiler_get_tasks(stack_profiler_task_t *tasks, int max)
+{
+    (void)tasks;
+    (void)max;
+    return 0;
+}
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STACK_PROFILER_H */
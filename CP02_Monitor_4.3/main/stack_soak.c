@@ -0,0 +1,112 @@
+/**
+ * @file     stack_soak.c
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    Stack Soak Workload Implementation
+ */
+
+#include "stack_soak.h"
+
+#if CONFIG_EXAMPLE_STACK_SOAK
+
+#include <stdbool.h>
+#include "esp_log.h"
+#include "lvgl.h"
+#include "gauge_view.h"
+#include "settings_ui.h"
+#include "perf_hud.h"
+#include "ui_theme.h"
+#include "stack_profiler.h"
+
+static const char *TAG = "STACK_SOAK";
+
+#define STEP_MS     1500        // 每一步的间隔，页面切换和至少一次数据刷新都能完成
+
+static lv_timer_t *soak_timer = NULL;
+static uint32_t cycle = 0;
+static int step = 0;
+static ui_theme_id_t start_theme;
+
+static void step_gauges_open(void)
+{
+    gauge_view_open();
+}
+
+static void step_gauges_close(void)
+{
+    gauge_view_close();
+}
+
+static void step_settings_open(void)
+{
+    settings_ui_open_wifi_settings();
+}
+
+static void step_settings_close(void)
+{
+    settings_ui_close_wifi_settings();
+}
+
+static void step_hud_toggle(void)
+{
+    perf_hud_set_visible(!perf_hud_is_visible());
+}
+
+// 前UI_THEME_MAX轮每轮换一种主题，最后一次切回开始时的主题
+static void step_theme(void)
+{
+    if (cycle < UI_THEME_MAX) {
+        ui_theme_set((ui_theme_id_t)((start_theme + cycle + 1) % UI_THEME_MAX));
+    }
+}
+
+// 每一轮的步骤，性能信息切换两次，结束时恢复原样
+static void (*const steps[])(void) = {
+    step_gauges_open,
+    step_gauges_close,
+    step_settings_open,
+    step_settings_close,
+    step_hud_toggle,
+    step_hud_toggle,
+    step_theme,
+};
+
+#define STEP_COUNT  (int)(sizeof(steps) / sizeof(steps[0]))
+
+static void soak_timer_cb(lv_timer_t *timer)
+{
+    steps[step]();
+    if (++step < STEP_COUNT) {
+        return;
+    }
+
+    step = 0;
+    cycle++;
+    if (cycle % 10 == 0) {
+        ESP_LOGI(TAG, "已完成 %lu/%d 轮", (unsigned long)cycle, CONFIG_EXAMPLE_STACK_SOAK_CYCLES);
+    }
+    if (cycle >= CONFIG_EXAMPLE_STACK_SOAK_CYCLES) {
+        lv_timer_del(timer);
+        soak_timer = NULL;
+        ESP_LOGI(TAG, "压力测试结束，共 %lu 轮", (unsigned long)cycle);
+        stack_profiler_report();
+    }
+}
+
+esp_err_t stack_soak_start(void)
+{
+    if (soak_timer != NULL) {
+        return ESP_OK;
+    }
+
+    start_theme = ui_theme_get();
+    soak_timer = lv_timer_create(soak_timer_cb, STEP_MS, NULL);
+    if (soak_timer == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    ESP_LOGW(TAG, "压力测试开始：%d 轮，每轮 %d 步，每步 %d ms", CONFIG_EXAMPLE_STACK_SOAK_CYCLES, STEP_COUNT, STEP_MS);
+    return ESP_OK;
+}
+
+#endif
@@ -0,0 +1,42 @@
+/**
+ * @file     stack_soak.h
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    Stack Soak Workload Header
+ *
+ * 栈水位统计用的压力测试。stack_profiler只能看到实际运行过的路径，仪表
+ * 页面、设置页面（拼音输入法、二维码）、性能信息和主题切换平时只有触摸才会
+ * 进入，只开机放着得到的建议大小偏小。启用后在LVGL任务中按固定顺序反复
+ * 打开和关闭这些页面，数据采集照常进行，跑完指定的轮数后打印一次栈报告。
+ *
+ * 只用于测试固件，会改变屏幕内容；每种主题只在前几轮各切换一次，最后恢复
+ * 原来的主题，不会反复写NVS。
+ */
+
+#ifndef STACK_SOAK_H
+#define STACK_SOAK_H
+
+#include "esp_err.h"
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if CONFIG_EXAMPLE_STACK_SOAK
+
+// 开始压力测试，需要在界面初始化之后、持有LVGL锁时调用
+esp_err_t stack_soak_start(void);
+
+#else
+
+static inline esp_err_t stack_soak_start(void) { return ESP_OK; }
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STACK_SOAK_H */
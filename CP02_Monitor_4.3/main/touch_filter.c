@@ -0,0 +1,228 @@
+/**
+ * @file     touch_filter.c
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    Touch Filter Module Implementation
+ *
+ * 坐标滤波使用 One-Euro 滤波器：静止时截止频率低，抑制抖动；
+ * 滑动时截止频率随速度升高，减小跟手延迟。
+ */
+
+#include "touch_filter.h"
+#include <stddef.h>
+#include <math.h>
+
+#define TOUCH_FILTER_PI         3.14159265f
+#define TOUCH_FILTER_MIN_DT_S   0.001f      // 时间戳相同或回绕时的最小时间间隔
+#define TOUCH_FILTER_MAX_DT_S   0.5f        // 超过该间隔认为是新的轨迹段
+
+// 计算一阶低通滤波系数
+static float lowpass_alpha(float cutoff_hz, float dt_s)
+{
+    float tau = 1.0f / (2.0f * TOUCH_FILTER_PI * cutoff_hz);
+    return 1.0f / (1.0f + tau / dt_s);
+}
+
+static float lowpass_apply(touch_lowpass_t *lp, float value, float alpha)
+{
+    if (!lp->initialized) {
+        lp->value = value;
+        lp->initialized = true;
+    } else {
+        lp->value = alpha * value + (1.0f - alpha) * lp->value;
+    }
+    return lp->value;
+}
+
+// 以一个采样为起点重新开始滤波
+static void filter_restart(touch_filter_t *f, int16_t x, int16_t y, uint32_t now_ms)
+{
+    f->x.value = x;
+    f->x.initialized = true;
+    f->y.value = y;
+    f->y.initialized = true;
+    f->dx.value = 0.0f;
+    f->dx.initialized = true;
+    f->dy.value = 0.0f;
+    f->dy.initialized = true;
+    f->last_ms = now_ms;
+    f->out_x = x;
+    f->out_y = y;
+}
+
+// 滤波一个按下状态下的采样，更新输出坐标
+static void filter_sample(touch_filter_t *f, int16_t raw_x, int16_t raw_y, uint32_t now_ms)
+{
+    float dt = (float)(uint32_t)(now_ms - f->last_ms) / 1000.0f;
+    if (dt > TOUCH_FILTER_MAX_DT_S) {
+        filter_restart(f, raw_x, raw_y, now_ms);
+        return;
+    }
+    if (dt < TOUCH_FILTER_MIN_DT_S) {
+        dt = TOUCH_FILTER_MIN_DT_S;
+    }
+    f->last_ms = now_ms;
+
+    // 速度估计（相对上一次滤波结果）
+    float a_d = lowpass_alpha(f->cfg.d_cutoff_hz, dt);
+    float vx = lowpass_apply(&f->dx, ((float)raw_x - f->x.value) / dt, a_d);
+    float vy = lowpass_apply(&f->dy, ((float)raw_y - f->y.value) / dt, a_d);
+
+    // 截止频率随速度自适应
+    float speed = sqrtf(vx * vx + vy * vy);
+    float cutoff = f->cfg.min_cutoff_hz + f->cfg.beta * speed;
+    float a = lowpass_alpha(cutoff, dt);
+    float x = lowpass_apply(&f->x, raw_x, a);
+    float y = lowpass_apply(&f->y, raw_y, a);
+
+    // 按速度向前预测，补偿轮询与渲染带来的延迟
+    if (f->cfg.predict_ms > 0) {
+        float ahead_s = f->cfg.predict_ms / 1000.0f;
+        x += vx * ahead_s;
+        y += vy * ahead_s;
+    }
+    // 预测可能越过面板边缘，限制在面板内
+    if (x < 0.0f) {
+        x = 0.0f;
+    } else if (f->cfg.width > 0 && x > f->cfg.width - 1) {
+        x = f->cfg.width - 1;
+    }
+    if (y < 0.0f) {
+        y = 0.0f;
+    } else if (f->cfg.height > 0 && y > f->cfg.height - 1) {
+        y = f->cfg.height - 1;
+    }
+
+    int16_t nx = (int16_t)lroundf(x);
+    int16_t ny = (int16_t)lroundf(y);
+
+    // 死区：移动量很小时保持上一次输出，避免静止时的抖动引起重绘
+    int dzx = nx - f->out_x;
+    int dzy = ny - f->out_y;
+    if (dzx < 0) {
+        dzx = -dzx;
+    }
+    if (dzy < 0) {
+        dzy = -dzy;
+    }
+    if (dzx <= f->cfg.dead_zone_px && dzy <= f->cfg.dead_zone_px) {
+        return;
+    }
+
+    f->out_x = nx;
+    f->out_y = ny;
+}
+
+void touch_filter_init(touch_filter_t *f, const touch_filter_config_t *cfg)
+{
+    const touch_filter_config_t def = TOUCH_FILTER_DEFAULT_CONFIG();
+    f->cfg = (cfg != NULL) ? *cfg : def;
+    if (f->cfg.press_debounce == 0) {
+        f->cfg.press_debounce = 1;
+    }
+    if (f->cfg.release_debounce == 0) {
+        f->cfg.release_debounce = 1;
+    }
+    touch_filter_reset(f);
+}
+
+void touch_filter_reset(touch_filter_t *f)
+{
+    f->state = TOUCH_STATE_IDLE;
+    f->debounce_cnt = 0;
+    f->last_ms = 0;
+    f->x.initialized = false;
+    f->y.initialized = false;
+    f->dx.initialized = false;
+    f->dy.initialized = false;
+    f->out_x = 0;
+    f->out_y = 0;
+}
+
+bool touch_filter_update(touch_filter_t *f, bool raw_pressed, int16_t raw_x, int16_t raw_y,
+                         uint32_t now_ms, int16_t *out_x, int16_t *out_y)
+{
+    bool pressed = false;
+
+    switch (f->state) {
+        case TOUCH_STATE_IDLE:
+            if (raw_pressed) {
+                f->debounce_cnt = 1;
+                if (f->debounce_cnt >= f->cfg.press_debounce) {
+                    filter_restart(f, raw_x, raw_y, now_ms);
+                    f->state = TOUCH_STATE_PRESSED;
+                    pressed = true;
+                } else {
+                    f->state = TOUCH_STATE_PRESS_PENDING;
+                }
+            }
+            break;
+
+        case TOUCH_STATE_PRESS_PENDING:
+            if (raw_pressed) {
+                f->debounce_cnt++;
+                if (f->debounce_cnt >= f->cfg.press_debounce) {
+                    filter_restart(f, raw_x, raw_y, now_ms);
+                    f->state = TOUCH_STATE_PRESSED;
+                    pressed = true;
+                }
+            } else {
+                // 单个毛刺，丢弃
+                f->state = TOUCH_STATE_IDLE;
+                f->debounce_cnt = 0;
+            }
+            break;
+
+        case TOUCH_STATE_PRESSED:
+            if (raw_pressed) {
+                filter_sample(f, raw_x, raw_y, now_ms);
+                pressed = true;
+            } else if (f->cfg.release_debounce <= 1) {
+                f->state = TOUCH_STATE_IDLE;
+            } else {
+                f->debounce_cnt = 1;
+                f->state = TOUCH_STATE_RELEASE_PENDING;
+                pressed = true;
+            }
+            break;
+
+        case TOUCH_STATE_RELEASE_PENDING:
+            if (raw_pressed) {
+                // 抬起是误报，继续跟踪
+                f->state = TOUCH_STATE_PRESSED;
+                filter_sample(f, raw_x, raw_y, now_ms);
+                pressed = true;
+            } else {
+                f->debounce_cnt++;
+                if (f->debounce_cnt >= f->cfg.release_debounce) {
+                    f->state = TOUCH_STATE_IDLE;
+                } else {
+                    pressed = true;
+                }
+            }
+            break;
+
+        default:
+            touch_filter_reset(f);
+            break;
+    }
+
+    if (out_x != NULL) {
+        *out_x = f->out_x;
+    }
+    if (out_y != NULL) {
+        *out_y = f->out_y;
+    }
+    return pressed;
+}
+
+bool touch_filter_is_active(const touch_filter_t *f)
+{
+    return f->state != TOUCH_STATE_IDLE;
+}
+
+touch_state_t touch_filter_get_state(const touch_filter_t *f)
+{
+    return f->state;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file     touch_filter.h
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    Touch Filter Module Header
+ *
+ * 触摸坐标滤波与按下/抬起状态机。只依赖标准C头文件，
+ * 可以直接在主机上用录制的触摸轨迹回放验证。
+ */
+
+#ifndef TOUCH_FILTER_H
+#define TOUCH_FILTER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 滤波器参数
+typedef struct {
+    float min_cutoff_hz;        // One-Euro 最小截止频率，越小静止时越稳
+    float beta;                 // One-Euro 速度系数，越大快速滑动时延迟越小
+    float d_cutoff_hz;          // 速度估计的截止频率
+    uint16_t dead_zone_px;      // 死区：静止时小于该距离的抖动不输出
+    uint16_t predict_ms;        // 按当前速度向前预测的时间，0表示关闭预测
+    uint16_t width;             // 面板宽度，输出坐标限制在0~width-1，0表示不限制
+    uint16_t height;            // 面板高度，输出坐标限制在0~height-1，0表示不限制
+    uint8_t press_debounce;     // 连续多少个采样为按下才确认按下
+    uint8_t release_debounce;   // 连续多少个采样为抬起才确认抬起
+} touch_filter_config_t;
+
+// 默认参数，适用于800x480的GT911
+#define TOUCH_FILTER_DEFAULT_CONFIG() {  \
+    .min_cutoff_hz = 1.5f,               \
+    .beta = 0.02f,                       \
+    .d_cutoff_hz = 1.0f,                 \
+    .dead_zone_px = 2,                   \
+    .predict_ms = 8,                     \
+    .width = 800,                        \
+    .height = 480,                       \
+    .press_debounce = 1,                 \
+    .release_debounce = 2,               \
+}
+
+// 状态机状态
+typedef enum {
+    TOUCH_STATE_IDLE,               // 无触摸
+    TOUCH_STATE_PRESS_PENDING,      // 检测到触摸，等待去抖确认
+    TOUCH_STATE_PRESSED,            // 已确认按下
+    TOUCH_STATE_RELEASE_PENDING,    // 检测到抬起，等待去抖确认
+} touch_state_t;
+
+// 一阶低通滤波器状态
+typedef struct {
+    float value;
+    bool initialized;
+} touch_lowpass_t;
+
+// 滤波器实例
+typedef struct {
+    touch_filter_config_t cfg;
+    touch_state_t state;
+    uint8_t debounce_cnt;           // 当前去抖计数
+    uint32_t last_ms;               // 上一个有效采样的时间戳
+    touch_lowpass_t x, y;           // 坐标滤波
+    touch_lowpass_t dx, dy;         // 速度滤波 (px/s)
+    int16_t out_x, out_y;           // 最近一次输出的坐标
+} touch_filter_t;
+
+// 初始化滤波器，cfg为NULL时使用默认参数
+void touch_filter_init(touch_filter_t *f, const touch_filter_config_t *cfg);
+
+// 复位到空闲状态，保留参数
+void touch_filter_reset(touch_filter_t *f);
+
+/**
+ * @brief 输入一个原始采样
+ *
+ * @param raw_pressed  控制器是否报告有触摸
+ * @param raw_x/raw_y  原始坐标，raw_pressed为false时忽略
+ * @param now_ms       采样时间
+ * @param out_x/out_y  输出坐标（按下时为滤波后坐标，抬起时为最后一次按下坐标）
+ *
+ * @return 去抖后的按下状态
+ */
+bool touch_filter_update(touch_filter_t *f, bool raw_pressed, int16_t raw_x, int16_t raw_y,
+                         uint32_t now_ms, int16_t *out_x, int16_t *out_y);
+
+// 是否处于活动状态（非空闲），用于决定轮询频率
+bool touch_filter_is_active(const touch_filter_t *f);
+
+// 获取当前状态
+touch_state_t touch_filter_get_state(const touch_filter_t *f);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOUCH_FILTER_H */
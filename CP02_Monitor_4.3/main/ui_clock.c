@@ -0,0 +1,73 @@
+/**
+ * @file     ui_clock.c
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    UI Clock Module Implementation
+ */
+
+#include "ui_clock.h"
+#include "esp_attr.h"
+#include "esp_timer.h"
+
+#define UI_CLOCK_STALE_MS   100     // 超过这个时间没有新帧就改用实时时间
+
+static volatile uint32_t frame_ms = 0;          // 最近一帧的显示时刻
+static volatile bool frame_valid = false;
+static volatile bool manual = false;
+static uint32_t manual_ms = 0;
+static uint32_t offset_ms = 0;                  // 退出手动模式后保持动画时间连续
+
+static inline uint32_t now_ms(void)
+{
+    return (uint32_t)(esp_timer_get_time() / 1000) + offset_ms;
+}
+
+uint32_t ui_clock_tick_ms(void)
+{
+    return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+uint32_t ui_clock_ms(void)
+{
+    if (manual) {
+        return manual_ms;
+    }
+    uint32_t now = now_ms();
+#if CONFIG_EXAMPLE_UI_CLOCK_VSYNC
+    // 先读实时时间再读帧时间，中间来了新帧时差值溢出，按实时时间返回
+    uint32_t frame = frame_ms;
+    if (frame_valid && now - frame < UI_CLOCK_STALE_MS) {
+        return frame;
+    }
+#endif
+    return now;
+}
+
+IRAM_ATTR void ui_clock_frame(void)
+{
+#if CONFIG_EXAMPLE_UI_CLOCK_VSYNC
+    frame_ms = now_ms();
+    frame_valid = true;
+#endif
+}
+
+void ui_clock_manual(uint32_t start_ms)
+{
+    manual_ms = start_ms;
+    manual = true;
+    frame_valid = false;
+}
+
+void ui_clock_step(uint32_t ms)
+{
+    manual_ms += ms;
+}
+
+void ui_clock_release(void)
+{
+    // 从手动模式的时间继续往后走，动画看到的时间不会倒退
+    offset_ms = manual_ms - ui_clock_tick_ms();
+    frame_valid = false;
+    manual = false;
+}
@@ -0,0 +1,60 @@
+/**
+ * @file     ui_clock.h
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    UI Clock Module Header
+ *
+ * LVGL时钟。LVGL通过LV_TICK_CUSTOM_SYS_TIME_EXPR调用ui_clock_tick_ms()
+ * 按需读取实时时间，不再需要每2ms一次的定时器中断，定时器、触摸轮询和
+ * 任务休眠都按实时时间。动画通过LV_ANIM_TIME_CUSTOM_EXPR单独读取
+ * ui_clock_ms()：启用VSYNC锁存时，动画时间只在每帧开始时前进一次，同一
+ * 帧内所有动画都按同一个显示时刻计算，步长是整数个帧周期，不受任务调度
+ * 延迟影响。屏幕没有VSYNC时退回实时时间。手动模式下动画时间完全由调用者
+ * 推进，主机上的模拟器可以逐帧重现动画。
+ */
+
+#ifndef UI_CLOCK_H
+#define UI_CLOCK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// LVGL定时器用的实时时间，单位ms
+uint32_t ui_clock_tick_ms(void);
+
+// 动画时间，单位ms
+uint32_t ui_clock_ms(void);
+
+/**
+ * @brief 新的一帧开始显示
+ *
+ * 在VSYNC（或者bounce buffer扫描到第一行）的中断回调中调用，锁存这一帧
+ * 的显示时刻。
+ */
+void ui_clock_frame(void);
+
+/**
+ * @brief 切换到手动模式
+ *
+ * 之后ui_clock_ms()固定返回start_ms，只有ui_clock_step()能推进时间，
+ * VSYNC不再起作用，LVGL定时器仍按实时时间运行。用于主机模拟和动画测试。
+ */
+void ui_clock_manual(uint32_t start_ms);
+
+// 手动模式下推进时间
+void ui_clock_step(uint32_t ms);
+
+// 退出手动模式
+void ui_clock_release(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UI_CLOCK_H */
@@ -0,0 +1,353 @@
+/**
+ * @file     ui_nav.c
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    UI Navigation Module Implementation
+ */
+
+#include "ui_nav.h"
+#include "ui_theme.h"
+#include "mem_tag.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+static const char *TAG = "UI_NAV";
+
+#define UI_NAV_MAX_SCREENS  8       // 最多登记的页面数
+
+// 每个页面对应一个fragment，fragment的obj是页面所在的屏幕
+typedef struct {
+    lv_fragment_t base;
+    ui_nav_screen_t *screen;
+} nav_fragment_t;
+
+typedef enum {
+    NAV_OP_NONE = 0,
+    NAV_OP_PUSH,
+    NAV_OP_POP,
+} nav_op_t;
+
+static lv_fragment_manager_t *manager = NULL;
+static lv_obj_t *cache_holder = NULL;           // 不显示的屏幕，保存后台页面的控件
+static ui_nav_screen_t *screens[UI_NAV_MAX_SCREENS];
+static int screen_count = 0;
+static nav_op_t pending_op = NAV_OP_NONE;
+static ui_nav_screen_t *pending_screen = NULL;
+static ui_nav_stats_t nav_stats;
+static lv_coord_t bottom_inset = 0;             // 屏幕底部留给顶层控件的高度
+
+static void nav_constructor_cb(lv_fragment_t *self, void *args)
+{
+    ((nav_fragment_t *)self)->screen = (ui_nav_screen_t *)args;
+}
+
+static lv_obj_t *nav_create_obj_cb(lv_fragment_t *self, lv_obj_t *container)
+{
+    ui_nav_screen_t *screen = ((nav_fragment_t *)self)->screen;
+    (void)container;
+
+    lv_obj_t *host = lv_obj_create(NULL);
+    ui_theme_apply(host, UI_STYLE_SCREEN, LV_PART_MAIN);
+    lv_obj_set_style_pad_bottom(host, bottom_inset, LV_PART_MAIN);
+
+    if (screen->cached && screen->content != NULL) {
+        // 保留的页面直接挂回来
+        lv_obj_set_parent(screen->content, host);
+        return host;
+    }
+
+    // 透明的内容容器，页面的控件都建在里面，离开时整体挪走
+    screen->content = lv_obj_create(host);
+    lv_obj_remove_style_all(screen->content);
+    lv_obj_set_size(screen->content, LV_PCT(100), LV_PCT(100));
+    screen->pending = 0;
+    screen->create(screen->content);
+    return host;
+}
+
+static void nav_timers_del(ui_nav_screen_t *screen)
+{
+    for (int i = 0; i < UI_NAV_MAX_TIMERS; i++) {
+        if (screen->timers[i] != NULL) {
+            lv_timer_del(screen->timers[i]);
+            screen->timers[i] = NULL;
+        }
+    }
+}
+
+static void nav_obj_will_delete_cb(lv_fragment_t *self, lv_obj_t *obj)
+{
+    ui_nav_screen_t *screen = ((nav_fragment_t *)self)->screen;
+    // LVGL不允许删除当前显示的屏幕后再加载新屏幕，先临时切到cache_holder，
+    // 切换在同一次定时器处理中完成，中间不会刷新
+    if (lv_scr_act() == obj) {
+        lv_scr_load(cache_holder);
+    }
+
+    if (screen->cached) {
+        lv_obj_set_parent(screen->content, cache_holder);
+        return;
+    }
+
+    if (screen->destroy) {
+        screen->destroy();
+    }
+    nav_timers_del(screen);
+    screen->content = NULL;     // 随屏幕一起删除
+}
+
+static const lv_fragment_class_t nav_fragment_class = {
+    .constructor_cb = nav_constructor_cb,
+    .create_obj_cb = nav_create_obj_cb,
+    .obj_will_delete_cb = nav_obj_will_delete_cb,
+    .instance_size = sizeof(nav_fragment_t),
+};
+
+static void nav_register(ui_nav_screen_t *screen)
+{
+    for (int i = 0; i < screen_count; i++) {
+        if (screens[i] == screen) {
+            return;
+        }
+    }
+    if (screen_count < UI_NAV_MAX_SCREENS) {
+        screens[screen_count++] = screen;
+    } else {
+        ESP_LOGW(TAG, "页面太多，%s 收不到后台数据", screen->name);
+    }
+}
+
+// 页面退到后台：暂停定时器
+static void nav_background(ui_nav_screen_t *screen)
+{
+    if (screen->hide) {
+        screen->hide();
+    }
+    for (int i = 0; i < UI_NAV_MAX_TIMERS; i++) {
+        if (screen->timers[i] != NULL) {
+            lv_timer_pause(screen->timers[i]);
+        }
+    }
+    screen->active = false;
+}
+
+// 页面回到前台：恢复定时器，补发后台期间的数据
+static void nav_foreground(ui_nav_screen_t *screen)
+{
+    screen->active = true;
+    for (int i = 0; i < UI_NAV_MAX_TIMERS; i++) {
+        if (screen->timers[i] != NULL) {
+            lv_timer_resume(screen->timers[i]);
+        }
+    }
+    if (screen->show) {
+        screen->show();
+    }
+    uint32_t topics = screen->pending;
+    screen->pending = 0;
+    if (topics != 0 && screen->on_data) {
+        screen->on_data(topics);
+    }
+}
+
+static void nav_finish(const char *from, int64_t start_us)
+{
+    lv_fragment_t *top = lv_fragment_manager_get_top(manager);
+    ui_nav_screen_t *screen = ((nav_fragment_t *)top)->screen;
+
+    nav_foreground(screen);
+    lv_scr_load(top->obj);
+
+    uint32_t elapsed = (uint32_t)(esp_timer_get_time() - start_us);
+    mem_tag_stats_t lv_stats;
+    mem_tag_get_stats(MEM_TAG_LVGL, &lv_stats);
+    nav_stats.transitions++;
+    nav_stats.last_us = elapsed;
+    if (elapsed > nav_stats.max_us) {
+        nav_stats.max_us = elapsed;
+    }
+    nav_stats.lvgl_bytes = lv_stats.live_bytes;
+
+    ESP_LOGI(TAG, "%s -> %s: %lu us, 栈深度 %lu, LVGL %lu 字节", from ? from : "-", screen->name,
+             (unsigned long)elapsed, (unsigned long)nav_stats.depth, (unsigned long)lv_stats.live_bytes);
+}
+
+static void nav_do_push(ui_nav_screen_t *screen)
+{
+    int64_t start_us = esp_timer_get_time();
+    ui_nav_screen_t *prev = ui_nav_top();
+
+    if (prev != NULL) {
+        nav_background(prev);
+    }
+    nav_register(screen);
+
+    lv_fragment_t *fragment = lv_fragment_create(&nav_fragment_class, screen);
+    lv_fragment_manager_push(manager, fragment, NULL);
+    screen->stacked = true;
+    nav_stats.depth++;
+
+    nav_finish(prev ? prev->name : NULL, start_us);
+}
+
+static void nav_do_pop(void)
+{
+    int64_t start_us = esp_timer_get_time();
+    ui_nav_screen_t *top = ui_nav_top();
+
+    nav_background(top);
+    lv_fragment_manager_pop(manager);
+    top->stacked = false;
+    nav_stats.depth--;
+
+    nav_finish(top->name, start_us);
+}
+
+// 在LVGL定时器处理中执行切换，这时没有控件的事件回调在运行
+static void nav_async_cb(void *user_data)
+{
+    (void)user_data;
+    nav_op_t op = pending_op;
+    ui_nav_screen_t *screen = pending_screen;
+
+    pending_op = NAV_OP_NONE;
+    pending_screen = NULL;
+
+    if (op == NAV_OP_PUSH) {
+        nav_do_push(screen);
+    } else if (op == NAV_OP_POP) {
+        nav_do_pop();
+    }
+}
+
+static esp_err_t nav_request(nav_op_t op, ui_nav_screen_t *screen)
+{
+    if (pending_op != NAV_OP_NONE) {
+        ESP_LOGW(TAG, "正在切换页面，忽略新的请求");
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (lv_async_call(nav_async_cb, NULL) != LV_RES_OK) {
+        return ESP_ERR_NO_MEM;
+    }
+    pending_op = op;
+    pending_screen = screen;
+    return ESP_OK;
+}
+
+esp_err_t ui_nav_init(void)
+{
+    if (manager != NULL) {
+        return ESP_OK;
+    }
+
+    manager = lv_fragment_manager_create(NULL);
+    if (manager == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    cache_holder = lv_obj_create(NULL);
+
+    ESP_LOGI(TAG, "导航栈已初始化");
+    return ESP_OK;
+}
+
+esp_err_t ui_nav_push(ui_nav_screen_t *screen)
+{
+    if (manager == NULL || screen == NULL || screen->create == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (screen->stacked) {
+        // 已经在前台时什么都不做，在栈里但不在前台时不允许重复打开
+        return ui_nav_is_top(screen) ? ESP_OK : ESP_ERR_INVALID_STATE;
+    }
+
+    if (lv_fragment_manager_get_top(manager) == NULL) {
+        nav_do_push(screen);
+        return ESP_OK;
+    }
+    return nav_request(NAV_OP_PUSH, screen);
+}
+
+esp_err_t ui_nav_pop(void)
+{
+    if (manager == NULL || nav_stats.depth <= 1) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    return nav_request(NAV_OP_POP, NULL);
+}
+
+ui_nav_screen_t *ui_nav_top(void)
+{
+    if (manager == NULL) {
+        return NULL;
+    }
+    lv_fragment_t *top = lv_fragment_manager_get_top(manager);
+    return top ? ((nav_fragment_t *)top)->screen : NULL;
+}
+
+bool ui_nav_is_top(const ui_nav_screen_t *screen)
+{
+    return screen != NULL && ui_nav_top() == screen;
+}
+
+void ui_nav_publish(uint32_t topics)
+{
+    for (int i = 0; i < screen_count; i++) {
+        ui_nav_screen_t *screen = screens[i];
+        uint32_t hit = screen->topics & topics;
+        if (hit == 0 || screen->content == NULL) {
+            continue;
+        }
+        if (screen->active) {
+            if (screen->on_data) {
+                screen->on_data(hit);
+            }
+        } else {
+            screen->pending |= hit;
+        }
+    }
+}
+
+lv_timer_t *ui_nav_timer_create(ui_nav_screen_t *screen, lv_timer_cb_t cb, uint32_t period, void *user_data)
+{
+    for (int i = 0; i < UI_NAV_MAX_TIMERS; i++) {
+        if (screen->timers[i] != NULL) {
+            continue;
+        }
+        lv_timer_t *timer = lv_timer_create(cb, period, user_data);
+        if (timer != NULL && !screen->active) {
+            lv_timer_pause(timer);
+        }
+        screen->timers[i] = timer;
+        return timer;
+    }
+    ESP_LOGE(TAG, "%s 的定时器超过 %d 个", screen->name, UI_NAV_MAX_TIMERS);
+    return NULL;
+}
+
+void ui_nav_timer_del(ui_nav_screen_t *screen, lv_timer_t *timer)
+{
+    for (int i = 0; i < UI_NAV_MAX_TIMERS; i++) {
+        if (screen->timers[i] == timer) {
+            screen->timers[i] = NULL;
+            lv_timer_del(timer);
+            return;
+        }
+    }
+}
+
+void ui_nav_set_bottom_inset(lv_coord_t h)
+{
+    bottom_inset = h;
+    // 内容容器占满所在屏幕的内容区，屏幕的下边距变了，容器跟着变高或变矮
+    for (int i = 0; i < screen_count; i++) {
+        if (screens[i]->content != NULL) {
+            lv_obj_set_style_pad_bottom(lv_obj_get_parent(screens[i]->content), h, LV_PART_MAIN);
+        }
+    }
+}
+
+void ui_nav_get_stats(ui_nav_stats_t *stats)
+{
+    *stats = nav_stats;
+}
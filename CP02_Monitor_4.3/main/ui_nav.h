@@ -0,0 +1,119 @@
+/**
+ * @file     ui_nav.h
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    UI Navigation Module Header
+ *
+ * 页面导航栈，基于LVGL的fragment管理器。每个页面用ui_nav_screen_t声明
+ * 自己的创建函数、订阅的数据主题，以及离开时是保留（cached）还是销毁。
+ * 保留的页面离开时整个内容容器挪到一个不显示的屏幕上，返回时直接挂回来，
+ * 不需要重新创建控件；销毁的页面每次进入时重新创建。
+ *
+ * 页面退到后台时，通过ui_nav_timer_create()创建的定时器自动暂停，
+ * ui_nav_publish()发布的数据只记下主题，等页面回到前台时合并成一次
+ * on_data回调，后台页面不占用刷新和重绘时间。
+ */
+
+#ifndef UI_NAV_H
+#define UI_NAV_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl.h"
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UI_NAV_MAX_TIMERS   4       // 每个页面最多托管的定时器数
+
+// 数据主题，按位组合
+#define UI_NAV_TOPIC_POWER  (1U << 0)   // 端口功率数据
+#define UI_NAV_TOPIC_WIFI   (1U << 1)   // WiFi连接状态
+
+// 页面声明，一般定义为静态变量
+typedef struct ui_nav_screen {
+    const char *name;                       // 页面名称，用于日志
+    bool cached;                            // 离开时保留控件，返回时不重新创建
+    uint32_t topics;                        // 订阅的数据主题
+    void (*create)(lv_obj_t *parent);       // 在parent中创建控件，parent占满整个屏幕
+    void (*destroy)(void);                  // 控件即将删除，清理指向控件的指针（可选）
+    void (*show)(void);                     // 回到前台（可选）
+    void (*hide)(void);                     // 退到后台或销毁之前（可选）
+    void (*on_data)(uint32_t topics);       // 订阅的主题有更新（可选）
+
+    // 以下由ui_nav内部使用
+    lv_obj_t *content;
+    bool active;
+    bool stacked;
+    uint32_t pending;
+    lv_timer_t *timers[UI_NAV_MAX_TIMERS];
+} ui_nav_screen_t;
+
+// 导航统计
+typedef struct {
+    uint32_t transitions;       // 页面切换次数
+    uint32_t last_us;           // 最近一次切换耗时
+    uint32_t max_us;            // 切换耗时最大值
+    uint32_t lvgl_bytes;        // 最近一次切换后LVGL占用的字节数
+    uint32_t depth;             // 当前栈深度
+} ui_nav_stats_t;
+
+// 初始化导航栈，需要在创建任何页面之前、持有LVGL锁时调用
+esp_err_t ui_nav_init(void);
+
+/**
+ * @brief 打开页面
+ *
+ * 栈为空时立即创建并显示，否则在下一次LVGL定时器处理时切换，
+ * 可以在被删除的控件自己的事件回调中调用。切换过程中的新请求被忽略。
+ */
+esp_err_t ui_nav_push(ui_nav_screen_t *screen);
+
+// 返回上一个页面，栈里只有一个页面时返回ESP_ERR_INVALID_STATE
+esp_err_t ui_nav_pop(void);
+
+// 当前显示的页面
+ui_nav_screen_t *ui_nav_top(void);
+
+// 页面是否在前台
+bool ui_nav_is_top(const ui_nav_screen_t *screen);
+
+/**
+ * @brief 发布数据更新
+ *
+ * 前台页面订阅了其中的主题时立即调用on_data，后台页面只记下主题，
+ * 回到前台时再一起通知。需要持有LVGL锁。
+ */
+void ui_nav_publish(uint32_t topics);
+
+/**
+ * @brief 创建页面托管的定时器
+ *
+ * 和lv_timer_create()相同，但页面不在前台时自动暂停。页面被销毁时
+ * 定时器一起删除，调用者保存的指针随之失效。
+ */
+lv_timer_t *ui_nav_timer_create(ui_nav_screen_t *screen, lv_timer_cb_t cb, uint32_t period, void *user_data);
+
+// 删除页面托管的定时器
+void ui_nav_timer_del(ui_nav_screen_t *screen, lv_timer_t *timer);
+
+/**
+ * @brief 在屏幕底部留出h像素
+ *
+ * 所有页面（包括后台和保留的页面）的内容容器缩短h像素，给常驻在顶层的
+ * 控件让出位置。页面用对齐或LV_EVENT_SIZE_CHANGED适应新的高度。
+ * 需要持有LVGL锁。
+ */
+void ui_nav_set_bottom_inset(lv_coord_t h);
+
+// 获取导航统计
+void ui_nav_get_stats(ui_nav_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UI_NAV_H */
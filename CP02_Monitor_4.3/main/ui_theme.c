@@ -0,0 +1,272 @@
+/**
+ * @file     ui_theme.c
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    UI Theme Module Implementation
+ */
+
+#include "ui_theme.h"
+#include "esp_log.h"
+#include "nvs.h"
+
+static const char *TAG = "UI_THEME";
+
+#define THEME_NVS_NAMESPACE     "ui"
+#define THEME_NVS_KEY           "theme"
+#define VOLTAGE_LEVEL_MAX       7
+
+// 调色板，颜色均为0xRRGGBB
+typedef struct {
+    const char *name;
+    uint32_t screen;
+    uint32_t title;
+    uint32_t text;
+    uint32_t muted;
+    uint32_t button;
+    uint32_t button_text;
+    uint32_t button_secondary;
+    uint32_t button_ok;
+    uint32_t card;
+    uint32_t card_border;
+    uint32_t popup;
+    uint32_t popup_border;
+    uint32_t field;             // 设置项容器背景
+    uint32_t field_border;      // 设置项容器边框和分隔线
+    uint32_t bar;
+    uint32_t bar_start;         // 指示器渐变起始色
+    uint32_t bar_end;           // 指示器渐变终止色
+    uint32_t voltage[VOLTAGE_LEVEL_MAX];    // 见voltage_level()
+    uint32_t status[UI_STATUS_MAX];
+} ui_palette_t;
+
+static const ui_palette_t palettes[UI_THEME_MAX] = {
+    [UI_THEME_LIGHT] = {
+        .name = "浅色",
+        .screen = 0xFFFFFF, .title = 0x000000, .text = 0x000000, .muted = 0x888888,
+        .button = 0x2196F3, .button_text = 0xFFFFFF, .button_secondary = 0x999999, .button_ok = 0x00AA00,
+        .card = 0xFAFAFA, .card_border = 0xDDDDDD,
+        .popup = 0xFFFFFF, .popup_border = 0x2196F3,
+        .field = 0xF5F5F5, .field_border = 0xDDDDDD,
+        .bar = 0xCCCCCC, .bar_start = 0x88FF00, .bar_end = 0xFF8800,
+        .voltage = {0xFF00FF, 0xFF0000, 0xFF8800, 0x88FF00, 0x00FF00, 0x444444, 0x888888},
+        .status = {0x0000FF, 0x00FF00, 0xFFFFFF, 0xFFFF00, 0xFF0000},
+    },
+    [UI_THEME_DARK] = {
+        .name = "深色",
+        .screen = 0x121212, .title = 0xFFFFFF, .text = 0xE0E0E0, .muted = 0x9E9E9E,
+        .button = 0x1E88E5, .button_text = 0xFFFFFF, .button_secondary = 0x616161, .button_ok = 0x2E7D32,
+        .card = 0x1E1E1E, .card_border = 0x333333,
+        .popup = 0x242424, .popup_border = 0x1E88E5,
+        .field = 0x1E1E1E, .field_border = 0x333333,
+        .bar = 0x3A3A3A, .bar_start = 0x88FF00, .bar_end = 0xFF8800,
+        .voltage = {0xFF40FF, 0xFF5252, 0xFF9800, 0xC6FF00, 0x00E676, 0xBDBDBD, 0x757575},
+        .status = {0x448AFF, 0x00E676, 0x121212, 0xFFEB3B, 0xFF5252},
+    },
+    [UI_THEME_HIGH_CONTRAST] = {
+        .name = "高对比度",
+        .screen = 0x000000, .title = 0xFFFFFF, .text = 0xFFFFFF, .muted = 0xFFFFFF,
+        .button = 0xFFFF00, .button_text = 0x000000, .button_secondary = 0xFFFFFF, .button_ok = 0x00FF00,
+        .card = 0x000000, .card_border = 0xFFFFFF,
+        .popup = 0x000000, .popup_border = 0xFFFF00,
+        .field = 0x000000, .field_border = 0xFFFFFF,
+        .bar = 0x404040, .bar_start = 0xFFFFFF, .bar_end = 0xFFFF00,
+        .voltage = {0xFF00FF, 0xFF0000, 0xFF8000, 0xFFFF00, 0x00FF00, 0xFFFFFF, 0xC0C0C0},
+        .status = {0x00FFFF, 0x00FF00, 0x000000, 0xFFFF00, 0xFF0000},
+    },
+    [UI_THEME_NIGHT] = {
+        .name = "夜间",
+        .screen = 0x000000, .title = 0xCC0000, .text = 0xCC0000, .muted = 0x660000,
+        .button = 0x400000, .button_text = 0xFF3030, .button_secondary = 0x200000, .button_ok = 0x550000,
+        .card = 0x0A0000, .card_border = 0x330000,
+        .popup = 0x000000, .popup_border = 0x990000,
+        .field = 0x0A0000, .field_border = 0x330000,
+        .bar = 0x200000, .bar_start = 0x550000, .bar_end = 0xCC0000,
+        .voltage = {0xFF2020, 0xE01818, 0xC01010, 0xA00808, 0x800000, 0x600000, 0x400000},
+        .status = {0x800000, 0xCC0000, 0x000000, 0x990000, 0xFF0000},
+    },
+};
+
+static ui_theme_id_t current_theme = UI_THEME_LIGHT;
+static lv_style_t styles[UI_STYLE_MAX];
+static lv_style_t voltage_styles[VOLTAGE_LEVEL_MAX];
+static lv_style_t status_styles[UI_STATUS_MAX];
+static bool styles_ready = false;
+
+// 电压等级 - 与原get_voltage_color保持一致的分段
+static uint32_t voltage_level(int voltage_mv)
+{
+    if (voltage_mv > 21000) {
+        return 0;   // 21V以上
+    } else if (voltage_mv > 16000) {
+        return 1;   // 16V~21V
+    } else if (voltage_mv > 13000) {
+        return 2;   // 13V~16V
+    } else if (voltage_mv > 10000) {
+        return 3;   // 10V~13V
+    } else if (voltage_mv > 6000) {
+        return 4;   // 6V~10V
+    } else if (voltage_mv >= 0) {
+        return 5;   // 0V~6V
+    }
+    return 6;       // 未识别电压
+}
+
+// 把调色板写入共享样式。属性已存在时lv_style_set_*只改写值，不会重新分配
+static void theme_fill(const ui_palette_t *p)
+{
+    lv_style_set_bg_color(&styles[UI_STYLE_SCREEN], lv_color_hex(p->screen));
+    lv_style_set_text_color(&styles[UI_STYLE_TITLE], lv_color_hex(p->title));
+    lv_style_set_text_color(&styles[UI_STYLE_TEXT], lv_color_hex(p->text));
+    lv_style_set_text_color(&styles[UI_STYLE_MUTED], lv_color_hex(p->muted));
+
+    lv_style_set_bg_color(&styles[UI_STYLE_BUTTON], lv_color_hex(p->button));
+    lv_style_set_text_color(&styles[UI_STYLE_BUTTON], lv_color_hex(p->button_text));
+    lv_style_set_bg_color(&styles[UI_STYLE_BUTTON_SECONDARY], lv_color_hex(p->button_secondary));
+    lv_style_set_text_color(&styles[UI_STYLE_BUTTON_SECONDARY], lv_color_hex(p->button_text));
+    lv_style_set_bg_color(&styles[UI_STYLE_BUTTON_OK], lv_color_hex(p->button_ok));
+    lv_style_set_text_color(&styles[UI_STYLE_BUTTON_OK], lv_color_hex(p->button_text));
+
+    lv_style_set_bg_color(&styles[UI_STYLE_CARD], lv_color_hex(p->card));
+    lv_style_set_border_color(&styles[UI_STYLE_CARD], lv_color_hex(p->card_border));
+    lv_style_set_border_width(&styles[UI_STYLE_CARD], 2);
+    lv_style_set_radius(&styles[UI_STYLE_CARD], 10);
+    lv_style_set_pad_all(&styles[UI_STYLE_CARD], 15);
+
+    lv_style_set_bg_color(&styles[UI_STYLE_POPUP], lv_color_hex(p->popup));
+    lv_style_set_border_color(&styles[UI_STYLE_POPUP], lv_color_hex(p->popup_border));
+    lv_style_set_border_width(&styles[UI_STYLE_POPUP], 3);
+    lv_style_set_radius(&styles[UI_STYLE_POPUP], 10);
+    lv_style_set_shadow_width(&styles[UI_STYLE_POPUP], 20);
+    lv_style_set_text_color(&styles[UI_STYLE_POPUP], lv_color_hex(p->text));
+
+    lv_style_set_bg_color(&styles[UI_STYLE_FIELD], lv_color_hex(p->field));
+    lv_style_set_border_color(&styles[UI_STYLE_FIELD], lv_color_hex(p->field_border));
+    lv_style_set_border_width(&styles[UI_STYLE_FIELD], 1);
+    lv_style_set_pad_all(&styles[UI_STYLE_FIELD], 5);
+    lv_style_set_line_color(&styles[UI_STYLE_SEPARATOR], lv_color_hex(p->field_border));
+    lv_style_set_line_width(&styles[UI_STYLE_SEPARATOR], 1);
+
+    lv_style_set_bg_color(&styles[UI_STYLE_BAR], lv_color_hex(p->bar));
+    lv_style_set_radius(&styles[UI_STYLE_BAR], LV_RADIUS_CIRCLE);
+    lv_style_set_bg_color(&styles[UI_STYLE_BAR_INDICATOR], lv_color_hex(p->bar_start));
+    lv_style_set_radius(&styles[UI_STYLE_BAR_INDICATOR], LV_RADIUS_CIRCLE);
+    lv_style_set_bg_grad_color(&styles[UI_STYLE_BAR_INDICATOR], lv_color_hex(p->bar_end));
+    lv_style_set_bg_grad_dir(&styles[UI_STYLE_BAR_INDICATOR], LV_GRAD_DIR_HOR);
+#if LV_DITHER_GRADIENT
+    // 8位色深下用有序抖动消除渐变色带
+    lv_style_set_bg_dither_mode(&styles[UI_STYLE_BAR_INDICATOR], LV_DITHER_ORDERED);
+#endif
+
+    for (int i = 0; i < VOLTAGE_LEVEL_MAX; i++) {
+        lv_style_set_text_color(&voltage_styles[i], lv_color_hex(p->voltage[i]));
+    }
+    for (int i = 0; i < UI_STATUS_MAX; i++) {
+        lv_style_set_text_color(&status_styles[i], lv_color_hex(p->status[i]));
+    }
+}
+
+void ui_theme_init(void)
+{
+    nvs_handle_t nvs_handle;
+    if (nvs_open(THEME_NVS_NAMESPACE, NVS_READONLY, &nvs_handle) == ESP_OK) {
+        uint8_t id;
+        if (nvs_get_u8(nvs_handle, THEME_NVS_KEY, &id) == ESP_OK && id < UI_THEME_MAX) {
+            current_theme = (ui_theme_id_t)id;
+        }
+        nvs_close(nvs_handle);
+    }
+
+    for (int i = 0; i < UI_STYLE_MAX; i++) {
+        lv_style_init(&styles[i]);
+    }
+    for (int i = 0; i < VOLTAGE_LEVEL_MAX; i++) {
+        lv_style_init(&voltage_styles[i]);
+    }
+    for (int i = 0; i < UI_STATUS_MAX; i++) {
+        lv_style_init(&status_styles[i]);
+    }
+    theme_fill(&palettes[current_theme]);
+    styles_ready = true;
+
+    ESP_LOGI(TAG, "使用主题: %s", palettes[current_theme].name);
+}
+
+lv_style_t *ui_theme_style(ui_style_id_t id)
+{
+    return &styles[id];
+}
+
+void ui_theme_apply(lv_obj_t *obj, ui_style_id_t id, lv_style_selector_t selector)
+{
+    lv_obj_add_style(obj, &styles[id], selector);
+}
+
+// 对象上同一组样式最多只有一个，变化时直接替换样式指针，只刷新文字颜色
+static void style_swap(lv_obj_t *obj, lv_style_t *set, uint32_t count, uint32_t idx)
+{
+    lv_style_t *want = &set[idx];
+    for (uint32_t i = 0; i < obj->style_cnt; i++) {
+        lv_style_t *cur = obj->styles[i].style;
+        if (cur >= set && cur < set + count) {
+            if (cur != want) {
+                obj->styles[i].style = want;
+                lv_obj_refresh_style(obj, LV_PART_MAIN, LV_STYLE_TEXT_COLOR);
+            }
+            return;
+        }
+    }
+    lv_obj_add_style(obj, want, LV_PART_MAIN);
+}
+
+void ui_theme_set_voltage(lv_obj_t *obj, int voltage_mv)
+{
+    style_swap(obj, voltage_styles, VOLTAGE_LEVEL_MAX, voltage_level(voltage_mv));
+}
+
+void ui_theme_set_status(lv_obj_t *obj, ui_status_t status)
+{
+    style_swap(obj, status_styles, UI_STATUS_MAX, status);
+}
+
+esp_err_t ui_theme_set(ui_theme_id_t id)
+{
+    if (id >= UI_THEME_MAX || !styles_ready) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (id == current_theme) {
+        return ESP_OK;
+    }
+
+    current_theme = id;
+    theme_fill(&palettes[id]);
+    // 样式对象不变，只需通知使用样式的对象重新读取一次
+    lv_obj_report_style_change(NULL);
+    ESP_LOGI(TAG, "切换主题: %s", palettes[id].name);
+
+    nvs_handle_t nvs_handle;
+    esp_err_t err = nvs_open(THEME_NVS_NAMESPACE, NVS_READWRITE, &nvs_handle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "打开NVS失败: %s", esp_err_to_name(err));
+        return err;
+    }
+    err = nvs_set_u8(nvs_handle, THEME_NVS_KEY, (uint8_t)id);
+    if (err == ESP_OK) {
+        err = nvs_commit(nvs_handle);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "保存主题失败: %s", esp_err_to_name(err));
+    }
+    nvs_close(nvs_handle);
+    return err;
+}
+
+ui_theme_id_t ui_theme_get(void)
+{
+    return current_theme;
+}
+
+const char *ui_theme_name(ui_theme_id_t id)
+{
+    return id < UI_THEME_MAX ? palettes[id].name : "";
+}
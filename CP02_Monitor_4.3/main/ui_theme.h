@@ -0,0 +1,94 @@
+/**
+ * @file     ui_theme.h
+ * @author   YPW
+ * @version  V1.0
+ * @date     2026-10-18
+ * @brief    UI Theme Module Header
+ *
+ * 界面主题。所有颜色集中在每个主题的调色板表中，界面控件使用同一组
+ * 共享的lv_style_t，不再给每个对象单独设置本地样式。切换主题时只改写
+ * 共享样式中的值，然后整体刷新一次，不需要逐个对象修改样式。
+ * 电压等级和状态颜色同样是共享样式，变化时只替换对象上的样式指针。
+ */
+
+#ifndef UI_THEME_H
+#define UI_THEME_H
+
+#include "esp_err.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    UI_THEME_LIGHT = 0,         // 浅色（默认）
+    UI_THEME_DARK,              // 深色
+    UI_THEME_HIGH_CONTRAST,     // 高对比度
+    UI_THEME_NIGHT,             // 夜间红色，减少夜间眩光
+    UI_THEME_MAX,
+} ui_theme_id_t;
+
+typedef enum {
+    UI_STYLE_SCREEN = 0,        // 屏幕背景
+    UI_STYLE_TITLE,             // 标题文字
+    UI_STYLE_TEXT,              // 普通文字
+    UI_STYLE_MUTED,             // 次要文字
+    UI_STYLE_BUTTON,            // 按钮
+    UI_STYLE_CARD,              // 功率条容器
+    UI_STYLE_POPUP,             // 详情面板
+    UI_STYLE_BAR,               // 功率条背景
+    UI_STYLE_BAR_INDICATOR,     // 功率条指示器（渐变）
+    UI_STYLE_BUTTON_SECONDARY,  // 次要按钮（返回）
+    UI_STYLE_BUTTON_OK,         // 确认按钮（保存）
+    UI_STYLE_FIELD,             // 设置项容器
+    UI_STYLE_SEPARATOR,         // 分隔线
+    UI_STYLE_MAX,
+} ui_style_id_t;
+
+typedef enum {
+    UI_STATUS_IDLE = 0,         // 尚未获取状态
+    UI_STATUS_OK,               // 正常
+    UI_STATUS_BLINK,            // 正常状态闪烁时的暗相
+    UI_STATUS_WARN,             // 获取IP中
+    UI_STATUS_ERROR,            // 断开或数据错误
+    UI_STATUS_MAX,
+} ui_status_t;
+
+/**
+ * @brief 初始化主题
+ *
+ * 从NVS读取上次使用的主题并创建共享样式，需要在NVS初始化之后、
+ * 创建界面之前调用。
+ */
+void ui_theme_init(void);
+
+// 获取共享样式
+lv_style_t *ui_theme_style(ui_style_id_t id);
+
+// 给对象加上共享样式
+void ui_theme_apply(lv_obj_t *obj, ui_style_id_t id, lv_style_selector_t selector);
+
+// 按电压设置文字颜色，电压等级不变时不做任何事
+void ui_theme_set_voltage(lv_obj_t *obj, int voltage_mv);
+
+// 按状态设置文字颜色，状态不变时不做任何事
+void ui_theme_set_status(lv_obj_t *obj, ui_status_t status);
+
+/**
+ * @brief 切换主题并保存到NVS
+ *
+ * 改写共享样式后刷新一次所有对象。
+ */
+esp_err_t ui_theme_set(ui_theme_id_t id);
+
+ui_theme_id_t ui_theme_get(void);
+
+// 主题名称，用于设置界面的下拉框
+const char *ui_theme_name(ui_theme_id_t id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UI_THEME_H */
@@ -8,12 +8,24 @@
 
 static const char *TAG = "LCD_PORT"; // Log tag for the LCD port
 
+#if LVGL_PORT_BOUNCE_SCANOUT && EXAMPLE_RGB_BOUNCE_BUFFER_SIZE == 0
+#error "Bounce buffer scanout needs the RGB bounce buffers"
+#endif
+
 // VSYNC event callback function
 IRAM_ATTR static bool rgb_lcd_on_vsync_event(esp_lcd_panel_handle_t panel, const esp_lcd_rgb_panel_event_data_t *edata, void *user_ctx)
 {
     return lvgl_port_notify_rgb_vsync();
 }
 
+#if LVGL_PORT_BOUNCE_SCANOUT
+// Bounce buffer empty callback, converts the next lines of the LVGL buffer to RGB565
+IRAM_ATTR static bool rgb_lcd_on_bounce_empty(esp_lcd_panel_handle_t panel, void *bounce_buf, int pos_px, int len_bytes, void *user_ctx)
+{
+    return lvgl_port_fill_bounce_buf(bounce_buf, pos_px, len_bytes);
+}
+#endif
+
 #if CONFIG_EXAMPLE_LCD_TOUCH_CONTROLLER_GT911
 /**
  * @brief I2C master initialization
@@ -95,7 +107,11 @@ esp_err_t waveshare_esp32_s3_rgb_lcd_init()
         },
         .data_width = EXAMPLE_RGB_DATA_WIDTH, // Data width for RGB
         .bits_per_pixel = EXAMPLE_RGB_BIT_PER_PIXEL, // Bits per pixel
+#if LVGL_PORT_BOUNCE_SCANOUT
+        .num_fbs = 0, // LVGL owns the buffers, the panel only uses the bounce buffers
+#else
         .num_fbs = LVGL_PORT_LCD_RGB_BUFFER_NUMS, // Number of frame buffers
+#endif
         .bounce_buffer_size_px = EXAMPLE_RGB_BOUNCE_BUFFER_SIZE, // Bounce buffer size in pixels
         .sram_trans_align = 4, // SRAM transaction alignment
         .psram_trans_align = 64, // PSRAM transaction alignment
@@ -123,7 +139,11 @@ esp_err_t waveshare_esp32_s3_rgb_lcd_init()
             EXAMPLE_LCD_IO_RGB_DATA15,
         },
         .flags = {
+#if LVGL_PORT_BOUNCE_SCANOUT
+            .no_fb = 1, // Pixels come from the bounce buffer callback
+#else
             .fb_in_psram = 1, // Use PSRAM for framebuffer
+#endif
         },
     };
 
@@ -171,7 +191,9 @@ esp_err_t waveshare_esp32_s3_rgb_lcd_init()
 
     // Register callbacks for RGB panel events
     esp_lcd_rgb_panel_event_callbacks_t cbs = {
-#if EXAMPLE_RGB_BOUNCE_BUFFER_SIZE > 0
+#if LVGL_PORT_BOUNCE_SCANOUT
+        .on_bounce_empty = rgb_lcd_on_bounce_empty, // Callback for filling the bounce buffer
+#elif EXAMPLE_RGB_BOUNCE_BUFFER_SIZE > 0
         .on_bounce_frame_finish = rgb_lcd_on_vsync_event, // Callback for bounce frame finish
 #else
         .on_vsync = rgb_lcd_on_vsync_event, // Callback for vertical sync
@@ -7,6 +7,7 @@
  */
 
 #include "wifi_manager.h"
+#include "app_config.h"
 #include "esp_log.h"
 #include "esp_system.h"
 #include "esp_wifi.h"
@@ -41,6 +42,74 @@ static wifi_status_t current_status = WIFI_STATUS_DISCONNECTED;
 #define WIFI_CONNECT_RETRY_MAX  5
 static int s_retry_num = 0;
 
+// 后台切换WiFi的状态
+typedef enum {
+    SWITCH_IDLE,
+    SWITCH_SCANNING,        // 保持原连接，先扫描确认新网络存在
+    SWITCH_CONNECTING,      // 已切换到新网络，连上后才保存
+    SWITCH_ROLLBACK,        // 新网络连接失败，正在连回原来的网络
+} wifi_switch_state_t;
+
+static bool wifi_started = false;
+static wifi_switch_state_t switch_state = SWITCH_IDLE;
+static wifi_user_config_t switch_target;        // 要切换到的网络
+static wifi_user_config_t switch_fallback;      // 切换前的网络
+
+static void wifi_apply_sta_config(const wifi_user_config_t *config)
+{
+    wifi_config_t wifi_config = {0};
+    strncpy((char*)wifi_config.sta.ssid, config->ssid, sizeof(wifi_config.sta.ssid) - 1);
+    strncpy((char*)wifi_config.sta.password, config->password, sizeof(wifi_config.sta.password) - 1);
+    
+    // 配置高级参数
+    wifi_config.sta.threshold.authmode = WIFI_AUTH_WPA2_PSK;
+    wifi_config.sta.pmf_cfg.capable = true;
+    wifi_config.sta.pmf_cfg.required = false;
+    
+    ESP_ERROR_CHECK(esp_wifi_set_config(WIFI_IF_STA, &wifi_config));
+}
+
+// 断开当前网络，改连switch_target，断开事件中按新配置重连
+static void wifi_switch_connect(void)
+{
+    ESP_LOGI(TAG, "切换到WiFi: %s", switch_target.ssid);
+    memcpy(&current_config, &switch_target, sizeof(current_config));
+    switch_state = SWITCH_CONNECTING;
+    
+    bool connected = WIFI_Connection;
+    wifi_apply_sta_config(&current_config);
+    s_retry_num = 0;
+    xEventGroupClearBits(wifi_event_group, WIFI_CONNECTED_BIT | WIFI_GOT_IP_BIT | WIFI_FAIL_BIT);
+    current_status = WIFI_STATUS_CONNECTING;
+    if (status_callback) status_callback(current_status);
+    
+    if (!wifi_started) {
+        wifi_started = true;
+        ESP_ERROR_CHECK(esp_wifi_start());
+    } else if (connected) {
+        esp_wifi_disconnect();
+    } else {
+        esp_wifi_connect();
+    }
+}
+
+// 新网络连接失败，连回原来的网络，返回false表示没有可以回退的网络
+static bool wifi_switch_rollback(void)
+{
+    if (switch_fallback.ssid[0] == '\0' ||
+        (strcmp(switch_fallback.ssid, switch_target.ssid) == 0 &&
+         strcmp(switch_fallback.password, switch_target.password) == 0)) {
+        return false;
+    }
+    ESP_LOGW(TAG, "连接 %s 失败，连回 %s", switch_target.ssid, switch_fallback.ssid);
+    memcpy(&current_config, &switch_fallback, sizeof(current_config));
+    switch_state = SWITCH_ROLLBACK;
+    wifi_apply_sta_config(&current_config);
+    s_retry_num = 0;
+    esp_wifi_connect();
+    return true;
+}
+
 // ESP-IDF事件处理函数
 static void event_handler(void* arg, esp_event_base_t event_base,
                           int32_t event_id, void* event_data)
@@ -71,9 +140,32 @@ static void event_handler(void* arg, esp_event_base_t event_base,
                     ESP_LOGI(TAG, "正在尝试重连...");
                 } else {
                     ESP_LOGI(TAG, "WiFi连接失败");
-                    xEventGroupSetBits(wifi_event_group, WIFI_FAIL_BIT);
                     current_status = WIFI_STATUS_CONNECT_FAILED;
                     if (status_callback) status_callback(current_status);
+                    if (switch_state == SWITCH_CONNECTING && wifi_switch_rollback()) {
+                        break;
+                    }
+                    switch_state = SWITCH_IDLE;
+                    xEventGroupSetBits(wifi_event_group, WIFI_FAIL_BIT);
+                }
+                break;
+                
+            case WIFI_EVENT_SCAN_DONE:
+                if (switch_state == SWITCH_SCANNING) {
+                    uint16_t found = 0;
+                    esp_wifi_scan_get_ap_num(&found);
+                    // 读取一条记录，同时释放扫描结果占用的内存
+                    wifi_ap_record_t record;
+                    uint16_t count = 1;
+                    esp_wifi_scan_get_ap_records(&count, &record);
+                    if (found == 0) {
+                        // 找不到新网络，保持原来的连接
+                        ESP_LOGW(TAG, "未找到WiFi %s，保持当前连接", switch_target.ssid);
+                        switch_state = SWITCH_IDLE;
+                        if (status_callback) status_callback(WIFI_STATUS_CONNECT_FAILED);
+                    } else {
+                        wifi_switch_connect();
+                    }
                 }
                 break;
                 
@@ -86,6 +178,12 @@ static void event_handler(void* arg, esp_event_base_t event_base,
             ESP_LOGI(TAG, "获取IP地址:" IPSTR, IP2STR(&event->ip_info.ip));
             s_retry_num = 0;
             WIFI_GotIP = true;
+            if (switch_state == SWITCH_CONNECTING) {
+                // 新网络连上之后才保存，下次开机直接连接
+                ESP_LOGI(TAG, "已切换到WiFi: %s", current_config.ssid);
+                wifi_manager_save_config(&current_config);
+            }
+            switch_state = SWITCH_IDLE;
             xEventGroupSetBits(wifi_event_group, WIFI_CONNECTED_BIT | WIFI_GOT_IP_BIT);
             current_status = WIFI_STATUS_GOT_IP;
             if (status_callback) status_callback(current_status);
@@ -93,6 +191,12 @@ static void event_handler(void* arg, esp_event_base_t event_base,
     }
 }
 
+static void wifi_config_changed(uint32_t changed, const app_config_t *config)
+{
+    (void)changed;
+    wifi_manager_switch(config->wifi_ssid, config->wifi_password);
+}
+
 // 初始化WiFi管理器
 esp_err_t wifi_manager_init(void)
 {
@@ -139,6 +243,9 @@ esp_err_t wifi_manager_init(void)
         current_config.auto_connect = false;
     }
     
+    // 设置页面修改WiFi后在后台切换
+    app_config_subscribe(APP_CONFIG_WIFI, wifi_config_changed);
+    
     // 如果配置为自动连接，则启动WiFi
     if (current_config.auto_connect && strlen(current_config.ssid) > 0) {
         wifi_manager_connect();
@@ -147,7 +254,7 @@ esp_err_t wifi_manager_init(void)
     return ESP_OK;
 }
 
-// 启动WiFi连接
+// 启动WiFi连接，不等待结果，连接结果通过状态回调通知
 esp_err_t wifi_manager_connect(void)
 {
     ESP_LOGI(TAG, "连接到WiFi: %s", current_config.ssid);
@@ -157,42 +264,59 @@ esp_err_t wifi_manager_connect(void)
         return ESP_ERR_INVALID_ARG;
     }
     
-    // 配置WiFi参数
-    wifi_config_t wifi_config = {0};
-    strncpy((char*)wifi_config.sta.ssid, current_config.ssid, sizeof(wifi_config.sta.ssid) - 1);
-    strncpy((char*)wifi_config.sta.password, current_config.password, sizeof(wifi_config.sta.password) - 1);
-    
-    // 配置高级参数
-    wifi_config.sta.threshold.authmode = WIFI_AUTH_WPA2_PSK;
-    wifi_config.sta.pmf_cfg.capable = true;
-    wifi_config.sta.pmf_cfg.required = false;
-    
     // 设置WiFi配置
-    ESP_ERROR_CHECK(esp_wifi_set_config(WIFI_IF_STA, &wifi_config));
+    wifi_apply_sta_config(&current_config);
     
     // 重置重试计数器
     s_retry_num = 0;
+    xEventGroupClearBits(wifi_event_group, WIFI_FAIL_BIT);
+    
+    // 启动WiFi，STA启动事件中开始连接；已经启动时直接连接
+    if (!wifi_started) {
+        wifi_started = true;
+        ESP_ERROR_CHECK(esp_wifi_start());
+    } else if (!WIFI_Connection) {
+        esp_wifi_connect();
+    }
     
-    // 启动WiFi
-    ESP_ERROR_CHECK(esp_wifi_start());
+    return ESP_OK;
+}
+
+// 后台切换到新的WiFi
+esp_err_t wifi_manager_switch(const char *ssid, const char *password)
+{
+    if (ssid == NULL || ssid[0] == '\0' || password == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (switch_state != SWITCH_IDLE) {
+        ESP_LOGW(TAG, "正在切换WiFi，忽略新的请求");
+        return ESP_ERR_INVALID_STATE;
+    }
     
-    // 等待连接或失败
-    EventBits_t bits = xEventGroupWaitBits(wifi_event_group,
-                                           WIFI_CONNECTED_BIT | WIFI_FAIL_BIT,
-                                           pdFALSE,
-                                           pdFALSE,
-                                           portMAX_DELAY);
+    memcpy(&switch_fallback, &current_config, sizeof(switch_fallback));
+    memcpy(&switch_target, &current_config, sizeof(switch_target));
+    strlcpy(switch_target.ssid, ssid, sizeof(switch_target.ssid));
+    strlcpy(switch_target.password, password, sizeof(switch_target.password));
+    switch_target.auto_connect = true;
     
-    // 检查连接结果
-    if (bits & WIFI_CONNECTED_BIT) {
-        ESP_LOGI(TAG, "已连接到WiFi网络: %s", current_config.ssid);
+    if (!wifi_manager_is_connected()) {
+        // 原来就没有连接，不需要保持
+        wifi_switch_connect();
         return ESP_OK;
-    } else if (bits & WIFI_FAIL_BIT) {
-        ESP_LOGI(TAG, "连接到WiFi网络失败: %s", current_config.ssid);
-        return ESP_FAIL;
     }
     
-    return ESP_OK;
+    // 保持原连接，先扫描确认新网络存在，结果在扫描完成事件中处理
+    wifi_scan_config_t scan_config = {
+        .ssid = (uint8_t *)switch_target.ssid,
+        .show_hidden = true,
+    };
+    switch_state = SWITCH_SCANNING;
+    esp_err_t err = esp_wifi_scan_start(&scan_config, false);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "扫描WiFi失败: %s", esp_err_to_name(err));
+        switch_state = SWITCH_IDLE;
+    }
+    return err;
 }
 
 // 断开WiFi连接
@@ -203,6 +327,8 @@ esp_err_t wifi_manager_disconnect(void)
     // 停止WiFi
     esp_err_t err = esp_wifi_stop();
     if (err == ESP_OK) {
+        wifi_started = false;
+        switch_state = SWITCH_IDLE;
         WIFI_Connection = false;
         WIFI_GotIP = false;
         current_status = WIFI_STATUS_DISCONNECTED;
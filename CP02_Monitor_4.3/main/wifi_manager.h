@@ -43,9 +43,13 @@ typedef enum {
 // 初始化WiFi管理器
 esp_err_t wifi_manager_init(void);
 
-// 启动WiFi连接
+// 启动WiFi连接，不等待结果，连接结果通过状态回调通知
 esp_err_t wifi_manager_connect(void);
 
+// 后台切换到新的WiFi：已连接时先扫描确认新网络存在，再断开原连接；
+// 新网络连上之后才保存，连接失败时连回原来的网络
+esp_err_t wifi_manager_switch(const char *ssid, const char *password);
+
 // 断开WiFi连接
 esp_err_t wifi_manager_disconnect(void);
 
@@ -0,0 +1,331 @@
+/**
+ * @file     bench_gauge_view.c
+ * @brief    五个仪表10Hz更新的绘制开销，和五个lv_arc对比
+ *
+ * 在800x480的direct mode显示器上打开仪表页面，按10Hz发布400次随机游走的
+ * 端口功率，LVGL时间按5ms步进，指示弧动画按页面的帧间隔（50ms）运行。
+ * 记录每次刷新的绘制耗时和像素数，并定期把局部刷新后的画面和整屏重绘比较，
+ * 两者必须逐像素相同。之后在另一个屏幕上用五个lv_arc加同样的文字、同样的
+ * 缓动显示同一串数据，作为对比。每种都再跑一遍隐藏全部文字的，只看圆弧
+ * 本身的开销。耗时只打印不检查。
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "host_test.h"
+#include "esp_timer.h"
+#include "gauge_view.h"
+#include "gauge_geom.h"
+#include "power_monitor.h"
+#include "font_manager.h"
+#include "ui_nav.h"
+#include "ui_theme.h"
+
+#define DISP_W          800
+#define DISP_H          480
+#define PORTS           5
+#define UPDATES         400
+#define UPDATE_MS       100     // 10Hz
+#define TICK_MS         5
+#define CHECK_EVERY     25      // 每隔多少次更新和整屏重绘比较一次
+
+const float MAX_PORT_WATTS = 140;
+
+static port_info_t ports[PORTS] = {
+    { .id = 0, .name = "A" }, { .id = 1, .name = "C1" }, { .id = 2, .name = "C2" },
+    { .id = 3, .name = "C3" }, { .id = 4, .name = "C4" },
+};
+static float total_power = 0;
+
+port_info_t *power_monitor_get_port_info(void)
+{
+    return ports;
+}
+
+float power_monitor_get_total_power(void)
+{
+    return total_power;
+}
+
+const lv_font_t *font_manager_get(uint16_t size)
+{
+    (void)size;
+    return &lv_font_montserrat_16;
+}
+
+static lv_color_t framebuffer[DISP_W * DISP_H];
+static lv_color_t partial[DISP_W * DISP_H];
+static lv_disp_drv_t disp_drv;
+
+// 刷新统计，monitor_cb在每次刷新结束时调用
+typedef struct {
+    uint32_t frames;
+    uint64_t px;
+    int64_t render_us;
+} bench_stats_t;
+
+static bench_stats_t stats;
+static bool refreshed = false;
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    (void)area;
+    (void)color_p;
+    lv_disp_flush_ready(drv);
+}
+
+static void monitor_cb(lv_disp_drv_t *drv, uint32_t time, uint32_t px)
+{
+    (void)drv;
+    (void)time;
+    stats.frames++;
+    stats.px += px;
+    refreshed = true;
+}
+
+static void display_init(void)
+{
+    static lv_disp_draw_buf_t draw_buf;
+
+    lv_disp_draw_buf_init(&draw_buf, framebuffer, NULL, DISP_W * DISP_H);
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = DISP_W;
+    disp_drv.ver_res = DISP_H;
+    disp_drv.draw_buf = &draw_buf;
+    disp_drv.direct_mode = 1;
+    disp_drv.flush_cb = flush_cb;
+    disp_drv.monitor_cb = monitor_cb;
+    lv_disp_t *disp = lv_disp_drv_register(&disp_drv);
+    lv_timer_set_period(disp->refr_timer, TICK_MS);
+}
+
+static uint32_t rng_state = 20261018;
+
+static uint32_t rng(void)
+{
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
+}
+
+// 功率随机游走，偶尔插拔
+static void ports_step(void)
+{
+    total_power = 0;
+    for (int i = 0; i < PORTS; i++) {
+        port_info_t *p = &ports[i];
+        if (rng() % 200 == 0) {
+            p->current = p->current > 0 ? 0 : 1000;
+        } else if (p->current > 0) {
+            int next = p->current + (int)(rng() % 401) - 200;
+            p->current = next < 50 ? 50 : next > 5000 ? 5000 : next;
+        }
+        p->voltage = p->current > 0 ? 20000 : 0;
+        p->power = p->current * p->voltage / 1000000.0f;
+        p->state = p->current > 0;
+        total_power += p->power;
+    }
+}
+
+static void ports_reset(void)
+{
+    rng_state = 20261018;
+    for (int i = 0; i < PORTS; i++) {
+        ports[i].current = 500 + i * 800;
+    }
+}
+
+// 推进一次数据更新的时间，只统计发生了刷新的定时器处理
+static void run_ms(uint32_t ms)
+{
+    for (uint32_t t = 0; t < ms; t += TICK_MS) {
+        lv_tick_inc(TICK_MS);
+        refreshed = false;
+        int64_t start = esp_timer_get_time();
+        lv_timer_handler();
+        if (refreshed) {
+            stats.render_us += esp_timer_get_time() - start;
+        }
+    }
+}
+
+// 局部刷新后的画面必须和整屏重绘相同
+static int full_redraw_mismatch(void)
+{
+    memcpy(partial, framebuffer, sizeof(partial));
+    bench_stats_t saved = stats;
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    stats = saved;
+
+    int mismatch = 0;
+    for (int i = 0; i < DISP_W * DISP_H; i++) {
+        mismatch += partial[i].full != framebuffer[i].full;
+    }
+    return mismatch;
+}
+
+// 隐藏屏幕上所有的文字，隐藏的控件改变内容时不会刷新
+static void labels_hide(lv_obj_t *obj)
+{
+    if (lv_obj_check_type(obj, &lv_label_class)) {
+        lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    }
+    for (uint32_t i = 0; i < lv_obj_get_child_cnt(obj); i++) {
+        labels_hide(lv_obj_get_child(obj, i));
+    }
+}
+
+// 按10Hz发布数据，返回这段时间的刷新统计
+static bench_stats_t run_updates(void (*publish)(void), bool compare, int *mismatch)
+{
+    memset(&stats, 0, sizeof(stats));
+    for (int i = 0; i < UPDATES; i++) {
+        ports_step();
+        publish();
+        run_ms(UPDATE_MS);
+        if (compare && i % CHECK_EVERY == 0) {
+            *mismatch += full_redraw_mismatch();
+        }
+    }
+    return stats;
+}
+
+static void print_stats(const char *name, const bench_stats_t *s)
+{
+    printf("%-16s %u frames, %.3f ms/frame, %.1fk px/frame\n", name, (unsigned)s->frames,
+           s->frames ? s->render_us / 1000.0 / s->frames : 0.0,
+           s->frames ? s->px / 1000.0 / s->frames : 0.0);
+}
+
+static void gauges_publish(void)
+{
+    ui_nav_publish(UI_NAV_TOPIC_POWER);
+}
+
+static void bench_gauges(bench_stats_t *result, bench_stats_t *arc_only)
+{
+    ports_reset();
+    ports_step();
+    CHECK_EQ_INT(gauge_view_open(), ESP_OK);
+    CHECK(gauge_view_is_open());
+    run_ms(1000);       // 打开页面的整屏绘制和初始动画不计入
+
+    int mismatch = 0;
+    *result = run_updates(gauges_publish, true, &mismatch);
+    labels_hide(lv_scr_act());
+    run_ms(1000);
+    *arc_only = run_updates(gauges_publish, true, &mismatch);
+    CHECK_EQ_INT(mismatch, 0);
+}
+
+// 对比用：五个lv_arc，文字和缓动与仪表页面相同
+typedef struct {
+    lv_obj_t *arc;
+    lv_obj_t *value_label;
+    lv_obj_t *info_label;
+    int shown;
+    int target;
+} arc_gauge_t;
+
+static arc_gauge_t arcs[PORTS];
+static const int display_order[PORTS] = {1, 2, 3, 4, 0};
+
+static void arc_anim_cb(lv_timer_t *timer)
+{
+    (void)timer;
+    for (int i = 0; i < PORTS; i++) {
+        arc_gauge_t *a = &arcs[i];
+        int delta = a->target - a->shown;
+        if (delta != 0) {
+            a->shown += delta > 0 ? (delta + 1) / 2 : (delta - 1) / 2;
+            lv_arc_set_value(a->arc, a->shown);
+        }
+    }
+}
+
+static void arc_update(void)
+{
+    char text[32];
+    for (int i = 0; i < PORTS; i++) {
+        arc_gauge_t *a = &arcs[i];
+        port_info_t *p = &ports[display_order[i]];
+        a->target = gauge_geom_step(p->power, MAX_PORT_WATTS);
+        snprintf(text, sizeof(text), "%.1fW", p->power);
+        if (strcmp(lv_label_get_text(a->value_label), text) != 0) {
+            lv_label_set_text(a->value_label, text);
+        }
+        snprintf(text, sizeof(text), "%.1fV  %.2fA", p->voltage / 1000.0f, p->current / 1000.0f);
+        if (strcmp(lv_label_get_text(a->info_label), text) != 0) {
+            lv_label_set_text(a->info_label, text);
+        }
+    }
+}
+
+static void bench_arcs(bench_stats_t *result, bench_stats_t *arc_only)
+{
+    const gauge_view_config_t cfg = GAUGE_VIEW_DEFAULT_CONFIG();
+    lv_obj_t *scr = lv_obj_create(NULL);
+    ui_theme_apply(scr, UI_STYLE_SCREEN, LV_PART_MAIN);
+    lv_coord_t gap = (DISP_W - PORTS * cfg.size) / (PORTS + 1);
+
+    for (int i = 0; i < PORTS; i++) {
+        arc_gauge_t *a = &arcs[i];
+        a->arc = lv_arc_create(scr);
+        lv_obj_set_size(a->arc, cfg.size, cfg.size);
+        lv_obj_set_pos(a->arc, gap + i * (cfg.size + gap), 110);
+        lv_arc_set_bg_angles(a->arc, cfg.start_deg, cfg.start_deg + cfg.sweep_deg);
+        lv_arc_set_rotation(a->arc, 0);
+        lv_arc_set_range(a->arc, 0, GAUGE_GEOM_STEPS);
+        lv_arc_set_value(a->arc, 0);
+        lv_obj_remove_style(a->arc, NULL, LV_PART_KNOB);
+        lv_obj_set_style_arc_width(a->arc, cfg.arc_width, LV_PART_MAIN);
+        lv_obj_set_style_arc_width(a->arc, cfg.arc_width, LV_PART_INDICATOR);
+        a->value_label = lv_label_create(a->arc);
+        lv_obj_set_style_text_font(a->value_label, &lv_font_montserrat_20, LV_PART_MAIN);
+        lv_label_set_text(a->value_label, "");
+        lv_obj_center(a->value_label);
+        a->info_label = lv_label_create(scr);
+        lv_obj_set_style_text_font(a->info_label, &lv_font_montserrat_16, LV_PART_MAIN);
+        lv_label_set_text(a->info_label, "");
+        lv_obj_align_to(a->info_label, a->arc, LV_ALIGN_OUT_BOTTOM_MID, 0, 40);
+        a->shown = a->target = 0;
+    }
+    lv_timer_create(arc_anim_cb, cfg.frame_ms, NULL);
+
+    ports_reset();
+    ports_step();
+    arc_update();
+    lv_scr_load(scr);
+    run_ms(1000);
+
+    *result = run_updates(arc_update, false, NULL);
+    labels_hide(scr);
+    run_ms(1000);
+    *arc_only = run_updates(arc_update, false, NULL);
+}
+
+int main(void)
+{
+    lv_init();
+    display_init();
+    ui_theme_init();
+    CHECK_EQ_INT(ui_nav_init(), ESP_OK);
+
+    bench_stats_t gauges, gauges_arc;
+    bench_stats_t stock, stock_arc;
+    bench_gauges(&gauges, &gauges_arc);
+    bench_arcs(&stock, &stock_arc);
+
+    printf("%d updates at %d Hz\n", UPDATES, 1000 / UPDATE_MS);
+    print_stats("gauges", &gauges);
+    print_stats("gauges arc-only", &gauges_arc);
+    print_stats("lv_arc", &stock);
+    print_stats("lv_arc arc-only", &stock_arc);
+
+    // 每次更新至少一帧；只有圆弧时每个动画帧最多刷新一次
+    CHECK(gauges.frames >= UPDATES);
+    CHECK(gauges_arc.frames <= UPDATES * UPDATE_MS / 50);
+    return HOST_TEST_RESULT();
+}
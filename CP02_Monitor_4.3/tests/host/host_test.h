@@ -0,0 +1,33 @@
+/**
+ * @file     host_test.h
+ * @brief    主机测试用的检查宏
+ */
+
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static int host_test_failures = 0;
+
+// 检查失败时打印位置并继续，main最后用HOST_TEST_RESULT()返回
+#define CHECK(cond) do {                                                        \
+        if (!(cond)) {                                                          \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+            host_test_failures++;                                               \
+        }                                                                       \
+    } while (0)
+
+#define CHECK_EQ_INT(a, b) do {                                                 \
+        long long _a = (long long)(a), _b = (long long)(b);                     \
+        if (_a != _b) {                                                         \
+            fprintf(stderr, "%s:%d: %s == %s failed (%lld != %lld)\n",           \
+                    __FILE__, __LINE__, #a, #b, _a, _b);                        \
+            host_test_failures++;                                               \
+        }                                                                       \
+    } while (0)
+
+#define HOST_TEST_RESULT() (host_test_failures == 0 ? (printf("OK\n"), 0) : (printf("%d failures\n", host_test_failures), 1))
+
+#endif /* HOST_TEST_H */
@@ -0,0 +1,33 @@
+/**
+ * @file     lv_conf.h
+ * @brief    主机测试用的LVGL配置
+ *
+ * 只打开被测模块用到的功能，没有列出的选项使用lv_conf_internal.h里的默认值。
+ */
+
+#ifndef LV_CONF_H
+#define LV_CONF_H
+
+#define LV_COLOR_DEPTH      16
+#define LV_MEM_CUSTOM       0
+#define LV_MEM_SIZE         (256U * 1024U)
+#ifndef LV_TICK_CUSTOM
+#define LV_TICK_CUSTOM      0
+#endif
+#define LV_USE_LOG          0
+#define LV_USE_FRAGMENT     1
+#define LV_USE_SNAPSHOT     1
+#define LV_USE_METER        1
+
+// 和sdkconfig一样打开遮挡剔除和刷新预算，预算用LVGL的时间计时
+#define LV_USE_OCCLUSION_CULLING        1
+#define LV_OCCLUSION_CULLING_MAX_RECTS  8
+#define LV_USE_REFR_BUDGET              1
+#define LV_REFR_BUDGET_MS               30
+
+#define LV_FONT_MONTSERRAT_12   1
+#define LV_FONT_MONTSERRAT_16   1
+#define LV_FONT_MONTSERRAT_20   1
+#define LV_FONT_MONTSERRAT_24   1
+
+#endif /* LV_CONF_H */
@@ -0,0 +1,11 @@
+/**
+ * @file     esp_attr.h
+ * @brief    主机测试用的段属性，全部为空
+ */
+
+#ifndef ESP_ATTR_H
+#define ESP_ATTR_H
+
+#define IRAM_ATTR
+
+#endif /* ESP_ATTR_H */
@@ -0,0 +1,19 @@
+/**
+ * @file     esp_heap_caps.h
+ * @brief    主机测试用的堆接口，全部映射到标准库
+ */
+
+#ifndef ESP_HEAP_CAPS_H
+#define ESP_HEAP_CAPS_H
+
+#include <stdlib.h>
+
+#define MALLOC_CAP_DEFAULT  (1 << 12)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_SPIRAM   (1 << 10)
+
+#define heap_caps_malloc(size, caps)        malloc(size)
+#define heap_caps_realloc(ptr, size, caps)  realloc((ptr), (size))
+#define heap_caps_free(ptr)                 free(ptr)
+
+#endif /* ESP_HEAP_CAPS_H */
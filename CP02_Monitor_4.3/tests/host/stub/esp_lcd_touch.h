@@ -0,0 +1,11 @@
+/**
+ * @file     esp_lcd_touch.h
+ * @brief    主机测试用的触摸句柄类型
+ */
+
+#ifndef ESP_LCD_TOUCH_H
+#define ESP_LCD_TOUCH_H
+
+typedef struct esp_lcd_touch_s *esp_lcd_touch_handle_t;
+
+#endif /* ESP_LCD_TOUCH_H */
@@ -0,0 +1,11 @@
+/**
+ * @file     esp_lcd_types.h
+ * @brief    主机测试用的LCD句柄类型
+ */
+
+#ifndef ESP_LCD_TYPES_H
+#define ESP_LCD_TYPES_H
+
+typedef struct esp_lcd_panel_t *esp_lcd_panel_handle_t;
+
+#endif /* ESP_LCD_TYPES_H */
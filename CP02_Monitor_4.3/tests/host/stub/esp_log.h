@@ -0,0 +1,20 @@
+/**
+ * @file     esp_log.h
+ * @brief    主机测试用的日志宏，警告和错误打印到stderr，其余丢弃
+ */
+
+#ifndef ESP_LOG_H
+#define ESP_LOG_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define ESP_LOGE(tag, fmt, ...) fprintf(stderr, "E %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) fprintf(stderr, "W %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...) do { if (0) printf("%s" fmt, tag, ##__VA_ARGS__); } while (0)
+#define ESP_LOGD(tag, fmt, ...) do { if (0) printf("%s" fmt, tag, ##__VA_ARGS__); } while (0)
+
+// 毫秒时间戳，用到它的测试自己实现
+uint32_t esp_log_timestamp(void);
+
+#endif /* ESP_LOG_H */
@@ -0,0 +1,4 @@
+/**
+ * @file     esp_system.h
+ * @brief    主机测试用的空头文件
+ */
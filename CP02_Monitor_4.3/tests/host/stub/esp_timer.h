@@ -0,0 +1,24 @@
+/**
+ * @file     esp_timer.h
+ * @brief    主机测试用的微秒时钟
+ */
+
+#ifndef ESP_TIMER_H
+#define ESP_TIMER_H
+
+#include <stdint.h>
+#include <time.h>
+
+#ifdef HOST_FAKE_TIMER
+// 时间由测试推进
+int64_t esp_timer_get_time(void);
+#else
+static inline int64_t esp_timer_get_time(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+#endif
+
+#endif /* ESP_TIMER_H */
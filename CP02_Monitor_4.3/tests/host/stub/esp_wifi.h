@@ -0,0 +1,14 @@
+/**
+ * @file     esp_wifi.h
+ * @brief    主机测试用的WiFi头文件，只有被测模块用到的错误码
+ */
+
+#ifndef ESP_WIFI_H
+#define ESP_WIFI_H
+
+#include "esp_err.h"
+
+#define ESP_ERR_WIFI_BASE           0x3000
+#define ESP_ERR_WIFI_NOT_CONNECT    (ESP_ERR_WIFI_BASE + 15)
+
+#endif /* ESP_WIFI_H */
@@ -0,0 +1,15 @@
+/**
+ * @file     FreeRTOS.h
+ * @brief    主机测试用的FreeRTOS定义，一个tick是1ms
+ */
+
+#ifndef FREERTOS_H
+#define FREERTOS_H
+
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+
+#define portTICK_PERIOD_MS  ((TickType_t)1)
+
+#endif /* FREERTOS_H */
@@ -0,0 +1,16 @@
+/**
+ * @file     task.h
+ * @brief    主机测试用的任务接口，延时直接返回
+ */
+
+#ifndef FREERTOS_TASK_H
+#define FREERTOS_TASK_H
+
+#include "freertos/FreeRTOS.h"
+
+static inline void vTaskDelay(TickType_t ticks)
+{
+    (void)ticks;
+}
+
+#endif /* FREERTOS_TASK_H */
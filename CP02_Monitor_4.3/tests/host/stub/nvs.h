@@ -0,0 +1,53 @@
+/**
+ * @file     nvs.h
+ * @brief    主机测试用的NVS，没有保存的数据，写入直接丢弃
+ */
+
+#ifndef NVS_H
+#define NVS_H
+
+#include <stdint.h>
+#include "esp_err.h"
+
+typedef uint32_t nvs_handle_t;
+
+typedef enum {
+    NVS_READONLY,
+    NVS_READWRITE,
+} nvs_open_mode_t;
+
+static inline esp_err_t nvs_open(const char *name, nvs_open_mode_t mode, nvs_handle_t *handle)
+{
+    (void)name;
+    *handle = 1;
+    return mode == NVS_READONLY ? ESP_ERR_NOT_FOUND : ESP_OK;
+}
+
+static inline esp_err_t nvs_get_u8(nvs_handle_t handle, const char *key, uint8_t *value)
+{
+    (void)handle;
+    (void)key;
+    (void)value;
+    return ESP_ERR_NOT_FOUND;
+}
+
+static inline esp_err_t nvs_set_u8(nvs_handle_t handle, const char *key, uint8_t value)
+{
+    (void)handle;
+    (void)key;
+    (void)value;
+    return ESP_OK;
+}
+
+static inline esp_err_t nvs_commit(nvs_handle_t handle)
+{
+    (void)handle;
+    return ESP_OK;
+}
+
+static inline void nvs_close(nvs_handle_t handle)
+{
+    (void)handle;
+}
+
+#endif /* NVS_H */
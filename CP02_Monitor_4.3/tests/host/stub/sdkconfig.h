@@ -0,0 +1,4 @@
+/**
+ * @file     sdkconfig.h
+ * @brief    主机测试用的空配置，可选功能全部关闭
+ */
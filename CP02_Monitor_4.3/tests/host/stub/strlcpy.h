@@ -0,0 +1,22 @@
+/**
+ * @file     strlcpy.h
+ * @brief    主机的C库没有strlcpy时用这个实现，ESP-IDF的newlib自带
+ */
+
+#ifndef STRLCPY_H
+#define STRLCPY_H
+
+#include <string.h>
+
+static inline size_t strlcpy(char *dst, const char *src, size_t size)
+{
+    size_t len = strlen(src);
+    if (size > 0) {
+        size_t n = len < size - 1 ? len : size - 1;
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    return len;
+}
+
+#endif /* STRLCPY_H */
@@ -0,0 +1,87 @@
+/**
+ * @file     test_gauge_geom.c
+ * @brief    扇形包围框必须包含新旧指示位置之间所有变化的像素
+ *
+ * 随机取两个指示位置，逐像素比较两个位置下的覆盖率，变化的像素必须落在
+ * gauge_geom_sector_area()返回的区域内，否则局部刷新会留下残影。
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "host_test.h"
+#include "gauge_geom.h"
+
+#define PAIRS   20000
+
+static uint32_t rng_state = 4242;
+
+static uint32_t rng(void)
+{
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
+}
+
+// 返回包围框之外变化的像素数
+static int sector_misses(const gauge_geom_t *geom, uint16_t a, uint16_t b)
+{
+    gauge_area_t area;
+    bool has_area = gauge_geom_sector_area(geom, a, b, &area);
+    int size = geom->cfg.size;
+    int misses = 0;
+
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            if (gauge_geom_lit(geom, x, y, a) == gauge_geom_lit(geom, x, y, b)) {
+                continue;
+            }
+            if (!has_area || x < area.x1 || x > area.x2 || y < area.y1 || y > area.y2) {
+                misses++;
+            }
+        }
+    }
+    return misses;
+}
+
+static void check_config(const gauge_geom_config_t *cfg)
+{
+    gauge_geom_t geom;
+    void *buf = malloc(gauge_geom_buf_size(cfg));
+    gauge_geom_init(&geom, cfg, buf);
+
+    // 满量程时整个圆环都亮，位置0时全暗
+    int lit = 0;
+    for (int y = 0; y < cfg->size; y++) {
+        for (int x = 0; x < cfg->size; x++) {
+            CHECK_EQ_INT(gauge_geom_lit(&geom, x, y, 0), 0);
+            lit += gauge_geom_lit(&geom, x, y, GAUGE_GEOM_STEPS) != 0;
+        }
+    }
+    CHECK(lit > 0);
+
+    int misses = 0;
+    for (uint16_t s = 0; s < GAUGE_GEOM_STEPS; s++) {
+        misses += sector_misses(&geom, s, s + 1);
+    }
+    for (int i = 0; i < PAIRS; i++) {
+        misses += sector_misses(&geom, rng() % (GAUGE_GEOM_STEPS + 1), rng() % (GAUGE_GEOM_STEPS + 1));
+    }
+    CHECK_EQ_INT(misses, 0);
+    free(buf);
+}
+
+int main(void)
+{
+    CHECK_EQ_INT(gauge_geom_step(-1.0f, 140.0f), 0);
+    CHECK_EQ_INT(gauge_geom_step(0.0f, 140.0f), 0);
+    CHECK_EQ_INT(gauge_geom_step(70.0f, 140.0f), GAUGE_GEOM_STEPS / 2);
+    CHECK_EQ_INT(gauge_geom_step(500.0f, 140.0f), GAUGE_GEOM_STEPS);
+    CHECK_EQ_INT(gauge_geom_step(10.0f, 0.0f), 0);
+
+    // 仪表页面的默认参数，以及跨过全部四个坐标轴方向的整圆
+    const gauge_geom_config_t view = { .size = 144, .r_outer = 70, .r_inner = 58, .start_deg = 135, .sweep_deg = 270 };
+    const gauge_geom_config_t full = { .size = 100, .r_outer = 48, .r_inner = 30, .start_deg = -90, .sweep_deg = 360 };
+    check_config(&view);
+    check_config(&full);
+    return HOST_TEST_RESULT();
+}
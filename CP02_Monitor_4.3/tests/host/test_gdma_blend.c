@@ -0,0 +1,351 @@
+/**
+ * @file     test_gdma_blend.c
+ * @brief    DMA填充和拷贝的拆分：对齐、模板行、等待和回退
+ *
+ * 用一个记录传输的模拟后端代替esp_async_memcpy。和真正的DMA一样，传输在
+ * wait()时才写入目标，提交后CPU再改写同一块内存、或者没有等待就读取的
+ * 错误都会在结果里出现。后端可以限制队列长度，也可以拒绝全部传输。
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "host_test.h"
+#include "gdma_blend.h"
+
+#define ALIGN           64
+#define STRIDE          200         // 像素
+#define ROWS            40
+#define MAX_TRANSFERS   4096
+#define SENTINEL        0xDEAD
+
+typedef struct {
+    void *dst;
+    const void *src;
+    size_t len;
+} transfer_t;
+
+typedef struct {
+    transfer_t queued[MAX_TRANSFERS];
+    size_t queued_count;
+    size_t capacity;                // 队列长度，满了之后copy返回false
+    bool reject_all;
+    const void *no_dma;             // DMA无法访问的缓冲区（比如flash中的图片）
+    size_t no_dma_len;
+    transfer_t log[MAX_TRANSFERS];  // 所有提交过的传输
+    size_t log_count;
+} mock_t;
+
+static bool mock_copy(void *user_ctx, void *dst, const void *src, size_t len)
+{
+    mock_t *m = (mock_t *)user_ctx;
+    if (m->reject_all || m->queued_count >= m->capacity) {
+        return false;
+    }
+    transfer_t t = {dst, src, len};
+    m->queued[m->queued_count++] = t;
+    if (m->log_count < MAX_TRANSFERS) {
+        m->log[m->log_count++] = t;
+    }
+    return true;
+}
+
+// 按提交顺序完成所有传输
+static void mock_wait(void *user_ctx)
+{
+    mock_t *m = (mock_t *)user_ctx;
+    for (size_t i = 0; i < m->queued_count; i++) {
+        memcpy(m->queued[i].dst, m->queued[i].src, m->queued[i].len);
+    }
+    m->queued_count = 0;
+}
+
+static bool mock_can_access(void *user_ctx, const void *ptr)
+{
+    mock_t *m = (mock_t *)user_ctx;
+    const uint8_t *p = (const uint8_t *)ptr;
+    const uint8_t *no = (const uint8_t *)m->no_dma;
+    return ptr != NULL && !(no != NULL && p >= no && p < no + m->no_dma_len);
+}
+
+static mock_t mock;
+static const gdma_blend_backend_t mock_backend = {
+    .copy = mock_copy,
+    .wait = mock_wait,
+    .can_access = mock_can_access,
+    .user_ctx = &mock,
+};
+
+static uint16_t fb[STRIDE * ROWS] __attribute__((aligned(ALIGN)));
+static uint16_t image[STRIDE * ROWS + ALIGN] __attribute__((aligned(ALIGN)));
+static uint16_t fill_row[STRIDE] __attribute__((aligned(ALIGN)));
+static uint16_t expected[STRIDE * ROWS];
+static gdma_blend_t gb;
+
+// 和lvgl_port.c相同的参数，模板行是一行的宽度
+static void setup(size_t capacity)
+{
+    memset(&mock, 0, sizeof(mock));
+    mock.capacity = capacity;
+    for (int i = 0; i < STRIDE * ROWS; i++) {
+        fb[i] = expected[i] = SENTINEL;
+    }
+    for (int i = 0; i < STRIDE * ROWS + ALIGN; i++) {
+        image[i] = (uint16_t)(i * 7 + 1);
+    }
+    const gdma_blend_config_t cfg = {
+        .backend = &mock_backend,
+        .align = ALIGN,
+        .min_span_bytes = 2 * ALIGN,
+        .min_pixels = 100,
+        .fill_row = fill_row,
+        .fill_row_px = STRIDE,
+    };
+    gdma_blend_init(&gb, &cfg);
+}
+
+static void expect_fill(int x, int y, int w, int h, uint16_t color)
+{
+    for (int r = y; r < y + h; r++) {
+        for (int c = x; c < x + w; c++) {
+            expected[r * STRIDE + c] = color;
+        }
+    }
+}
+
+static void expect_copy(int x, int y, int w, int h, const uint16_t *src, int src_stride)
+{
+    for (int r = 0; r < h; r++) {
+        for (int c = 0; c < w; c++) {
+            expected[(y + r) * STRIDE + x + c] = src[r * src_stride + c];
+        }
+    }
+}
+
+static int fb_mismatch(void)
+{
+    int n = 0;
+    for (int i = 0; i < STRIDE * ROWS; i++) {
+        n += fb[i] != expected[i];
+    }
+    return n;
+}
+
+// 每个传输都按ALIGN对齐、长度是ALIGN的整数倍，并且落在矩形的某一行之内
+static int bad_transfers(int x, int y, int w, int h)
+{
+    int bad = 0;
+    for (size_t i = 0; i < mock.log_count; i++) {
+        uintptr_t p = (uintptr_t)mock.log[i].dst;
+        uintptr_t off = (p - (uintptr_t)fb) / sizeof(uint16_t);
+        int r = (int)(off / STRIDE);
+        int c = (int)(off % STRIDE);
+        size_t px = mock.log[i].len / sizeof(uint16_t);
+        bad += (p % ALIGN) != 0 || (mock.log[i].len % ALIGN) != 0 || r < y || r >= y + h || c < x ||
+               c + (int)px > x + w;
+    }
+    return bad;
+}
+
+// 行首行尾由CPU立即写入，中间部分等到wait才写入
+static void test_fill_split(void)
+{
+    setup(MAX_TRANSFERS);
+    const int x = 3, y = 2, w = 150, h = 6;
+    CHECK(gdma_blend_fill16(&gb, fb + y * STRIDE + x, STRIDE, w, h, 0x1234));
+    CHECK_EQ_INT(mock.log_count, h);
+    CHECK_EQ_INT(bad_transfers(x, y, w, h), 0);
+
+    // 第一行在第一个64字节边界之前的像素已经写入，之后的还没有
+    int head = (int)((ALIGN - (uintptr_t)(fb + y * STRIDE + x) % ALIGN) % ALIGN / sizeof(uint16_t));
+    CHECK(head > 0);
+    CHECK_EQ_INT(fb[y * STRIDE + x], 0x1234);
+    CHECK_EQ_INT(fb[y * STRIDE + x + head - 1], 0x1234);
+    CHECK_EQ_INT(fb[y * STRIDE + x + head], SENTINEL);
+
+    const gdma_blend_stats_t *st = gdma_blend_get_stats(&gb);
+    CHECK_EQ_INT(st->dma_bytes + st->cpu_bytes, (uint64_t)w * h * sizeof(uint16_t));
+
+    gdma_blend_wait(&gb);
+    expect_fill(x, y, w, h, 0x1234);
+    CHECK_EQ_INT(fb_mismatch(), 0);
+}
+
+// 行太短时整行由CPU完成
+static void test_fill_short_rows(void)
+{
+    setup(MAX_TRANSFERS);
+    CHECK(gdma_blend_fill16(&gb, fb + 5 * STRIDE + 10, STRIDE, 40, 10, 0x0F0F));
+    CHECK_EQ_INT(mock.log_count, 0);
+    expect_fill(10, 5, 40, 10, 0x0F0F);
+    CHECK_EQ_INT(fb_mismatch(), 0);
+}
+
+// 同一种颜色复用模板行，不需要等待；换颜色时先等模板行上的传输完成
+static void test_fill_row_reuse(void)
+{
+    setup(MAX_TRANSFERS);
+    const gdma_blend_stats_t *st = gdma_blend_get_stats(&gb);
+    CHECK(gdma_blend_fill16(&gb, fb + 0 * STRIDE + 8, STRIDE, 180, 4, 0xAAAA));
+    CHECK(gdma_blend_fill16(&gb, fb + 10 * STRIDE + 8, STRIDE, 180, 4, 0xAAAA));
+    CHECK_EQ_INT(st->waits, 0);
+    CHECK_EQ_INT(mock.queued_count, 8);
+
+    CHECK(gdma_blend_fill16(&gb, fb + 20 * STRIDE + 8, STRIDE, 180, 4, 0x5555));
+    CHECK_EQ_INT(st->waits, 1);
+    CHECK_EQ_INT(mock.queued_count, 4);
+    CHECK_EQ_INT(fill_row[0], 0x5555);
+
+    gdma_blend_wait(&gb);
+    expect_fill(8, 0, 180, 4, 0xAAAA);
+    expect_fill(8, 10, 180, 4, 0xAAAA);
+    expect_fill(8, 20, 180, 4, 0x5555);
+    CHECK_EQ_INT(fb_mismatch(), 0);
+}
+
+// 只有和未完成的填充重叠时才等待，重叠的填充结果是后画的在上面
+static void test_wait_area(void)
+{
+    setup(MAX_TRANSFERS);
+    const gdma_blend_stats_t *st = gdma_blend_get_stats(&gb);
+    CHECK(gdma_blend_fill16(&gb, fb + 2 * STRIDE, STRIDE, 100, 10, 0x1111));
+
+    // 同样的行、不相交的列；以及不相交的行
+    gdma_blend_wait_area(&gb, fb + 2 * STRIDE + 120, STRIDE, 60, 10);
+    gdma_blend_wait_area(&gb, fb + 20 * STRIDE, STRIDE, 100, 5);
+    CHECK_EQ_INT(st->waits, 0);
+    CHECK(gdma_blend_fill16(&gb, fb + 2 * STRIDE + 120, STRIDE, 64, 10, 0x1111));
+    CHECK_EQ_INT(st->waits, 0);
+
+    // 行宽不同的缓冲区无法比较，按重叠处理
+    gdma_blend_wait_area(&gb, image, STRIDE / 2, 10, 10);
+    CHECK_EQ_INT(st->waits, 1);
+
+    CHECK(gdma_blend_fill16(&gb, fb + 2 * STRIDE, STRIDE, 100, 10, 0x1111));
+    CHECK(gdma_blend_fill16(&gb, fb + 6 * STRIDE + 40, STRIDE, 120, 2, 0x1111));
+    CHECK_EQ_INT(st->waits, 2);
+
+    gdma_blend_wait(&gb);
+    expect_fill(0, 2, 100, 10, 0x1111);
+    expect_fill(120, 2, 64, 10, 0x1111);
+    expect_fill(40, 6, 120, 2, 0x1111);
+    CHECK_EQ_INT(fb_mismatch(), 0);
+
+    // 颜色不同的重叠填充：后一个必须盖住前一个
+    setup(MAX_TRANSFERS);
+    CHECK(gdma_blend_fill16(&gb, fb + 4 * STRIDE + 4, STRIDE, 180, 20, 0x2222));
+    CHECK(gdma_blend_fill16(&gb, fb + 8 * STRIDE + 30, STRIDE, 100, 4, 0x3333));
+    gdma_blend_wait(&gb);
+    expect_fill(4, 4, 180, 20, 0x2222);
+    expect_fill(30, 8, 100, 4, 0x3333);
+    CHECK_EQ_INT(fb_mismatch(), 0);
+}
+
+// 行首尾相连的区域合并成一行：整屏填充按模板行长度分段，整屏拷贝只有一次传输
+static void test_merged_rows(void)
+{
+    setup(MAX_TRANSFERS);
+    CHECK(gdma_blend_fill16(&gb, fb, STRIDE, STRIDE, ROWS, 0x7777));
+    CHECK_EQ_INT(mock.log_count, (STRIDE * ROWS * 2 + STRIDE * 2 - 1) / (STRIDE * 2 / ALIGN * ALIGN));
+    gdma_blend_wait(&gb);
+    expect_fill(0, 0, STRIDE, ROWS, 0x7777);
+    CHECK_EQ_INT(fb_mismatch(), 0);
+
+    setup(MAX_TRANSFERS);
+    CHECK(gdma_blend_copy16(&gb, fb, STRIDE, image, STRIDE, STRIDE, ROWS));
+    CHECK_EQ_INT(mock.log_count, 1);
+    expect_copy(0, 0, STRIDE, ROWS, image, STRIDE);
+    CHECK_EQ_INT(fb_mismatch(), 0);
+}
+
+// 源和目标的对齐偏移相同时中间部分交给DMA，不同时整行由CPU拷贝；返回时拷贝已完成
+static void test_copy_alignment(void)
+{
+    // 源的行宽和目标除以ALIGN的余数相同，每一行的对齐偏移都一样
+    const int x = 5, y = 3, w = 150, h = 8, src_stride = STRIDE + ALIGN / 2;
+    const size_t dst_offset = (uintptr_t)(fb + y * STRIDE + x) % ALIGN / sizeof(uint16_t);
+    setup(MAX_TRANSFERS);
+    uint16_t *src = image + dst_offset;
+    CHECK(gdma_blend_copy16(&gb, fb + y * STRIDE + x, STRIDE, src, src_stride, w, h));
+    CHECK_EQ_INT(mock.log_count, h);
+    CHECK_EQ_INT(bad_transfers(x, y, w, h), 0);
+    CHECK_EQ_INT(mock.queued_count, 0);
+    expect_copy(x, y, w, h, src, src_stride);
+    CHECK_EQ_INT(fb_mismatch(), 0);
+
+    // 返回后改写源数据不影响结果
+    memset(image, 0, sizeof(image));
+    CHECK_EQ_INT(fb_mismatch(), 0);
+
+    setup(MAX_TRANSFERS);
+    src = image + dst_offset + 1;
+    CHECK(gdma_blend_copy16(&gb, fb + y * STRIDE + x, STRIDE, src, src_stride, w, h));
+    CHECK_EQ_INT(mock.log_count, 0);
+    CHECK_EQ_INT(gdma_blend_get_stats(&gb)->cpu_bytes, (uint64_t)w * h * sizeof(uint16_t));
+    expect_copy(x, y, w, h, src, src_stride);
+    CHECK_EQ_INT(fb_mismatch(), 0);
+}
+
+// 拷贝的源区域正在被填充写入时，先等填充完成
+static void test_copy_after_fill(void)
+{
+    setup(MAX_TRANSFERS);
+    CHECK(gdma_blend_fill16(&gb, fb, STRIDE, 180, 4, 0x4444));
+    CHECK(gdma_blend_copy16(&gb, fb + 20 * STRIDE, STRIDE, fb, STRIDE, 180, 4));
+    expect_fill(0, 0, 180, 4, 0x4444);
+    expect_fill(0, 20, 180, 4, 0x4444);
+    CHECK_EQ_INT(fb_mismatch(), 0);
+}
+
+// 队列满时等待后重试；后端一直拒绝时由CPU完成，结果相同
+static void test_rejected_transfers(void)
+{
+    setup(3);
+    const gdma_blend_stats_t *st = gdma_blend_get_stats(&gb);
+    CHECK(gdma_blend_fill16(&gb, fb + 1 * STRIDE + 2, STRIDE, 190, 10, 0x6666));
+    CHECK_EQ_INT(st->submits, 10);
+    CHECK(st->retries >= 3);
+    gdma_blend_wait(&gb);
+    expect_fill(2, 1, 190, 10, 0x6666);
+    CHECK_EQ_INT(fb_mismatch(), 0);
+
+    setup(MAX_TRANSFERS);
+    mock.reject_all = true;
+    CHECK(gdma_blend_fill16(&gb, fb + 1 * STRIDE + 2, STRIDE, 190, 10, 0x6666));
+    CHECK(gdma_blend_copy16(&gb, fb + 20 * STRIDE + 2, STRIDE, image + 2, STRIDE, 190, 10));
+    CHECK_EQ_INT(st->submits, 0);
+    CHECK_EQ_INT(st->retries, 20);
+    CHECK_EQ_INT(st->dma_bytes, 0);
+    CHECK_EQ_INT(st->cpu_bytes, 2 * 190 * 10 * sizeof(uint16_t));
+    gdma_blend_wait(&gb);
+    expect_fill(2, 1, 190, 10, 0x6666);
+    expect_copy(2, 20, 190, 10, image + 2, STRIDE);
+    CHECK_EQ_INT(fb_mismatch(), 0);
+}
+
+// 面积太小或者DMA不能访问的源，交回软件渲染
+static void test_handed_back(void)
+{
+    setup(MAX_TRANSFERS);
+    const gdma_blend_stats_t *st = gdma_blend_get_stats(&gb);
+    CHECK(!gdma_blend_fill16(&gb, fb, STRIDE, 9, 9, 0x1234));
+    mock.no_dma = image;
+    mock.no_dma_len = sizeof(image);
+    CHECK(!gdma_blend_copy16(&gb, fb, STRIDE, image, STRIDE, 180, 10));
+    CHECK_EQ_INT(st->rejected, 2);
+    CHECK_EQ_INT(fb_mismatch(), 0);
+}
+
+int main(void)
+{
+    test_fill_split();
+    test_fill_short_rows();
+    test_fill_row_reuse();
+    test_wait_area();
+    test_merged_rows();
+    test_copy_alignment();
+    test_copy_after_fill();
+    test_rejected_transfers();
+    test_handed_back();
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,243 @@
+/**
+ * @file     test_gesture.c
+ * @brief    手势识别：单击、双击、长按、滑动和fling、取消
+ *
+ * 轨迹按触摸轮询的10ms间隔合成，阈值使用Kconfig的默认值（和lvgl_port.c
+ * 一样只覆盖Kconfig提供的五项）。和lvgl_port.c中的调用方式相同，只在按下或
+ * gesture_is_tracking()时送入采样。
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "host_test.h"
+#include "gesture.h"
+
+#define SAMPLE_MS       10
+#define MAX_EVENTS      8
+
+// Kconfig.projbuild中EXAMPLE_GESTURE_*的默认值
+#define KCONFIG_TAP_SLOP_PX     15
+#define KCONFIG_DOUBLE_TAP_MS   350
+#define KCONFIG_LONG_PRESS_MS   600
+#define KCONFIG_SWIPE_MIN_PX    80
+#define KCONFIG_FLING_PX_S      800
+
+typedef struct {
+    int count;
+    gesture_event_t events[MAX_EVENTS];
+} recorder_t;
+
+static void record_cb(const gesture_event_t *event, void *user_data)
+{
+    recorder_t *rec = (recorder_t *)user_data;
+    if (rec->count < MAX_EVENTS) {
+        rec->events[rec->count] = *event;
+    }
+    rec->count++;
+}
+
+static gesture_t g;
+static recorder_t rec;
+static uint32_t now_ms;
+
+static void setup(void)
+{
+    gesture_config_t cfg = GESTURE_DEFAULT_CONFIG();
+    cfg.tap_slop_px = KCONFIG_TAP_SLOP_PX;
+    cfg.double_tap_gap_ms = KCONFIG_DOUBLE_TAP_MS;
+    cfg.long_press_ms = KCONFIG_LONG_PRESS_MS;
+    cfg.swipe_min_px = KCONFIG_SWIPE_MIN_PX;
+    cfg.fling_min_px_s = KCONFIG_FLING_PX_S;
+    memset(&rec, 0, sizeof(rec));
+    gesture_init(&g, &cfg, record_cb, &rec);
+    now_ms = 10000;
+}
+
+// 送入一个采样，和touchpad_read()一样空闲时不送
+static gesture_type_t feed(bool pressed, int x, int y)
+{
+    gesture_type_t type = GESTURE_NONE;
+    if (pressed || gesture_is_tracking(&g)) {
+        type = gesture_feed(&g, pressed, (int16_t)x, (int16_t)y, now_ms);
+    }
+    now_ms += SAMPLE_MS;
+    return type;
+}
+
+// 在(x, y)按住ms毫秒后抬起，返回这期间识别出的手势数
+static int press_at(int x, int y, uint32_t ms)
+{
+    int before = rec.count;
+    for (uint32_t t = 0; t < ms; t += SAMPLE_MS) {
+        feed(true, x, y);
+    }
+    feed(false, x, y);
+    return rec.count - before;
+}
+
+// 空闲ms毫秒
+static void idle(uint32_t ms)
+{
+    for (uint32_t t = 0; t < ms; t += SAMPLE_MS) {
+        feed(false, 0, 0);
+    }
+}
+
+// 从(x, y)以每个采样(step_x, step_y)的速度移动steps个采样后抬起，返回抬起时识别出的手势
+static gesture_type_t drag(int x, int y, int step_x, int step_y, int steps)
+{
+    for (int i = 0; i <= steps; i++) {
+        feed(true, x + i * step_x, y + i * step_y);
+    }
+    return feed(false, x + steps * step_x, y + steps * step_y);
+}
+
+// 单击在双击窗口结束后才发出，窗口内什么都没有
+static void test_tap(void)
+{
+    setup();
+    CHECK_EQ_INT(press_at(200, 200, 80), 0);
+    CHECK(gesture_is_tracking(&g));
+    idle(KCONFIG_DOUBLE_TAP_MS - 20);
+    CHECK_EQ_INT(rec.count, 0);
+    idle(40);
+    CHECK_EQ_INT(rec.count, 1);
+    CHECK_EQ_INT(rec.events[0].type, GESTURE_TAP);
+    CHECK_EQ_INT(rec.events[0].x, 200);
+    CHECK(!gesture_is_tracking(&g));
+}
+
+// 双击只发出一次GESTURE_DOUBLE_TAP；间隔太长或者位置太远是两次单击
+static void test_double_tap(void)
+{
+    setup();
+    press_at(300, 200, 60);
+    idle(150);
+    CHECK_EQ_INT(press_at(305, 204, 60), 1);
+    idle(KCONFIG_DOUBLE_TAP_MS * 2);
+    CHECK_EQ_INT(rec.count, 1);
+    CHECK_EQ_INT(rec.events[0].type, GESTURE_DOUBLE_TAP);
+
+    setup();
+    press_at(300, 200, 60);
+    idle(KCONFIG_DOUBLE_TAP_MS + 50);
+    press_at(300, 200, 60);
+    idle(KCONFIG_DOUBLE_TAP_MS + 50);
+    CHECK_EQ_INT(rec.count, 2);
+    CHECK_EQ_INT(rec.events[0].type, GESTURE_TAP);
+    CHECK_EQ_INT(rec.events[1].type, GESTURE_TAP);
+
+    setup();
+    press_at(100, 200, 60);
+    idle(100);
+    press_at(400, 200, 60);
+    idle(KCONFIG_DOUBLE_TAP_MS + 50);
+    CHECK_EQ_INT(rec.count, 2);
+    CHECK_EQ_INT(rec.events[0].type, GESTURE_TAP);
+    CHECK_EQ_INT(rec.events[1].x, 400);
+}
+
+// 长按在按住期间达到阈值时发出，抬起后不再有别的手势；抖动在tap_slop内不影响
+static void test_long_press(void)
+{
+    setup();
+    int fired_at = -1;
+    for (int t = 0; t < KCONFIG_LONG_PRESS_MS + 200; t += SAMPLE_MS) {
+        int wobble = (t / SAMPLE_MS) % 3 - 1;
+        if (feed(true, 500 + wobble * 5, 300 - wobble * 5) == GESTURE_LONG_PRESS) {
+            fired_at = t;
+        }
+    }
+    CHECK_EQ_INT(fired_at, KCONFIG_LONG_PRESS_MS);
+    feed(false, 500, 300);
+    idle(KCONFIG_DOUBLE_TAP_MS * 2);
+    CHECK_EQ_INT(rec.count, 1);
+    CHECK_EQ_INT(rec.events[0].type, GESTURE_LONG_PRESS);
+
+    // 移出tap_slop后不会成为长按
+    setup();
+    for (int t = 0; t < KCONFIG_LONG_PRESS_MS + 200; t += SAMPLE_MS) {
+        feed(true, 500 + (t > 100 ? KCONFIG_TAP_SLOP_PX + 5 : 0), 300);
+    }
+    feed(false, 520, 300);
+    idle(KCONFIG_DOUBLE_TAP_MS * 2);
+    CHECK_EQ_INT(rec.count, 0);
+}
+
+// 慢速滑动需要swipe_min_px；超过fling速度时一半距离就够
+static void test_swipe_and_fling(void)
+{
+    // 400px/s，刚好swipe_min_px：普通滑动
+    setup();
+    CHECK_EQ_INT(drag(400, 240, -4, 0, KCONFIG_SWIPE_MIN_PX / 4), GESTURE_SWIPE_LEFT);
+    CHECK_EQ_INT(rec.count, 1);
+    CHECK(!rec.events[0].fling);
+    CHECK_EQ_INT(rec.events[0].dx, -KCONFIG_SWIPE_MIN_PX);
+
+    // 同样的速度少走一点：不是滑动
+    setup();
+    CHECK_EQ_INT(drag(400, 240, -4, 0, KCONFIG_SWIPE_MIN_PX / 4 - 2), GESTURE_NONE);
+    idle(KCONFIG_DOUBLE_TAP_MS * 2);
+    CHECK_EQ_INT(rec.count, 0);
+
+    // 1000px/s，只走swipe_min_px的一半多一点：fling
+    setup();
+    CHECK_EQ_INT(drag(400, 100, 0, 10, KCONFIG_SWIPE_MIN_PX / 20 + 1), GESTURE_SWIPE_DOWN);
+    CHECK_EQ_INT(rec.count, 1);
+    CHECK(rec.events[0].fling);
+    CHECK(rec.events[0].velocity_px_s >= KCONFIG_FLING_PX_S);
+
+    // 速度在fling阈值以下（600px/s），同样的距离不算滑动
+    setup();
+    CHECK_EQ_INT(drag(400, 100, 0, 6, KCONFIG_SWIPE_MIN_PX / 12 + 1), GESTURE_NONE);
+    CHECK_EQ_INT(rec.count, 0);
+
+    // 滑动之前的单击先发出，不等双击窗口
+    setup();
+    press_at(100, 100, 50);
+    idle(50);
+    CHECK_EQ_INT(drag(600, 300, 0, -5, 20), GESTURE_SWIPE_UP);
+    CHECK_EQ_INT(rec.count, 2);
+    CHECK_EQ_INT(rec.events[0].type, GESTURE_TAP);
+    CHECK_EQ_INT(rec.events[1].type, GESTURE_SWIPE_UP);
+}
+
+// 按下期间取消：手指抬起之前的采样和抬起本身都不产生手势，之后的单击正常
+static void test_cancel(void)
+{
+    setup();
+    for (int i = 0; i < 10; i++) {
+        feed(true, 300, 300);
+    }
+    gesture_cancel(&g);
+    CHECK(gesture_is_tracking(&g));
+    for (int i = 0; i < 10; i++) {
+        feed(true, 300, 300);
+    }
+    feed(false, 300, 300);
+    CHECK(!gesture_is_tracking(&g));
+    idle(KCONFIG_DOUBLE_TAP_MS * 2);
+    CHECK_EQ_INT(rec.count, 0);
+
+    // 取消也丢掉等待中的单击
+    press_at(300, 300, 50);
+    gesture_cancel(&g);
+    idle(KCONFIG_DOUBLE_TAP_MS * 2);
+    CHECK_EQ_INT(rec.count, 0);
+
+    press_at(300, 300, 50);
+    idle(KCONFIG_DOUBLE_TAP_MS * 2);
+    CHECK_EQ_INT(rec.count, 1);
+    CHECK_EQ_INT(rec.events[0].type, GESTURE_TAP);
+}
+
+int main(void)
+{
+    test_tap();
+    test_double_tap();
+    test_long_press();
+    test_swipe_and_fling();
+    test_cancel();
+    return HOST_TEST_RESULT();
+}
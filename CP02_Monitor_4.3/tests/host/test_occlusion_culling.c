@@ -0,0 +1,148 @@
+/**
+ * @file     test_occlusion_culling.c
+ * @brief    被不透明子控件遮住的背景不绘制：画面不变，绘制事件每次刷新只发一次
+ *
+ * 在800x480的显示器上搭一个和仪表页面相似的布局：屏幕背景上一张卡片，卡片里
+ * 六个不透明的进度条，每个进度条上有文字。整屏重绘一次，打印被跳过的背景像素
+ * 比例。再给所有父控件加上空的绘制事件回调（这样它们不再被剔除），重绘同一个
+ * 画面作为参照，两者必须逐像素相同。最后检查有绘制回调的控件在一次刷新中
+ * DRAW_MAIN_BEGIN/MAIN/END各收到一次。
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "host_test.h"
+#include "lvgl.h"
+
+#define DISP_W      800
+#define DISP_H      480
+#define BARS        6
+
+static lv_color_t framebuffer[DISP_W * DISP_H];
+static lv_color_t culled[DISP_W * DISP_H];
+static lv_disp_drv_t disp_drv;
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    (void)area;
+    (void)color_p;
+    lv_disp_flush_ready(drv);
+}
+
+static void display_init(void)
+{
+    static lv_disp_draw_buf_t draw_buf;
+
+    lv_disp_draw_buf_init(&draw_buf, framebuffer, NULL, DISP_W * DISP_H);
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = DISP_W;
+    disp_drv.ver_res = DISP_H;
+    disp_drv.draw_buf = &draw_buf;
+    disp_drv.direct_mode = 1;
+    disp_drv.flush_cb = flush_cb;
+    lv_disp_drv_register(&disp_drv);
+}
+
+static lv_obj_t *card;
+static lv_obj_t *bars[BARS];
+
+// 仪表页面的布局：卡片里两列进度条，进度条不透明、带圆角
+static void dashboard_create(void)
+{
+    lv_obj_t *scr = lv_scr_act();
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x101418), 0);
+
+    card = lv_obj_create(scr);
+    lv_obj_set_size(card, 760, 400);
+    lv_obj_align(card, LV_ALIGN_BOTTOM_MID, 0, -20);
+    lv_obj_set_style_bg_color(card, lv_color_hex(0x1e2630), 0);
+    lv_obj_set_style_radius(card, 12, 0);
+    lv_obj_set_style_pad_all(card, 0, 0);
+    lv_obj_clear_flag(card, LV_OBJ_FLAG_SCROLLABLE);
+
+    for (int i = 0; i < BARS; i++) {
+        bars[i] = lv_bar_create(card);
+        lv_obj_set_size(bars[i], 360, 110);
+        lv_obj_set_pos(bars[i], 12 + (i % 2) * 376, 15 + (i / 2) * 125);
+        lv_obj_set_style_radius(bars[i], 8, LV_PART_MAIN);
+        lv_obj_set_style_bg_opa(bars[i], LV_OPA_COVER, LV_PART_MAIN);
+        lv_obj_set_style_bg_color(bars[i], lv_color_hex(0x2c3a48), LV_PART_MAIN);
+        lv_bar_set_value(bars[i], 15 + i * 14, LV_ANIM_OFF);
+
+        lv_obj_t *label = lv_label_create(bars[i]);
+        lv_label_set_text_fmt(label, "C%d  %d.%d W", i + 1, 3 + i * 7, i);
+        lv_obj_center(label);
+    }
+}
+
+static void redraw(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+static void noop_cb(lv_event_t *e)
+{
+    (void)e;
+}
+
+// 每种绘制事件收到的次数
+static int draw_events[3];
+
+static void count_cb(lv_event_t *e)
+{
+    lv_event_code_t code = lv_event_get_code(e);
+    if (code >= LV_EVENT_DRAW_MAIN_BEGIN && code <= LV_EVENT_DRAW_MAIN_END) {
+        draw_events[code - LV_EVENT_DRAW_MAIN_BEGIN]++;
+    }
+}
+
+int main(void)
+{
+    lv_init();
+    display_init();
+    dashboard_create();
+
+    // 剔除后的画面
+    lv_refr_reset_occlusion_stats();
+    redraw();
+    uint32_t drawn_px, culled_px;
+    lv_refr_get_occlusion_stats(&drawn_px, &culled_px);
+    memcpy(culled, framebuffer, sizeof(culled));
+    printf("occlusion culling: %u px drawn, %u px culled (%.1f%% of the main parts skipped)\n",
+           (unsigned)drawn_px, (unsigned)culled_px, 100.0 * culled_px / (drawn_px + culled_px));
+    CHECK(culled_px > 0);
+
+    // 父控件有绘制回调时不剔除，作为参照画面
+    lv_obj_add_event_cb(lv_scr_act(), noop_cb, LV_EVENT_DRAW_MAIN, NULL);
+    lv_obj_add_event_cb(card, noop_cb, LV_EVENT_DRAW_MAIN, NULL);
+    memset(framebuffer, 0, sizeof(framebuffer));
+    lv_refr_reset_occlusion_stats();
+    redraw();
+    lv_refr_get_occlusion_stats(NULL, &culled_px);
+    CHECK_EQ_INT(culled_px, 0);
+
+    int mismatch = 0;
+    for (int i = 0; i < DISP_W * DISP_H; i++) {
+        mismatch += culled[i].full != framebuffer[i].full;
+    }
+    CHECK_EQ_INT(mismatch, 0);
+
+    // 有绘制回调的卡片被六个进度条遮住大半，事件仍然各发一次
+    lv_obj_remove_event_cb(lv_scr_act(), noop_cb);
+    lv_obj_remove_event_cb(card, noop_cb);
+    lv_obj_add_event_cb(card, count_cb, LV_EVENT_ALL, NULL);
+    redraw();
+    CHECK_EQ_INT(draw_events[0], 1);
+    CHECK_EQ_INT(draw_events[1], 1);
+    CHECK_EQ_INT(draw_events[2], 1);
+
+    // 屏幕本身没有回调，仍然被剔除
+    lv_refr_reset_occlusion_stats();
+    redraw();
+    lv_refr_get_occlusion_stats(NULL, &culled_px);
+    CHECK(culled_px > 0);
+
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,157 @@
+/**
+ * @file     test_panel_rotate.c
+ * @brief    bounce buffer旋转填充与panel_rotate_copy()逐像素比较
+ *
+ * 随机的800x480帧先用panel_rotate_copy()整帧旋转得到参考图像，再按不同的
+ * bounce buffer高度逐块填充，两者必须完全相同。8-bpp时参考图像由LUT展开
+ * 后的16-bpp帧旋转得到。
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "host_test.h"
+#include "panel_rotate.h"
+
+#define PANEL_W     800
+#define PANEL_H     480
+#define PANEL_PX    (PANEL_W * PANEL_H)
+
+static uint16_t src16[PANEL_PX];
+static uint8_t src8[PANEL_PX];
+static uint16_t expanded[PANEL_PX];
+static uint16_t reference[PANEL_PX];
+static uint16_t filled[PANEL_PX];
+static uint16_t lut[256];
+
+static uint32_t rng_state = 12345;
+
+static uint32_t rng(void)
+{
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
+}
+
+// 与lvgl_port.c中的l8_lut_init()相同的RGB332展开
+static void lut_init(void)
+{
+    for (int i = 0; i < 256; i++) {
+        uint32_t r = (i >> 5) & 0x7;
+        uint32_t g = (i >> 2) & 0x7;
+        uint32_t b = i & 0x3;
+        lut[i] = ((r * 31 + 3) / 7) << 11 | ((g * 63 + 3) / 7) << 5 | ((b * 31 + 1) / 3);
+    }
+}
+
+// LVGL缓冲的尺寸：90/270度时为480x800
+static void lvgl_size(uint16_t rotation, int *w, int *h)
+{
+    bool swap = rotation == 90 || rotation == 270;
+    *w = swap ? PANEL_H : PANEL_W;
+    *h = swap ? PANEL_W : PANEL_H;
+}
+
+static int count_mismatch(void)
+{
+    int n = 0;
+    for (int i = 0; i < PANEL_PX; i++) {
+        n += reference[i] != filled[i];
+    }
+    return n;
+}
+
+static void check_rotation(uint16_t rotation, int bounce_lines)
+{
+    int w, h;
+    lvgl_size(rotation, &w, &h);
+
+    // 16-bpp
+    memset(reference, 0, sizeof(reference));
+    panel_rotate_copy(src16, reference, 0, 0, w - 1, h - 1, w, h, rotation);
+    memset(filled, 0, sizeof(filled));
+    for (int y = 0; y < PANEL_H; y += bounce_lines) {
+        panel_rotate_fill_16(src16, filled + y * PANEL_W, y, bounce_lines, w, h, PANEL_W, rotation);
+    }
+    int mismatch16 = count_mismatch();
+
+    // 8-bpp
+    for (int i = 0; i < PANEL_PX; i++) {
+        expanded[i] = lut[src8[i]];
+    }
+    memset(reference, 0, sizeof(reference));
+    panel_rotate_copy(expanded, reference, 0, 0, w - 1, h - 1, w, h, rotation);
+    memset(filled, 0, sizeof(filled));
+    for (int y = 0; y < PANEL_H; y += bounce_lines) {
+        panel_rotate_fill_8(src8, filled + y * PANEL_W, y, bounce_lines, w, h, PANEL_W, rotation, lut);
+    }
+    int mismatch8 = count_mismatch();
+
+    printf("rotation %3u, %2d-line bounce: %d / %d mismatching pixels (16 / 8 bpp)\n",
+           rotation, bounce_lines, mismatch16, mismatch8);
+    CHECK_EQ_INT(mismatch16, 0);
+    CHECK_EQ_INT(mismatch8, 0);
+}
+
+// 部分区域的复制只改写旋转后的目标区域
+static void check_partial_copy(uint16_t rotation)
+{
+    int w, h;
+    lvgl_size(rotation, &w, &h);
+
+    memset(reference, 0, sizeof(reference));
+    panel_rotate_copy(src16, reference, 0, 0, w - 1, h - 1, w, h, rotation);
+    memset(filled, 0, sizeof(filled));
+    // 四块拼出整帧
+    panel_rotate_copy(src16, filled, 0, 0, w / 2 - 1, h / 2 - 1, w, h, rotation);
+    panel_rotate_copy(src16, filled, w / 2, 0, w - 1, h / 2 - 1, w, h, rotation);
+    panel_rotate_copy(src16, filled, 0, h / 2, w / 2 - 1, h - 1, w, h, rotation);
+    panel_rotate_copy(src16, filled, w / 2, h / 2, w - 1, h - 1, w, h, rotation);
+    CHECK_EQ_INT(count_mismatch(), 0);
+}
+
+// 已知像素的位置：LVGL左上角在各旋转角度下落到面板的哪个角
+static void check_corners(void)
+{
+    static const struct {
+        uint16_t rotation;
+        int x, y;
+    } corners[] = {
+        {90, 0, PANEL_H - 1},
+        {180, PANEL_W - 1, PANEL_H - 1},
+        {270, PANEL_W - 1, 0},
+    };
+
+    for (size_t i = 0; i < sizeof(corners) / sizeof(corners[0]); i++) {
+        int w, h;
+        lvgl_size(corners[i].rotation, &w, &h);
+        memset(src16, 0, sizeof(src16));
+        src16[0] = 0xF800;
+        memset(filled, 0, sizeof(filled));
+        for (int y = 0; y < PANEL_H; y += 16) {
+            panel_rotate_fill_16(src16, filled + y * PANEL_W, y, 16, w, h, PANEL_W, corners[i].rotation);
+        }
+        CHECK_EQ_INT(filled[corners[i].y * PANEL_W + corners[i].x], 0xF800);
+    }
+}
+
+int main(void)
+{
+    static const uint16_t rotations[] = {90, 180, 270};
+    static const int bounce_lines[] = {10, 16, 32};
+
+    lut_init();
+    for (int i = 0; i < PANEL_PX; i++) {
+        src16[i] = (uint16_t)rng();
+        src8[i] = (uint8_t)rng();
+    }
+
+    for (size_t r = 0; r < sizeof(rotations) / sizeof(rotations[0]); r++) {
+        for (size_t b = 0; b < sizeof(bounce_lines) / sizeof(bounce_lines[0]); b++) {
+            check_rotation(rotations[r], bounce_lines[b]);
+        }
+        check_partial_copy(rotations[r]);
+    }
+    check_corners();
+
+    return HOST_TEST_RESULT();
+}
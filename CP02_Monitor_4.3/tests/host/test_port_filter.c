@@ -0,0 +1,137 @@
+/**
+ * @file     test_port_filter.c
+ * @brief    端口显示过滤：协议变化，以及合成的一小时数据回放
+ *
+ * 回放traces/desk_session.txt（由同目录的gen_desk_session.py生成），统计三种
+ * 做法下端口行的重绘次数：每次采样都重绘、原始读数的文字变化时重绘、经过
+ * port_filter之后的重绘。同时统计显示功率和原始功率的平均误差。数据是合成
+ * 的，打印的数字只说明过滤在这个模型上的效果，不代表设备上实测的结果。
+ *
+ *   test_port_filter [trace]
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "host_test.h"
+#include "port_filter.h"
+
+#define PORTS           5
+#define DEFAULT_TRACE   "traces/desk_session.txt"
+
+// 与power_monitor_update_ui()中端口行的文字格式相同，协议用编号代替名称
+static void row_text(char *buf, size_t len, int mv, int ma, int protocol)
+{
+    float power = mv * (float)ma / 1000000.0f;
+    snprintf(buf, len, "%.1fV  %.1fA  %.2fW %d", mv / 1000.0f, ma / 1000.0f, power, protocol);
+}
+
+// 读数不动时只有协议变化也要更新显示，关闭状态下不更新
+static void test_protocol(void)
+{
+    const port_filter_config_t cfg = PORT_FILTER_DEFAULT_CONFIG();
+    port_filter_t filter;
+    port_filter_reset(&filter);
+
+    CHECK_EQ_INT(port_filter_update(&filter, &cfg, 9000, 2000, 16), PORT_FILTER_VALUE | PORT_FILTER_STATE);
+    CHECK_EQ_INT(filter.shown_protocol, 16);
+    CHECK_EQ_INT(port_filter_update(&filter, &cfg, 9005, 2003, 16), 0);
+    CHECK_EQ_INT(port_filter_update(&filter, &cfg, 9005, 2003, 18), PORT_FILTER_VALUE);
+    CHECK_EQ_INT(filter.shown_protocol, 18);
+    CHECK_EQ_INT(port_filter_update(&filter, &cfg, 9005, 2003, 18), 0);
+
+    for (int i = 0; i < cfg.off_samples; i++) {
+        port_filter_update(&filter, &cfg, 0, 0, 18);
+    }
+    CHECK(filter.off);
+    CHECK_EQ_INT(port_filter_update(&filter, &cfg, 0, 0, 0), 0);
+    CHECK_EQ_INT(port_filter_update(&filter, &cfg, 5000, 500, 15), PORT_FILTER_VALUE | PORT_FILTER_STATE);
+    CHECK_EQ_INT(filter.shown_protocol, 15);
+}
+
+static void test_replay(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    CHECK(f != NULL);
+    if (f == NULL) {
+        return;
+    }
+
+    const port_filter_config_t cfg = PORT_FILTER_DEFAULT_CONFIG();
+    port_filter_t filters[PORTS];
+    char last_text[PORTS][48];
+    for (int p = 0; p < PORTS; p++) {
+        port_filter_reset(&filters[p]);
+        last_text[p][0] = '\0';
+    }
+
+    uint32_t samples = 0;
+    uint32_t every_row = 0;
+    uint32_t text_changes = 0;
+    uint32_t filtered = 0;
+    uint32_t port_filtered[PORTS] = {0};
+    double error_sum = 0.0;
+    char line[256];
+
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (line[0] == '#') {
+            continue;
+        }
+        int v[PORTS * 3];
+        const char *s = line;
+        int n = 0;
+        int used;
+        while (n < PORTS * 3 && sscanf(s, "%d%n", &v[n], &used) == 1) {
+            s += used;
+            n++;
+        }
+        CHECK_EQ_INT(n, PORTS * 3);
+        if (n != PORTS * 3) {
+            break;
+        }
+        samples++;
+
+        for (int p = 0; p < PORTS; p++) {
+            int mv = v[p * 3];
+            int ma = v[p * 3 + 1];
+            int protocol = v[p * 3 + 2];
+            char text[48];
+
+            every_row++;
+            row_text(text, sizeof(text), mv, ma, protocol);
+            if (strcmp(text, last_text[p]) != 0) {
+                strcpy(last_text[p], text);
+                text_changes++;
+            }
+            if (port_filter_update(&filters[p], &cfg, mv, ma, protocol) != 0) {
+                filtered++;
+                port_filtered[p]++;
+            }
+            error_sum += fabs(port_filter_power(&filters[p]) - mv * (double)ma / 1000000.0);
+        }
+    }
+    fclose(f);
+
+    double mean_error = every_row ? error_sum / every_row : 0.0;
+    printf("%s: %u samples%s\n", path, (unsigned)samples, strcmp(path, DEFAULT_TRACE) == 0 ? " (synthetic)" : "");
+    printf("  row redraws: every sample %u, on text change %u, filtered %u\n",
+           (unsigned)every_row, (unsigned)text_changes, (unsigned)filtered);
+    printf("  filtered per port (A C1 C2 C3 C4):");
+    for (int p = 0; p < PORTS; p++) {
+        printf(" %u", (unsigned)port_filtered[p]);
+    }
+    printf("\n  mean |shown - raw| power: %.3f W\n", mean_error);
+
+    CHECK_EQ_INT(samples, 7200);
+    CHECK(filtered * 10 < text_changes);
+    CHECK(mean_error < 0.2);
+}
+
+int main(int argc, char **argv)
+{
+    test_protocol();
+    test_replay(argc > 1 ? argv[1] : DEFAULT_TRACE);
+    return HOST_TEST_RESULT();
+}
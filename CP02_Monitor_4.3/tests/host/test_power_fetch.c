@@ -0,0 +1,226 @@
+/**
+ * @file     test_power_fetch.c
+ * @brief    数据采集的HTTP客户端：复用、出错重建，设置页面修改的地址用于下一次请求
+ *
+ * 在主机上编译power_monitor.c，HTTP客户端由这里的假实现代替，只记录每次
+ * 请求用的句柄和地址。app_config也由这里实现，修改地址时和app_config.c一样
+ * 通知订阅者。
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+#include "power_monitor.h"
+#include "app_config.h"
+#include "font_manager.h"
+#include "gauge_view.h"
+#include "settings_ui.h"
+#include "lvgl_port.h"
+#include "ui_nav.h"
+#include "ui_theme.h"
+
+#define DISP_W          800
+#define DISP_H          480
+#define REFRESH_MS      1000
+#define URL_A           "http://192.168.1.10/metrics"
+#define URL_B           "http://192.168.1.20/metrics"
+
+const float MAX_POWER_WATTS = 160;
+const float MAX_PORT_WATTS = 140;
+bool WIFI_Connection = true;
+bool WIFI_GotIP = true;
+
+// 假的HTTP客户端
+struct esp_http_client {
+    char url[APP_CONFIG_URL_LEN];
+    bool live;
+};
+
+static int client_inits;
+static int client_cleanups;
+static int performs;
+static int stale_performs;          // 在已经释放的句柄上请求
+static esp_err_t perform_result = ESP_OK;
+static char last_url[APP_CONFIG_URL_LEN];
+static struct esp_http_client clients[8];
+
+esp_http_client_handle_t esp_http_client_init(const esp_http_client_config_t *config)
+{
+    struct esp_http_client *c = &clients[client_inits++ % 8];
+    strncpy(c->url, config->url, sizeof(c->url) - 1);
+    c->live = true;
+    return c;
+}
+
+esp_err_t esp_http_client_set_method(esp_http_client_handle_t client, esp_http_client_method_t method)
+{
+    (void)client;
+    (void)method;
+    return ESP_OK;
+}
+
+esp_err_t esp_http_client_set_header(esp_http_client_handle_t client, const char *key, const char *value)
+{
+    (void)client;
+    (void)key;
+    (void)value;
+    return ESP_OK;
+}
+
+esp_err_t esp_http_client_set_url(esp_http_client_handle_t client, const char *url)
+{
+    strncpy(client->url, url, sizeof(client->url) - 1);
+    return ESP_OK;
+}
+
+esp_err_t esp_http_client_perform(esp_http_client_handle_t client)
+{
+    performs++;
+    stale_performs += !client->live;
+    strcpy(last_url, client->url);
+    return perform_result;
+}
+
+int esp_http_client_get_status_code(esp_http_client_handle_t client)
+{
+    (void)client;
+    return 200;
+}
+
+esp_err_t esp_http_client_cleanup(esp_http_client_handle_t client)
+{
+    client->live = false;
+    client_cleanups++;
+    return ESP_OK;
+}
+
+// 时间由测试推进
+static uint32_t now_ms = 1000;
+
+uint32_t esp_log_timestamp(void)
+{
+    return now_ms;
+}
+
+// app_config：设置页面修改后通知订阅者
+static app_config_t config = { .metrics_url = URL_A, .refresh_ms = REFRESH_MS };
+static app_config_cb_t config_cb;
+
+const app_config_t *app_config_get(void)
+{
+    return &config;
+}
+
+esp_err_t app_config_subscribe(uint32_t items, app_config_cb_t cb)
+{
+    (void)items;
+    config_cb = cb;
+    return ESP_OK;
+}
+
+static void settings_set_url(const char *url)
+{
+    strcpy(config.metrics_url, url);
+    config_cb(APP_CONFIG_METRICS_URL, &config);
+}
+
+// 主界面用到的其他模块
+bool font_manager_is_ttf(void) { return false; }
+const lv_font_t *font_manager_get(uint16_t size) { (void)size; return &lv_font_montserrat_16; }
+void font_manager_warm_up(const lv_font_t *font, const char *text) { (void)font; (void)text; }
+void font_manager_get_stats(font_manager_stats_t *stats) { memset(stats, 0, sizeof(*stats)); }
+esp_err_t gauge_view_open(void) { return ESP_OK; }
+void gauge_view_close(void) {}
+bool gauge_view_is_open(void) { return false; }
+void settings_ui_open_wifi_settings(void) {}
+void settings_ui_close_wifi_settings(void) {}
+void lvgl_port_set_gesture_cb(gesture_cb_t cb, void *user_data) { (void)cb; (void)user_data; }
+
+static lv_color_t framebuffer[DISP_W * DISP_H];
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    (void)area;
+    (void)color_p;
+    lv_disp_flush_ready(drv);
+}
+
+static void display_init(void)
+{
+    static lv_disp_draw_buf_t draw_buf;
+    static lv_disp_drv_t disp_drv;
+
+    lv_disp_draw_buf_init(&draw_buf, framebuffer, NULL, DISP_W * DISP_H);
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = DISP_W;
+    disp_drv.ver_res = DISP_H;
+    disp_drv.draw_buf = &draw_buf;
+    disp_drv.direct_mode = 1;
+    disp_drv.flush_cb = flush_cb;
+    lv_disp_drv_register(&disp_drv);
+}
+
+// 过了一个刷新间隔后采集一次
+static esp_err_t fetch(void)
+{
+    now_ms += REFRESH_MS;
+    return power_monitor_fetch_data();
+}
+
+// 同一个客户端用于后续的请求
+static void test_reuse(void)
+{
+    CHECK_EQ_INT(fetch(), ESP_OK);
+    CHECK_EQ_INT(fetch(), ESP_OK);
+    CHECK_EQ_INT(performs, 2);
+    CHECK_EQ_INT(client_inits, 1);
+    CHECK(strcmp(last_url, URL_A) == 0);
+}
+
+// 设置页面修改的地址用于下一次请求，不会再用旧的地址或已经释放的句柄
+static void test_url_change(void)
+{
+    settings_set_url(URL_B);
+    CHECK(strcmp(power_monitor_get_data_url(), URL_B) == 0);
+    CHECK_EQ_INT(fetch(), ESP_OK);
+    CHECK(strcmp(last_url, URL_B) == 0);
+    CHECK_EQ_INT(client_cleanups, 1);
+    CHECK_EQ_INT(stale_performs, 0);
+
+    CHECK_EQ_INT(fetch(), ESP_OK);
+    CHECK(strcmp(last_url, URL_B) == 0);
+    CHECK_EQ_INT(client_inits, 2);
+}
+
+// 请求失败后重建客户端，仍然用当前的地址
+static void test_error_rebuild(void)
+{
+    perform_result = ESP_FAIL;
+    CHECK_EQ_INT(fetch(), ESP_FAIL);
+    CHECK(power_monitor_has_error());
+    perform_result = ESP_OK;
+
+    int inits = client_inits;
+    now_ms += 1000;
+    CHECK_EQ_INT(fetch(), ESP_OK);
+    CHECK_EQ_INT(client_inits, inits + 1);
+    CHECK(strcmp(last_url, URL_B) == 0);
+    CHECK_EQ_INT(stale_performs, 0);
+    CHECK(!power_monitor_has_error());
+}
+
+int main(void)
+{
+    lv_init();
+    display_init();
+    ui_theme_init();
+    CHECK_EQ_INT(ui_nav_init(), ESP_OK);
+    CHECK_EQ_INT(power_monitor_init(), ESP_OK);
+
+    test_reuse();
+    test_url_change();
+    test_error_rebuild();
+    return HOST_TEST_RESULT();
+}
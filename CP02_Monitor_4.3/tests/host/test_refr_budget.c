@@ -0,0 +1,197 @@
+/**
+ * @file     test_refr_budget.c
+ * @brief    刷新预算：按优先级绘制，超出预算的区域推迟到下一帧并提升优先级
+ *
+ * 在800x480的direct mode显示器上，屏幕背景的绘制回调按绘制的像素推进LVGL
+ * 时间（8000像素1ms，整屏48ms），所以每一帧的耗时和设备上一样和像素数成
+ * 正比，预算和sdkconfig一样是30ms。每次lv_refr_now()是一帧，回调记录这一帧
+ * 按顺序绘制了哪些区域。
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "host_test.h"
+#include "lvgl.h"
+
+#define DISP_W          800
+#define DISP_H          480
+#define PX_PER_MS       8000
+#define MAX_DRAWN       16
+
+static lv_color_t framebuffer[DISP_W * DISP_H];
+static lv_disp_drv_t disp_drv;
+
+// 这一帧按顺序绘制的区域
+static lv_area_t drawn[MAX_DRAWN];
+static int drawn_cnt;
+static uint32_t charge_px;
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    (void)area;
+    (void)color_p;
+    lv_disp_flush_ready(drv);
+}
+
+// 屏幕没有子控件，每个区域都从屏幕开始绘制，在这里按像素数计时
+static void charge_cb(lv_event_t *e)
+{
+    const lv_area_t *clip = lv_event_get_draw_ctx(e)->clip_area;
+    if (drawn_cnt < MAX_DRAWN) {
+        drawn[drawn_cnt] = *clip;
+    }
+    drawn_cnt++;
+
+    charge_px += lv_area_get_size(clip);
+    lv_tick_inc(charge_px / PX_PER_MS);
+    charge_px %= PX_PER_MS;
+}
+
+static void display_init(void)
+{
+    static lv_disp_draw_buf_t draw_buf;
+
+    lv_disp_draw_buf_init(&draw_buf, framebuffer, NULL, DISP_W * DISP_H);
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = DISP_W;
+    disp_drv.ver_res = DISP_H;
+    disp_drv.draw_buf = &draw_buf;
+    disp_drv.direct_mode = 1;
+    disp_drv.flush_cb = flush_cb;
+    lv_disp_drv_register(&disp_drv);
+    lv_obj_add_event_cb(lv_scr_act(), charge_cb, LV_EVENT_DRAW_MAIN, NULL);
+}
+
+// 整行的区域，h行
+static lv_area_t rows(int y, int h)
+{
+    lv_area_t a;
+    lv_area_set(&a, 0, y, DISP_W - 1, y + h - 1);
+    return a;
+}
+
+static void inv(const lv_area_t *a, lv_refr_prio_t prio)
+{
+    _lv_inv_area_prio(NULL, a, prio);
+}
+
+static void frame(void)
+{
+    drawn_cnt = 0;
+    lv_refr_now(NULL);
+}
+
+// 这一帧中区域a是第几个绘制的，没有绘制返回-1
+static int drawn_at(const lv_area_t *a)
+{
+    for (int i = 0; i < drawn_cnt && i < MAX_DRAWN; i++) {
+        if (_lv_area_is_in(a, &drawn[i], 0)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// 整屏重绘几次，学到每个像素的耗时
+static void test_cost_estimate(void)
+{
+    lv_area_t scr = rows(0, DISP_H);
+    for (int i = 0; i < 3; i++) {
+        inv(&scr, LV_REFR_PRIO_HIGH);
+        frame();
+    }
+
+    lv_refr_budget_stats_t st;
+    lv_refr_get_budget_stats(&st);
+    printf("learned cost %u ns/px, full screen %u ms\n", (unsigned)st.px_cost_ns, (unsigned)st.last_time);
+    CHECK_EQ_INT(st.px_cost_ns, 1000000 / PX_PER_MS);
+    CHECK_EQ_INT(st.last_time, DISP_W * DISP_H / PX_PER_MS);
+    CHECK_EQ_INT(st.over_budget, 3);
+    // 高优先级的区域不推迟，即使超出预算
+    CHECK_EQ_INT(st.deferred_areas, 0);
+}
+
+// 预算内的区域都在同一帧绘制，高优先级的先画，同优先级保持失效的顺序
+static void test_priority_order(void)
+{
+    lv_area_t low = rows(0, 40), mid1 = rows(100, 40), high = rows(200, 40), mid2 = rows(300, 40);
+    inv(&low, LV_REFR_PRIO_LOW);
+    inv(&mid1, LV_REFR_PRIO_MID);
+    inv(&high, LV_REFR_PRIO_HIGH);
+    inv(&mid2, LV_REFR_PRIO_MID);
+    frame();
+    CHECK_EQ_INT(drawn_cnt, 4);
+    CHECK_EQ_INT(drawn_at(&high), 0);
+    CHECK_EQ_INT(drawn_at(&mid1), 1);
+    CHECK_EQ_INT(drawn_at(&mid2), 2);
+    CHECK_EQ_INT(drawn_at(&low), 3);
+}
+
+// 超出预算时推迟优先级低的区域，下一帧重新失效并绘制
+static void test_defer_and_restore(void)
+{
+    // 10ms + 15ms在30ms以内，再加上20ms就超出了
+    lv_area_t high = rows(0, 100), mid = rows(100, 150), low = rows(250, 200);
+    lv_refr_reset_budget_stats();
+    inv(&low, LV_REFR_PRIO_LOW);
+    inv(&mid, LV_REFR_PRIO_MID);
+    inv(&high, LV_REFR_PRIO_HIGH);
+    frame();
+    CHECK(drawn_at(&high) >= 0);
+    CHECK(drawn_at(&mid) >= 0);
+    CHECK_EQ_INT(drawn_at(&low), -1);
+
+    lv_refr_budget_stats_t st;
+    lv_refr_get_budget_stats(&st);
+    CHECK_EQ_INT(st.deferred_areas, 1);
+    CHECK_EQ_INT(st.deferred_px, lv_area_get_size(&low));
+    CHECK(st.last_time <= LV_REFR_BUDGET_MS);
+
+    // 没有新的失效，推迟的区域自己回来
+    frame();
+    CHECK_EQ_INT(drawn_cnt, 1);
+    CHECK_EQ_INT(drawn_at(&low), 0);
+    frame();
+    CHECK_EQ_INT(drawn_cnt, 0);
+}
+
+// 高优先级的区域每帧都占满预算时，推迟的区域每帧提升一级，最迟两帧后作为高优先级绘制
+static void test_aging(void)
+{
+    lv_area_t busy = rows(0, 240), mid = rows(240, 90), low = rows(330, 150);
+    int low_frame = -1, mid_frame = -1;
+    inv(&low, LV_REFR_PRIO_LOW);
+    for (int f = 0; f < 6; f++) {
+        inv(&busy, LV_REFR_PRIO_HIGH);
+        inv(&mid, LV_REFR_PRIO_MID);
+        frame();
+        // 提升到高优先级的区域先于同优先级的新区域失效，所以busy不一定第一个画
+        CHECK(drawn_at(&busy) >= 0);
+        if (mid_frame < 0 && drawn_at(&mid) >= 0) {
+            mid_frame = f;
+        }
+        if (low_frame < 0 && drawn_at(&low) >= 0) {
+            low_frame = f;
+        }
+    }
+    printf("under full load the mid area waits %d frame(s), the low area %d frame(s)\n", mid_frame, low_frame);
+    CHECK_EQ_INT(mid_frame, 1);
+    CHECK_EQ_INT(low_frame, 2);
+
+    // 负载结束后没有剩下的区域
+    frame();
+    frame();
+    CHECK_EQ_INT(drawn_cnt, 0);
+}
+
+int main(void)
+{
+    lv_init();
+    display_init();
+    test_cost_estimate();
+    test_priority_order();
+    test_defer_and_restore();
+    test_aging();
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,195 @@
+/**
+ * @file     test_touch_filter.c
+ * @brief    触摸滤波：去抖、死区、One-Euro跟手延迟和预测
+ *
+ * 轨迹是按GT911的10ms采样合成的：静止按压带±1px抖动，匀速滑动，控制器偶尔
+ * 漏报一个采样或者报出单个的假触摸。逐个采样送进touch_filter_update()，
+ * 检查输出。
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "host_test.h"
+#include "touch_filter.h"
+
+#define SAMPLE_MS   10
+
+static uint32_t rng_state = 7;
+
+static int jitter(int range)
+{
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return (int)((rng_state >> 16) % (2 * range + 1)) - range;
+}
+
+typedef struct {
+    bool pressed;
+    int16_t x, y;
+} sample_t;
+
+// 逐个采样回放，返回最后一次的按下状态，pressed和xs记录每个采样的输出
+static bool replay(touch_filter_t *f, const sample_t *trace, int n, uint32_t start_ms, bool *pressed, int16_t *xs)
+{
+    bool p = false;
+    for (int i = 0; i < n; i++) {
+        int16_t x, y;
+        p = touch_filter_update(f, trace[i].pressed, trace[i].x, trace[i].y, start_ms + i * SAMPLE_MS, &x, &y);
+        if (pressed != NULL) {
+            pressed[i] = p;
+        }
+        if (xs != NULL) {
+            xs[i] = x;
+        }
+    }
+    return p;
+}
+
+// 单个假触摸被丢弃，按下需要连续press_debounce个采样；单个漏报不会抬起，抬起时保持最后的坐标
+static void test_debounce(void)
+{
+    touch_filter_config_t cfg = TOUCH_FILTER_DEFAULT_CONFIG();
+    cfg.press_debounce = 2;
+    cfg.release_debounce = 2;
+    touch_filter_t f;
+    touch_filter_init(&f, &cfg);
+
+    const sample_t trace[] = {
+        {false, 0, 0}, {true, 300, 200}, {false, 0, 0},         // 假触摸
+        {true, 400, 240}, {true, 400, 240}, {true, 400, 240},   // 第二个采样确认按下
+        {false, 0, 0}, {true, 400, 240},                        // 单个漏报
+        {false, 0, 0}, {false, 0, 0}, {false, 0, 0},            // 抬起
+    };
+    const bool expected[] = {false, false, false, false, true, true, true, true, true, false, false};
+    const int n = sizeof(trace) / sizeof(trace[0]);
+    bool pressed[sizeof(trace) / sizeof(trace[0])];
+    replay(&f, trace, n, 1000, pressed, NULL);
+    for (int i = 0; i < n; i++) {
+        CHECK_EQ_INT(pressed[i], expected[i]);
+    }
+    CHECK_EQ_INT(touch_filter_get_state(&f), TOUCH_STATE_IDLE);
+    CHECK(!touch_filter_is_active(&f));
+
+    int16_t x, y;
+    touch_filter_update(&f, false, 0, 0, 2000, &x, &y);
+    CHECK_EQ_INT(x, 400);
+    CHECK_EQ_INT(y, 240);
+}
+
+// 静止按压的±1px抖动都在死区内，输出一直不变
+static void test_dead_zone(void)
+{
+    touch_filter_t f;
+    touch_filter_init(&f, NULL);
+
+    sample_t trace[300];
+    for (int i = 0; i < 300; i++) {
+        trace[i] = (sample_t){true, (int16_t)(500 + jitter(1)), (int16_t)(300 + jitter(1))};
+    }
+    trace[0] = (sample_t){true, 500, 300};
+    int16_t xs[300];
+    replay(&f, trace, 300, 5000, NULL, xs);
+    for (int i = 0; i < 300; i++) {
+        CHECK_EQ_INT(xs[i], 500);
+    }
+}
+
+// 1000px/s匀速滑动，返回稳定后输出落后于原始坐标的平均距离
+static double swipe_lag(const touch_filter_config_t *cfg)
+{
+    touch_filter_t f;
+    touch_filter_init(&f, cfg);
+
+    enum { N = 50 };
+    sample_t trace[N];
+    for (int i = 0; i < N; i++) {
+        trace[i] = (sample_t){true, (int16_t)(100 + i * 10), 240};
+    }
+    int16_t xs[N];
+    replay(&f, trace, N, 0, NULL, xs);
+
+    double lag = 0;
+    for (int i = N / 2; i < N; i++) {
+        lag += trace[i].x - xs[i];
+    }
+    return lag / (N - N / 2);
+}
+
+// beta让截止频率随速度升高，滑动时比固定截止频率跟手得多；预测再补上一部分延迟
+static void test_lag_and_prediction(void)
+{
+    touch_filter_config_t cfg = TOUCH_FILTER_DEFAULT_CONFIG();
+    cfg.predict_ms = 0;
+    double lag = swipe_lag(&cfg);
+
+    touch_filter_config_t fixed = cfg;
+    fixed.beta = 0.0f;
+    double fixed_lag = swipe_lag(&fixed);
+
+    touch_filter_config_t predicted = cfg;
+    predicted.predict_ms = 8;
+    double predicted_lag = swipe_lag(&predicted);
+
+    printf("swipe lag at 1000 px/s: fixed cutoff %.1f px, one-euro %.1f px, with 8 ms prediction %.1f px\n",
+           fixed_lag, lag, predicted_lag);
+    CHECK(lag > 0 && lag < 15);
+    CHECK(fixed_lag > 5 * lag);
+    CHECK(predicted_lag < lag);
+    CHECK(predicted_lag > -10);
+}
+
+// 快速滑到面板的两个角上，返回输出坐标的范围
+static void corner_swipes(const touch_filter_config_t *cfg, int16_t *min_x, int16_t *min_y, int16_t *max_x,
+                          int16_t *max_y)
+{
+    const int16_t w = 800, h = 480;
+    touch_filter_t f;
+    touch_filter_init(&f, cfg);
+
+    *max_x = *max_y = 0;
+    *min_x = *min_y = 1000;
+    for (int dir = 0; dir < 2; dir++) {
+        touch_filter_reset(&f);
+        for (int i = 0; i <= 40; i++) {
+            // 对角线方向3000px/s，最后停在角上
+            int16_t x = (int16_t)(dir == 0 ? 400 + i * 10 : 400 - i * 10);
+            int16_t y = (int16_t)(dir == 0 ? 240 + i * 6 : 240 - i * 6);
+            x = x > w - 1 ? w - 1 : x < 0 ? 0 : x;
+            y = y > h - 1 ? h - 1 : y < 0 ? 0 : y;
+            int16_t ox, oy;
+            touch_filter_update(&f, true, x, y, 100000 + dir * 10000 + i * SAMPLE_MS, &ox, &oy);
+            *max_x = ox > *max_x ? ox : *max_x;
+            *max_y = oy > *max_y ? oy : *max_y;
+            *min_x = ox < *min_x ? ox : *min_x;
+            *min_y = oy < *min_y ? oy : *min_y;
+        }
+    }
+}
+
+// 不限制时预测会越过面板边缘，限制后输出始终在面板内
+static void test_prediction_clamp(void)
+{
+    touch_filter_config_t cfg = TOUCH_FILTER_DEFAULT_CONFIG();
+    cfg.predict_ms = 30;
+    int16_t min_x, min_y, max_x, max_y;
+
+    touch_filter_config_t unclamped = cfg;
+    unclamped.width = 0;
+    unclamped.height = 0;
+    corner_swipes(&unclamped, &min_x, &min_y, &max_x, &max_y);
+    CHECK(max_x > cfg.width - 1 && max_y > cfg.height - 1);
+
+    corner_swipes(&cfg, &min_x, &min_y, &max_x, &max_y);
+    CHECK(max_x <= cfg.width - 1 && max_y <= cfg.height - 1);
+    CHECK(min_x >= 0 && min_y >= 0);
+    CHECK(max_x > cfg.width - 10 && min_x < 10);
+}
+
+int main(void)
+{
+    test_debounce();
+    test_dead_zone();
+    test_lag_and_prediction();
+    test_prediction_clamp();
+    return HOST_TEST_RESULT();
+}
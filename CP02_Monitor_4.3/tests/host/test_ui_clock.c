@@ -0,0 +1,129 @@
+/**
+ * @file     test_ui_clock.c
+ * @brief    手动模式逐帧推进动画，退出手动模式后动画时间不倒退
+ *
+ * LVGL和设备上一样通过ui_clock读取时间：定时器用实时时间，动画用
+ * ui_clock_ms()。实时时间（esp_timer）由这里推进，每帧带一点抖动。手动模式下
+ * 线性动画的值只取决于ui_clock_step()推进的时间；退出后动画从手动模式的时间
+ * 继续走，时间倒退时LVGL算出的间隔溢出，动画会直接跳到终点。
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "host_test.h"
+#include "lvgl.h"
+#include "ui_clock.h"
+
+#define FRAME_MS        32
+#define ANIM_MS         1024
+
+// 开机5s后开始，手动模式的时间比实时时间慢
+static int64_t real_us = 5000000;
+
+int64_t esp_timer_get_time(void)
+{
+    return real_us;
+}
+
+// 推进一帧的实时时间，超过动画定时器的周期，带一点调度抖动
+static void real_frame(int k)
+{
+    real_us += (int64_t)(LV_DISP_DEF_REFR_PERIOD + (k * 7) % 20) * 1000;
+}
+
+static int32_t value;
+
+static void exec_cb(void *var, int32_t v)
+{
+    (void)var;
+    value = v;
+}
+
+// 0到ANIM_MS的线性动画，值等于动画已经运行的毫秒数
+static void anim_start(void)
+{
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, &value);
+    lv_anim_set_exec_cb(&a, exec_cb);
+    lv_anim_set_values(&a, 0, ANIM_MS);
+    lv_anim_set_time(&a, ANIM_MS);
+    lv_anim_start(&a);
+    value = 0;
+}
+
+// 手动模式逐帧推进，动画值和实时时间无关
+static int32_t step_frames(int frames)
+{
+    int32_t start = value;
+    for (int k = 1; k <= frames; k++) {
+        ui_clock_step(FRAME_MS);
+        real_frame(k);
+        lv_timer_handler();
+        CHECK_EQ_INT(value, start + k * FRAME_MS);
+    }
+    return value;
+}
+
+// 退出手动模式后按实时时间继续，动画值从手动模式停下的地方往后走
+static void check_release(uint32_t manual_ms, int32_t manual_value)
+{
+    // 手动模式下的VSYNC不起作用，退出后也不能用它锁存的时间
+    ui_clock_frame();
+    ui_clock_release();
+    CHECK_EQ_INT(ui_clock_ms(), manual_ms);
+
+    real_us += 33 * 1000;
+    lv_timer_handler();
+    CHECK_EQ_INT(value, manual_value + 33);
+    CHECK(value < ANIM_MS);
+}
+
+static void test_step_and_release(void)
+{
+    ui_clock_manual(0);
+    anim_start();
+    int32_t v = step_frames(8);
+    CHECK_EQ_INT(v, 8 * FRAME_MS);
+    check_release(8 * FRAME_MS, v);
+}
+
+// 再次进入手动模式时已经有偏移，退出后仍然连续
+static void test_second_round(void)
+{
+    uint32_t t = ui_clock_ms();
+    ui_clock_manual(t);
+    int32_t v = step_frames(4);
+    check_release(t + 4 * FRAME_MS, v);
+
+    // 剩下的部分按实时时间走完，值不倒退
+    int32_t last = value;
+    for (int k = 0; k < 64 && lv_anim_count_running() > 0; k++) {
+        real_frame(k);
+        ui_clock_frame();
+        lv_timer_handler();
+        CHECK(value >= last);
+        last = value;
+    }
+    CHECK_EQ_INT(value, ANIM_MS);
+}
+
+// VSYNC锁存：同一帧内动画时间不变，没有新帧超过100ms后改用实时时间
+static void test_vsync_latch(void)
+{
+    ui_clock_frame();
+    uint32_t frame = ui_clock_ms();
+    real_us += 10 * 1000;
+    CHECK_EQ_INT(ui_clock_ms(), frame);
+    real_us += 100 * 1000;
+    CHECK_EQ_INT(ui_clock_ms(), frame + 110);
+}
+
+int main(void)
+{
+    lv_init();
+    test_step_and_release();
+    test_second_round();
+    test_vsync_latch();
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,272 @@
+/**
+ * @file     test_ui_nav.c
+ * @brief    导航栈的记账：页面切换、缓存、后台数据合并、托管定时器、底部留出的区域
+ *
+ * 在主机上编译的LVGL里注册一个不输出的显示器，按真实的调用顺序打开和返回
+ * 页面。异步的切换在lv_timer_handler()里完成，和设备上一样。
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "host_test.h"
+#include "ui_nav.h"
+#include "ui_theme.h"
+
+#define DISP_W      80
+#define DISP_H      60
+
+// 每个页面的回调计数
+typedef struct {
+    int create;
+    int destroy;
+    int show;
+    int hide;
+    int data;
+    uint32_t data_topics;
+} screen_calls_t;
+
+static screen_calls_t calls_a, calls_b, calls_c;
+
+#define SCREEN_CALLBACKS(x, calls)                                                  \
+    static void x##_create(lv_obj_t *parent) { (void)parent; calls.create++; }      \
+    static void x##_destroy(void) { calls.destroy++; }                              \
+    static void x##_show(void) { calls.show++; }                                    \
+    static void x##_hide(void) { calls.hide++; }                                    \
+    static void x##_on_data(uint32_t topics) { calls.data++; calls.data_topics |= topics; }
+
+SCREEN_CALLBACKS(a, calls_a)
+SCREEN_CALLBACKS(b, calls_b)
+SCREEN_CALLBACKS(c, calls_c)
+
+// 主页：返回时保留控件，订阅全部主题
+static ui_nav_screen_t screen_a = {
+    .name = "a", .cached = true, .topics = UI_NAV_TOPIC_POWER | UI_NAV_TOPIC_WIFI,
+    .create = a_create, .destroy = a_destroy, .show = a_show, .hide = a_hide, .on_data = a_on_data,
+};
+
+// 详情页：每次进入重新创建
+static ui_nav_screen_t screen_b = {
+    .name = "b", .cached = false, .topics = UI_NAV_TOPIC_POWER,
+    .create = b_create, .destroy = b_destroy, .show = b_show, .hide = b_hide, .on_data = b_on_data,
+};
+
+// 设置页：不订阅数据
+static ui_nav_screen_t screen_c = {
+    .name = "c", .cached = false, .topics = 0,
+    .create = c_create, .destroy = c_destroy, .show = c_show, .hide = c_hide, .on_data = c_on_data,
+};
+
+// ui_nav只用到样式，主机上不需要真正的主题
+void ui_theme_apply(lv_obj_t *obj, ui_style_id_t id, lv_style_selector_t selector)
+{
+    (void)obj;
+    (void)id;
+    (void)selector;
+}
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    (void)area;
+    (void)color_p;
+    lv_disp_flush_ready(drv);
+}
+
+static void display_init(void)
+{
+    static lv_color_t buf[DISP_W * 10];
+    static lv_disp_draw_buf_t draw_buf;
+    static lv_disp_drv_t drv;
+
+    lv_disp_draw_buf_init(&draw_buf, buf, NULL, DISP_W * 10);
+    lv_disp_drv_init(&drv);
+    drv.hor_res = DISP_W;
+    drv.ver_res = DISP_H;
+    drv.draw_buf = &draw_buf;
+    drv.flush_cb = flush_cb;
+    lv_disp_drv_register(&drv);
+}
+
+static void timer_cb(lv_timer_t *timer)
+{
+    (void)timer;
+}
+
+static uint32_t depth(void)
+{
+    ui_nav_stats_t stats;
+    ui_nav_get_stats(&stats);
+    return stats.depth;
+}
+
+// 第一个页面立即显示，之后的切换等到下一次定时器处理
+static void test_push_pop(void)
+{
+    CHECK_EQ_INT(ui_nav_pop(), ESP_ERR_INVALID_STATE);
+
+    CHECK_EQ_INT(ui_nav_push(&screen_a), ESP_OK);
+    CHECK(ui_nav_top() == &screen_a);
+    CHECK(screen_a.active && screen_a.stacked);
+    CHECK_EQ_INT(calls_a.create, 1);
+    CHECK_EQ_INT(calls_a.show, 1);
+    CHECK_EQ_INT(depth(), 1);
+    CHECK_EQ_INT(ui_nav_pop(), ESP_ERR_INVALID_STATE);
+
+    CHECK_EQ_INT(ui_nav_push(&screen_b), ESP_OK);
+    CHECK(ui_nav_top() == &screen_a);
+    CHECK_EQ_INT(calls_b.create, 0);
+
+    // 切换完成之前的新请求被忽略
+    CHECK_EQ_INT(ui_nav_push(&screen_c), ESP_ERR_INVALID_STATE);
+    CHECK_EQ_INT(ui_nav_pop(), ESP_ERR_INVALID_STATE);
+
+    lv_timer_handler();
+    CHECK(ui_nav_top() == &screen_b);
+    CHECK(ui_nav_is_top(&screen_b));
+    CHECK(!ui_nav_is_top(&screen_a));
+    CHECK(!screen_a.active && screen_a.stacked);
+    CHECK(screen_b.active && screen_b.stacked);
+    CHECK_EQ_INT(calls_a.hide, 1);
+    CHECK_EQ_INT(calls_b.create, 1);
+    CHECK_EQ_INT(calls_b.show, 1);
+    CHECK_EQ_INT(depth(), 2);
+    CHECK(lv_scr_act() == lv_obj_get_parent(screen_b.content));
+
+    // 已经在前台的页面再次打开什么都不做，在栈里的后台页面不能重复打开
+    CHECK_EQ_INT(ui_nav_push(&screen_b), ESP_OK);
+    CHECK_EQ_INT(ui_nav_push(&screen_a), ESP_ERR_INVALID_STATE);
+    lv_timer_handler();
+    CHECK_EQ_INT(depth(), 2);
+    CHECK_EQ_INT(calls_b.create, 1);
+}
+
+// 后台页面的数据合并成一次回调，定时器在后台暂停
+static void test_background(void)
+{
+    lv_timer_t *timer_a = ui_nav_timer_create(&screen_a, timer_cb, 1000, NULL);
+    lv_timer_t *timer_b = ui_nav_timer_create(&screen_b, timer_cb, 1000, NULL);
+    CHECK(timer_a != NULL && timer_b != NULL);
+    CHECK(timer_a->paused);
+    CHECK(!timer_b->paused);
+
+    ui_nav_publish(UI_NAV_TOPIC_POWER);
+    ui_nav_publish(UI_NAV_TOPIC_WIFI);
+    ui_nav_publish(UI_NAV_TOPIC_POWER);
+    CHECK_EQ_INT(calls_a.data, 0);
+    CHECK_EQ_INT(screen_a.pending, UI_NAV_TOPIC_POWER | UI_NAV_TOPIC_WIFI);
+    CHECK_EQ_INT(calls_b.data, 2);
+    CHECK_EQ_INT(calls_b.data_topics, UI_NAV_TOPIC_POWER);
+
+    // 返回主页：b被销毁，a的控件和定时器原样恢复，后台数据一次补发
+    lv_obj_t *content_a = screen_a.content;
+    CHECK_EQ_INT(ui_nav_pop(), ESP_OK);
+    lv_timer_handler();
+    CHECK(ui_nav_top() == &screen_a);
+    CHECK_EQ_INT(depth(), 1);
+    CHECK(screen_a.active);
+    CHECK(!timer_a->paused);
+    CHECK_EQ_INT(calls_a.create, 1);
+    CHECK_EQ_INT(calls_a.show, 2);
+    CHECK_EQ_INT(calls_a.data, 1);
+    CHECK_EQ_INT(calls_a.data_topics, UI_NAV_TOPIC_POWER | UI_NAV_TOPIC_WIFI);
+    CHECK_EQ_INT(screen_a.pending, 0);
+    CHECK(screen_a.content == content_a);
+    CHECK(lv_scr_act() == lv_obj_get_parent(content_a));
+
+    CHECK(!screen_b.stacked && !screen_b.active);
+    CHECK(screen_b.content == NULL);
+    CHECK_EQ_INT(calls_b.hide, 1);
+    CHECK_EQ_INT(calls_b.destroy, 1);
+    for (int i = 0; i < UI_NAV_MAX_TIMERS; i++) {
+        CHECK(screen_b.timers[i] == NULL);
+    }
+
+    // 销毁的页面收不到数据
+    ui_nav_publish(UI_NAV_TOPIC_POWER);
+    CHECK_EQ_INT(calls_b.data, 2);
+    CHECK_EQ_INT(calls_a.data, 2);
+    ui_nav_timer_del(&screen_a, timer_a);
+    CHECK(screen_a.timers[0] == NULL);
+}
+
+// 销毁的页面被新页面盖住时也会销毁，返回时重新创建；不订阅的页面不受数据影响
+static void test_recreate(void)
+{
+    CHECK_EQ_INT(ui_nav_push(&screen_b), ESP_OK);
+    lv_timer_handler();
+    CHECK(ui_nav_top() == &screen_b);
+    CHECK_EQ_INT(calls_b.create, 2);
+    CHECK(screen_b.content != NULL);
+
+    CHECK_EQ_INT(ui_nav_push(&screen_c), ESP_OK);
+    lv_timer_handler();
+    CHECK(ui_nav_top() == &screen_c);
+    CHECK_EQ_INT(depth(), 3);
+    CHECK(screen_b.stacked && !screen_b.active);
+    CHECK(screen_b.content == NULL);
+    CHECK_EQ_INT(calls_b.destroy, 2);
+
+    ui_nav_publish(UI_NAV_TOPIC_POWER | UI_NAV_TOPIC_WIFI);
+    CHECK_EQ_INT(calls_c.data, 0);
+    CHECK_EQ_INT(screen_b.pending, 0);
+    CHECK_EQ_INT(screen_a.pending, UI_NAV_TOPIC_POWER | UI_NAV_TOPIC_WIFI);
+
+    // b重新创建时读取最新数据，不再补发
+    CHECK_EQ_INT(ui_nav_pop(), ESP_OK);
+    lv_timer_handler();
+    CHECK(ui_nav_top() == &screen_b);
+    CHECK_EQ_INT(calls_c.destroy, 1);
+    CHECK_EQ_INT(calls_b.create, 3);
+    CHECK_EQ_INT(calls_b.data, 2);
+
+    CHECK_EQ_INT(ui_nav_pop(), ESP_OK);
+    lv_timer_handler();
+    CHECK(ui_nav_top() == &screen_a);
+    CHECK_EQ_INT(calls_b.destroy, 3);
+    CHECK_EQ_INT(calls_a.create, 1);
+    CHECK_EQ_INT(calls_a.data, 3);
+
+    ui_nav_stats_t stats;
+    ui_nav_get_stats(&stats);
+    CHECK_EQ_INT(stats.depth, 1);
+    CHECK_EQ_INT(stats.transitions, 7);
+}
+
+static lv_coord_t content_height(const ui_nav_screen_t *screen)
+{
+    lv_obj_update_layout(screen->content);
+    return lv_obj_get_height(screen->content);
+}
+
+// 底部留出的区域对前台页面立即生效，后台的保留页面回到前台时也生效
+static void test_bottom_inset(void)
+{
+    CHECK_EQ_INT(content_height(&screen_a), DISP_H);
+    ui_nav_set_bottom_inset(10);
+    CHECK_EQ_INT(content_height(&screen_a), DISP_H - 10);
+
+    CHECK_EQ_INT(ui_nav_push(&screen_c), ESP_OK);
+    lv_timer_handler();
+    CHECK_EQ_INT(content_height(&screen_c), DISP_H - 10);
+    ui_nav_set_bottom_inset(0);
+    CHECK_EQ_INT(content_height(&screen_c), DISP_H);
+
+    CHECK_EQ_INT(ui_nav_pop(), ESP_OK);
+    lv_timer_handler();
+    CHECK(ui_nav_top() == &screen_a);
+    CHECK_EQ_INT(content_height(&screen_a), DISP_H);
+}
+
+int main(void)
+{
+    lv_init();
+    display_init();
+    CHECK_EQ_INT(ui_nav_push(&screen_a), ESP_ERR_INVALID_ARG);
+    CHECK_EQ_INT(ui_nav_init(), ESP_OK);
+
+    test_push_pop();
+    test_background();
+    test_recreate();
+    test_bottom_inset();
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+"""
+生成端口过滤回放用的合成数据：桌面上一小时的充电场景，500ms一次采样
+
+  A   空载，5V，几mA的噪声
+  C1  20V笔记本，负载缓慢漂移，时不时有几十秒的满载
+  C2  9V手机，先恒流后降流，切到5V涓流，50分钟时拔掉
+  C3  空
+  C4  空
+
+每行是一次采样，依次为A、C1、C2、C3、C4的电压(mV)、电流(mA)、快充协议，
+用空格分隔。随机数种子固定，重新生成的文件完全相同。
+
+用法: python tests/host/traces/gen_desk_session.py [-o tests/host/traces/desk_session.txt]
+"""
+
+import argparse
+import os
+import random
+
+SAMPLE_MS = 500
+SAMPLES = 3600 * 1000 // SAMPLE_MS
+PORTS = 5
+
+PROTO_NONE = 0
+PROTO_PD_FIX5V = 15
+PROTO_PD_FIXHV = 16
+
+
+def idle_a(rng, t):
+    return 5000 + rng.randint(-30, 30), rng.randint(0, 8), PROTO_NONE
+
+
+class Laptop:
+    def __init__(self):
+        self.load = 1800.0
+        self.burst_left = 0
+
+    def sample(self, rng, t):
+        self.load += rng.gauss(0, 15)
+        self.load = min(max(self.load, 1200), 2600)
+        if self.burst_left == 0 and rng.random() < 0.002:
+            self.burst_left = rng.randint(40, 120)
+        current = self.load
+        if self.burst_left > 0:
+            self.burst_left -= 1
+            current = 3200
+        return 20000 + rng.randint(-40, 40), int(current + rng.randint(-12, 12)), PROTO_PD_FIXHV
+
+
+def phone(rng, t):
+    minutes = t / 60000
+    if minutes >= 50:
+        return rng.randint(0, 40), 0, PROTO_NONE
+    if minutes >= 40:
+        return 5000 + rng.randint(-30, 30), 120 + rng.randint(-15, 15), PROTO_PD_FIX5V
+    if minutes >= 20:
+        # 降流阶段电流从2A线性降到0.5A
+        current = 2000 - (minutes - 20) / 20 * 1500
+    else:
+        current = 2000
+    return 9000 + rng.randint(-30, 30), int(current + rng.randint(-10, 10)), PROTO_PD_FIXHV
+
+
+def empty(rng, t):
+    return rng.randint(0, 40), 0, PROTO_NONE
+
+
+def main():
+    parser = argparse.ArgumentParser(description='生成端口过滤回放用的合成数据')
+    parser.add_argument('-o', '--output', default=os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                                                               'desk_session.txt'))
+    args = parser.parse_args()
+
+    rng = random.Random(20261018)
+    laptop = Laptop()
+    ports = [idle_a, laptop.sample, phone, empty, empty]
+    with open(args.output, 'w') as f:
+        f.write('# 合成数据，由gen_desk_session.py生成，不是设备上的实测记录\n')
+        f.write('# 桌面一小时，%dms一次采样；每个端口: 电压mV 电流mA 协议，顺序A C1 C2 C3 C4\n' % SAMPLE_MS)
+        for i in range(SAMPLES):
+            t = i * SAMPLE_MS
+            fields = []
+            for port in ports:
+                fields.extend(port(rng, t))
+            f.write(' '.join(str(v) for v in fields) + '\n')
+    print('%s: %d samples x %d ports' % (args.output, SAMPLES, PORTS))
+
+
+if __name__ == '__main__':
+    main()
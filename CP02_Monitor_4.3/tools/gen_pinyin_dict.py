@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+"""
+从拼音词典文本生成拼音前缀树(C源文件)
+
+词典格式见main/pinyin/pinyin_dict.txt。生成的节点按层次顺序排列，同一节点
+的子节点连续存放，用26位掩码标记存在的字母，查找一个字母只需一次popcount。
+候选按先序遍历排列，每个节点自己的候选在前，因此任意前缀对应的全部候选
+是候选表中连续的一段。
+
+用法: python tools/gen_pinyin_dict.py main/pinyin/pinyin_dict.txt -o pinyin_dict.c
+"""
+
+import argparse
+import re
+import sys
+from collections import deque
+
+PINYIN_RE = re.compile(r'^[a-z]+$')
+
+
+class Node:
+    def __init__(self):
+        self.children = {}
+        self.cands = []
+        self.index = 0
+        self.cand_start = 0
+        self.cand_total = 0
+
+
+def load(path):
+    root = Node()
+    entries = 0
+    with open(path, encoding='utf-8') as f:
+        for lineno, line in enumerate(f, 1):
+            line = line.strip()
+            if not line or line.startswith('#'):
+                continue
+            fields = line.split()
+            py = fields[0]
+            if not PINYIN_RE.match(py):
+                raise SystemExit('%s:%d: 无效的拼音 "%s"' % (path, lineno, py))
+            node = root
+            for c in py:
+                node = node.children.setdefault(c, Node())
+            for cand in fields[1:]:
+                if cand not in node.cands:
+                    node.cands.append(cand)
+                    entries += 1
+    return root, entries
+
+
+def layout(root):
+    # 层次遍历编号，保证兄弟节点连续
+    nodes = []
+    queue = deque([root])
+    while queue:
+        node = queue.popleft()
+        node.index = len(nodes)
+        nodes.append(node)
+        for c in sorted(node.children):
+            queue.append(node.children[c])
+
+    # 先序遍历排列候选
+    cands = []
+
+    def visit(node):
+        node.cand_start = len(cands)
+        cands.extend(node.cands)
+        for c in sorted(node.children):
+            visit(node.children[c])
+        node.cand_total = len(cands) - node.cand_start
+
+    sys.setrecursionlimit(10000)
+    visit(root)
+    return nodes, cands
+
+
+def c_string(s):
+    return '"' + s.replace('\\', '\\\\').replace('"', '\\"') + '"'
+
+
+def write(path, src, nodes, cands):
+    with open(path, 'w', encoding='utf-8') as f:
+        f.write('/* 由tools/gen_pinyin_dict.py从%s生成，请勿修改 */\n\n' % src.replace('\\', '/').split('/')[-1])
+        f.write('#include "pinyin_ime.h"\n\n')
+        f.write('static const pinyin_node_t pinyin_nodes[%d] = {\n' % len(nodes))
+        for node in nodes:
+            mask = 0
+            for c in node.children:
+                mask |= 1 << (ord(c) - ord('a'))
+            first = node.children[min(node.children)].index if node.children else 0
+            f.write('    {0x%07x, %d, %d, %d, %d},\n' %
+                    (mask, first, node.cand_start, len(node.cands), node.cand_total))
+        f.write('};\n\n')
+        f.write('static const char *const pinyin_cands[%d] = {\n' % max(len(cands), 1))
+        for i in range(0, len(cands), 16):
+            f.write('    ' + ', '.join(c_string(c) for c in cands[i:i + 16]) + ',\n')
+        if not cands:
+            f.write('    "",\n')
+        f.write('};\n\n')
+        f.write('const pinyin_dict_t pinyin_dict = {\n')
+        f.write('    .nodes = pinyin_nodes,\n')
+        f.write('    .node_cnt = %d,\n' % len(nodes))
+        f.write('    .cands = pinyin_cands,\n')
+        f.write('    .cand_cnt = %d,\n' % len(cands))
+        f.write('};\n')
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('dict', help='拼音词典文本')
+    parser.add_argument('-o', '--output', required=True, help='生成的C文件')
+    args = parser.parse_args()
+
+    root, entries = load(args.dict)
+    nodes, cands = layout(root)
+    write(args.output, args.dict, nodes, cands)
+    print('拼音词典: %d 个候选, %d 个节点 -> %s' % (entries, len(nodes), args.output))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
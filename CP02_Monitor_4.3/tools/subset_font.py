@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+"""
+生成fonts分区使用的子集字体
+
+只保留界面源码和拼音词典候选中出现的字符以及ASCII，去掉字距和排版表（tiny_ttf的字形缓存
+假定字形与相邻字无关）以及hinting，减小字体体积。
+
+用法: python tools/subset_font.py NotoSansSC-Regular.ttf [-o fonts/cn_subset.ttf] [--dict main/pinyin/pinyin_dict.txt]
+依赖: pip install fonttools
+"""
+
+import argparse
+import glob
+import os
+import sys
+
+from fontTools import subset
+
+PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+PARTITION_SIZE = 2 * 1024 * 1024  # 与partitions.csv中fonts分区大小一致
+DEFAULT_DICT = os.path.join(PROJECT_DIR, 'main', 'pinyin', 'pinyin_dict.txt')  # 与CONFIG_EXAMPLE_PINYIN_DICT_FILE一致
+
+
+def collect_chars(sources):
+    chars = set(chr(c) for c in range(0x20, 0x7F))
+    for path in sources:
+        with open(path, encoding='utf-8') as f:
+            for line in f:
+                # 词典的注释行不会显示
+                if path.endswith('.txt') and line.lstrip().startswith('#'):
+                    continue
+                chars.update(c for c in line if ord(c) > 0x7F)
+    return chars
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('font', help='源字体文件 (TTF)')
+    parser.add_argument('-o', '--output', default=os.path.join(PROJECT_DIR, 'fonts', 'cn_subset.ttf'))
+    parser.add_argument('--extra', default='', help='额外保留的字符')
+    parser.add_argument('--dict', default=DEFAULT_DICT, help='拼音词典，候选字显示在输入法候选栏中')
+    args = parser.parse_args()
+
+    sources = glob.glob(os.path.join(PROJECT_DIR, 'main', '*.c'))
+    if args.dict:
+        if not os.path.exists(args.dict):
+            print('拼音词典 %s 不存在' % args.dict, file=sys.stderr)
+            return 1
+        sources.append(args.dict)
+    chars = collect_chars(sources)
+    chars.update(args.extra)
+
+    options = subset.Options()
+    options.layout_features = []
+    options.drop_tables += ['kern', 'GPOS', 'GSUB', 'GDEF', 'fpgm', 'prep', 'cvt ']
+    options.hinting = False
+    options.notdef_outline = True
+
+    font = subset.load_font(args.font, options)
+    subsetter = subset.Subsetter(options)
+    subsetter.populate(unicodes=[ord(c) for c in chars])
+    subsetter.subset(font)
+
+    os.makedirs(os.path.dirname(os.path.abspath(args.output)), exist_ok=True)
+    subset.save_font(font, args.output, options)
+
+    size = os.path.getsize(args.output)
+    print('%d 个字符, %d 字节 -> %s' % (len(chars), size, args.output))
+    if size > PARTITION_SIZE:
+        print('字体超过fonts分区大小 %d 字节' % PARTITION_SIZE, file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -11,11 +11,13 @@ static lv_color_t buf2[ LVGL_BUF_LEN];
 lv_disp_draw_buf_t disp_buf;                                                 // contains internal graphic buffer(s) called draw buffer(s)
 lv_disp_drv_t disp_drv;                                                      // contains callback functions
     
+#if !CONFIG_LV_TICK_CUSTOM
 void example_increase_lvgl_tick(void *arg)
 {
     /* Tell LVGL how many milliseconds has elapsed */
     lv_tick_inc(EXAMPLE_LVGL_TICK_PERIOD_MS);
 }
+#endif
 
 bool example_notify_lvgl_flush_ready(esp_lcd_panel_io_handle_t panel_io, esp_lcd_panel_io_event_data_t *edata, void *user_ctx)
 {
@@ -90,6 +92,7 @@ void LVGL_Init(void)
     disp = lv_disp_drv_register(&disp_drv);                                                  // Create screen objects
     
     /********************* LVGL *********************/
+#if !CONFIG_LV_TICK_CUSTOM
     ESP_LOGI(TAG_LVGL, "Install LVGL tick timer");
     // Tick interface for LVGL (using esp_timer to generate 2ms periodic event)
     const esp_timer_create_args_t lvgl_tick_timer_args = {
@@ -100,5 +103,6 @@ void LVGL_Init(void)
     esp_timer_handle_t lvgl_tick_timer = NULL;
     ESP_ERROR_CHECK(esp_timer_create(&lvgl_tick_timer_args, &lvgl_tick_timer));
     ESP_ERROR_CHECK(esp_timer_start_periodic(lvgl_tick_timer, EXAMPLE_LVGL_TICK_PERIOD_MS * 1000));
+#endif
 
 }
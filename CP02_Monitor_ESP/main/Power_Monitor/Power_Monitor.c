@@ -129,6 +129,7 @@ static esp_err_t http_event_handler(esp_http_client_event_t *evt)
 {
     static char *output_buffer;
     static int  output_len;
+    static int  output_cap;
     
     switch(evt->event_id) {
         case HTTP_EVENT_ERROR:
@@ -163,14 +164,28 @@ static esp_err_t http_event_handler(esp_http_client_event_t *evt)
                         return ESP_FAIL;
                     }
                     output_len = 0;
+                    output_cap = initial_size;
                 }
                 
-                // 检查是否需要扩展缓冲区
-                size_t new_size = output_len + evt->data_len + 1; // +1 for null terminator
-                output_buffer = (char *)realloc(output_buffer, new_size);
-                if (output_buffer == NULL) {
-                    ESP_LOGE(TAG, "Failed to reallocate memory for output buffer");
-                    return ESP_FAIL;
+                // 空间不够时按倍数扩展；realloc失败时原缓冲区仍然有效，
+                // 不能直接覆盖指针，否则原缓冲区会泄漏。这个固件没有4.3寸
+                // 版本的mem_tag分配标签，缓冲区只能从总的堆占用中看出
+                int need = output_len + evt->data_len + 1; // +1 for null terminator
+                if (need > output_cap) {
+                    int new_cap = output_cap;
+                    while (new_cap < need) {
+                        new_cap *= 2;
+                    }
+                    char *new_buffer = (char *)realloc(output_buffer, new_cap);
+                    if (new_buffer == NULL) {
+                        ESP_LOGE(TAG, "Failed to reallocate memory for output buffer");
+                        free(output_buffer);
+                        output_buffer = NULL;
+                        output_len = 0;
+                        return ESP_FAIL;
+                    }
+                    output_buffer = new_buffer;
+                    output_cap = new_cap;
                 }
                 
                 // 复制数据到缓冲区